@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/axiswrap_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	A clock by clock software model of the credit and FIFO logic
+//		generated by sw/axiswrap.cpp, for every pipeline latency our
+//	cores might have.  With both TVALIDs and TREADYs held high, the wrapper
+//	must accept a sample on every clock once it leaves reset.  With random
+//	stalls on either side, the FIFO must never overflow, and every sample
+//	must come out once, in order.  No Verilator model is required.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "axiswrap.h"
+
+const int	NCLOCKS = 20000, MAX_LATENCY = 64;
+
+// AXISWRAP_MODEL
+// {{{
+// The registers of the generated <core>_axis module, and of the core within
+// it.  The core is modeled only by when its results come out: for the
+// pipelined cores, o_aux follows i_aux by LATENCY clocks.  The sequential
+// cores are busy for LATENCY-1 clocks after i_stb, and then raise o_done.
+class	AXISWRAP_MODEL {
+	bool	m_sequential;
+	int	m_latency, m_depth;
+	int	m_credits, m_wr, m_rd, m_busy;
+	bool	m_s_ready;
+	bool	*m_pipe;	// The core's aux pipeline
+	long	*m_pipedata, *m_fifo, m_seqdata;
+public:
+	int	m_overflows;
+
+	AXISWRAP_MODEL(bool sequential, int latency) {
+		m_sequential = sequential;
+		m_latency = latency;
+		m_depth   = 1 << axis_lgfifo(sequential, latency);
+		m_pipe     = new bool[latency];
+		m_pipedata = new long[latency];
+		m_fifo     = new long[m_depth];
+		reset();
+	}
+
+	~AXISWRAP_MODEL(void) {
+		delete[] m_pipe;
+		delete[] m_pipedata;
+		delete[] m_fifo;
+	}
+
+	void	reset(void) {
+		m_credits = 0; m_wr = 0; m_rd = 0; m_busy = 0;
+		m_s_ready = true;
+		m_overflows = 0;
+		for(int k=0; k<m_latency; k++)
+			m_pipe[k] = false;
+	}
+
+	int	depth(void) const { return m_depth; }
+
+	// Combinational outputs
+	bool	s_tready(void) const {
+		return m_s_ready && ((!m_sequential)||(m_busy == 0));
+	}
+	bool	m_tvalid(void) const { return m_wr != m_rd; }
+	long	m_tdata(void) const { return m_fifo[m_rd % m_depth]; }
+
+	// One clock.  Returns true if a sample was accepted on S_AXIS
+	bool	tick(bool s_tvalid, long s_tdata, bool m_tready) {
+		bool	s_accept = s_tvalid && s_tready(),
+			m_accept = m_tvalid() && m_tready,
+			core_valid;
+		long	core_data;
+
+		// The core's output on this clock
+		// {{{
+		if (m_sequential) {
+			core_valid = (m_busy == 1);
+			core_data  = m_seqdata;
+			if (m_busy > 0)
+				m_busy--;
+			if (s_accept) {
+				m_busy = m_latency;
+				m_seqdata = s_tdata;
+			}
+		} else {
+			core_valid = m_pipe[m_latency-1];
+			core_data  = m_pipedata[m_latency-1];
+			for(int k=m_latency-1; k>0; k--) {
+				m_pipe[k]     = m_pipe[k-1];
+				m_pipedata[k] = m_pipedata[k-1];
+			}
+			m_pipe[0]     = s_accept;
+			m_pipedata[0] = s_tdata;
+		}
+		// }}}
+
+		// credits_used, s_ready
+		// {{{
+		if (s_accept && !m_accept) {
+			m_s_ready = (m_credits < m_depth-1);
+			m_credits++;
+		} else if (!s_accept && m_accept) {
+			m_s_ready = true;
+			m_credits--;
+		}
+		// }}}
+
+		// Output FIFO
+		// {{{
+		if (core_valid) {
+			if (m_wr - m_rd >= m_depth)
+				m_overflows++;
+			m_fifo[m_wr % m_depth] = core_data;
+			m_wr++;
+		} if (m_accept)
+			m_rd++;
+		// }}}
+
+		return s_accept;
+	}
+};
+// }}}
+
+// check_throughput
+// {{{
+// With TVALID and TREADY held high, a pipelined core must accept a new
+// sample on every clock.  Returns the number of clocks it didn't.
+int	check_throughput(int latency) {
+	AXISWRAP_MODEL	m(false, latency);
+	int	stalls = 0;
+
+	for(int k=0; k<NCLOCKS; k++) {
+		if (!m.tick(true, k, true))
+			stalls++;
+	}
+
+	if (stalls > 0 || m.m_overflows > 0)
+		printf("LATENCY %2d, DEPTH %3d: %5d stalls in %d clocks (%.1f%% throughput), %d overflows\n",
+			latency, m.depth(), stalls, NCLOCKS,
+			100.0 * (NCLOCKS - stalls) / NCLOCKS,
+			m.m_overflows);
+	return stalls + m.m_overflows;
+}
+// }}}
+
+// check_ordering
+// {{{
+// With random stalls on both sides, every sample must come out once, and in
+// order, and the FIFO must never overflow.  Returns the number of errors.
+int	check_ordering(bool sequential, int latency) {
+	AXISWRAP_MODEL	m(sequential, latency);
+	long	next_in = 0, next_out = 0;
+	int	errs = 0;
+
+	for(int k=0; k<NCLOCKS; k++) {
+		bool	m_tready = (rand() & 3) != 0,
+			s_tvalid = (rand() & 3) != 0;
+
+		if (m.m_tvalid() && m_tready) {
+			if (m.m_tdata() != next_out) {
+				if (errs < 8)
+					printf("%s LATENCY %2d: OUT-OF-ORDER, %ld != %ld\n",
+						(sequential) ? "SEQ":"PIPE",
+						latency, m.m_tdata(), next_out);
+				errs++;
+			}
+			next_out++;
+		}
+
+		if (m.tick(s_tvalid, next_in, m_tready))
+			next_in++;
+	}
+
+	if (m.m_overflows > 0)
+		printf("%s LATENCY %2d: %d FIFO overflows\n",
+			(sequential) ? "SEQ":"PIPE", latency, m.m_overflows);
+	if (next_in - next_out > m.depth()) {
+		printf("%s LATENCY %2d: %ld samples lost\n",
+			(sequential) ? "SEQ":"PIPE", latency,
+			next_in - next_out - m.depth());
+		errs++;
+	}
+
+	return errs + m.m_overflows;
+}
+// }}}
+
+int main(int argc, char **argv) {
+	// {{{
+	int	errs = 0;
+
+	for(int latency=1; latency<=MAX_LATENCY; latency++) {
+		errs += check_throughput(latency);
+		errs += check_ordering(false, latency);
+		errs += check_ordering(true,  latency);
+	}
+
+	if (errs) {
+		printf("TEST FAILURE: %d errors\n", errs);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/constcordic_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Checks the compile-time CORDIC calculations of constcordic.h
+//		against their run-time counterparts in cordiclib.cpp, and
+//	against the angle table of the generated cordic.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "cordic.h"
+#include "cordiclib.h"
+#include "constcordic.h"
+
+// These must all be evaluated by the compiler
+constexpr cordic::angle_table<PW, NSTAGES>	ANGLE;
+static_assert(ANGLE.size() == NSTAGES, "");
+static_assert(cordic::stages<WW, PW>() >= NSTAGES, "");
+static_assert(cordic::gain<NSTAGES>() > 1.16
+		&& cordic::gain<NSTAGES>() < 1.17, "");
+static_assert(cordic::inverse_gain_q32<NSTAGES>() > 0, "");
+
+int main(int argc, char **argv) {
+	// {{{
+	int	errs = 0;
+
+	// Against the values in the generated header
+	// {{{
+	if (fabs(cordic::gain<NSTAGES>() - GAIN) > 2e-15) {
+		printf("gain<%d>() = %.17f != %.17f\n", NSTAGES,
+			cordic::gain<NSTAGES>(), GAIN);
+		errs++;
+	}
+
+	for(int k=0; k<NSTAGES; k++) {
+		if (ANGLE[k] != CORDIC_ANGLE[k]) {
+			printf("ANGLE[%d] = 0x%lx != 0x%lx\n", k,
+				ANGLE[k], CORDIC_ANGLE[k]);
+			errs++;
+		}
+	}
+	// }}}
+
+	// Against cordiclib, for every configuration it supports
+	// {{{
+	for(int pw=3; pw<=32; pw++) {
+		for(int k=0; k<48; k++) {
+			if (cordic::angle(k, pw) != cordic_angle(k, pw)) {
+				printf("angle(%d, %d) = 0x%lx != 0x%lx\n", k, pw,
+					cordic::angle(k, pw),
+					cordic_angle(k, pw));
+				errs++;
+			}
+		}
+
+		if (cordic::calc_stages(0, pw) != calc_stages(pw)) {
+			printf("calc_stages(%d) = %d != %d\n", pw,
+				cordic::calc_stages(0, pw), calc_stages(pw));
+			errs++;
+		}
+
+		for(int ww=4; ww<=40; ww++) {
+			if (cordic::calc_stages(ww, pw) != calc_stages(ww, pw)) {
+				printf("calc_stages(%d, %d) = %d != %d\n", ww, pw,
+					cordic::calc_stages(ww, pw),
+					calc_stages(ww, pw));
+				errs++;
+			}
+		}
+
+		for(int n=1; n<=pw; n++) {
+			if (cordic::calc_phase_variance(n, pw)
+					!= phase_variance(n, pw)) {
+				printf("phase_variance(%d, %d) = %g != %g\n",
+					n, pw,
+					cordic::calc_phase_variance(n, pw),
+					phase_variance(n, pw));
+				errs++;
+			}
+		}
+	}
+
+	for(int ow=2; ow<=30; ow++) {
+		if (cordic::calc_phase_bits(ow) != calc_phase_bits(ow)) {
+			printf("calc_phase_bits(%d) = %d != %d\n", ow,
+				cordic::calc_phase_bits(ow),
+				calc_phase_bits(ow));
+			errs++;
+		}
+	}
+
+	for(int n=0; n<=40; n++) {
+		double	g = (double)cordic::gain(n);
+
+		if (fabs(g - cordic_gain(n)) > 2e-15) {
+			printf("gain(%d) = %.17f != %.17f\n", n,
+				g, cordic_gain(n));
+			errs++;
+		}
+	}
+	// }}}
+
+	printf("inverse_gain_q32<%d>() = 0x%08x\n", NSTAGES,
+		cordic::inverse_gain_q32<NSTAGES>());
+
+	if (errs) {
+		printf("TEST FAILURE: %d mismatches\n", errs);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -38,21 +38,70 @@
 //
 // }}}
 #include <stdio.h>
+#include <assert.h>
 
 #include <verilated.h>
 #include <verilated_vcd_c.h>
-#ifdef	CLOCKS_PER_OUTPUT
+#if	defined(CLOCKS_PER_OUTPUT) && defined(SEQK_TB)
+# include "Vseqcordick.h"
+# include "seqcordick.h"
+# define BASECLASS Vseqcordick
+# define TBNAME "seqcordick_tb"
+#elif	defined(CLOCKS_PER_OUTPUT) && defined(UNIT_GAIN_TB)
+# include "Vugseqcordic.h"
+# include "ugseqcordic.h"
+# define BASECLASS Vugseqcordic
+# define TBNAME "ugseqcordic_tb"
+#elif	defined(CLOCKS_PER_OUTPUT)
 # include "Vseqcordic.h"
 # include "seqcordic.h"
 # define BASECLASS Vseqcordic
+# define TBNAME "seqcordic_tb"
+#elif	defined(LANES_TB)
+# include "Vlanecordic.h"
+# include "lanecordic.h"
+# define BASECLASS Vlanecordic
+# define TBNAME "lanecordic_tb"
+#elif	defined(REGS_TB)
+# include "Vregcordic.h"
+# include "regcordic.h"
+# define BASECLASS Vregcordic
+# define TBNAME "regcordic_tb"
+#elif	defined(UNIT_GAIN_TB)
+# include "Vugcordic.h"
+# include "ugcordic.h"
+# define BASECLASS Vugcordic
+# define TBNAME "ugcordic_tb"
 #else
 # include "Vcordic.h"
 # include "cordic.h"
 # define BASECLASS Vcordic
+# define TBNAME "cordic_tb"
 #endif
 #include "fft.h"
 #include "testb.h"
 
+// lanes
+// {{{
+// Copy a w-bit value into every lane of a (packed, multi-lane) port
+unsigned long	lanes(unsigned long v, int w) {
+	unsigned long	r = 0;
+
+	v &= (1ul << w)-1;
+	for(int k=0; k<NLANES; k++)
+		r |= v << (k*w);
+	return r;
+}
+// }}}
+
+// lane
+// {{{
+// Return lane k of a packed port, sign extended from w bits
+int	lane(unsigned long v, int k, int w) {
+	return (int)(((long)(v << (64-(k+1)*w))) >> (64-w));
+}
+// }}}
+
 class	CORDIC_TB : public TESTB<BASECLASS> {
 	bool		m_debug;
 public:
@@ -65,7 +114,7 @@ public:
 #else	// CLOCKS_PER_OUTPUT
 		m_core->i_ce    = 1;
 #endif	// CLOCKS_PER_OUTPUT
-		m_core->i_xval  = (1ul<<(IW-1))-1;
+		m_core->i_xval  = lanes((1ul<<(IW-1))-1, IW);
 		m_core->i_yval  = 0;
 		m_core->i_phase = 0;
 		m_core->i_aux   = 0;
@@ -102,11 +151,7 @@ int main(int  argc, char **argv) {
 
 	// Open a trace
 	// {{{
-#ifdef	CLOCKS_PER_OUTPUT
-	tb->opentrace("seqcordic_tb.vcd");
-#else
-	tb->opentrace("cordic_tb.vcd");
-#endif
+	tb->opentrace(TBNAME ".vcd");
 	// }}}
 
 	// Reset the design
@@ -116,29 +161,39 @@ int main(int  argc, char **argv) {
 
 	// scale
 	// {{{
-	scale  = tb->m_core->i_xval * (double)tb->m_core->i_xval;
-	scale += tb->m_core->i_yval * (double)tb->m_core->i_yval;
+	scale  = lane(tb->m_core->i_xval, 0, IW)
+			* (double)lane(tb->m_core->i_xval, 0, IW);
+	scale += lane(tb->m_core->i_yval, 0, IW)
+			* (double)lane(tb->m_core->i_yval, 0, IW);
 	scale  = sqrt(scale);
 	// }}}
 
 	// Simulation loop for NSAMPLES time steps
 	// {{{
+	// Each clock carries NLANES samples, lane k holding sample i+k
+	assert(0 == (NSAMPLES % NLANES));
 	idx = 0;
-	for(int i=0; i<NSAMPLES; i++) {
-		int	shift = (PW-LGNSAMPLES);
-		if (shift < 0) {
-			int	sv = i;
-			if (i & (1ul<<(-shift)))
-				// Odd value, round down
-				sv += (1ul<<(-shift-1))-1;
-			else
-				sv += (1ul<<(-shift-1));
-			tb->m_core->i_phase = sv >> (-shift);
-		} else
-			tb->m_core->i_phase = i << shift;
-		pdata[i] = tb->m_core->i_phase;
-		ixval[i] = tb->m_core->i_xval;
-		iyval[i] = tb->m_core->i_yval;
+	for(int i=0; i<NSAMPLES; i+=NLANES) {
+		unsigned long	phase = 0;
+
+		for(int k=0; k<NLANES; k++) {
+			int	shift = (PW-LGNSAMPLES), sv = i+k;
+			if (shift < 0) {
+				if (sv & (1ul<<(-shift)))
+					// Odd value, round down
+					sv += (1ul<<(-shift-1))-1;
+				else
+					sv += (1ul<<(-shift-1));
+				sv >>= (-shift);
+			} else
+				sv <<= shift;
+			sv &= (1ul<<PW)-1;
+			phase |= (unsigned long)sv << (k*PW);
+			pdata[i+k] = sv;
+			ixval[i+k] = lane(tb->m_core->i_xval, k, IW);
+			iyval[i+k] = lane(tb->m_core->i_yval, k, IW);
+		}
+		tb->m_core->i_phase = phase;
 		tb->m_core->i_aux   = 1;
 
 		// Step the clock
@@ -159,20 +214,21 @@ int main(int  argc, char **argv) {
 		// }}}
 #else
 		tb->tick();
+		// The first output arrives LATENCY clocks after the first input
+		assert(tb->m_core->o_aux == (i/NLANES+1 >= LATENCY));
 #endif
 		// }}}
 
 		// Copy the results to an array for later analysis
 		// {{{
 		if (tb->m_core->o_aux) {
-			shift = (8*sizeof(int)-OW);
 			// Make our values signed..
-			xval[idx] = tb->m_core->o_xval << (shift);
-			yval[idx] = tb->m_core->o_yval << (shift);
-			xval[idx] >>= shift;
-			yval[idx] >>= shift;
-			// printf("%08x<<%d: %08x %08x\n", (unsigned)pdata[i], shift, xval[idx], yval[idx]);
-			idx++;
+			for(int k=0; k<NLANES; k++) {
+				xval[idx] = lane(tb->m_core->o_xval, k, OW);
+				yval[idx] = lane(tb->m_core->o_yval, k, OW);
+				// printf("%08x: %08x %08x\n", (unsigned)pdata[idx], xval[idx], yval[idx]);
+				idx++;
+			}
 		}
 		// }}}
 	}
@@ -183,17 +239,16 @@ int main(int  argc, char **argv) {
 #ifndef	CLOCKS_PER_OUTPUT
 	tb->m_core->i_aux = 0;
 	while(tb->m_core->o_aux) {
-		int	shift = (8*sizeof(int)-OW);
 		tb->m_core->i_aux   = 0;
 		tb->tick();
 
 		if (tb->m_core->o_aux) {
-			xval[idx] = tb->m_core->o_xval << (shift);
-			yval[idx] = tb->m_core->o_yval << (shift);
-			xval[idx] >>= shift;
-			yval[idx] >>= shift;
-			// printf("%08x %08x\n", xval[idx], yval[idx]);
-			idx++;
+			for(int k=0; k<NLANES; k++) {
+				xval[idx] = lane(tb->m_core->o_xval, k, OW);
+				yval[idx] = lane(tb->m_core->o_yval, k, OW);
+				// printf("%08x %08x\n", xval[idx], yval[idx]);
+				idx++;
+			}
 			assert(idx <= NSAMPLES);
 		}
 	}
@@ -304,6 +359,35 @@ int main(int  argc, char **argv) {
 	imag   = sqrt(imag);
 	// }}}
 
+#ifdef	HAS_CORDIC_MODEL
+	// Compare every output against a bit-exact model of the core
+	// {{{
+	{
+		int	nerrs = 0;
+
+		for(int i=0; i<NSAMPLES; i++) {
+			long	mxval, myval;
+
+			cordic_model(ixval[i], iyval[i], (unsigned)pdata[i],
+				mxval, myval);
+			if ((mxval != xval[i])||(myval != yval[i])) {
+				if (nerrs < 16)
+					printf("MISMATCH: PH=%08x (%6d,%6d) -> (%6d,%6d), model (%6ld,%6ld)\n",
+						pdata[i], ixval[i], iyval[i],
+						xval[i], yval[i],
+						mxval, myval);
+				nerrs++;
+			}
+		}
+
+		printf("Bit-exact: %d mismatches out of %d samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			failed = true;
+	}
+	// }}}
+#endif
+
 	// What average error do we expect?  and did we pass?
 
 	// Report on the results
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/cordicsim_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Verifies the batched software model of the polar to rectangular
+//		CORDIC, found in sw/cordicsim.cpp.  The vector path is checked
+//		against the scalar path, and both are checked against the
+//		bit-exact model found in the generated cordic.h header.  No
+//		Verilator model is required.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "cordic.h"
+#include "cordicsim.h"
+
+const int	NSAMPLES = (1<<20);
+
+// now
+// {{{
+double	now(void) {
+	struct timespec	tv;
+
+	clock_gettime(CLOCK_MONOTONIC, &tv);
+	return tv.tv_sec + tv.tv_nsec * 1e-9;
+}
+// }}}
+
+// randv
+// {{{
+// Return a random (signed) value of the given bit width
+int	randv(int bits) {
+	unsigned long	v = ((unsigned long)rand() << 31) ^ rand();
+
+	return (int)(((long)(v << (64-bits))) >> (64-bits));
+}
+// }}}
+
+// compare
+// {{{
+// Compare two sets of outputs, reporting the first few differences
+int	compare(const char *name, int n, const int *ax, const int *ay,
+		const int *bx, const int *by) {
+	int	errs = 0;
+
+	for(int k=0; k<n; k++) {
+		if ((ax[k] != bx[k])||(ay[k] != by[k])) {
+			if (errs < 8)
+				printf("%s MISMATCH[%d]: (%6d,%6d) != (%6d,%6d)\n",
+					name, k, ax[k], ay[k], bx[k], by[k]);
+			errs++;
+		}
+	}
+
+	return errs;
+}
+// }}}
+
+// check_config
+// {{{
+// Test the vector path against the scalar path for an arbitrary
+// configuration, such as one we don't have a header for.
+int	check_config(int nstages, int iw, int ow, int nxtra, int pw) {
+	P2RSIM	sim(nstages, iw, ow, nxtra, pw);
+	int		*ix, *iy, *sx, *sy, *vx, *vy, errs;
+	unsigned	*ph;
+	const int	N = 4099;	// Not a multiple of any lane count
+
+	ix = new int[N]; iy = new int[N]; ph = new unsigned[N];
+	sx = new int[N]; sy = new int[N]; vx = new int[N]; vy = new int[N];
+
+	for(int k=0; k<N; k++) {
+		ix[k] = randv(iw);
+		iy[k] = randv(iw);
+		ph[k] = (unsigned)randv(pw) & (unsigned)((1ul<<pw)-1);
+	}
+
+	sim.rotate_scalar(N, ix, iy, ph, sx, sy);
+	sim.rotate(N, ix, iy, ph, vx, vy);
+
+	char	name[64];
+	sprintf(name, "CFG(%d,%d,%d,%d,%d)", nstages, iw, ow, nxtra, pw);
+	errs = compare(name, N, sx, sy, vx, vy);
+
+	delete[] ix; delete[] iy; delete[] ph;
+	delete[] sx; delete[] sy; delete[] vx; delete[] vy;
+
+	return errs;
+}
+// }}}
+
+int main(int argc, char **argv) {
+	// {{{
+	P2RSIM	sim(NSTAGES, IW, OW, NEXTRA, PW);
+	int		*ix, *iy, *sx, *sy, *vx, *vy, *mx, *my, errs = 0;
+	unsigned	*ph;
+	double		start, scalar_time, vector_time;
+
+	ix = new int[NSAMPLES]; iy = new int[NSAMPLES];
+	ph = new unsigned[NSAMPLES];
+	sx = new int[NSAMPLES]; sy = new int[NSAMPLES];
+	vx = new int[NSAMPLES]; vy = new int[NSAMPLES];
+	mx = new int[NSAMPLES]; my = new int[NSAMPLES];
+
+	// Random inputs, covering the full input range
+	for(int k=0; k<NSAMPLES; k++) {
+		ix[k] = randv(IW);
+		iy[k] = randv(IW);
+		ph[k] = (unsigned)randv(PW) & ((1u<<PW)-1);
+	}
+
+	// The reference: the bit-exact model from the generated header
+	for(int k=0; k<NSAMPLES; k++) {
+		long	ox, oy;
+
+		cordic_model(ix[k], iy[k], ph[k], ox, oy);
+		mx[k] = (int)ox;
+		my[k] = (int)oy;
+	}
+
+	start = now();
+	sim.rotate_scalar(NSAMPLES, ix, iy, ph, sx, sy);
+	scalar_time = now() - start;
+
+	start = now();
+	sim.rotate(NSAMPLES, ix, iy, ph, vx, vy);
+	vector_time = now() - start;
+
+	errs += compare("SCALAR", NSAMPLES, mx, my, sx, sy);
+	errs += compare("VECTOR", NSAMPLES, mx, my, vx, vy);
+
+	printf("Lanes:  %2d\n", sim.lanes());
+	printf("Scalar: %8.2f MS/s\n", NSAMPLES / scalar_time / 1e6);
+	printf("Vector: %8.2f MS/s\n", NSAMPLES / vector_time / 1e6);
+
+	// Other configurations, including the 32-bit extremes
+	errs += check_config(NSTAGES, IW, OW, NEXTRA, PW);
+	errs += check_config(12,  8,  8, 1, 12);
+	errs += check_config(20, 16, 12, 2, 24);
+	errs += check_config(24, 12, 16, 4, 32);
+	errs += check_config(30, 30, 30, 2, 32);
+	errs += check_config(32, 24, 24, 8, 32);
+
+	delete[] ix; delete[] iy; delete[] ph;
+	delete[] sx; delete[] sy; delete[] vx; delete[] vy;
+	delete[] mx; delete[] my;
+
+	if (errs) {
+		printf("TEST FAILURE: %d mismatches\n", errs);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/cubtbl_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the cubically interpolated sine table, rtl/cubtbl.v, as
+//		built by gencordic -t qtbl --order 3.
+//
+//	A bit-exact model of the core's Horner pipeline reads the same four
+//	cubtbl_?tbl.hex tables the core does, and produces an output for every
+//	possible phase.  Those outputs are then checked against sin().  The
+//	worst error must stay within one LSB, and the mean error must be
+//	within an eighth of an LSB.  The outputs must peak at +/- SCALE, one
+//	step below full scale, so that the negative peak never overflows.
+//	This part needs no Verilator model, and is built as cubtblsim_tb.
+//
+//	Then, when built with -DRTL_CHECK (cubtbl_tb), the Verilated core is
+//	fed every phase as well.  Its first output must arrive LATENCY clocks
+//	after its first input, and every output must match the model exactly.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "Vcubtbl.h"
+#endif
+
+#include "cubtbl.h"
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+const int	WW = OW + NEXTRA,
+		DXBITS = PW - TBL_LGSZ;	// One less than the core's DXBITS
+const long	NSAMPLES = (1l << PW);
+const double	MAX_ERR = 1.0;	// LSBs
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+// readhex
+// {{{
+// Read a table of signed, w-bit values written by sw/hexfile.cpp, in the
+// same format $readmemh expects
+void	readhex(const char *fname, long *tbl, int entries, int w) {
+	FILE	*fp = fopen(fname, "r");
+	char	word[64];
+	int	idx = 0;
+
+	if (NULL == fp) {
+		fprintf(stderr, "ERR: Cannot open %s\n", fname);
+		exit(EXIT_FAILURE);
+	}
+
+	while((idx < entries)&&(1 == fscanf(fp, "%63s", word))) {
+		if ('@' == word[0])
+			idx = strtol(&word[1], NULL, 16);
+		else
+			tbl[idx++] = sext(strtol(word, NULL, 16), w);
+	}
+
+	fclose(fp);
+	assert(idx == entries);
+}
+// }}}
+
+// cubtbl_model
+// {{{
+// Duplicates the core's pipeline in integer arithmetic.  Each product keeps
+// its top bits only, dropping DXBITS, and each sum wraps to the width of the
+// register it lands in.
+long	cubtbl_model(const long *ctbl, const long *ltbl, const long *qtbl,
+		const long *ktbl, unsigned long phase) {
+	unsigned long	index, rv, wv;
+	long		dx, qv, lsum, r_value;
+
+	index = phase >> DXBITS;
+	dx    = phase & ((1ul << DXBITS)-1);
+
+	// Clocks 1-3: The cubic term
+	qv = sext(((ktbl[index] * dx) >> DXBITS) + qtbl[index], QBITS);
+
+	// Clocks 4-7: The quadratic interpolation
+	lsum    = sext(((qv   * dx) >> DXBITS) + ltbl[index], LBITS);
+	r_value = sext(((lsum * dx) >> DXBITS) + ctbl[index], CBITS);
+
+	// Clock 8: Round to even, unless doing so would overflow
+	rv = (unsigned long)r_value & ((1ul << WW)-1);
+	if ((0 == ((rv >> (WW-1))&1))
+		&& (((rv >> NEXTRA) & ((1ul << (WW-1-NEXTRA))-1))
+				== ((1ul << (WW-1-NEXTRA))-1)))
+		wv = rv;
+	else if ((3 == ((rv >> (WW-2))&3))
+		&& (0 == ((rv >> NEXTRA) & ((1ul << (WW-2-NEXTRA))-1))))
+		wv = rv;
+	else if ((rv >> NEXTRA) & 1)
+		wv = rv + (1ul << (NEXTRA-1));
+	else
+		wv = rv + (1ul << (NEXTRA-1)) - 1;
+
+	return sext(wv >> NEXTRA, OW);
+}
+// }}}
+
+#ifdef	RTL_CHECK
+class	CUBTBL_TB : public TESTB<Vcubtbl> {
+public:
+	// CUBTBL_TB constructor
+	// {{{
+	CUBTBL_TB(void) {
+		m_core->i_ce    = 1;
+		m_core->i_phase = 0;
+		m_core->i_aux   = 0;
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	long	*ctbl, *ltbl, *qtbl, *ktbl, *mo, mxv = 0, mnv = 0;
+	double	mxerr = 0.0, bias = 0.0;
+	int	errs = 0;
+
+	assert(3 == ORDER);
+	assert(CBITS >= WW);
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	ctbl = new long[TBL_SZ]; ltbl = new long[TBL_SZ];
+	qtbl = new long[TBL_SZ]; ktbl = new long[TBL_SZ];
+	mo   = new long[NSAMPLES];
+
+	readhex("cubtbl_ctbl.hex", ctbl, TBL_SZ, CBITS);
+	readhex("cubtbl_ltbl.hex", ltbl, TBL_SZ, LBITS);
+	readhex("cubtbl_qtbl.hex", qtbl, TBL_SZ, QBITS);
+	readhex("cubtbl_ktbl.hex", ktbl, TBL_SZ, KBITS);
+
+	// Check the model against sin()
+	// {{{
+	for(long k=0; k<NSAMPLES; k++) {
+		double	err;
+
+		mo[k] = cubtbl_model(ctbl, ltbl, qtbl, ktbl, k);
+
+		err = mo[k] - SCALE * sin(2.0 * M_PI * k / NSAMPLES);
+		if (fabs(err) > mxerr)
+			mxerr = fabs(err);
+		bias += err;
+		if (mo[k] > mxv)
+			mxv = mo[k];
+		if (mo[k] < mnv)
+			mnv = mo[k];
+	}
+
+	bias /= NSAMPLES;
+	printf("Model MXERR: %.4f LSBs (%.2f allowed)\n", mxerr, MAX_ERR);
+	printf("Model bias : %.4f LSBs\n", bias);
+	printf("Model peaks: %ld, %ld (SCALE = %ld)\n", mxv, mnv, SCALE);
+	if ((mxerr > MAX_ERR)||(fabs(bias) > 1./8.)
+			||(mxv != SCALE)||(mnv != -SCALE))
+		errs++;
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the core against the model
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		CUBTBL_TB	*tb = new CUBTBL_TB;
+		long	idx = 0;
+		int	nerrs = 0;
+
+		tb->reset();
+
+		for(long k=0; idx < NSAMPLES; k++) {
+			long	co;
+
+			if (k < NSAMPLES) {
+				tb->m_core->i_phase = k;
+				tb->m_core->i_aux   = 1;
+			} else
+				tb->m_core->i_aux   = 0;
+			tb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+
+			if ((0 == idx)&&(k+1 != LATENCY)) {
+				printf("LATENCY: The first output took %ld clocks, not %d\n",
+					k+1, LATENCY);
+				nerrs++;
+			}
+
+			co = sext(tb->m_core->o_sin, OW);
+			if (co != mo[idx]) {
+				if (nerrs < 16)
+					printf("MISMATCH: 0x%06lx -> %6ld, model %6ld\n",
+						idx, co, mo[idx]);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %ld samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete tb;
+	}
+	// }}}
+#endif
+
+	delete[] ctbl; delete[] ltbl; delete[] qtbl; delete[] ktbl;
+	delete[] mo;
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
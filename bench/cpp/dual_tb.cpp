@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/dual_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the --dual sine and cosine table cores: rtl/dualtbl.v,
+//		the quadratically interpolated table built by gencordic -t qtbl
+//	--dual, or, when built with -DDUALQTR_TB, rtl/dualqtr.v, the quarter
+//	wave table built by gencordic -t qtr --dual.
+//
+//	A bit-exact model of the core reads the same hex table(s) the core
+//	does.  Since the core's cosine is its sine a quarter wave later, the
+//	model's cosine is its sine at the phase plus 2^(PW-2).  The model's
+//	cosine is then checked against cos() for every phase.  The quarter wave
+//	table, which truncates its entries, must be within one LSB of
+//	SCALE*cos(), at the phase's half step offset, and the quadratic within
+//	the two LSBs quadtbl_tb allows.  The sine has to match the single
+//	output core, rtl/quarterwav.v or rtl/quadtbl.v, built with the same
+//	options.  Here, that means the dual core's tables must match that
+//	core's tables, entry for entry.  This part needs no Verilator model,
+//	and is built as dualqtrsim_tb and dualtblsim_tb.
+//
+//	Then, when built with -DRTL_CHECK (dualqtr_tb and dualtbl_tb), the
+//	Verilated dual core and the Verilated single output core are fed every
+//	phase together.  The dual core's first output must arrive LATENCY
+//	clocks after its first input.  Every o_cos must match the model, and
+//	every o_sin must match the single output core's, exactly.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#endif
+
+#ifdef	DUALQTR_TB
+# include "dualqtr.h"
+# ifdef	RTL_CHECK
+#  include "Vdualqtr.h"
+#  include "Vquarterwav.h"
+#  define DUALCORE	Vdualqtr
+#  define SINGLECORE	Vquarterwav
+#  define SINGLE_OUT	o_val
+# endif
+#else
+# include "dualtbl.h"
+# ifdef	RTL_CHECK
+#  include "Vdualtbl.h"
+#  include "Vquadtbl.h"
+#  define DUALCORE	Vdualtbl
+#  define SINGLECORE	Vquadtbl
+#  define SINGLE_OUT	o_sin
+# endif
+#endif
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+#ifndef	HAS_COS_OUTPUT
+#error "This test-bench depends upon a core built with --dual"
+#endif
+
+const long	NSAMPLES = (1l << PW);
+#ifdef	DUALQTR_TB
+// The table truncates each value, rather than rounding it
+const double	MAX_ERR = 1.0;	// LSBs
+const int	NTBLS = 1;
+const char	*DUAL_HEX[NTBLS]   = { "dualqtr.hex" },
+		*SINGLE_HEX[NTBLS] = { "quarterwav.hex" };
+const int	TBL_BITS[NTBLS]    = { OW };
+#else
+// What quadtbl_tb allows
+const double	MAX_ERR = 2.0;	// LSBs
+const int	NTBLS = 3,
+		WW = OW + NEXTRA,
+		DXBITS = PW - TBL_LGSZ;	// One less than the core's DXBITS
+const char	*DUAL_HEX[NTBLS] = {
+			"dualtbl_ctbl.hex", "dualtbl_ltbl.hex",
+			"dualtbl_qtbl.hex" },
+		*SINGLE_HEX[NTBLS] = {
+			"quadtbl_ctbl.hex", "quadtbl_ltbl.hex",
+			"quadtbl_qtbl.hex" };
+const int	TBL_BITS[NTBLS]    = { CBITS, LBITS, QBITS };
+#endif
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+// readhex
+// {{{
+// Read a table of signed, w-bit values written by sw/hexfile.cpp, in the
+// same format $readmemh expects
+void	readhex(const char *fname, long *tbl, int entries, int w) {
+	FILE	*fp = fopen(fname, "r");
+	char	word[64];
+	int	idx = 0;
+
+	if (NULL == fp) {
+		fprintf(stderr, "ERR: Cannot open %s\n", fname);
+		exit(EXIT_FAILURE);
+	}
+
+	while((idx < entries)&&(1 == fscanf(fp, "%63s", word))) {
+		if ('@' == word[0])
+			idx = strtol(&word[1], NULL, 16);
+		else
+			tbl[idx++] = sext(strtol(word, NULL, 16), w);
+	}
+
+	fclose(fp);
+	assert(idx == entries);
+}
+// }}}
+
+// sin_model
+// {{{
+// Duplicates one channel of the core in integer arithmetic, returning the
+// sine of phase.
+#ifdef	DUALQTR_TB
+long	sin_model(long **tbl, unsigned long phase) {
+	unsigned long	index;
+	long		v;
+
+	// Quarter wave symmetry: mirror the second and fourth quarters, and
+	// negate the second half
+	index = phase & ((1ul << (PW-2))-1);
+	if ((phase >> (PW-2)) & 1)
+		index = (~index) & ((1ul << (PW-2))-1);
+	v = tbl[0][index];
+
+	return sext(((phase >> (PW-1)) & 1) ? -v : v, OW);
+}
+#else
+long	sin_model(long **tbl, unsigned long phase) {
+	const long	*ctbl = tbl[0], *ltbl = tbl[1], *qtbl = tbl[2];
+	unsigned long	index, rv, wv;
+	long		dx, lsum, r_value;
+
+	index = phase >> DXBITS;
+	dx    = phase & ((1ul << DXBITS)-1);
+
+	// Each product keeps its top bits only, dropping DXBITS, and each
+	// sum wraps to the width of the register it lands in
+	lsum    = sext(((qtbl[index] * dx) >> DXBITS) + ltbl[index], LBITS);
+	r_value = sext(((lsum * dx) >> DXBITS) + ctbl[index], CBITS);
+
+	// Round to even, unless doing so would overflow
+	rv = (unsigned long)r_value & ((1ul << WW)-1);
+	if ((0 == ((rv >> (WW-1))&1))
+		&& (((rv >> NEXTRA) & ((1ul << (WW-1-NEXTRA))-1))
+				== ((1ul << (WW-1-NEXTRA))-1)))
+		wv = rv;
+	else if ((3 == ((rv >> (WW-2))&3))
+		&& (0 == ((rv >> NEXTRA) & ((1ul << (WW-2-NEXTRA))-1))))
+		wv = rv;
+	else if ((rv >> NEXTRA) & 1)
+		wv = rv + (1ul << (NEXTRA-1));
+	else
+		wv = rv + (1ul << (NEXTRA-1)) - 1;
+
+	return sext(wv >> NEXTRA, OW);
+}
+#endif
+// }}}
+
+#ifdef	RTL_CHECK
+template <class VA>	class	TABLE_TB : public TESTB<VA> {
+public:
+	// TABLE_TB constructor
+	// {{{
+	TABLE_TB(void) {
+		this->m_core->i_ce    = 1;
+		this->m_core->i_phase = 0;
+		this->m_core->i_aux   = 0;
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	long	*dtbl[NTBLS], *stbl[NTBLS], *mc;
+	double	mxerr = 0.0;
+	int	errs = 0, nmismatch = 0;
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	for(int t=0; t<NTBLS; t++) {
+		dtbl[t] = new long[TBL_SZ];
+		stbl[t] = new long[TBL_SZ];
+		readhex(DUAL_HEX[t],   dtbl[t], TBL_SZ, TBL_BITS[t]);
+		readhex(SINGLE_HEX[t], stbl[t], TBL_SZ, TBL_BITS[t]);
+	}
+	mc = new long[NSAMPLES];
+
+	// The sine: the same tables as the single output core
+	// {{{
+	for(int t=0; t<NTBLS; t++) {
+		for(int k=0; k<TBL_SZ; k++) {
+			if (dtbl[t][k] != stbl[t][k]) {
+				if (nmismatch < 16)
+					printf("TABLE MISMATCH: %s[%d] = %ld, %s[%d] = %ld\n",
+						DUAL_HEX[t], k, dtbl[t][k],
+						SINGLE_HEX[t], k, stbl[t][k]);
+				nmismatch++;
+			}
+		}
+	}
+
+	printf("Tables: %d entries differ from the single output core\n",
+		nmismatch);
+	if (nmismatch > 0)
+		errs++;
+	// }}}
+
+	// The cosine: the sine a quarter wave later, checked against cos()
+	// {{{
+	for(long k=0; k<NSAMPLES; k++) {
+		double	err;
+
+		mc[k] = sin_model(dtbl, (k + NSAMPLES/4) & (NSAMPLES-1));
+
+#ifdef	DUALQTR_TB
+		err = mc[k] - SCALE * cos(2.0 * M_PI * (k + 0.5) / NSAMPLES);
+#else
+		err = mc[k] - ((1l << (OW-1))-1)
+					* cos(2.0 * M_PI * k / NSAMPLES);
+#endif
+		if (fabs(err) > mxerr)
+			mxerr = fabs(err);
+	}
+
+	printf("Model cosine MXERR: %.4f LSBs (%.2f allowed)\n",
+		mxerr, MAX_ERR);
+	if (mxerr > MAX_ERR)
+		errs++;
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the dual core against the model and the single output core
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		TABLE_TB<DUALCORE>	*tb = new TABLE_TB<DUALCORE>;
+		TABLE_TB<SINGLECORE>	*sb = new TABLE_TB<SINGLECORE>;
+		long	idx = 0;
+		int	nerrs = 0;
+
+		tb->reset();
+		sb->reset();
+
+		for(long k=0; idx < NSAMPLES; k++) {
+			long	co, so, ss;
+
+			if (k < NSAMPLES) {
+				tb->m_core->i_phase = k;
+				sb->m_core->i_phase = k;
+				tb->m_core->i_aux   = 1;
+				sb->m_core->i_aux   = 1;
+			} else {
+				tb->m_core->i_aux   = 0;
+				sb->m_core->i_aux   = 0;
+			}
+			tb->tick();
+			sb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+
+			if ((0 == idx)&&(k+1 != LATENCY)) {
+				printf("LATENCY: The first output took %ld clocks, not %d\n",
+					k+1, LATENCY);
+				nerrs++;
+			}
+
+			co = sext(tb->m_core->o_cos, OW);
+			so = sext(tb->m_core->o_sin, OW);
+			ss = sext(sb->m_core->SINGLE_OUT, OW);
+			if ((!sb->m_core->o_aux)||(co != mc[idx])||(so != ss)) {
+				if (nerrs < 16)
+					printf("MISMATCH: 0x%06lx -> (%6ld,%6ld), expected (%6ld,%6ld)\n",
+						idx, co, so, mc[idx], ss);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %ld samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete tb;
+		delete sb;
+	}
+	// }}}
+#endif
+
+	for(int t=0; t<NTBLS; t++) {
+		delete[] dtbl[t];
+		delete[] stbl[t];
+	} delete[] mc;
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/hyperbolic_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the hyperbolic CORDIC cores, rtl/hrotate.v and, when
+//		built with -DHVECTOR_TB, rtl/hvector.v.
+//
+//	First, the bit-exact model found in the generated header is checked
+//	against cosh(), sinh(), and atanh().  Every sample's error must lie
+//	within what the header's QUANTIZATION_VARIANCE and PHASE_VARIANCE
+//	predict, both on average and at its worst.  This part needs no
+//	Verilator model, and is built as hrotsim_tb and hvecsim_tb.
+//
+//	Then, when built with -DRTL_CHECK (hrotate_tb and hvector_tb), the
+//	Verilated core is fed the same samples, and every one of its outputs
+//	must match the model exactly.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#endif
+
+#ifdef	HVECTOR_TB
+# include "hvector.h"
+# ifdef	RTL_CHECK
+#  include "Vhvector.h"
+#  define BASECLASS Vhvector
+# endif
+#else
+# include "hrotate.h"
+# ifdef	RTL_CHECK
+#  include "Vhrotate.h"
+#  define BASECLASS Vhrotate
+# endif
+#endif
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+#ifndef	HAS_HYPERBOLIC_MODEL
+#error "This test-bench depends upon the header's bit-exact model"
+#endif
+
+const int	NSAMPLES = (1<<16);
+
+// randv
+// {{{
+// Return a random (signed) value of the given bit width
+long	randv(int bits) {
+	unsigned long	v = ((unsigned long)rand() << 31) ^ rand();
+
+	return ((long)(v << (64-bits))) >> (64-bits);
+}
+// }}}
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+#ifdef	RTL_CHECK
+class	HYPERBOLIC_TB : public TESTB<BASECLASS> {
+public:
+	// HYPERBOLIC_TB constructor
+	// {{{
+	HYPERBOLIC_TB(void) {
+		m_core->i_ce    = 1;
+		m_core->i_xval  = 0;
+		m_core->i_yval  = 0;
+#ifndef	VECTORING
+		m_core->i_phase = 0;
+#endif
+		m_core->i_aux   = 0;
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	long	*ix, *iy, *mx, *my;
+	unsigned long	*ph;
+	double	avg = 0.0, mxv = 0.0;
+	int	errs = 0;
+	// Output = GAIN * result * 2^(OW-IW-1)
+	const double	OSCALE = GAIN * pow(2.0, OW-IW-1),
+			UNITS  = (double)(1ul << (PW-2));
+
+	ix = new long[NSAMPLES]; iy = new long[NSAMPLES];
+	ph = new unsigned long[NSAMPLES];
+	mx = new long[NSAMPLES]; my = new long[NSAMPLES];
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	// Random inputs, within the range the CORDIC will converge over
+	// {{{
+	for(int k=0; k<NSAMPLES; k++) {
+#ifdef	VECTORING
+		// |y| < 0.75 |x|, and |x| no smaller than 1/8 full scale
+		do {
+			ix[k] = randv(IW);
+		} while(labs(ix[k]) < (1l<<(IW-4)));
+		iy[k] = (long)(0.75 * ix[k] * (2.0*drand48()-1.0));
+		ph[k] = 0;
+#else
+		ix[k] = randv(IW);
+		iy[k] = randv(IW);
+		// |phase| < 1.1
+		ph[k] = (unsigned long)(long)(1.1 * UNITS * (2.0*drand48()-1.0))
+				& ((1ul<<PW)-1);
+#endif
+	}
+	// }}}
+
+	// Check the model against the math
+	// {{{
+	for(int k=0; k<NSAMPLES; k++) {
+		double	ex, ey, vx, vy, err;
+
+#ifdef	VECTORING
+		unsigned long	mph;
+		double	x = ix[k], y = iy[k], dmag, dph, wmag;
+
+		hvector_model(ix[k], iy[k], mx[k], mph);
+		my[k] = sext(mph, PW);
+
+		dmag = OSCALE * sqrt(x*x - y*y);
+		dph  = atanh(y/x) * UNITS;
+		ex = mx[k] - dmag;
+		ey = my[k] - dph;
+
+		// The magnitude sees the quantization noise, as does the y
+		// that's left over.  Relative to the magnitude within the
+		// working width, that leftover becomes the error in the angle.
+		wmag = dmag * pow(2.0, WW-OW);
+		vx = QUANTIZATION_VARIANCE;
+		vy = (PHASE_VARIANCE
+			+ QUANTIZATION_VARIANCE * pow(4.0, WW-OW)
+				/ (wmag * wmag)) * UNITS * UNITS;
+		if (vy < 1./12.)
+			vy = 1./12.;
+#else
+		double	x = ix[k], y = iy[k],
+			theta = sext(ph[k], PW) / UNITS, dx, dy;
+
+		hrotate_model(ix[k], iy[k], ph[k], mx[k], my[k]);
+
+		dx = OSCALE * (x * cosh(theta) + y * sinh(theta));
+		dy = OSCALE * (x * sinh(theta) + y * cosh(theta));
+		ex = mx[k] - dx;
+		ey = my[k] - dy;
+
+		// An error in the angle moves x along y, and y along x
+		vx = QUANTIZATION_VARIANCE + PHASE_VARIANCE * dy * dy;
+		vy = QUANTIZATION_VARIANCE + PHASE_VARIANCE * dx * dx;
+#endif
+
+		// Normalized, each error should have unit variance
+		err  = ex*ex/vx + ey*ey/vy;
+		avg += err;
+		err  = sqrt(err / 2.0);
+		if (err > mxv) {
+			mxv = err;
+			if (mxv > 5.2)
+				printf("OUT-OF-BOUNDS: (%6ld,%6ld,0x%06lx) -> (%6ld,%6ld), error (%.2f,%.2f)\n",
+					ix[k], iy[k], ph[k], mx[k], my[k],
+					ex, ey);
+		}
+	}
+
+	avg = sqrt(avg / NSAMPLES / 2.0);
+	printf("Model AVG Err: %.4f of that expected\n", avg);
+	printf("Model MAX Err: %.4f of that expected (5.2 threshold)\n", mxv);
+	if ((avg > 1.5)||(mxv > 5.2))
+		errs++;
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the core against the model
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		HYPERBOLIC_TB	*tb = new HYPERBOLIC_TB;
+		int	idx = 0, nerrs = 0;
+
+		tb->reset();
+
+		for(int k=0; idx < NSAMPLES; k++) {
+			long	cx, cy;
+
+			if (k < NSAMPLES) {
+				tb->m_core->i_xval  = ix[k] & ((1l<<IW)-1);
+				tb->m_core->i_yval  = iy[k] & ((1l<<IW)-1);
+#ifndef	VECTORING
+				tb->m_core->i_phase = ph[k];
+#endif
+				tb->m_core->i_aux   = 1;
+			} else
+				tb->m_core->i_aux   = 0;
+			tb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+#ifdef	VECTORING
+			cx = sext(tb->m_core->o_mag, OW);
+			cy = sext(tb->m_core->o_phase, PW);
+#else
+			cx = sext(tb->m_core->o_xval, OW);
+			cy = sext(tb->m_core->o_yval, OW);
+#endif
+			if ((cx != mx[idx])||(cy != my[idx])) {
+				if (nerrs < 16)
+					printf("MISMATCH: (%6ld,%6ld,0x%06lx) -> (%6ld,%6ld), model (%6ld,%6ld)\n",
+						ix[idx], iy[idx], ph[idx],
+						cx, cy, mx[idx], my[idx]);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %d samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete tb;
+	}
+	// }}}
+#endif
+
+	delete[] ix; delete[] iy; delete[] ph;
+	delete[] mx; delete[] my;
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/linear_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the linear CORDIC cores, rtl/lrotate.v (y+x*z) and, when
+//		built with -DLVECTOR_TB, rtl/lvector.v (z=y/x).
+//
+//	First, the bit-exact model found in the generated header is checked
+//	against the same product or quotient computed in floating point.  The
+//	product's error must lie within what QUANTIZATION_VARIANCE and
+//	PHASE_VARIANCE predict, on average and at its worst, and its mean must
+//	stay within half an LSB.  The quotient must be within one LSB of y/x on
+//	every sample, with a mean error under an eighth of an LSB.  This part
+//	needs no Verilator model, and is built as lrotsim_tb and lvecsim_tb.
+//
+//	Then, when built with -DRTL_CHECK (lrotate_tb and lvector_tb), the
+//	Verilated core is fed the same samples, and every one of its outputs
+//	must match the model exactly.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#endif
+
+#ifdef	LVECTOR_TB
+# include "lvector.h"
+# ifdef	RTL_CHECK
+#  include "Vlvector.h"
+#  define BASECLASS Vlvector
+# endif
+#else
+# include "lrotate.h"
+# ifdef	RTL_CHECK
+#  include "Vlrotate.h"
+#  define BASECLASS Vlrotate
+# endif
+#endif
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+#ifndef	HAS_LINEAR_MODEL
+#error "This test-bench depends upon the header's bit-exact model"
+#endif
+
+const int	NSAMPLES = (1<<16);
+
+// randv
+// {{{
+// Return a random (signed) value of the given bit width
+long	randv(int bits) {
+	unsigned long	v = ((unsigned long)rand() << 31) ^ rand();
+
+	return ((long)(v << (64-bits))) >> (64-bits);
+}
+// }}}
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+#ifdef	RTL_CHECK
+class	LINEAR_TB : public TESTB<BASECLASS> {
+public:
+	// LINEAR_TB constructor
+	// {{{
+	LINEAR_TB(void) {
+		m_core->i_ce    = 1;
+		m_core->i_xval  = 0;
+		m_core->i_yval  = 0;
+#ifndef	VECTORING
+		m_core->i_zval  = 0;
+#endif
+		m_core->i_aux   = 0;
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	long	*ix, *iy, *mo;
+	unsigned long	*iz;
+	double	avg = 0.0, mxv = 0.0, bias = 0.0;
+	int	errs = 0;
+#ifdef	VECTORING
+	int	nbad = 0;
+#endif
+	// A z of 1.0 is 2^(PW-1)
+	const double	ZUNITS = (double)(1ul << (PW-1));
+
+	ix = new long[NSAMPLES]; iy = new long[NSAMPLES];
+	iz = new unsigned long[NSAMPLES];
+	mo = new long[NSAMPLES];
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	// Random inputs
+	// {{{
+	for(int k=0; k<NSAMPLES; k++) {
+#ifdef	VECTORING
+		// Any non-zero x, with |y| < |x|
+		do {
+			ix[k] = randv(IW);
+			iy[k] = randv(IW);
+		} while(labs(iy[k]) >= labs(ix[k]));
+		iz[k] = 0;
+#else
+		ix[k] = randv(IW);
+		iy[k] = randv(IW);
+		iz[k] = randv(PW) & ((1ul<<PW)-1);
+#endif
+	}
+	// }}}
+
+	// Check the model against the math
+	// {{{
+	for(int k=0; k<NSAMPLES; k++) {
+		double	x = ix[k], y = iy[k], err, v;
+
+#ifdef	VECTORING
+		unsigned long	mz;
+
+		lvector_model(ix[k], iy[k], mz);
+		mo[k] = sext(mz, PW);
+
+		// The quotient, in units of the LSB of z
+		err = mo[k] - (y / x) * ZUNITS;
+		// The residual of the last stage is uniform across one LSB
+		v = PHASE_VARIANCE * ZUNITS * ZUNITS;
+#else
+		double	z = sext(iz[k], PW) / ZUNITS;
+
+		lrotate_model(ix[k], iy[k], iz[k], mo[k]);
+
+		// Output = (y + x * z) * 2^(OW-IW-1)
+		err = mo[k] - (y + x * z) * pow(2.0, OW-IW-1);
+		// Any error left in z moves the output along x
+		x *= pow(2.0, OW-IW-1);
+		v = QUANTIZATION_VARIANCE + PHASE_VARIANCE * x * x;
+#endif
+
+		bias += err;
+#ifdef	VECTORING
+		// Nothing is truncated, so the quotient must be within its
+		// last bit.  It can only get there when y/x lands exactly on
+		// a value the (always odd) result can't represent.
+		if (fabs(err) > 1.0 + 1e-9) {
+			if (nbad++ < 16)
+				printf("OUT-OF-BOUNDS: %6ld / %6ld -> 0x%04lx, error %.2f LSBs\n",
+					iy[k], ix[k], mo[k] & ((1ul<<PW)-1),
+					err);
+		}
+#endif
+		// Normalized, each error should have unit variance
+		avg += err * err / v;
+		err  = fabs(err) / sqrt(v);
+		if (err > mxv) {
+			mxv = err;
+#ifndef	VECTORING
+			if (mxv > 5.2)
+				printf("OUT-OF-BOUNDS: (%6ld,%6ld,0x%04lx) -> %6ld, error %.2f\n",
+					ix[k], iy[k], iz[k], mo[k],
+					err * sqrt(v));
+#endif
+		}
+	}
+
+	avg  = sqrt(avg / NSAMPLES);
+	bias = bias / NSAMPLES;
+	printf("Model AVG Err: %.4f of that expected\n", avg);
+	printf("Model MAX Err: %.4f of that expected (5.2 threshold)\n", mxv);
+	printf("Model bias   : %.4f LSBs\n", bias);
+	if ((avg > 1.5)||(mxv > 5.2))
+		errs++;
+#ifdef	VECTORING
+	printf("Model: %d quotients more than one LSB from y/x\n", nbad);
+	if ((nbad > 0)||(fabs(bias) > 1./8.))
+		errs++;
+#else
+	if (fabs(bias) > 0.5)
+		errs++;
+#endif
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the core against the model
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		LINEAR_TB	*tb = new LINEAR_TB;
+		int	idx = 0, nerrs = 0;
+
+		tb->reset();
+
+		for(int k=0; idx < NSAMPLES; k++) {
+			long	co;
+
+			if (k < NSAMPLES) {
+				tb->m_core->i_xval  = ix[k] & ((1l<<IW)-1);
+				tb->m_core->i_yval  = iy[k] & ((1l<<IW)-1);
+#ifndef	VECTORING
+				tb->m_core->i_zval  = iz[k];
+#endif
+				tb->m_core->i_aux   = 1;
+			} else
+				tb->m_core->i_aux   = 0;
+			tb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+#ifdef	VECTORING
+			co = sext(tb->m_core->o_zval, PW);
+#else
+			co = sext(tb->m_core->o_yval, OW);
+#endif
+			if (co != mo[idx]) {
+				if (nerrs < 16)
+					printf("MISMATCH: (%6ld,%6ld,0x%04lx) -> %6ld, model %6ld\n",
+						ix[idx], iy[idx], iz[idx],
+						co, mo[idx]);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %d samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete tb;
+	}
+	// }}}
+#endif
+
+	delete[] ix; delete[] iy; delete[] iz;
+	delete[] mo;
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
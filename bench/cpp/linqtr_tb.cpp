@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/linqtr_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the linearly interpolated quarter-wave table,
+//		rtl/linqtr.v.
+//
+//	A bit-exact model of the core's datapath reads the same linqtr_ctbl.hex
+//	and linqtr_ltbl.hex tables the core does, and produces an output for
+//	every possible phase.  Those outputs are then checked against sin(), at
+//	the phase's half step offset.  The worst error must stay within half
+//	an LSB of rounding, plus the minimax table error the header reports in
+//	TBL_ERR, plus the truncation of the two tables and the product.  The
+//	mean error across the first quarter wave must be within an eighth of an
+//	LSB, which checks the offset and rounding the value table absorbs.  The
+//	peak must reach SCALE without ever needing to saturate.  This part
+//	needs no Verilator model, and is built as linqtrsim_tb.
+//
+//	Then, when built with -DRTL_CHECK (linqtr_tb), the Verilated core is fed
+//	every phase as well, and every output must match the model exactly.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "Vlinqtr.h"
+#endif
+
+#include "linqtr.h"
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+const int	WW = OW + NEXTRA,
+		DXBITS = PW - 2 - TBL_LGSZ;
+const long	NSAMPLES = (1l << PW);
+
+// readhex
+// {{{
+// Read a table written by sw/hexfile.cpp, in the same format $readmemh
+// expects
+void	readhex(const char *fname, long *tbl, int entries) {
+	FILE	*fp = fopen(fname, "r");
+	char	word[64];
+	int	idx = 0;
+
+	if (NULL == fp) {
+		fprintf(stderr, "ERR: Cannot open %s\n", fname);
+		exit(EXIT_FAILURE);
+	}
+
+	while((idx < entries)&&(1 == fscanf(fp, "%63s", word))) {
+		if ('@' == word[0])
+			idx = strtol(&word[1], NULL, 16);
+		else
+			tbl[idx++] = strtol(word, NULL, 16);
+	}
+
+	fclose(fp);
+	assert(idx == entries);
+}
+// }}}
+
+// linqtr_model
+// {{{
+// Duplicates the core's datapath, clock by clock, in integer arithmetic.
+// Sets sat if the magnitude would have needed to saturate.
+long	linqtr_model(const long *ctbl, const long *ltbl, unsigned long phase,
+		bool &sat) {
+	bool		negate;
+	unsigned long	qphase, index, dx;
+	long		mag, w_mag;
+
+	// Clock 1 - Quarter wave symmetry
+	negate = (phase >> (PW-1)) & 1;
+	qphase = phase & ((1ul << (PW-2))-1);
+	if ((phase >> (PW-2)) & 1)
+		qphase = (~qphase) & ((1ul << (PW-2))-1);
+	index = qphase >> DXBITS;
+	dx    = qphase & ((1ul << DXBITS)-1);
+
+	// Clocks 2-4 - Table lookups, multiply, and add
+	mag = (ctbl[index] + ((ltbl[index] * (long)dx) >> DXBITS))
+			& ((1l << WW)-1);
+
+	// Clock 5 - Saturate, drop the extra bits, and negate
+	sat = (mag >> (WW-1)) & 1;
+	if (sat)
+		w_mag = (1l << (OW-1))-1;
+	else
+		w_mag = mag >> NEXTRA;
+
+	return (negate) ? -w_mag : w_mag;
+}
+// }}}
+
+#ifdef	RTL_CHECK
+class	LINQTR_TB : public TESTB<Vlinqtr> {
+public:
+	// LINQTR_TB constructor
+	// {{{
+	LINQTR_TB(void) {
+		m_core->i_ce    = 1;
+		m_core->i_phase = 0;
+		m_core->i_aux   = 0;
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	long	*ctbl, *ltbl, *mo, mxv = 0;
+	double	mxerr = 0.0, bias = 0.0, bound;
+	int	errs = 0, nsat = 0;
+
+	ctbl = new long[TBL_SZ];
+	ltbl = new long[TBL_SZ];
+	mo   = new long[NSAMPLES];
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	readhex("linqtr_ctbl.hex", ctbl, TBL_SZ);
+	readhex("linqtr_ltbl.hex", ltbl, TBL_SZ);
+
+	// Check the model against sin()
+	// {{{
+	for(long k=0; k<NSAMPLES; k++) {
+		bool	sat;
+		double	err;
+
+		mo[k] = linqtr_model(ctbl, ltbl, k, sat);
+		if (sat)
+			nsat++;
+
+		err = mo[k] - SCALE * sin(2.0 * M_PI * (k + 0.5) / NSAMPLES);
+		if (fabs(err) > mxerr)
+			mxerr = fabs(err);
+		if (k < NSAMPLES/4)
+			bias += err;
+		if (labs(mo[k]) > mxv)
+			mxv = labs(mo[k]);
+	}
+
+	bias /= (NSAMPLES/4);
+	// Round to OW bits, the minimax table error, and then the truncation
+	// of the two tables and the product, in WW bits, that the value
+	// table's offset centers around zero.
+	bound = 0.5 + SCALE * fabs(TBL_ERR) + pow(0.5, NEXTRA);
+
+	printf("Model MXERR: %.4f LSBs (%.4f allowed)\n", mxerr, bound);
+	printf("Model bias : %.4f LSBs\n", bias);
+	printf("Model peak : %ld (SCALE = %ld), %d saturated\n",
+		mxv, SCALE, nsat);
+	if ((mxerr > bound)||(fabs(bias) > 1./8.)||(mxv != SCALE)||(nsat > 0))
+		errs++;
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the core against the model
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		LINQTR_TB	*tb = new LINQTR_TB;
+		long	idx = 0;
+		int	nerrs = 0;
+
+		tb->reset();
+
+		for(long k=0; idx < NSAMPLES; k++) {
+			long	co;
+
+			if (k < NSAMPLES) {
+				tb->m_core->i_phase = k;
+				tb->m_core->i_aux   = 1;
+			} else
+				tb->m_core->i_aux   = 0;
+			tb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+
+			co = ((long)tb->m_core->o_val << (64-OW)) >> (64-OW);
+			if (co != mo[idx]) {
+				if (nerrs < 16)
+					printf("MISMATCH: 0x%06lx -> %6ld, model %6ld\n",
+						idx, co, mo[idx]);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %ld samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete tb;
+	}
+	// }}}
+#endif
+
+	delete[] ctbl; delete[] ltbl; delete[] mo;
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
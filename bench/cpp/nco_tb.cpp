@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/nco_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the NCO wrapper, as built around the sine and cosine
+//		CORDIC by gencordic -t sincos --nco <bits> --dither <bits>.
+//
+//	The wrapper is modeled here clock by clock: the frequency word, the
+//	phase accumulator, a bit at a time Fibonacci LFSR using the header's
+//	NCO_TAPS, and the register feeding the core.  First, that LFSR must be
+//	of maximal length.  Then, run from a random frequency word, the dither
+//	words must span all DW bits, with the mean and variance of the bottom
+//	DW bits of such an LFSR.  The phase handed to the core, less the
+//	accumulator's own phase, must then be zero mean to within 2^-(DW+1),
+//	where truncation alone would bias it by half an LSB, and its variance
+//	must match NCO_PHASE_NOISE_DBC.  This part needs no Verilator model,
+//	and is built as ncosim_tb.
+//
+//	Then, when built with -DRTL_CHECK (nco_tb), the Verilated wrapper is
+//	given one frequency word, and then another halfway through.  Its first
+//	output must arrive NCO_LATENCY clocks after its first input, and every
+//	output must match the header's sincos_model(), given the phase the
+//	model above hands to the core.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "Vsincosnco.h"
+#endif
+
+#include "sincosnco.h"
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+#if	!defined(HAS_NCO) || !defined(HAS_SINCOS_MODEL)
+#error "This test-bench depends upon the NCO wrapper and the sincos model"
+#endif
+
+// The accumulator bits below the core's phase
+const int	FRACBITS = NCO_AW - NCO_PW;
+const long	NSAMPLES = (1l << 20);
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+// NCO_MODEL
+// {{{
+// The wrapper's registers.  tick() returns what the core sees on this clock,
+// and then updates every register from its prior value, just as the RTL does
+// on a rising edge with i_ce set.
+class	NCO_MODEL {
+public:
+	unsigned long	m_step, m_phase, m_lfsr, m_nco;
+	int		m_aux;
+
+	NCO_MODEL(void) { reset(); }
+
+	void	reset(void) {
+		m_step = m_phase = m_nco = 0;
+		m_lfsr = 1;
+		m_aux  = 0;
+	}
+
+	// The dither word, in units of 2^-NCO_DW phase LSBs
+	unsigned long	dither(void) {
+		return (NCO_DW > 0) ? (m_lfsr & ((1ul << NCO_DW)-1)) : 0;
+	}
+
+	// Step the LFSR one bit: shift up, with the XOR of the taps into bit 0
+	static unsigned long	lfsr_bit(unsigned long lfsr) {
+		unsigned long	fb = __builtin_parityl(lfsr & NCO_TAPS);
+
+		return ((lfsr << 1) | fb) & ((1ul << NCO_LW)-1);
+	}
+
+	void	tick(int ld, unsigned long step, int aux) {
+		unsigned long	dp;
+
+		dp = m_phase;
+		if (NCO_DW > 0)
+			dp += dither() << (FRACBITS - NCO_DW);
+		m_nco = (dp >> FRACBITS) & ((1ul << NCO_PW)-1);
+
+		m_phase = (m_phase + m_step) & ((1ul << NCO_AW)-1);
+		if (ld)
+			m_step = step & ((1ul << NCO_AW)-1);
+		for(int k=0; k<NCO_DW; k++)
+			m_lfsr = lfsr_bit(m_lfsr);
+		m_aux = ((m_aux << 1) | (aux & 1)) & 3;
+	}
+};
+// }}}
+
+#ifdef	RTL_CHECK
+class	NCO_TB : public TESTB<Vsincosnco> {
+public:
+	// NCO_TB constructor
+	// {{{
+	NCO_TB(void) {
+		m_core->i_ce   = 1;
+		m_core->i_ld   = 0;
+		m_core->i_step = 0;
+		m_core->i_aux  = 0;
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	NCO_MODEL	nco;
+	unsigned long	step, dmin, dmax;
+	double	dmean = 0.0, dvar = 0.0, emean = 0.0, evar = 0.0,
+		dn, w, umean, uvar, emean_x, evar_x;
+	int	errs = 0;
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+	assert(NCO_PW == PW);
+	assert(NCO_DW > 0);
+
+	// The LFSR must be of maximal length
+	// {{{
+	if (NCO_LW <= 24) {
+		unsigned long	lfsr = 1, period = 0;
+
+		do {
+			lfsr = NCO_MODEL::lfsr_bit(lfsr);
+			period++;
+		} while((lfsr != 1)&&(period < (1ul << NCO_LW)));
+
+		printf("LFSR period: %ld (%ld expected)\n", period,
+			(1ul << NCO_LW)-1);
+		if (period != (1ul << NCO_LW)-1)
+			errs++;
+	}
+	// }}}
+
+	// The dither, and the phase error it leaves behind
+	// {{{
+	step = (((unsigned long)rand() << 31) ^ rand()) | 1;
+	nco.reset();
+	nco.tick(1, step, 0);
+	dmin = (1ul << NCO_DW);
+	dmax = 0;
+	for(long k=0; k<NSAMPLES; k++) {
+		unsigned long	d = nco.dither(), acc = nco.m_phase;
+		double		err;
+
+		nco.tick(0, 0, 0);
+
+		if (d < dmin)
+			dmin = d;
+		if (d > dmax)
+			dmax = d;
+		dmean += d;
+		dvar  += d * (double)d;
+
+		// The core's phase, less the accumulator's, in core LSBs
+		err = sext(nco.m_nco - (acc >> FRACBITS), NCO_PW)
+			- (acc & ((1ul << FRACBITS)-1)) / (double)(1ul << FRACBITS);
+		emean += err;
+		evar  += err * err;
+	}
+
+	dmean /= NSAMPLES;
+	dvar   = dvar / NSAMPLES - dmean * dmean;
+	emean /= NSAMPLES;
+	evar   = evar / NSAMPLES - emean * emean;
+
+	// The LFSR never holds zero, so across its period each nonzero dither
+	// word appears 2^(LW-DW) times, and zero one time fewer
+	// {{{
+	dn   = pow(2.0, NCO_DW);
+	w    = pow(2.0, NCO_LW-NCO_DW) / (pow(2.0, NCO_LW) - 1.0);
+	umean= w * (dn - 1.0) / 2.0;
+	uvar = w * (dn - 1.0) * (2.0 * dn - 1.0) / 6.0 / dn - umean * umean;
+	// }}}
+
+	dmean /= dn;
+	dvar  /= dn * dn;
+	printf("Dither range: %ld to %ld (%d to %ld expected)\n", dmin, dmax,
+		(NCO_LW > NCO_DW) ? 0:1, (1ul << NCO_DW)-1);
+	printf("Dither mean : %.4f LSBs (%.4f expected)\n", dmean, umean);
+	printf("Dither var  : %.4f LSBs^2 (%.4f expected)\n", dvar, uvar);
+	// Over a million samples, every word should appear
+	if ((NCO_DW <= 16)&&((dmin != ((NCO_LW > NCO_DW) ? 0ul:1ul))
+				||(dmax != (1ul << NCO_DW)-1)))
+		errs++;
+	if ((fabs(dmean / umean - 1.0) > 0.02)||(fabs(dvar / uvar - 1.0) > 0.02))
+		errs++;
+
+	// Truncation alone would leave a mean of -(1-2^-FRACBITS)/2 LSBs.  The
+	// dither's mean cancels all of that, save for at most 2^-(DW+1).
+	emean_x = umean - (1.0 - pow(2.0, -FRACBITS)) / 2.0;
+
+	// NCO_PHASE_NOISE_DBC is relative to the carrier, in radians^2
+	evar_x = pow(10.0, NCO_PHASE_NOISE_DBC / 10.0)
+			* pow(pow(2.0, NCO_PW) / (2.0 * M_PI), 2);
+	printf("Phase err mean: %.4f LSBs (%.4f expected, %.4f undithered)\n",
+		emean, emean_x, -(1.0 - pow(2.0, -FRACBITS)) / 2.0);
+	printf("Phase err var : %.4f LSBs^2 (%.4f expected)\n", evar, evar_x);
+	if ((fabs(emean - emean_x) > 1./256.)
+			||(fabs(evar / evar_x - 1.0) > 0.02))
+		errs++;
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the wrapper against the model
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		NCO_TB	*tb = new NCO_TB;
+		unsigned long	steps[2], *ph;
+		long	idx = 0, nin = 0;
+		int	nerrs = 0;
+
+		ph = new unsigned long[NSAMPLES];
+
+		// About one LSB of phase per clock, then a random frequency
+		steps[0] = (1ul << FRACBITS) + 1;
+		steps[1] = (((unsigned long)rand() << 31) ^ rand()) | 1;
+
+		tb->reset();
+		nco.reset();
+
+		for(long k=0; idx < NSAMPLES; k++) {
+			long	co, so, mc, ms;
+			int	ld = (k == 0)||(k == NSAMPLES/2),
+				aux = (k < NSAMPLES);
+			unsigned long	step = steps[(k < NSAMPLES/2) ? 0 : 1];
+
+			tb->m_core->i_ld   = ld;
+			tb->m_core->i_step = step & ((1ul << NCO_AW)-1);
+			tb->m_core->i_aux  = aux;
+
+			// The phase the core is given on this clock
+			if ((nco.m_aux >> 1) & 1)
+				ph[nin++] = nco.m_nco;
+			nco.tick(ld, step, aux);
+			tb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+
+			if ((0 == idx)&&(k+1 != NCO_LATENCY)) {
+				printf("LATENCY: The first output took %ld clocks, not %d\n",
+					k+1, NCO_LATENCY);
+				nerrs++;
+			}
+
+			assert(idx < nin);
+			sincos_model(ph[idx], mc, ms);
+			co = sext(tb->m_core->o_cos, OW);
+			so = sext(tb->m_core->o_sin, OW);
+			if ((co != mc)||(so != ms)) {
+				if (nerrs < 16)
+					printf("MISMATCH[%ld]: 0x%08lx -> (%6ld,%6ld), model (%6ld,%6ld)\n",
+						idx, ph[idx], co, so, mc, ms);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %ld samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete[] ph;
+		delete tb;
+	}
+	// }}}
+#endif
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/polarsim_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Verifies the batched software model of the rectangular to polar
+//		CORDIC, R2PSIM from sw/cordicsim.cpp.  The vector path is
+//		checked against the scalar path, and both are checked against
+//		the bit-exact model found in the generated topolar.h header.
+//		The throughput is compared against that of atan2f() and
+//		hypotf().
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "topolar.h"
+#include "cordicsim.h"
+
+const int	NSAMPLES = (1<<20);
+
+// now
+// {{{
+double	now(void) {
+	struct timespec	tv;
+
+	clock_gettime(CLOCK_MONOTONIC, &tv);
+	return tv.tv_sec + tv.tv_nsec * 1e-9;
+}
+// }}}
+
+// randv
+// {{{
+// Return a random (signed) value of the given bit width
+int	randv(int bits) {
+	unsigned long	v = ((unsigned long)rand() << 31) ^ rand();
+
+	return (int)(((long)(v << (64-bits))) >> (64-bits));
+}
+// }}}
+
+// compare
+// {{{
+// Compare two sets of outputs, reporting the first few differences
+int	compare(const char *name, int n, const int *am, const unsigned *ap,
+		const int *bm, const unsigned *bp) {
+	int	errs = 0;
+
+	for(int k=0; k<n; k++) {
+		if ((am[k] != bm[k])||(ap[k] != bp[k])) {
+			if (errs < 8)
+				printf("%s MISMATCH[%d]: (%6d,%08x) != (%6d,%08x)\n",
+					name, k, am[k], ap[k], bm[k], bp[k]);
+			errs++;
+		}
+	}
+
+	return errs;
+}
+// }}}
+
+// check_config
+// {{{
+// Test the vector path against the scalar path for an arbitrary
+// configuration, such as one we don't have a header for.
+int	check_config(int nstages, int iw, int ow, int nxtra, int pw) {
+	R2PSIM		sim(nstages, iw, ow, nxtra, pw);
+	int		*ix, *iy, *sm, *vm, errs;
+	unsigned	*sp, *vp;
+	const int	N = 4099;	// Not a multiple of any lane count
+
+	ix = new int[N]; iy = new int[N];
+	sm = new int[N]; vm = new int[N];
+	sp = new unsigned[N]; vp = new unsigned[N];
+
+	for(int k=0; k<N; k++) {
+		ix[k] = randv(iw);
+		iy[k] = randv(iw);
+	}
+
+	sim.topolar_scalar(N, ix, iy, sm, sp);
+	sim.topolar(N, ix, iy, vm, vp);
+
+	char	name[64];
+	sprintf(name, "CFG(%d,%d,%d,%d,%d)", nstages, iw, ow, nxtra, pw);
+	errs = compare(name, N, sm, sp, vm, vp);
+
+	delete[] ix; delete[] iy;
+	delete[] sm; delete[] vm; delete[] sp; delete[] vp;
+
+	return errs;
+}
+// }}}
+
+int main(int argc, char **argv) {
+	// {{{
+	R2PSIM		sim(NSTAGES, IW, OW, NEXTRA, PW);
+	int		*ix, *iy, *sm, *vm, *mm, errs = 0;
+	unsigned	*sp, *vp, *mp;
+	float		*fx, *fy, *fm, *fp;
+	double		start, scalar_time, vector_time, libm_time;
+
+	ix = new int[NSAMPLES]; iy = new int[NSAMPLES];
+	sm = new int[NSAMPLES]; vm = new int[NSAMPLES]; mm = new int[NSAMPLES];
+	sp = new unsigned[NSAMPLES]; vp = new unsigned[NSAMPLES];
+	mp = new unsigned[NSAMPLES];
+	fx = new float[NSAMPLES]; fy = new float[NSAMPLES];
+	fm = new float[NSAMPLES]; fp = new float[NSAMPLES];
+
+	// Random inputs, covering the full input range
+	for(int k=0; k<NSAMPLES; k++) {
+		ix[k] = randv(IW);
+		iy[k] = randv(IW);
+		fx[k] = (float)ix[k];
+		fy[k] = (float)iy[k];
+	}
+
+	// The reference: the bit-exact model from the generated header
+	for(int k=0; k<NSAMPLES; k++) {
+		long		omag;
+		unsigned long	ophase;
+
+		topolar_model(ix[k], iy[k], omag, ophase);
+		mm[k] = (int)omag;
+		mp[k] = (unsigned)ophase;
+	}
+
+	start = now();
+	sim.topolar_scalar(NSAMPLES, ix, iy, sm, sp);
+	scalar_time = now() - start;
+
+	start = now();
+	sim.topolar(NSAMPLES, ix, iy, vm, vp);
+	vector_time = now() - start;
+
+	start = now();
+	for(int k=0; k<NSAMPLES; k++) {
+		fm[k] = hypotf(fx[k], fy[k]);
+		fp[k] = atan2f(fy[k], fx[k]);
+	}
+	libm_time = now() - start;
+
+	errs += compare("SCALAR", NSAMPLES, mm, mp, sm, sp);
+	errs += compare("VECTOR", NSAMPLES, mm, mp, vm, vp);
+
+	// Keep the compiler from optimizing the libm loop away
+	{
+		double	sum = 0.0;
+		for(int k=0; k<NSAMPLES; k++)
+			sum += fm[k] + fp[k];
+		if (!isfinite(sum))
+			printf("Non-finite libm result\n");
+	}
+
+	printf("Lanes:  %2d\n", sim.lanes());
+	printf("Scalar: %8.2f MS/s\n", NSAMPLES / scalar_time / 1e6);
+	printf("Vector: %8.2f MS/s\n", NSAMPLES / vector_time / 1e6);
+	printf("libm:   %8.2f MS/s (atan2f + hypotf)\n",
+		NSAMPLES / libm_time / 1e6);
+
+	// Other configurations, including the 32-bit extremes
+	errs += check_config(NSTAGES, IW, OW, NEXTRA, PW);
+	errs += check_config(12,  8,  8, 2, 12);
+	errs += check_config(20, 16, 12, 3, 24);
+	errs += check_config(24, 12, 16, 4, 32);
+	errs += check_config(30, 26, 26, 3, 32);
+	errs += check_config(32, 24, 20, 4, 32);
+
+	delete[] ix; delete[] iy;
+	delete[] sm; delete[] vm; delete[] mm;
+	delete[] sp; delete[] vp; delete[] mp;
+	delete[] fx; delete[] fy; delete[] fm; delete[] fp;
+
+	if (errs) {
+		printf("TEST FAILURE: %d mismatches\n", errs);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
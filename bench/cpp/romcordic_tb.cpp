@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/romcordic_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the hybrid ROM + CORDIC rotator, rtl/romcordic.v, as built
+//		by gencordic -t p2r --rom <bits>.
+//
+//	First, the two coarse rotation tables, romcordic_cos.hex and
+//	romcordic_sin.hex, are read back and checked against the header's
+//	hybrid_rom(), since that's what the bit-exact model uses in their
+//	place.  The model is then checked against GAIN times the ideal
+//	rotation of random inputs.  The error, summed across both outputs, must
+//	match what QUANTIZATION_VARIANCE and PHASE_VARIANCE_RAD predict: its RMS
+//	must be within 0.8 to 1.15 of that prediction, and no single sample may
+//	exceed it by more than 5.2 times.  The mean error of each output must
+//	stay within an eighth of an LSB.  This part needs no Verilator model,
+//	and is built as romcordicsim_tb.
+//
+//	Then, when built with -DRTL_CHECK (romcordic_tb), the Verilated core,
+//	whose tables are loaded by $readmemh from the same .hex files, is fed
+//	the same inputs.  Its first output must arrive LATENCY clocks after its
+//	first input, and every output must match the model exactly.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "Vromcordic.h"
+#endif
+
+#include "romcordic.h"
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+#if	!defined(HYBRID) || !defined(HAS_CORDIC_MODEL)
+#error "This test-bench depends upon the hybrid core's bit-exact model"
+#endif
+
+// A million samples, or every phase if there are fewer
+const int	LGSAMPLES = (PW < 20) ? PW : 20;
+const long	NSAMPLES = (1l << LGSAMPLES);
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+// randv
+// {{{
+// Return a random (signed) value of the given bit width
+long	randv(int bits) {
+	unsigned long	v = ((unsigned long)rand() << 31) ^ rand();
+
+	return sext(v, bits);
+}
+// }}}
+
+// readhex
+// {{{
+// Read a table of signed, w-bit values written by sw/hexfile.cpp, in the
+// same format $readmemh expects
+void	readhex(const char *fname, long *tbl, int entries, int w) {
+	FILE	*fp = fopen(fname, "r");
+	char	word[64];
+	int	idx = 0;
+
+	if (NULL == fp) {
+		fprintf(stderr, "ERR: Cannot open %s\n", fname);
+		exit(EXIT_FAILURE);
+	}
+
+	while((idx < entries)&&(1 == fscanf(fp, "%63s", word))) {
+		if ('@' == word[0])
+			idx = strtol(&word[1], NULL, 16);
+		else
+			tbl[idx++] = sext(strtol(word, NULL, 16), w);
+	}
+
+	fclose(fp);
+	assert(idx == entries);
+}
+// }}}
+
+#ifdef	RTL_CHECK
+class	ROMCORDIC_TB : public TESTB<Vromcordic> {
+public:
+	// ROMCORDIC_TB constructor
+	// {{{
+	ROMCORDIC_TB(void) {
+		m_core->i_ce    = 1;
+		m_core->i_xval  = 0;
+		m_core->i_yval  = 0;
+		m_core->i_phase = 0;
+		m_core->i_aux   = 0;
+#ifdef	HAS_RESET_WIRE
+#ifdef	ASYNC_RESET
+		m_core->i_areset_n = 1;
+#else
+		m_core->i_reset = 0;
+#endif
+#endif
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	const int	ROMSZ = (1 << LGROM);
+	long	*costbl, *sintbl, *ix, *iy, *mx, *my;
+	unsigned long	*ph;
+	double	avg = 0.0, mse = 0.0, pmse = 0.0, mxv = 0.0,
+		xbias = 0.0, ybias = 0.0, scale;
+	int	errs = 0, terrs = 0;
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	costbl = new long[ROMSZ]; sintbl = new long[ROMSZ];
+	ix = new long[NSAMPLES]; iy = new long[NSAMPLES];
+	mx = new long[NSAMPLES]; my = new long[NSAMPLES];
+	ph = new unsigned long[NSAMPLES];
+
+	// Check the tables against the ones the model uses
+	// {{{
+	readhex("romcordic_cos.hex", costbl, ROMSZ, TW);
+	readhex("romcordic_sin.hex", sintbl, ROMSZ, TW);
+	for(int k=0; k<ROMSZ; k++) {
+		if ((costbl[k] != hybrid_rom(k, false))
+				||(sintbl[k] != hybrid_rom(k, true))) {
+			printf("ROM[%2d]: (%6ld,%6ld), model (%6ld,%6ld)\n", k,
+				costbl[k], sintbl[k],
+				hybrid_rom(k, false), hybrid_rom(k, true));
+			terrs++;
+		}
+	}
+
+	printf("Tables: %d mismatches out of %d entries\n", terrs, ROMSZ);
+	if (terrs > 0)
+		errs++;
+	// }}}
+
+	// Random inputs, at every phase or an evenly spread set of them with
+	// random low bits
+	// {{{
+	for(long k=0; k<NSAMPLES; k++) {
+		ix[k] = randv(IW);
+		iy[k] = randv(IW);
+		ph[k] = k << (PW-LGSAMPLES);
+		if (PW > LGSAMPLES)
+			ph[k] |= rand() & ((1ul << (PW-LGSAMPLES))-1);
+	}
+	// }}}
+
+	// From input units to output units
+	scale = GAIN * pow(2.0, OW-IW-1);
+
+	// Check the model against the ideal rotation
+	// {{{
+	for(long k=0; k<NSAMPLES; k++) {
+		double	a, dx, dy, ex, ey, err, v;
+
+		cordic_model(ix[k], iy[k], ph[k], mx[k], my[k]);
+
+		a  = 2.0 * M_PI * ph[k] / (double)(1ul << PW);
+		dx = scale * (cos(a) * ix[k] - sin(a) * iy[k]);
+		dy = scale * (sin(a) * ix[k] + cos(a) * iy[k]);
+		ex = mx[k] - dx;
+		ey = my[k] - dy;
+		xbias += ex;
+		ybias += ey;
+
+		// The phase error grows with the size of the vector
+		v = QUANTIZATION_VARIANCE
+			+ PHASE_VARIANCE_RAD * (dx * dx + dy * dy);
+
+		// Normalized, each error should have unit variance
+		err   = ex * ex + ey * ey;
+		mse  += err;
+		pmse += v;
+		avg  += err / v;
+		err   = sqrt(err / v);
+		if (err > mxv) {
+			mxv = err;
+			if (mxv > 5.2)
+				printf("OUT-OF-BOUNDS: (%6ld,%6ld) @ 0x%08lx -> (%6ld,%6ld), error %.2f\n",
+					ix[k], iy[k], ph[k], mx[k], my[k],
+					err * sqrt(v));
+		}
+	}
+
+	avg   = sqrt(avg / NSAMPLES);
+	mse   = mse  / NSAMPLES;
+	pmse  = pmse / NSAMPLES;
+	xbias = xbias / NSAMPLES;
+	ybias = ybias / NSAMPLES;
+	printf("Model MSE    : %.4f Units^2 (%.4f predicted)\n", mse, pmse);
+	printf("Model AVG Err: %.4f of that expected (0.8 to 1.15 allowed)\n",
+		avg);
+	printf("Model MAX Err: %.4f of that expected (5.2 threshold)\n", mxv);
+	printf("Model bias   : %.4f, %.4f LSBs\n", xbias, ybias);
+	if ((avg < 0.8)||(avg > 1.15)||(mxv > 5.2))
+		errs++;
+	// With only one extra bit, the core truncates rather than rounds,
+	// and so carries a quarter LSB bias by design
+	if ((WW > OW+1)&&((fabs(xbias) > 1./8.)||(fabs(ybias) > 1./8.)))
+		errs++;
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the core against the model
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		ROMCORDIC_TB	*tb = new ROMCORDIC_TB;
+		long	idx = 0;
+		int	nerrs = 0;
+
+		tb->reset();
+
+		for(long k=0; idx < NSAMPLES; k++) {
+			long	xo, yo;
+
+			if (k < NSAMPLES) {
+				tb->m_core->i_xval  = ix[k];
+				tb->m_core->i_yval  = iy[k];
+				tb->m_core->i_phase = ph[k];
+				tb->m_core->i_aux   = 1;
+			} else
+				tb->m_core->i_aux   = 0;
+			tb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+
+			if ((0 == idx)&&(k+1 != LATENCY)) {
+				printf("LATENCY: The first output took %ld clocks, not %d\n",
+					k+1, LATENCY);
+				nerrs++;
+			}
+
+			xo = sext(tb->m_core->o_xval, OW);
+			yo = sext(tb->m_core->o_yval, OW);
+			if ((xo != mx[idx])||(yo != my[idx])) {
+				if (nerrs < 16)
+					printf("MISMATCH: (%6ld,%6ld) @ 0x%08lx -> (%6ld,%6ld), model (%6ld,%6ld)\n",
+						ix[idx], iy[idx], ph[idx],
+						xo, yo, mx[idx], my[idx]);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %ld samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete tb;
+	}
+	// }}}
+#endif
+
+	delete[] costbl; delete[] sintbl;
+	delete[] ix; delete[] iy; delete[] mx; delete[] my; delete[] ph;
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	bench/cpp/sincos_tb.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Tests the constant-input sine and cosine CORDIC, rtl/sincos.v,
+//		as built by gencordic -t sincos.
+//
+//	First, the bit-exact model found in the generated header is checked
+//	against AMPLITUDE times cos() and sin().  The error, summed across both
+//	outputs, must match what QUANTIZATION_VARIANCE and PHASE_VARIANCE_RAD
+//	predict: its RMS must be within 0.8 to 1.15 of that prediction, so
+//	that an understated (or badly overstated) model fails, and no single
+//	sample may exceed it by more than 5.2 times.  The mean error of each
+//	output must stay within an eighth of an LSB, and no output may reach
+//	the most negative value.  This part needs no Verilator model, and is
+//	built as sincossim_tb.
+//
+//	Then, when built with -DRTL_CHECK (sincos_tb), the Verilated core is
+//	fed the same phases.  Its first output must arrive LATENCY clocks
+//	after its first input, and every output must match the model exactly.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#ifdef	RTL_CHECK
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+#include "Vsincos.h"
+#endif
+
+#include "sincos.h"
+
+#ifdef	RTL_CHECK
+#include "testb.h"
+#endif
+
+#ifndef	HAS_SINCOS_MODEL
+#error "This test-bench depends upon the header's bit-exact model"
+#endif
+
+// Every phase, up to a million of them
+const int	LGSAMPLES = (PW < 20) ? PW : 20;
+const long	NSAMPLES = (1l << LGSAMPLES);
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+#ifdef	RTL_CHECK
+class	SINCOS_TB : public TESTB<Vsincos> {
+public:
+	// SINCOS_TB constructor
+	// {{{
+	SINCOS_TB(void) {
+		m_core->i_ce    = 1;
+		m_core->i_phase = 0;
+		m_core->i_aux   = 0;
+	}
+	// }}}
+};
+#endif
+
+int main(int  argc, char **argv) {
+	// {{{
+	unsigned long	*ph;
+	long	*mc, *ms;
+	double	avg = 0.0, mxv = 0.0, cbias = 0.0, sbias = 0.0, v;
+	int	errs = 0, novf = 0;
+	const long	MOST_NEGATIVE = -(1l << (OW-1));
+
+	ph = new unsigned long[NSAMPLES];
+	mc = new long[NSAMPLES]; ms = new long[NSAMPLES];
+
+	// This only works on DUT's with the aux flag turned on.
+	assert(HAS_AUX);
+
+	// Every phase, or else an evenly spread set of them with random
+	// low bits
+	// {{{
+	for(long k=0; k<NSAMPLES; k++) {
+		ph[k] = k << (PW-LGSAMPLES);
+		if (PW > LGSAMPLES)
+			ph[k] |= rand() & ((1ul << (PW-LGSAMPLES))-1);
+	}
+	// }}}
+
+	// The error of the output vector, summed across cos and sin
+	v = QUANTIZATION_VARIANCE
+		+ PHASE_VARIANCE_RAD * AMPLITUDE * AMPLITUDE;
+
+	// Check the model against the math
+	// {{{
+	for(long k=0; k<NSAMPLES; k++) {
+		double	a, ec, es, err;
+
+		sincos_model(ph[k], mc[k], ms[k]);
+		if ((mc[k] == MOST_NEGATIVE)||(ms[k] == MOST_NEGATIVE))
+			novf++;
+
+		a  = 2.0 * M_PI * ph[k] / (double)(1ul << PW);
+		ec = mc[k] - AMPLITUDE * cos(a);
+		es = ms[k] - AMPLITUDE * sin(a);
+		cbias += ec;
+		sbias += es;
+
+		// Normalized, each error should have unit variance
+		err  = ec * ec + es * es;
+		avg += err / v;
+		err  = sqrt(err / v);
+		if (err > mxv) {
+			mxv = err;
+			if (mxv > 5.2)
+				printf("OUT-OF-BOUNDS: 0x%08lx -> (%6ld,%6ld), error %.2f\n",
+					ph[k], mc[k], ms[k], err * sqrt(v));
+		}
+	}
+
+	avg   = sqrt(avg / NSAMPLES);
+	cbias = cbias / NSAMPLES;
+	sbias = sbias / NSAMPLES;
+	printf("Model AVG Err: %.4f of that expected (0.8 to 1.15 allowed)\n",
+		avg);
+	printf("Model MAX Err: %.4f of that expected (5.2 threshold)\n", mxv);
+	printf("Model bias   : %.4f, %.4f LSBs\n", cbias, sbias);
+	printf("Model: %d outputs at the most negative value\n", novf);
+	if ((avg < 0.8)||(avg > 1.15)||(mxv > 5.2)||(novf > 0))
+		errs++;
+	// With only one extra bit, the core truncates rather than rounds,
+	// and so carries a quarter LSB bias by design
+	if ((WW > OW+1)&&((fabs(cbias) > 1./8.)||(fabs(sbias) > 1./8.)))
+		errs++;
+	// }}}
+
+#ifdef	RTL_CHECK
+	// Check the core against the model
+	// {{{
+	{
+		Verilated::commandArgs(argc, argv);
+		SINCOS_TB	*tb = new SINCOS_TB;
+		long	idx = 0;
+		int	nerrs = 0;
+
+		tb->reset();
+
+		for(long k=0; idx < NSAMPLES; k++) {
+			long	co, so;
+
+			if (k < NSAMPLES) {
+				tb->m_core->i_phase = ph[k];
+				tb->m_core->i_aux   = 1;
+			} else
+				tb->m_core->i_aux   = 0;
+			tb->tick();
+
+			if (!tb->m_core->o_aux)
+				continue;
+
+			if ((0 == idx)&&(k+1 != LATENCY)) {
+				printf("LATENCY: The first output took %ld clocks, not %d\n",
+					k+1, LATENCY);
+				nerrs++;
+			}
+
+			co = sext(tb->m_core->o_cos, OW);
+			so = sext(tb->m_core->o_sin, OW);
+			if ((co != mc[idx])||(so != ms[idx])) {
+				if (nerrs < 16)
+					printf("MISMATCH: 0x%08lx -> (%6ld,%6ld), model (%6ld,%6ld)\n",
+						ph[idx], co, so, mc[idx], ms[idx]);
+				nerrs++;
+			} idx++;
+		}
+
+		printf("Bit-exact: %d mismatches out of %ld samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			errs++;
+		delete tb;
+	}
+	// }}}
+#endif
+
+	delete[] ph; delete[] mc; delete[] ms;
+
+	if (errs) {
+		printf("TEST FAILURE\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+	// }}}
+}
@@ -314,6 +314,36 @@ int main(int  argc, char **argv) {
 	if (mxverr > 2.0 * sqrt(QUANTIZATION_VARIANCE))
 		failed_test = true;
 
+#ifdef	HAS_TOPOLAR_MODEL
+	// Compare every output against a bit-exact model of the core
+	// {{{
+	{
+		int	nerrs = 0;
+
+		for(int i=0; i<NSAMPLES; i++) {
+			long		mmag, mphase;
+			unsigned long	uphase;
+
+			topolar_model(ixval[i], iyval[i], mmag, uphase);
+			mphase = (long)(uphase << pshift) >> pshift;
+			if ((mmag != omag[i])||(mphase != ophase[i])) {
+				if (nerrs < 16)
+					printf("MISMATCH: (%6d,%6d) -> (%6d,%08x), model (%6ld,%08lx)\n",
+						ixval[i], iyval[i],
+						omag[i], ophase[i],
+						mmag, uphase);
+				nerrs++;
+			}
+		}
+
+		printf("Bit-exact: %d mismatches out of %d samples\n",
+			nerrs, NSAMPLES);
+		if (nerrs > 0)
+			failed_test = true;
+	}
+	// }}}
+#endif
+
 	printf("Max phase     error: %.2f (%.6f Rel)\n", mxperr,
 		mxperr / (2.0 * (1<<(PW-1))));
 	printf("Max magnitude error: %9.6f, expect %.2f\n", mxverr,
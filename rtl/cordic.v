@@ -225,6 +225,17 @@ module	cordic#(
 	// and right shifting by 32 bits.
 	// }}}
 	// }}}
+	// Residual phase widths
+	// {{{
+	// Each stage leaves less phase for those following it.  Entry
+	// i of PHW holds the bits, sign included, that the phase can
+	// use following stage i.  Any bits above these are only ever
+	// copies of the sign bit.
+	localparam	[(8*NSTAGES-1):0]	PHW = {
+			8'd4, 8'd5, 8'd5, 8'd6, 8'd7, 8'd8, 8'd9, 8'd10,
+			8'd11, 8'd12, 8'd13, 8'd14, 8'd15, 8'd16, 8'd17, 8'd18 };
+	// }}}
+
 
 	// CORDIC rotations
 	// {{{
@@ -233,6 +244,17 @@ module	cordic#(
 		// Here's where we are going to put the actual CORDIC
 		// we've been studying and discussing.  Everything up to
 		// this point has simply been necessary preliminaries.
+		//
+		// The phase following this stage needs only PWN bits.
+		// Those above are copies of its sign, and so the adder
+		// need be no wider.
+		localparam	PWN = PHW[8*i +: 8];
+		wire	[(PWN-1):0]	nph;
+
+		assign	nph = (ph[i][PW-1])
+				? (ph[i][(PWN-1):0] + cordic_angle[i][(PWN-1):0])
+				: (ph[i][(PWN-1):0] - cordic_angle[i][(PWN-1):0]);
+
 		initial begin
 			xv[i+1] = 0;
 			yv[i+1] = 0;
@@ -266,7 +288,7 @@ module	cordic#(
 				// CORDIC angle in a clockwise direction.
 				xv[i+1] <= xv[i] + (yv[i]>>>(i+1));
 				yv[i+1] <= yv[i] - (xv[i]>>>(i+1));
-				ph[i+1] <= ph[i] + cordic_angle[i];
+				ph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };
 				// }}}
 			end else begin
 				// {{{
@@ -275,7 +297,7 @@ module	cordic#(
 				// counter-clockwise direction
 				xv[i+1] <= xv[i] - (yv[i]>>>(i+1));
 				yv[i+1] <= yv[i] + (xv[i]>>>(i+1));
-				ph[i+1] <= ph[i] - cordic_angle[i];
+				ph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };
 				// }}}
 			end
 			// }}}
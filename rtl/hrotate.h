@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/hrotate.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This .h file notes the default parameter values from
+//		within the generated file.  It is used to communicate
+//	information about the design to the bench testing code.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % (Not given)
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	HROTATE_H
+#define	HROTATE_H
+#define	HYPERBOLIC
+const int	IW = 13;
+const int	OW = 13;
+const int	NEXTRA = 4;
+const int	WW = 17;
+const int	PW = 21;
+const int	NSTAGES = 18;
+const int	LATENCY = 20;	// Clocks from i_ce to output
+const double	QUANTIZATION_VARIANCE = 1.1403e-01; // (Units^2)
+const double	PHASE_VARIANCE = 1.1983e-11; // (Angle^2)
+const double	HYPERBOLIC_GAIN = 0.8281593609923524;
+const double	GAIN = 0.4140796804961762;
+const double	BEST_POSSIBLE_CNR = 68.00;
+const bool	HAS_RESET = true;
+const bool	HAS_AUX   = true;
+#define	HAS_RESET_WIRE
+#define	HAS_AUX_WIRES
+
+// Bit-exact model
+// {{{
+// The following duplicates, in integer arithmetic, the logic of the core
+// above: the same truncated hyperbolic angles, the same repeated shifts,
+// and the same round-towards-even output stage.  Given the same inputs,
+// hrotate_model() will return exactly what the core will produce
+// once it has finished.
+//
+#define	HAS_HYPERBOLIC_MODEL
+
+static const unsigned long	HYPERBOLIC_ANGLE[18] = {
+	0x0464fa, 0x020b15, 0x010158, 0x00802a,
+	0x00802a, 0x004005, 0x002000, 0x001000,
+	0x000800, 0x000400, 0x000200, 0x000100,
+	0x000080, 0x000040, 0x000040, 0x000020,
+	0x000010, 0x000008
+};
+
+static const int	HYPERBOLIC_SHIFT[18] = {
+	 1,  2,  3,  4,  4,  5,  6,  7,
+	 8,  9, 10, 11, 12, 13, 13, 14,
+	15, 16
+};
+
+// Sign extend the bottom w bits of v
+static inline long	hyperbolic_sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+
+static inline void	hrotate_model(long i_xval, long i_yval,
+		unsigned long i_phase, long &o_xval, long &o_yval) {
+	const	unsigned long	PMSK = (1ul << PW) - 1;
+	long		xv, yv;
+	unsigned long	ph;
+
+	// Sign extend our inputs to the working width, two bits down
+	xv = hyperbolic_sext(i_xval, IW) * (1l << (WW-IW-2));
+	yv = hyperbolic_sext(i_yval, IW) * (1l << (WW-IW-2));
+	ph = i_phase & PMSK;
+
+	// Hyperbolic CORDIC rotations
+	for(int k=0; k<NSTAGES; k++) {
+		const	int	sh = HYPERBOLIC_SHIFT[k];
+		long	dx, dy;
+
+		if ((HYPERBOLIC_ANGLE[k] == 0)||(sh >= WW))
+			continue;
+
+		dx = xv >> sh;
+		dy = yv >> sh;
+		if (0 == ((ph >> (PW-1))&1)) {
+			xv = hyperbolic_sext(xv + dy, WW);
+			yv = hyperbolic_sext(yv + dx, WW);
+			ph = (ph - HYPERBOLIC_ANGLE[k]) & PMSK;
+		} else {
+			xv = hyperbolic_sext(xv - dy, WW);
+			yv = hyperbolic_sext(yv - dx, WW);
+			ph = (ph + HYPERBOLIC_ANGLE[k]) & PMSK;
+		}
+	}
+
+	// Round towards even, then drop the extra bits
+	if ((xv >> (WW-OW)) & 1)
+		xv += (1l << (WW-OW-1));
+	else
+		xv += (1l << (WW-OW-1)) - 1;
+	xv = hyperbolic_sext(xv, WW);
+	if ((yv >> (WW-OW)) & 1)
+		yv += (1l << (WW-OW-1));
+	else
+		yv += (1l << (WW-OW-1)) - 1;
+	yv = hyperbolic_sext(yv, WW);
+
+	o_xval = xv >> (WW-OW);
+	o_yval = yv >> (WW-OW);
+}
+// }}}
+#endif	// HROTATE_H
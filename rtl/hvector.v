@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/hvector.v
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file rotates the vector (i_xval, i_yval) through
+//		whatever hyperbolic angle will bring its y component to zero.
+//	The result is GAIN*sqrt(x^2-y^2) in o_mag, and atanh(y/x) in
+//	o_phase, in signed units of 2^-(PW-2).  For the CORDIC to
+//	converge, |i_yval| must be less than 0.8 |i_xval|.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % ./gencordic -vca -f ../rtl/hvector.v -i 13 -o 13 -t hvec -x 2
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+`default_nettype	none
+module	hvector#(
+		// {{{
+	localparam	IW=13,	// The number of bits in our inputs
+			OW=13,	// The number of output bits to produce
+			NSTAGES=18,
+			// XTRA= 4,// Extra bits for internal precision
+			WW=17,	// Our working bit-width
+			PW=21	// Bits in our phase variables
+		// }}}
+	) (
+		// {{{
+	input	wire				i_clk, i_reset, i_ce,
+	input	wire	signed	[(IW-1):0]		i_xval, i_yval,
+	output	reg	signed	[(OW-1):0]	o_mag,
+	output	reg	signed	[(PW-1):0]	o_phase,
+	input	wire				i_aux,
+	output	reg				o_aux
+		// }}}
+	);
+
+	// Declare variables for all of the separate stages
+	// {{{
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	reg	signed	[(WW-1):0]	xv	[0:(NSTAGES)];
+	reg	signed	[(WW-1):0]	yv	[0:(NSTAGES)];
+	reg		[(PW-1):0]	ph	[0:(NSTAGES)];
+	reg		[(NSTAGES):0]	ax;
+	// }}}
+
+	// Sign extend our inputs
+	// {{{
+	// Extend our inputs by two bits on the left, to allow for the
+	// growth of a hyperbolic rotation, and by any extra bits on
+	// the right.
+	assign	e_xval = { {(2){i_xval[(IW-1)]}}, i_xval, {(WW-IW-2){1'b0}} };
+	assign	e_yval = { {(2){i_yval[(IW-1)]}}, i_yval, {(WW-IW-2){1'b0}} };
+	// }}}
+
+	//
+	// Handle the auxilliary logic.
+	// {{{
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_xval and i_yval
+	// are input together with i_aux, then when the outputs are set to
+	// their result, o_aux *must* contain the value that was in i_aux.
+	//
+
+	initial	ax = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		ax <= 0;
+	else if (i_ce)
+		ax <= { ax[(NSTAGES-1):0], i_aux };
+	// }}}
+
+	// Pre-rotation
+	// {{{
+	// There's no quadrant to rotate out of here.  However, since
+	// (-x,-y) has the same hyperbolic angle and magnitude as (x,y),
+	// we can still make certain x is positive.
+	initial begin
+		xv[0] = 0;
+		yv[0] = 0;
+		ph[0] = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[0] <= 0;
+		yv[0] <= 0;
+		ph[0] <= 0;
+	end else if (i_ce)
+	begin
+		// {{{
+		if (i_xval[IW-1])
+		begin
+			xv[0] <= -e_xval;
+			yv[0] <= -e_yval;
+		end else begin
+			xv[0] <= e_xval;
+			yv[0] <= e_yval;
+		end
+		ph[0] <= 0;
+		// }}}
+	end
+	// }}}
+
+	// Hyperbolic angle table
+	// {{{
+	// Stage k rotates by atanh(2^-HSHIFT[k]), where the shifts run
+	// 1, 2, 3, 4, 4, 5, ... 13, 13, ... 40, 40, ...  Shifts 4, 13,
+	// 40, and so on are repeated, else the angles following them
+	// would be too small to make up for them.  Angles are in signed
+	// units of 2^-(PW-2), so the PW-bit angle runs from -2 to 2.
+	//
+	wire	[20:0]	hyperbolic_angle [0:(NSTAGES-1)];
+	localparam	[(8*NSTAGES-1):0]	HSHIFT = {
+			8'd16, 8'd15, 8'd14, 8'd13, 8'd13, 8'd12, 8'd11, 8'd10,
+			8'd9, 8'd8, 8'd7, 8'd6, 8'd5, 8'd4, 8'd4, 8'd3,
+			8'd2, 8'd1 };
+
+	assign	hyperbolic_angle[ 0] = 21'h04_64fa; // atanh(2^-1)
+	assign	hyperbolic_angle[ 1] = 21'h02_0b15; // atanh(2^-2)
+	assign	hyperbolic_angle[ 2] = 21'h01_0158; // atanh(2^-3)
+	assign	hyperbolic_angle[ 3] = 21'h00_802a; // atanh(2^-4)
+	assign	hyperbolic_angle[ 4] = 21'h00_802a; // atanh(2^-4)
+	assign	hyperbolic_angle[ 5] = 21'h00_4005; // atanh(2^-5)
+	assign	hyperbolic_angle[ 6] = 21'h00_2000; // atanh(2^-6)
+	assign	hyperbolic_angle[ 7] = 21'h00_1000; // atanh(2^-7)
+	assign	hyperbolic_angle[ 8] = 21'h00_0800; // atanh(2^-8)
+	assign	hyperbolic_angle[ 9] = 21'h00_0400; // atanh(2^-9)
+	assign	hyperbolic_angle[10] = 21'h00_0200; // atanh(2^-10)
+	assign	hyperbolic_angle[11] = 21'h00_0100; // atanh(2^-11)
+	assign	hyperbolic_angle[12] = 21'h00_0080; // atanh(2^-12)
+	assign	hyperbolic_angle[13] = 21'h00_0040; // atanh(2^-13)
+	assign	hyperbolic_angle[14] = 21'h00_0040; // atanh(2^-13)
+	assign	hyperbolic_angle[15] = 21'h00_0020; // atanh(2^-14)
+	assign	hyperbolic_angle[16] = 21'h00_0010; // atanh(2^-15)
+	assign	hyperbolic_angle[17] = 21'h00_0008; // atanh(2^-16)
+	// {{{
+	// Angle Quantization: 0.000003
+	// }}}
+	// }}}
+
+	// Hyperbolic CORDIC rotations
+	// {{{
+	// Unlike the circular CORDIC, a positive rotation adds both
+	// cross terms, so x and y move together.
+	genvar	i;
+	generate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops
+		localparam	S = HSHIFT[8*i +: 8];
+
+		initial begin
+			xv[i+1] = 0;
+			yv[i+1] = 0;
+			ph[i+1] = 0;
+		end
+
+		always @(posedge i_clk)
+	if (i_reset)
+		begin
+			// {{{
+			xv[i+1] <= 0;
+			yv[i+1] <= 0;
+			ph[i+1] <= 0;
+			// }}}
+		end else if (i_ce)
+		begin
+			// {{{
+			if ((hyperbolic_angle[i] == 0)||(S >= WW))
+			begin // Do nothing but move our outputs
+			// forward one stage, since we have more
+			// stages than valid data
+				// {{{
+				xv[i+1] <= xv[i];
+				yv[i+1] <= yv[i];
+				ph[i+1] <= ph[i];
+				// }}}
+			end else if (yv[i][WW-1])
+			begin
+				// {{{
+				xv[i+1] <= xv[i] + (yv[i]>>>S);
+				yv[i+1] <= yv[i] + (xv[i]>>>S);
+				ph[i+1] <= ph[i] - hyperbolic_angle[i];
+				// }}}
+			end else begin
+				// {{{
+				xv[i+1] <= xv[i] - (yv[i]>>>S);
+				yv[i+1] <= yv[i] - (xv[i]>>>S);
+				ph[i+1] <= ph[i] + hyperbolic_angle[i];
+				// }}}
+			end
+			// }}}
+		end
+	end endgenerate
+	// }}}
+
+
+	// Round our result towards even
+	// {{{
+	wire	[(WW-1):0]	pre_mag;
+
+	assign	pre_mag = xv[NSTAGES] + $signed({ {(OW){1'b0}},
+				xv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!xv[NSTAGES][WW-OW]}} });
+	// }}}
+
+	// Output assignments: o_mag, o_phase, o_aux
+	// {{{
+	initial begin
+		o_mag = 0;
+		o_phase = 0;
+		o_aux = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		o_mag <= 0;
+		o_phase <= 0;
+		o_aux <= 0;
+	end else if (i_ce)
+	begin
+		o_mag <= pre_mag[(WW-1):(WW-OW)];
+		o_phase <= ph[NSTAGES];
+		o_aux <= ax[NSTAGES];
+	end
+	// }}}
+
+	// Make Verilator happy with pre_.val
+	// {{{
+	// verilator lint_off UNUSED
+	wire	unused_val;
+	assign	unused_val = &{ 1'b0, pre_mag[(WW-OW-1):0] };
+	// verilator lint_on UNUSED
+	// }}}
+endmodule
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/lanecordic.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This .h file notes the default parameter values from
+//		within the generated file.  It is used to communicate
+//	information about the design to the bench testing code.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % (Not given)
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	LANECORDIC_H
+#define	LANECORDIC_H
+const int	NLANES = 2;
+const int	IW = 13;
+const int	OW = 13;
+const int	NEXTRA = 3;
+const int	WW = 16;
+const int	PW = 20;
+const int	NSTAGES = 16;
+const int	LATENCY = 18;	// Clocks from i_ce to output
+const double	QUANTIZATION_VARIANCE = 2.8025e-01; // (Units^2)
+const double	PHASE_VARIANCE_RAD = 2.1773e-10; // (Radians^2)
+const double	GAIN = 1.1644353454607288;
+const double	BEST_POSSIBLE_CNR = 78.92;
+const bool	HAS_RESET = true;
+const bool	HAS_AUX   = true;
+#define	HAS_RESET_WIRE
+#define	HAS_AUX_WIRES
+
+// Bit-exact model
+// {{{
+// The following duplicates, in integer arithmetic, the logic of the core
+// above: the same octant pre-rotation, the same truncated CORDIC angles,
+// the same shifts, and the same round-towards-even output stage.  Given
+// the same inputs, cordic_model() will return exactly what the core will
+// produce on o_xval and o_yval LATENCY clocks later.
+//
+#define	HAS_CORDIC_MODEL
+
+static const unsigned long	CORDIC_ANGLE[16] = {
+	0x12e40, 0x09fb3, 0x05111, 0x028b0,
+	0x0145d, 0x00a2f, 0x00517, 0x0028b,
+	0x00145, 0x000a2, 0x00051, 0x00028,
+	0x00014, 0x0000a, 0x00005, 0x00002
+};
+
+// Sign extend the bottom w bits of v
+static inline long	cordic_sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+
+static inline void	cordic_model(long i_xval, long i_yval,
+		unsigned long i_phase, long &o_xval, long &o_yval) {
+	const	unsigned long	PMSK = (1ul << PW) - 1;
+	long		xv, yv, tmp;
+	unsigned long	ph;
+
+	// Sign extend our inputs to the working width
+	xv = cordic_sext(i_xval, IW) * (1l << (WW-IW-1));
+	yv = cordic_sext(i_yval, IW) * (1l << (WW-IW-1));
+	ph = i_phase & PMSK;
+
+	// Pre-CORDIC rotation, to within +/- 45 degrees
+	switch((ph >> (PW-3)) & 7) {
+	case 1: case 2:	// 45 .. 135
+		tmp = xv; xv = -yv; yv = tmp;
+		ph -= (1ul << (PW-2));
+		break;
+	case 3: case 4:	// 135 .. 225
+		xv = -xv; yv = -yv;
+		ph -= (2ul << (PW-2));
+		break;
+	case 5: case 6:	// 225 .. 315
+		tmp = xv; xv = yv; yv = -tmp;
+		ph -= (3ul << (PW-2));
+		break;
+	default:	// 315 .. 45, no change
+		break;
+	}
+
+	xv = cordic_sext(xv, WW);
+	yv = cordic_sext(yv, WW);
+	ph &= PMSK;
+
+	// CORDIC rotations
+	for(int k=0; k<NSTAGES; k++) {
+		long	dx, dy;
+
+		if ((CORDIC_ANGLE[k] == 0)||(k >= WW))
+			continue;
+
+		dx = xv >> (k+1);
+		dy = yv >> (k+1);
+		if ((ph >> (PW-1))&1) {
+			// Negative phase, rotate clockwise
+			xv = cordic_sext(xv + dy, WW);
+			yv = cordic_sext(yv - dx, WW);
+			ph = (ph + CORDIC_ANGLE[k]) & PMSK;
+		} else {
+			// Positive phase, rotate counter-clockwise
+			xv = cordic_sext(xv - dy, WW);
+			yv = cordic_sext(yv + dx, WW);
+			ph = (ph - CORDIC_ANGLE[k]) & PMSK;
+		}
+	}
+
+	// Round towards even, then drop the extra bits
+	if ((xv >> (WW-OW)) & 1)
+		xv += (1l << (WW-OW-1));
+	else
+		xv += (1l << (WW-OW-1)) - 1;
+	if ((yv >> (WW-OW)) & 1)
+		yv += (1l << (WW-OW-1));
+	else
+		yv += (1l << (WW-OW-1)) - 1;
+	xv = cordic_sext(xv, WW);
+	yv = cordic_sext(yv, WW);
+
+	o_xval = xv >> (WW-OW);
+	o_yval = yv >> (WW-OW);
+}
+// }}}
+#endif	// LANECORDIC_H
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/linqtr.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This .h file notes the default parameter values from
+//		within the generated file.  It is used to communicate
+//	information about the design to the bench testing code.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % (Not given)
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	LINQTR_H
+#define	LINQTR_H
+const	int	OW         = 13; // bits
+const	int	NEXTRA     = 2; // bits
+const	int	PW         = 18; // bits
+const	int	LATENCY    = 5; // clocks
+const	long	TBL_LGSZ  = 6; // (Units)
+const	long	TBL_SZ    = 64; // (Units, 1/4 wave)
+const	long	SCALE     = 4095; // (Units)
+const	double	ITBL_ERR  = 0.62; // (WW Units)
+const	double	TBL_ERR   = 0.0000376370545670; // (sin Units)
+const	double	SPURDB    = -96.26; // dB
+const	bool	HAS_RESET = true;
+const	bool	HAS_AUX   = true;
+#define	HAS_RESET_WIRE
+#define	HAS_AUX_WIRES
+#endif	// LINQTR_H
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/linqtr.v
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This is a quarter-wave sine-wave table lookup, coupled with a
+//		linear interpolation of the result.  The table holds a value
+//	and a slope for each step of the first quarter wave, and the
+//	phase bits below the table index select how far along that
+//	slope to go, using only one multiply.  This sits between the
+//	quarter-wave table and the quadratically interpolated table, in
+//	both logic and accuracy.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % ./gencordic -vca -f ../rtl/linqtr.v -p 18 -o 13 -t linqtr -x 2
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+`default_nettype	none
+//
+module	linqtr #(
+		// {{{
+		localparam	PW=18,	// Bits in our phase variable
+				OW=13,  // The number of output bits to produce
+				XTRA= 2 // Extra bits for internal precision
+		// }}}
+	) (
+		// {{{
+		input	wire				i_clk, i_reset, i_ce,
+		//
+		input	wire		[(PW-1):0]	i_phase,
+		output	reg	signed	[(OW-1):0]	o_val,
+		//
+		input	wire				i_aux,
+		output	reg				o_aux
+		// }}}
+	);
+
+	// Declarations
+	// {{{
+	localparam	LGTBL   = 6,
+			DXBITS  = (PW-2-LGTBL),  // 10
+			TBLENTRIES = (1<<LGTBL), // 64
+			LBITS   = 9,
+			CBITS   = 14,
+			WW      = (OW+XTRA); // Working width
+
+	// Coefficient tables, covering the first quarter wave only:
+	//	Constant and Linear
+	reg	[(CBITS-1):0]	ctbl [0:(TBLENTRIES-1)];
+	reg	[(LBITS-1):0]	ltbl [0:(TBLENTRIES-1)];
+
+	initial begin
+		$readmemh("linqtr_ctbl.hex", ctbl);
+		$readmemh("linqtr_ltbl.hex", ltbl);
+	end
+
+	reg		[3:0]			negate;
+	reg		[(LGTBL-1):0]		index;
+	reg		[(DXBITS-1):0]		dx, dx_1;
+	reg		[(CBITS-1):0]		cv, cv_1;
+	reg		[(LBITS-1):0]		lv;
+	reg		[(LBITS+DXBITS-1):0]	lprod;
+	reg		[(WW-1):0]		mag;
+	wire		[(OW-2):0]		w_mag;
+	reg		[3:0]			aux;
+	// }}}
+
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Clock 1 - Quarter wave symmetry
+	// {{{
+	//	The top phase bit selects whether to negate the result, and
+	//	the next one whether to run backwards through the first
+	//	quarter wave.  The table entries are offset by half of a
+	//	phase step, so running backwards is just a bit inversion.
+	//	The negate flag then follows the data down the pipeline.
+	//
+	initial	negate = 0;
+	initial	index = 0;
+	initial	dx    = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		negate <= 0;
+		{ index, dx } <= 0;
+	end else if (i_ce)
+	begin
+		negate <= { negate[2:0], i_phase[(PW-1)] };
+		if (i_phase[(PW-2)])
+			{ index, dx } <= ~i_phase[(PW-3):0];
+		else
+			{ index, dx } <=  i_phase[(PW-3):0];
+	end
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Clock 2 - Table coefficient lookups
+	// {{{
+	//
+	// Here's our formula:
+	//
+	//	 Out = L*DX+C
+	//
+	// A basic linear interpolant.  All of the smarts are found within
+	// the L and C values.
+	//
+	always @(posedge i_clk)
+	if (i_ce)
+	begin
+		cv <= ctbl[index];
+		lv <= ltbl[index];
+	end
+
+	initial	dx_1 = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		dx_1 <= 0;
+	else if (i_ce)
+		dx_1 <= dx;
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Clock 3 - Our only multiply
+	// {{{
+	//
+	always @(posedge i_clk)
+	if (i_ce)
+		lprod <= lv * dx_1; // 19 bits
+
+	initial	cv_1 = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		cv_1 <= 0;
+	else if (i_ce)
+		cv_1 <= cv;
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Clock 4 - Add in the constant
+	// {{{
+	//	The constant already includes the rounding, so the magnitude
+	//	only needs to be truncated to produce our output.
+	//
+	initial	mag = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		mag <= 0;
+	else if (i_ce)
+		mag <= cv_1 + lprod[(LBITS+DXBITS-1):DXBITS];
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Clock 5 - Negate the output, if required
+	// {{{
+	//	Should the magnitude ever overflow, saturate it instead.
+	//
+	assign	w_mag = (mag[WW-1]) ? {(OW-1){1'b1}} : mag[(WW-2):XTRA];
+
+	initial	o_val = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		o_val <= 0;
+	else if (i_ce)
+	begin
+		if (negate[3])
+			o_val <= -{ 1'b0, w_mag };
+		else
+			o_val <=  { 1'b0, w_mag };
+	end
+	// }}}
+
+	// aux, o_aux
+	// {{{
+	initial	{ o_aux, aux } = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		{ o_aux, aux } <= 0;
+	else if (i_ce)
+		{ o_aux, aux } <= { aux, i_aux };
+	// }}}
+
+	// Make verilator happy
+	// {{{
+	// verilator lint_off UNUSED
+	wire	 unused;
+	assign	unused = &{ 1'b0, lprod[(DXBITS-1):0],
+			mag[(XTRA-1):0] };
+	// verilator lint_on  UNUSED
+	// }}}
+endmodule
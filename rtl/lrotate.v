@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/lrotate.v
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file calculates i_yval + i_xval * i_zval, using a linear
+//		CORDIC in rotation mode, and so without any multiplies.
+//	i_zval is a signed fraction, in units of 2^-(PW-1), and so runs
+//	from -1 to 1.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % ./gencordic -vca -f ../rtl/lrotate.v -i 13 -o 13 -t lrot -x 2
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+`default_nettype	none
+module	lrotate#(
+		// {{{
+	localparam	IW=13,	// The number of bits in our inputs
+			OW=13,	// The number of output bits to produce
+			NSTAGES=15,
+			// XTRA= 3,// Extra bits for internal precision
+			WW=16,	// Our working bit-width
+			PW=16	// Bits in our z variables
+		// }}}
+	) (
+		// {{{
+	input	wire				i_clk, i_reset, i_ce,
+	input	wire	signed	[(IW-1):0]		i_xval, i_yval,
+	input	wire	signed	[(PW-1):0]		i_zval,
+	output	reg	signed	[(OW-1):0]	o_yval,
+	input	wire				i_aux,
+	output	reg				o_aux
+		// }}}
+	);
+
+	// Declare variables for all of the separate stages
+	// {{{
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	reg	signed	[(WW-1):0]	xv	[0:(NSTAGES)];
+	reg	signed	[(WW-1):0]	yv	[0:(NSTAGES)];
+	reg		[(PW-1):0]	zv	[0:(NSTAGES)];
+	reg		[(NSTAGES):0]	ax;
+	// }}}
+
+	// Sign extend our inputs
+	// {{{
+	// Extend our inputs by one bit on the left, to make room for
+	// y + x*z, and by any extra bits on the right.
+	assign	e_xval = { i_xval[(IW-1)], i_xval, {(WW-IW-1){1'b0}} };
+	assign	e_yval = { i_yval[(IW-1)], i_yval, {(WW-IW-1){1'b0}} };
+	// }}}
+
+	//
+	// Handle the auxilliary logic.
+	// {{{
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_xval and i_yval
+	// are input together with i_aux, then when the outputs are set to
+	// their result, o_aux *must* contain the value that was in i_aux.
+	//
+
+	initial	ax = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		ax <= 0;
+	else if (i_ce)
+		ax <= { ax[(NSTAGES-1):0], i_aux };
+	// }}}
+
+	// Pre-rotation
+	// {{{
+	// There's nothing to reduce in the linear CORDIC.  The inputs
+	// are simply registered.
+	initial begin
+		xv[0] = 0;
+		yv[0] = 0;
+		zv[0] = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[0] <= 0;
+		yv[0] <= 0;
+		zv[0] <= 0;
+	end else if (i_ce)
+	begin
+		// {{{
+		xv[0] <= e_xval;
+		yv[0] <= e_yval;
+		zv[0] <= i_zval;
+		// }}}
+	end
+	// }}}
+
+	// Linear CORDIC stages
+	// {{{
+	// x never changes.  Each stage only adds (or subtracts) a
+	// shifted copy of it to y.  Stage i shifts x by i+1, and
+	// steps z by 2^-(i+1).
+	genvar	i;
+	generate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops
+		localparam			S = i+1;
+		localparam	[(PW-1):0]	ZSTEP
+				= { 2'b01, {(PW-2){1'b0}} } >> i;
+
+		initial begin
+			xv[i+1] = 0;
+			yv[i+1] = 0;
+			zv[i+1] = 0;
+		end
+
+		always @(posedge i_clk)
+	if (i_reset)
+		begin
+			// {{{
+			xv[i+1] <= 0;
+			yv[i+1] <= 0;
+			zv[i+1] <= 0;
+			// }}}
+		end else if (i_ce)
+		begin
+			// {{{
+			xv[i+1] <= xv[i];
+			if (!zv[i][PW-1])
+			begin
+				// {{{
+				yv[i+1] <= yv[i] + (xv[i]>>>S);
+				zv[i+1] <= zv[i] - ZSTEP;
+				// }}}
+			end else begin
+				// {{{
+				yv[i+1] <= yv[i] - (xv[i]>>>S);
+				zv[i+1] <= zv[i] + ZSTEP;
+				// }}}
+			end
+			// }}}
+		end
+	end endgenerate
+	// }}}
+
+
+	// Round our result towards even
+	// {{{
+	wire	[(WW-1):0]	pre_yval;
+
+	assign	pre_yval = yv[NSTAGES] + $signed({ {(OW){1'b0}},
+				yv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!yv[NSTAGES][WW-OW]}} });
+	// }}}
+
+	// Output assignments: o_yval, o_aux
+	// {{{
+	initial begin
+		o_yval = 0;
+		o_aux = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		o_yval <= 0;
+		o_aux <= 0;
+	end else if (i_ce)
+	begin
+		o_yval <= pre_yval[(WW-1):(WW-OW)];
+		o_aux <= ax[NSTAGES];
+	end
+	// }}}
+
+	// Make Verilator happy with pre_.val
+	// {{{
+	// verilator lint_off UNUSED
+	wire	unused_val;
+	assign	unused_val = &{ 1'b0, pre_yval[(WW-OW-1):0] };
+	// verilator lint_on UNUSED
+	// }}}
+endmodule
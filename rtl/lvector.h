@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/lvector.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This .h file notes the default parameter values from
+//		within the generated file.  It is used to communicate
+//	information about the design to the bench testing code.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % (Not given)
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	LVECTOR_H
+#define	LVECTOR_H
+#define	LINEAR
+#define	VECTORING
+const int	IW = 13;
+const int	OW = 13;
+const int	NEXTRA = 3;
+const int	WW = 16;
+const int	PW = 16;
+const int	NSTAGES = 15;
+const int	LATENCY = 17;	// Clocks from i_ce to output
+const double	QUANTIZATION_VARIANCE = 1.8924e-01; // (Units^2)
+const double	PHASE_VARIANCE = 3.1044e-10; // (Z^2)
+const double	GAIN = 1.0;
+const double	BEST_POSSIBLE_CNR = 73.42;
+const bool	HAS_RESET = true;
+const bool	HAS_AUX   = true;
+#define	HAS_RESET_WIRE
+#define	HAS_AUX_WIRES
+
+// Bit-exact model
+// {{{
+// The following duplicates, in integer arithmetic, the logic of the core
+// above.  Given the same inputs, lvector_model() will return exactly
+// what the core will produce once it has finished.
+//
+#define	HAS_LINEAR_MODEL
+
+// Sign extend the bottom w bits of v
+static inline long	linear_sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+
+static inline void	lvector_model(long i_xval, long i_yval,
+		unsigned long &o_zval) {
+	const	unsigned long	PMSK = (1ul << PW) - 1;
+	long		xv, yv;
+	unsigned long	zv;
+
+	// Sign extend our inputs to the working width, one bit down
+	xv = linear_sext(i_xval, IW) * (1l << (WW-IW-1));
+	yv = linear_sext(i_yval, IW) * (1l << (WW-IW-1));
+
+	// y/x is the same as (-y)/(-x)
+	if (xv < 0) {
+		xv = -xv;
+		yv = -yv;
+	}
+	zv = 0;
+
+	// Linear CORDIC stages
+	for(int k=0; k<NSTAGES; k++) {
+		const	unsigned long	zstep = (1ul << (PW-2)) >> k;
+
+		// y is kept scaled by 2^(k+1), so x is never shifted
+		if (yv < 0) {
+			yv = linear_sext(2*yv + xv, WW);
+			zv = (zv - zstep) & PMSK;
+		} else {
+			yv = linear_sext(2*yv - xv, WW);
+			zv = (zv + zstep) & PMSK;
+		}
+	}
+
+	o_zval = zv;
+}
+// }}}
+#endif	// LVECTOR_H
@@ -46,11 +46,18 @@
 const	int	OW         = 13; // bits
 const	int	NEXTRA     = 3; // bits
 const	int	PW         = 18; // bits
+const	int	ORDER      = 2; // Interpolation order
+const	int	LATENCY    = 6; // clocks
 const	long	TBL_LGSZ  = 6; // (Units)
 const	long	TBL_SZ    = 64; // (Units)
+const	int	CBITS      = 16; // bits
+const	int	LBITS      = 13; // bits
+const	int	QBITS      = 9; // bits
+const	int	NMULTS     = 2; // multiplies
+const	int	NDSPS      = 2; // 25x18 DSPs, est.
 const	long	SCALE     = 4094; // (Units)
 const	double	ITBL_ERR  = -0.25; // (OW Units)
-const	double	TBL_ERR   = -0.0000037981536051; // (sin Units)
+const	double	TBL_ERR   = -0.0000038016119704; // (sin Units)
 const	double	SPURDB    = -107.97; // dB
 const	bool	HAS_RESET = true;
 const	bool	HAS_AUX   = true;
@@ -0,0 +1,400 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/romcordic.v
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file executes a vector rotation on the values
+//		(i_xval, i_yval).  This vector is rotated left by
+//	i_phase.  i_phase is given by the angle, in radians, multiplied by
+//	2^32/(2pi).  In that fashion, a two pi value is zero just as a zero
+//	angle is zero.
+//
+//	Rather than starting with the largest CORDIC angles, this core
+//	looks up the cosine and sine of the top LGROM bits of the phase
+//	(following the octant), and rotates by them with one complex
+//	multiply.  Only the CORDIC stages from LGROM on are then required.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % ./gencordic -vca -f ../rtl/romcordic.v -i 13 -o 13 -t p2r --rom 5 -x 2 -c
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+`default_nettype	none
+module	romcordic#(
+		// {{{
+	localparam	IW=13,	// The number of bits in our inputs
+			OW=13,	// The number of output bits to produce
+			NSTAGES=16,
+			LGROM= 5,	// Phase bits looking up the ROM
+			// XTRA= 3,// Extra bits for internal precision
+			WW=16,	// Our working bit-width
+			TW=16,	// Bits in each ROM entry
+			PW=20	// Bits in our phase variables
+		// }}}
+	) (
+		// {{{
+	input	wire				i_clk, i_reset, i_ce,
+	input	wire	signed	[(IW-1):0]		i_xval, i_yval,
+	input	wire		[(PW-1):0]			i_phase,
+	output	reg	signed	[(OW-1):0]	o_xval, o_yval,
+	input	wire				i_aux,
+	output	reg				o_aux
+		// }}}
+	);
+
+	// Declare variables for all of the separate stages
+	// {{{
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	reg	signed	[(WW-1):0]	pre_xv, pre_yv;
+	reg		[(PW-1):0]	pre_ph, mpy_ph;
+	reg	signed	[(TW-1):0]	costbl	[0:((1<<LGROM)-1)];
+	reg	signed	[(TW-1):0]	sintbl	[0:((1<<LGROM)-1)];
+	reg	signed	[(TW-1):0]	r_cos, r_sin;
+	reg	signed	[(WW+TW-1):0]	p_xcos, p_ysin, p_xsin, p_ycos;
+	wire	signed	[(WW+TW):0]	w_xrot, w_yrot;
+	reg	signed	[(WW-1):0]	xv	[LGROM:(NSTAGES)];
+	reg	signed	[(WW-1):0]	yv	[LGROM:(NSTAGES)];
+	reg		[(PW-1):0]	ph	[LGROM:(NSTAGES)];
+	reg		[(NSTAGES-LGROM+2):0]	ax;
+	// }}}
+
+	// Sign extend our inputs
+	// {{{
+	// First step: expand our input to our working width.
+	// This is going to involve extending our input by one
+	// (or more) bits in addition to adding any xtra bits on
+	// bits on the right.  The one bit extra on the left is to
+	// allow for any accumulation due to the cordic gain
+	// within the algorithm.
+	// 
+	assign	e_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };
+	assign	e_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };
+
+	// }}}
+	// Cordic angle table
+	// {{{
+	// In many ways, the key to this whole algorithm lies in the angles
+	// necessary to do this.  These angles are also our basic reason for
+	// building this CORDIC in C++: Verilog just can't parameterize this
+	// much.  Further, these angle's risk becoming unsupportable magic
+	// numbers, hence we define these and set them in C++, based upon
+	// the needs of our problem, specifically the number of stages and
+	// the number of bits required in our phase accumulator
+	//
+	wire	[19:0]	cordic_angle [0:(NSTAGES-1)];
+
+	assign	cordic_angle[ 0] = 20'h1_2e40; //  26.565051 deg
+	assign	cordic_angle[ 1] = 20'h0_9fb3; //  14.036243 deg
+	assign	cordic_angle[ 2] = 20'h0_5111; //   7.125016 deg
+	assign	cordic_angle[ 3] = 20'h0_28b0; //   3.576334 deg
+	assign	cordic_angle[ 4] = 20'h0_145d; //   1.789911 deg
+	assign	cordic_angle[ 5] = 20'h0_0a2f; //   0.895174 deg
+	assign	cordic_angle[ 6] = 20'h0_0517; //   0.447614 deg
+	assign	cordic_angle[ 7] = 20'h0_028b; //   0.223811 deg
+	assign	cordic_angle[ 8] = 20'h0_0145; //   0.111906 deg
+	assign	cordic_angle[ 9] = 20'h0_00a2; //   0.055953 deg
+	assign	cordic_angle[10] = 20'h0_0051; //   0.027976 deg
+	assign	cordic_angle[11] = 20'h0_0028; //   0.013988 deg
+	assign	cordic_angle[12] = 20'h0_0014; //   0.006994 deg
+	assign	cordic_angle[13] = 20'h0_000a; //   0.003497 deg
+	assign	cordic_angle[14] = 20'h0_0005; //   0.001749 deg
+	assign	cordic_angle[15] = 20'h0_0002; //   0.000874 deg
+	// {{{
+	// Std-Dev    : 0.00 (Units)
+	// Phase Quantization: 0.000015 (Radians)
+	// Gain is 1.164435
+	// You can annihilate this gain by multiplying by 32'hdbd95b16
+	// and right shifting by 32 bits.
+	// }}}
+	// }}}
+	// Residual phase widths
+	// {{{
+	// Each stage leaves less phase for those following it.  Entry
+	// i of PHW holds the bits, sign included, that the phase can
+	// use following stage i.  Any bits above these are only ever
+	// copies of the sign bit.
+	localparam	[(8*NSTAGES-1):0]	PHW = {
+			8'd4, 8'd5, 8'd5, 8'd6, 8'd7, 8'd8, 8'd9, 8'd10,
+			8'd11, 8'd12, 8'd13, 8'd20, 8'd20, 8'd20, 8'd20, 8'd20 };
+	// }}}
+
+	//
+	// Handle the auxilliary logic.
+	// {{{
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_xval and i_yval
+	// are input together with i_aux, then when o_xval and o_yval are set
+	// to this value, o_aux *must* contain the value that was in i_aux.
+	//
+
+	initial	ax = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		ax <= 0;
+	else if (i_ce)
+		ax <= { ax[(NSTAGES-LGROM+1):0], i_aux };
+	// }}}
+
+	// Pre-CORDIC rotation
+	// {{{
+	// First stage, get rid of all but 45 degrees.  Since each
+	// octant is reduced by a multiple of 90 degrees, the bottom
+	// PW-2 bits of the phase are left unchanged.  The top LGROM
+	// of them then select the coarse rotation, and what's left
+	// below them, less the half step the ROM has already rotated
+	// by, is left for the CORDIC.
+	initial begin
+		pre_xv = 0;
+		pre_yv = 0;
+		pre_ph = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		pre_xv <= 0;
+		pre_yv <= 0;
+		pre_ph <= 0;
+	end else if (i_ce)
+	begin
+		// {{{
+		// This is a zero-gain operation, involving only sign
+		// adjustments.
+		case(i_phase[(PW-1):(PW-3)])
+		3'b001, 3'b010: begin	// 45 .. 135
+			pre_xv <= -e_yval;
+			pre_yv <= e_xval;
+			end
+		3'b011, 3'b100: begin	// 135 .. 225
+			pre_xv <= -e_xval;
+			pre_yv <= -e_yval;
+			end
+		3'b101, 3'b110: begin	// 225 .. 315
+			pre_xv <= e_yval;
+			pre_yv <= -e_xval;
+			end
+		default: begin	// 315 .. 45, No change
+			pre_xv <= e_xval;
+			pre_yv <= e_yval;
+			end
+		endcase
+
+		pre_ph <= { {(LGROM+3){!i_phase[PW-3-LGROM]}},
+				i_phase[(PW-4-LGROM):0] };
+		// }}}
+	end
+	// }}}
+
+	// Coarse rotation
+	// {{{
+	// Entry k of the tables holds the cosine and sine of the angle
+	// in the middle of the k'th step of 90/2^LGROM degrees, with k
+	// taken as a signed number, scaled by 2^(TW-1).  Neither the
+	// table reads nor the products are reset, so that they may be
+	// placed into block RAM and hardware multiplies.
+	initial begin
+		$readmemh("romcordic_cos.hex", costbl);
+		$readmemh("romcordic_sin.hex", sintbl);
+	end
+
+	always @(posedge i_clk)
+	if (i_ce)
+	begin
+		r_cos <= costbl[i_phase[(PW-3):(PW-2-LGROM)]];
+		r_sin <= sintbl[i_phase[(PW-3):(PW-2-LGROM)]];
+	end
+
+	always @(posedge i_clk)
+	if (i_ce)
+	begin
+		p_xcos <= pre_xv * r_cos;
+		p_ysin <= pre_yv * r_sin;
+		p_xsin <= pre_xv * r_sin;
+		p_ycos <= pre_yv * r_cos;
+	end
+
+	initial	mpy_ph = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		mpy_ph <= 0;
+	else if (i_ce)
+		mpy_ph <= pre_ph;
+
+	// Round the products back to the working width
+	assign	w_xrot = p_xcos - p_ysin
+			+ $signed({ {(WW+2){1'b0}}, 1'b1, {(TW-2){1'b0}} });
+	assign	w_yrot = p_xsin + p_ycos
+			+ $signed({ {(WW+2){1'b0}}, 1'b1, {(TW-2){1'b0}} });
+
+	initial begin
+		xv[LGROM] = 0;
+		yv[LGROM] = 0;
+		ph[LGROM] = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[LGROM] <= 0;
+		yv[LGROM] <= 0;
+		ph[LGROM] <= 0;
+	end else if (i_ce)
+	begin
+		xv[LGROM] <= w_xrot[(WW+TW-2):(TW-1)];
+		yv[LGROM] <= w_yrot[(WW+TW-2):(TW-1)];
+		ph[LGROM] <= mpy_ph;
+	end
+
+	// Make Verilator happy with the bits we don't use
+	// {{{
+	// verilator lint_off UNUSED
+	wire	unused_rot;
+	assign	unused_rot = &{ 1'b0,
+		w_xrot[(WW+TW):(WW+TW-1)], w_xrot[(TW-2):0],
+		w_yrot[(WW+TW):(WW+TW-1)], w_yrot[(TW-2):0]
+		};
+	// verilator lint_on UNUSED
+	// }}}
+	// }}}
+
+	// CORDIC rotations
+	// {{{
+	// The coarse rotation has left a phase of no more than half a
+	// ROM step, 45/2^LGROM degrees, either way.  The CORDIC stages
+	// from LGROM on can still rotate by more than that, so the
+	// first LGROM stages aren't needed.
+	genvar	i;
+	generate for(i=LGROM; i<NSTAGES; i=i+1) begin : CORDICops
+		// The phase following this stage needs only PWN bits.
+		// Those above are copies of its sign, and so the adder
+		// need be no wider.
+		localparam	PWN = PHW[8*i +: 8];
+		wire	[(PWN-1):0]	nph;
+
+		assign	nph = (ph[i][PW-1])
+				? (ph[i][(PWN-1):0] + cordic_angle[i][(PWN-1):0])
+				: (ph[i][(PWN-1):0] - cordic_angle[i][(PWN-1):0]);
+
+		initial begin
+			xv[i+1] = 0;
+			yv[i+1] = 0;
+			ph[i+1] = 0;
+		end
+
+		always @(posedge i_clk)
+	if (i_reset)
+		begin
+			// {{{
+			xv[i+1] <= 0;
+			yv[i+1] <= 0;
+			ph[i+1] <= 0;
+			// }}}
+		end else if (i_ce)
+		begin
+			// {{{
+			if ((cordic_angle[i] == 0)||(i >= WW))
+			begin // Do nothing but move our outputs
+			// forward one stage, since we have more
+			// stages than valid data
+				// {{{
+				xv[i+1] <= xv[i];
+				yv[i+1] <= yv[i];
+				ph[i+1] <= ph[i];
+				// }}}
+			end else if (ph[i][(PW-1)]) // Negative phase
+			begin
+				// {{{
+				// If the phase is negative, rotate by the
+				// CORDIC angle in a clockwise direction.
+				xv[i+1] <= xv[i] + (yv[i]>>>(i+1));
+				yv[i+1] <= yv[i] - (xv[i]>>>(i+1));
+				ph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };
+				// }}}
+			end else begin
+				// {{{
+				// On the other hand, if the phase is
+				// positive ... rotate in the
+				// counter-clockwise direction
+				xv[i+1] <= xv[i] - (yv[i]>>>(i+1));
+				yv[i+1] <= yv[i] + (xv[i]>>>(i+1));
+				ph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };
+				// }}}
+			end
+			// }}}
+		end
+	end endgenerate
+	// }}}
+
+	// Round our result towards even
+	// {{{
+	wire	[(WW-1):0]	pre_xval, pre_yval;
+
+	assign	pre_xval = xv[NSTAGES] + $signed({ {(OW){1'b0}},
+				xv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!xv[NSTAGES][WW-OW]}} });
+	assign	pre_yval = yv[NSTAGES] + $signed({ {(OW){1'b0}},
+				yv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!yv[NSTAGES][WW-OW]}} });
+	// }}}
+
+	// Output assignments
+	// {{{
+	initial begin
+		o_xval = 0;
+		o_yval = 0;
+		o_aux  = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		o_xval <= 0;
+		o_yval <= 0;
+		o_aux  <= 0;
+	end else if (i_ce)
+	begin
+		o_xval <= pre_xval[(WW-1):(WW-OW)];
+		o_yval <= pre_yval[(WW-1):(WW-OW)];
+		o_aux  <= ax[NSTAGES-LGROM+2];
+	end
+	// }}}
+
+	// Make Verilator happy with pre_.val
+	// {{{
+	// verilator lint_off UNUSED
+	wire	unused_val;
+	assign	unused_val = &{ 1'b0, 
+		pre_xval[(WW-OW-1):0],
+		pre_yval[(WW-OW-1):0]
+		};
+	// verilator lint_on UNUSED
+	// }}}
+endmodule
@@ -48,6 +48,7 @@
 #endif	// CLOCKS_PER_OUTPUT
 #define	CLOCKS_PER_OUTPUT	17
 
+const int	NLANES = 1;
 const int	IW = 13;
 const int	OW = 13;
 const int	NEXTRA = 3;
@@ -0,0 +1,370 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/seqcordick.v
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file executes a vector rotation on the values
+//		(i_xval, i_yval).  This vector is rotated left by
+//	i_phase.  i_phase is given by the angle, in radians, multiplied by
+//	2^32/(2pi).  In that fashion, a two pi value is zero just as a zero
+//	angle is zero.
+//
+//	This particular version of the CORDIC processes one value at a
+//	time in a sequential, vs pipelined or parallel, fashion.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % ./gencordic -vca -f ../rtl/seqcordick.v -i 13 -o 13 -t sp2r -x 2 -c -k 3
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+`default_nettype	none
+module	seqcordick #(
+		// {{{
+		// These parameters are fixed by the core generator.  They
+		// have been used in the definitions of internal constants,
+		// so they can't really be changed here.
+		localparam	IW=13,	// The number of bits in our inputs
+				OW=13,	// The number of output bits to produce
+				NSTAGES=16,
+				// XTRA= 3,// Extra bits for internal precision
+				WW=16,	// Our working bit-width
+				PW=20	// Bits in our phase variables
+		// }}}
+	) (
+		// {{{
+		input	wire				i_clk, i_reset, i_stb,
+		input	wire				i_aux,
+		input	wire	signed	[(IW-1):0]	i_xval, i_yval,
+		input	wire		[(PW-1):0]	i_phase,
+		output	wire				o_busy,
+		output	reg				o_done,
+		output	reg	signed	[(OW-1):0]	o_xval, o_yval,
+		output	reg				o_aux
+		// }}}
+	);
+	// First step: expand our input to our working width.
+	// {{{
+	// This is going to involve extending our input by one
+	// (or more) bits in addition to adding any xtra bits on
+	// bits on the right.  The one bit extra on the left is to
+	// allow for any accumulation due to the cordic gain
+	// within the algorithm.
+	// 
+	wire	signed [(WW-1):0]	e_xval, e_yval;
+	assign	e_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };
+	assign	e_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };
+
+	// }}}
+	// Declare variables for all of the separate stages
+	// {{{
+	reg	signed	[(WW-1):0]	xv, prex, yv, prey;
+	reg		[(PW-1):0]	ph, preph;
+	reg				idle, pre_valid;
+	reg		[4:0]		base;
+	wire				last_state;
+
+	reg				aux;
+	// }}}
+
+	//
+	// Handle the auxilliary logic.
+	// {{{
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_xval and i_yval
+	// are input together with i_aux, then when o_xval and o_yval are set
+	// to this value, o_aux *must* contain the value that was in i_aux.
+	//
+
+	initial	aux = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		aux <= 0;
+	else if ((i_stb)&&(!o_busy))
+		aux <= i_aux;
+	// }}}
+
+	// First step, get rid of all but the last 45 degrees
+	// {{{
+	// The resulting phase needs to be between -45 and 45
+	// degrees but in units of normalized phase
+	//
+	// We'll do this by walking through all possible quick phase
+	// shifts necessary to constrain the input to within +/- 45
+	// degrees.
+	always @(posedge i_clk)
+	case(i_phase[(PW-1):(PW-3)])
+	3'b000: begin	// 0 .. 45, No change
+		// {{{
+		prex  <=  e_xval;
+		prey  <=  e_yval;
+		preph <= i_phase;
+		end
+		// }}}
+	3'b001: begin	// 45 .. 90
+		// {{{
+		prex  <= -e_yval;
+		prey  <=  e_xval;
+		preph <= i_phase - 20'h40000;
+		end
+		// }}}
+	3'b010: begin	// 90 .. 135
+		// {{{
+		prex  <= -e_yval;
+		prey  <=  e_xval;
+		preph <= i_phase - 20'h40000;
+		end
+		// }}}
+	3'b011: begin	// 135 .. 180
+		// {{{
+		prex  <= -e_xval;
+		prey  <= -e_yval;
+		preph <= i_phase - 20'h80000;
+		end
+		// }}}
+	3'b100: begin	// 180 .. 225
+		// {{{
+		prex  <= -e_xval;
+		prey  <= -e_yval;
+		preph <= i_phase - 20'h80000;
+		end
+		// }}}
+	3'b101: begin	// 225 .. 270
+		// {{{
+		prex  <=  e_yval;
+		prey  <= -e_xval;
+		preph <= i_phase - 20'hc0000;
+		end
+		// }}}
+	3'b110: begin	// 270 .. 315
+		// {{{
+		prex  <=  e_yval;
+		prey  <= -e_xval;
+		preph <= i_phase - 20'hc0000;
+		end
+		// }}}
+	3'b111: begin	// 315 .. 360, No change
+		// {{{
+		prex  <=  e_xval;
+		prey  <=  e_yval;
+		preph <= i_phase;
+		end
+		// }}}
+	endcase
+	// }}}
+
+	// Cordic angle table
+	// {{{
+	// In many ways, the key to this whole algorithm lies in the angles
+	// necessary to do this.  These angles are also our basic reason for
+	// building this CORDIC in C++: Verilog just can't parameterize this
+	// much.  Further, these angle's risk becoming unsupportable magic
+	// numbers, hence we define these and set them in C++, based upon
+	// the needs of our problem, specifically the number of stages and
+	// the number of bits required in our phase accumulator
+	//
+	wire	[19:0]	cordic_angle [0:(NSTAGES-1)];
+
+	assign	cordic_angle[ 0] = 20'h1_2e40; //  26.565051 deg
+	assign	cordic_angle[ 1] = 20'h0_9fb3; //  14.036243 deg
+	assign	cordic_angle[ 2] = 20'h0_5111; //   7.125016 deg
+	assign	cordic_angle[ 3] = 20'h0_28b0; //   3.576334 deg
+	assign	cordic_angle[ 4] = 20'h0_145d; //   1.789911 deg
+	assign	cordic_angle[ 5] = 20'h0_0a2f; //   0.895174 deg
+	assign	cordic_angle[ 6] = 20'h0_0517; //   0.447614 deg
+	assign	cordic_angle[ 7] = 20'h0_028b; //   0.223811 deg
+	assign	cordic_angle[ 8] = 20'h0_0145; //   0.111906 deg
+	assign	cordic_angle[ 9] = 20'h0_00a2; //   0.055953 deg
+	assign	cordic_angle[10] = 20'h0_0051; //   0.027976 deg
+	assign	cordic_angle[11] = 20'h0_0028; //   0.013988 deg
+	assign	cordic_angle[12] = 20'h0_0014; //   0.006994 deg
+	assign	cordic_angle[13] = 20'h0_000a; //   0.003497 deg
+	assign	cordic_angle[14] = 20'h0_0005; //   0.001749 deg
+	assign	cordic_angle[15] = 20'h0_0002; //   0.000874 deg
+	// {{{
+	// Std-Dev    : 0.00 (Units)
+	// Phase Quantization: 0.000015 (Radians)
+	// Gain is 1.164435
+	// You can annihilate this gain by multiplying by 32'hdbd95b16
+	// and right shifting by 32 bits.
+	// }}}
+	// }}}
+
+	assign	last_state = (!idle)&&(base == 5'd18);
+
+	// idle
+	// {{{
+	initial	idle = 1'b1;
+	always @(posedge i_clk)
+	if (i_reset)
+		idle <= 1'b1;
+	else if ((i_stb)&&(idle))
+		idle <= 1'b0;
+	else if (last_state)
+		idle <= 1'b1;
+	// }}}
+
+	// pre_valid
+	// {{{
+	initial	pre_valid = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		pre_valid <= 1'b0;
+	else
+		pre_valid <= (i_stb)&&(idle);
+	// }}}
+
+	// base -- the first stage applied on this clock
+	// {{{
+	initial	base = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		base <= 0;
+	else if ((idle)||(pre_valid))
+		base <= 0;
+	else if (!last_state)
+		base <= base + 5'd3;
+	// }}}
+
+	// Unrolled CORDIC stages
+	// {{{
+	// Each clock applies the 3 stages starting with stage base,
+	// one after the other.  Any stage beyond the last useful one
+	// just passes its values through.
+	wire	signed	[(WW-1):0]	kx	[0:3];
+	wire	signed	[(WW-1):0]	ky	[0:3];
+	wire		[(PW-1):0]	kph	[0:3];
+
+	assign	kx[0]  = xv;
+	assign	ky[0]  = yv;
+	assign	kph[0] = ph;
+
+	// Stage base+0
+	assign	kx[1] = (base >= 5'd16) ? kx[0]
+			: (kph[0][PW-1]) ? (kx[0] + (ky[0] >>> (base + 5'd1)))
+			: (kx[0] - (ky[0] >>> (base + 5'd1)));
+	assign	ky[1] = (base >= 5'd16) ? ky[0]
+			: (kph[0][PW-1]) ? (ky[0] - (kx[0] >>> (base + 5'd1)))
+			: (ky[0] + (kx[0] >>> (base + 5'd1)));
+	assign	kph[1] = (base >= 5'd16) ? kph[0]
+			: (kph[0][PW-1]) ? (kph[0] + cordic_angle[base])
+			: (kph[0] - cordic_angle[base]);
+
+	// Stage base+1
+	assign	kx[2] = (base >= 5'd15) ? kx[1]
+			: (kph[1][PW-1]) ? (kx[1] + (ky[1] >>> (base + 5'd2)))
+			: (kx[1] - (ky[1] >>> (base + 5'd2)));
+	assign	ky[2] = (base >= 5'd15) ? ky[1]
+			: (kph[1][PW-1]) ? (ky[1] - (kx[1] >>> (base + 5'd2)))
+			: (ky[1] + (kx[1] >>> (base + 5'd2)));
+	assign	kph[2] = (base >= 5'd15) ? kph[1]
+			: (kph[1][PW-1]) ? (kph[1] + cordic_angle[base + 5'd1])
+			: (kph[1] - cordic_angle[base + 5'd1]);
+
+	// Stage base+2
+	assign	kx[3] = (base >= 5'd14) ? kx[2]
+			: (kph[2][PW-1]) ? (kx[2] + (ky[2] >>> (base + 5'd3)))
+			: (kx[2] - (ky[2] >>> (base + 5'd3)));
+	assign	ky[3] = (base >= 5'd14) ? ky[2]
+			: (kph[2][PW-1]) ? (ky[2] - (kx[2] >>> (base + 5'd3)))
+			: (ky[2] + (kx[2] >>> (base + 5'd3)));
+	assign	kph[3] = (base >= 5'd14) ? kph[2]
+			: (kph[2][PW-1]) ? (kph[2] + cordic_angle[base + 5'd2])
+			: (kph[2] - cordic_angle[base + 5'd2]);
+	// }}}
+
+	// CORDIC rotations
+	// {{{
+	// Here's where we are going to put the actual CORDIC
+	// we've been studying and discussing.  Everything up to
+	// this point has simply been necessary preliminaries.
+	always @(posedge i_clk)
+	if (pre_valid)
+	begin
+		// {{{
+		xv <= prex;
+		yv <= prey;
+		ph <= preph;
+		// }}}
+	end else begin
+		// {{{
+		xv <= kx[3];
+		yv <= ky[3];
+		ph <= kph[3];
+		// }}}
+	end
+	// }}}
+
+	// Round our result towards even
+	// {{{
+	wire	[(WW-1):0]	final_xv, final_yv;
+
+	assign	final_xv = xv + $signed({{(OW){1'b0}},
+				xv[(WW-OW)],
+				{(WW-OW-1){!xv[WW-OW]}} });
+	assign	final_yv = yv + $signed({{(OW){1'b0}},
+				yv[(WW-OW)],
+				{(WW-OW-1){!yv[WW-OW]}} });
+	// }}}
+	// o_done
+	// {{{
+	initial	o_done = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		o_done <= 1'b0;
+	else
+		o_done <= last_state;
+	// }}}
+
+	// Output assignments: o_xval, o_yval, o_aux
+	// {{{
+	initial	o_aux = 0;
+	always @(posedge i_clk)
+	if (last_state)
+	begin
+		o_xval <= final_xv[WW-1:WW-OW];
+		o_yval <= final_yv[WW-1:WW-OW];
+		o_aux <= aux;
+	end
+	// }}}
+
+	assign	o_busy = !idle;
+
+	// Make Verilator happy with pre_.val
+	// {{{
+	// verilator lint_off UNUSED
+	wire	unused_val;
+	assign	unused_val = &{ 1'b0,  final_xv[WW-OW-1:0], final_yv[WW-OW-1:0] };
+	// verilator lint_on UNUSED
+	// }}}
+endmodule
@@ -47,6 +47,7 @@
 #undef	CLOCKS_PER_OUTPUT
 #endif	// CLOCKS_PER_OUTPUT
 #define	CLOCKS_PER_OUTPUT	21
+const int	NLANES = 1;
 const int	IW = 13;
 const int	OW = 13;
 const int	NEXTRA = 4;
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/sincos.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This .h file notes the default parameter values from
+//		within the generated file.  It is used to communicate
+//	information about the design to the bench testing code.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % (Not given)
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	SINCOS_H
+#define	SINCOS_H
+const int	OW = 13;
+const int	NEXTRA = 2;
+const int	WW = 15;
+const int	PW = 19;
+const int	NSTAGES = 15;
+const int	LATENCY = 17;	// Clocks from i_ce to output
+const double	QUANTIZATION_VARIANCE = 7.5909e-01; // (Units^2)
+const double	PHASE_VARIANCE_RAD = 8.7713e-10; // (Radians^2)
+const double	CORDIC_GAIN = 1.6467602578654548;	// Folded into START
+const double	AMPLITUDE = 4087.6706500865252565;	// Of o_cos and o_sin
+const double	BEST_POSSIBLE_CNR = 73.34;
+const bool	HAS_RESET = true;
+const bool	HAS_AUX   = true;
+#define	HAS_RESET_WIRE
+#define	HAS_AUX_WIRES
+
+// Bit-exact model
+// {{{
+// The following duplicates, in integer arithmetic, the logic of the core
+// above: the same initial vector, the same truncated CORDIC angles, the
+// same shifts, and the same round-towards-even output stage.  Given the
+// same phase, sincos_model() will return exactly what the core will
+// produce on o_cos and o_sin LATENCY clocks later.
+//
+#define	HAS_SINCOS_MODEL
+
+static const long	SINCOS_START = 9929;
+
+static const unsigned long	SINCOS_ANGLE[15] = {
+	0x09720, 0x04fd9, 0x02888, 0x01458,
+	0x00a2e, 0x00517, 0x0028b, 0x00145,
+	0x000a2, 0x00051, 0x00028, 0x00014,
+	0x0000a, 0x00005, 0x00002
+};
+
+// Sign extend the bottom w bits of v
+static inline long	sincos_sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+
+static inline void	sincos_model(unsigned long i_phase,
+		long &o_cos, long &o_sin) {
+	const	unsigned long	PMSK = (1ul << PW) - 1;
+	long		xv, yv;
+	unsigned long	ph;
+
+	// The initial vector, one per quadrant
+	switch((i_phase >> (PW-2)) & 3) {
+	case 0:  xv =  SINCOS_START; yv =  SINCOS_START; break;
+	case 1:  xv = -SINCOS_START; yv =  SINCOS_START; break;
+	case 2:  xv = -SINCOS_START; yv = -SINCOS_START; break;
+	default: xv =  SINCOS_START; yv = -SINCOS_START; break;
+	}
+
+	// The phase within the quadrant, less 45 degrees
+	ph = ((i_phase & ((1ul << (PW-2))-1)) - (1ul << (PW-3))) & PMSK;
+
+	// CORDIC rotations
+	for(int k=0; k<NSTAGES; k++) {
+		long	dx, dy;
+
+		if ((SINCOS_ANGLE[k] == 0)||(k >= WW))
+			continue;
+
+		dx = xv >> (k+1);
+		dy = yv >> (k+1);
+		if ((ph >> (PW-1))&1) {
+			// Negative phase, rotate clockwise
+			xv = sincos_sext(xv + dy, WW);
+			yv = sincos_sext(yv - dx, WW);
+			ph = (ph + SINCOS_ANGLE[k]) & PMSK;
+		} else {
+			// Positive phase, rotate counter-clockwise
+			xv = sincos_sext(xv - dy, WW);
+			yv = sincos_sext(yv + dx, WW);
+			ph = (ph - SINCOS_ANGLE[k]) & PMSK;
+		}
+	}
+
+	// Round towards even, then drop the extra bits
+	if ((xv >> (WW-OW)) & 1)
+		xv += (1l << (WW-OW-1));
+	else
+		xv += (1l << (WW-OW-1)) - 1;
+	if ((yv >> (WW-OW)) & 1)
+		yv += (1l << (WW-OW-1));
+	else
+		yv += (1l << (WW-OW-1)) - 1;
+	xv = sincos_sext(xv, WW);
+	yv = sincos_sext(yv, WW);
+
+	o_cos = xv >> (WW-OW);
+	o_sin = yv >> (WW-OW);
+}
+// }}}
+#endif	// SINCOS_H
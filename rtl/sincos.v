@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/sincos.v
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	This file produces the cosine and sine of i_phase, on
+//		o_cos and o_sin respectively.  i_phase is given by the angle,
+//	in radians, multiplied by 2^PW/(2pi).  Internally, this is a
+//	polar to rectangular CORDIC whose input vector is a constant, and
+//	so has been folded into the logic.
+//
+// This core was generated via a core generator using the following command
+// line:
+//
+//  % ./gencordic -vca -f ../rtl/sincos.v -o 13 -t sincos -x 2
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This file is part of the CORDIC related project set.
+//
+// The CORDIC related project set is free software (firmware): you can
+// redistribute it and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// The CORDIC related project set is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTIBILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+// General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  (It's in the $(ROOT)/doc directory.  Run make
+// with no target there if the PDF file isn't present.)  If not, see
+// License:	LGPL, v3, as defined and found on www.gnu.org,
+//		http://www.gnu.org/licenses/lgpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+`default_nettype	none
+module	sincos#(
+		// {{{
+	localparam	OW=13,	// The number of output bits to produce
+			NSTAGES=15,
+			// XTRA= 2,// Extra bits for internal precision
+			WW=15,	// Our working bit-width
+			PW=19	// Bits in our phase variables
+		// }}}
+	) (
+		// {{{
+	input	wire				i_clk, i_reset, i_ce,
+	input	wire		[(PW-1):0]			i_phase,
+	output	reg	signed	[(OW-1):0]	o_cos, o_sin,
+	input	wire				i_aux,
+	output	reg				o_aux
+		// }}}
+	);
+
+	// Declare variables for all of the separate stages
+	// {{{
+	reg	signed	[(WW-1):0]	xv	[0:(NSTAGES)];
+	reg	signed	[(WW-1):0]	yv	[0:(NSTAGES)];
+	reg		[(PW-1):0]	ph	[0:(NSTAGES)];
+	reg		[(NSTAGES):0]	ax;
+	// }}}
+
+	//
+	// Handle the auxilliary logic.
+	// {{{
+	// The auxilliary bit is designed so that you can place a valid bit into
+	// the CORDIC function, and see when it comes out.  While the bit is
+	// allowed to be anything, the requirement of this bit is that it *must*
+	// be aligned with the output when done.  That is, if i_phase is input
+	// together with i_aux, then when o_cos and o_sin are set to its
+	// result, o_aux *must* contain the value that was in i_aux.
+	//
+
+	initial	ax = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		ax <= 0;
+	else if (i_ce)
+		ax <= { ax[(NSTAGES-1):0], i_aux };
+	// }}}
+
+	// Initial vector
+	// {{{
+	// With no input vector, the usual pre-rotation to within +/- 45
+	// degrees, followed by a rotation of +/- 45 degrees, can only
+	// ever produce one of four vectors--one per quadrant.  The gain
+	// of that first rotation, and of every CORDIC stage following,
+	// has already been divided out of START.  The phase left over
+	// is the phase within the quadrant, less 45 degrees.
+	//
+	localparam	signed	[(WW-1):0]	START = 15'h26c9;
+
+	initial begin
+		xv[0] = 0;
+		yv[0] = 0;
+		ph[0] = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		xv[0] <= 0;
+		yv[0] <= 0;
+		ph[0] <= 0;
+	end else if (i_ce)
+	begin
+		// {{{
+		case(i_phase[(PW-1):(PW-2)])
+		2'b00: begin xv[0] <=  START; yv[0] <=  START; end
+		2'b01: begin xv[0] <= -START; yv[0] <=  START; end
+		2'b10: begin xv[0] <= -START; yv[0] <= -START; end
+		2'b11: begin xv[0] <=  START; yv[0] <= -START; end
+		endcase
+
+		ph[0] <= { {(3){!i_phase[PW-3]}}, i_phase[(PW-4):0] };
+		// }}}
+	end
+	// }}}
+	// Cordic angle table
+	// {{{
+	// In many ways, the key to this whole algorithm lies in the angles
+	// necessary to do this.  These angles are also our basic reason for
+	// building this CORDIC in C++: Verilog just can't parameterize this
+	// much.  Further, these angle's risk becoming unsupportable magic
+	// numbers, hence we define these and set them in C++, based upon
+	// the needs of our problem, specifically the number of stages and
+	// the number of bits required in our phase accumulator
+	//
+	wire	[18:0]	cordic_angle [0:(NSTAGES-1)];
+
+	assign	cordic_angle[ 0] = 19'h0_9720; //  26.565051 deg
+	assign	cordic_angle[ 1] = 19'h0_4fd9; //  14.036243 deg
+	assign	cordic_angle[ 2] = 19'h0_2888; //   7.125016 deg
+	assign	cordic_angle[ 3] = 19'h0_1458; //   3.576334 deg
+	assign	cordic_angle[ 4] = 19'h0_0a2e; //   1.789911 deg
+	assign	cordic_angle[ 5] = 19'h0_0517; //   0.895174 deg
+	assign	cordic_angle[ 6] = 19'h0_028b; //   0.447614 deg
+	assign	cordic_angle[ 7] = 19'h0_0145; //   0.223811 deg
+	assign	cordic_angle[ 8] = 19'h0_00a2; //   0.111906 deg
+	assign	cordic_angle[ 9] = 19'h0_0051; //   0.055953 deg
+	assign	cordic_angle[10] = 19'h0_0028; //   0.027976 deg
+	assign	cordic_angle[11] = 19'h0_0014; //   0.013988 deg
+	assign	cordic_angle[12] = 19'h0_000a; //   0.006994 deg
+	assign	cordic_angle[13] = 19'h0_0005; //   0.003497 deg
+	assign	cordic_angle[14] = 19'h0_0002; //   0.001749 deg
+	// {{{
+	// Std-Dev    : 0.00 (Units)
+	// Phase Quantization: 0.000030 (Radians)
+	// Gain is 1.164435
+	// You can annihilate this gain by multiplying by 32'hdbd95b17
+	// and right shifting by 32 bits.
+	// }}}
+	// }}}
+
+	// CORDIC rotations
+	// {{{
+	genvar	i;
+	generate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops
+		initial begin
+			xv[i+1] = 0;
+			yv[i+1] = 0;
+			ph[i+1] = 0;
+		end
+
+		always @(posedge i_clk)
+	if (i_reset)
+		begin
+			// {{{
+			xv[i+1] <= 0;
+			yv[i+1] <= 0;
+			ph[i+1] <= 0;
+			// }}}
+		end else if (i_ce)
+		begin
+			// {{{
+			if ((cordic_angle[i] == 0)||(i >= WW))
+			begin // Do nothing but move our outputs
+			// forward one stage, since we have more
+			// stages than valid data
+				// {{{
+				xv[i+1] <= xv[i];
+				yv[i+1] <= yv[i];
+				ph[i+1] <= ph[i];
+				// }}}
+			end else if (ph[i][(PW-1)]) // Negative phase
+			begin
+				// {{{
+				// If the phase is negative, rotate by the
+				// CORDIC angle in a clockwise direction.
+				xv[i+1] <= xv[i] + (yv[i]>>>(i+1));
+				yv[i+1] <= yv[i] - (xv[i]>>>(i+1));
+				ph[i+1] <= ph[i] + cordic_angle[i];
+				// }}}
+			end else begin
+				// {{{
+				// On the other hand, if the phase is
+				// positive ... rotate in the
+				// counter-clockwise direction
+				xv[i+1] <= xv[i] - (yv[i]>>>(i+1));
+				yv[i+1] <= yv[i] + (xv[i]>>>(i+1));
+				ph[i+1] <= ph[i] - cordic_angle[i];
+				// }}}
+			end
+			// }}}
+		end
+	end endgenerate
+	// }}}
+
+	// Round our result towards even
+	// {{{
+	wire	[(WW-1):0]	pre_cos, pre_sin;
+
+	assign	pre_cos = xv[NSTAGES] + $signed({ {(OW){1'b0}},
+				xv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!xv[NSTAGES][WW-OW]}} });
+	assign	pre_sin = yv[NSTAGES] + $signed({ {(OW){1'b0}},
+				yv[NSTAGES][(WW-OW)],
+				{(WW-OW-1){!yv[NSTAGES][WW-OW]}} });
+
+
+	initial begin
+		o_cos = 0;
+		o_sin = 0;
+		o_aux = 0;
+	end
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		o_cos <= 0;
+		o_sin <= 0;
+		o_aux <= 0;
+	end else if (i_ce)
+	begin
+		o_cos <= pre_cos[(WW-1):(WW-OW)];
+		o_sin <= pre_sin[(WW-1):(WW-OW)];
+		o_aux <= ax[NSTAGES];
+	end
+	// }}}
+	// Make Verilator happy with pre_cos and pre_sin
+	// {{{
+	// verilator lint_off UNUSED
+	wire	unused_val;
+	assign	unused_val = &{ 1'b0, 
+		pre_cos[(WW-OW-1):0],
+		pre_sin[(WW-OW-1):0]
+		};
+	// }}}
+	// verilator lint_on UNUSED
+endmodule
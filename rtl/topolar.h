@@ -43,12 +43,14 @@
 // }}}
 #ifndef	TOPOLAR_H
 #define	TOPOLAR_H
+const int	NLANES = 1;
 const int	IW = 13;
 const int	OW = 13;
 const int	NEXTRA = 4;
 const int	WW = 21;
 const int	PW = 21;
 const int	NSTAGES = 18;
+const int	LATENCY = 20;	// Clocks from i_ce to output
 const double	QUANTIZATION_VARIANCE = 0.1964179315931617; // (Units^2)
 const double	PHASE_VARIANCE_RAD = 0.0000000000669195; // (Radians^2)
 const double	GAIN = 0.8233801290585359;
@@ -56,4 +58,94 @@ const bool	HAS_RESET = true;
 const bool	HAS_AUX   = true;
 #define	HAS_RESET_WIRE
 #define	HAS_AUX_WIRES
+
+// Bit-exact model
+// {{{
+// The following duplicates, in integer arithmetic, the logic of the core
+// above: the same quadrant pre-rotation, the same truncated CORDIC angles,
+// the same vectoring decisions, and the same round-towards-even magnitude.
+// Given the same inputs, topolar_model() will return exactly what the core
+// will produce on o_mag and o_phase LATENCY clocks later.
+//
+#define	HAS_TOPOLAR_MODEL
+
+static const unsigned long	TOPOLAR_ANGLE[18] = {
+	0x025c80, 0x013f67, 0x00a222, 0x005161,
+	0x0028ba, 0x00145e, 0x000a2f, 0x000517,
+	0x00028b, 0x000145, 0x0000a2, 0x000051,
+	0x000028, 0x000014, 0x00000a, 0x000005,
+	0x000002, 0x000001
+};
+
+// Sign extend the bottom w bits of v
+static inline long	topolar_sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+
+static inline void	topolar_model(long i_xval, long i_yval,
+		long &o_mag, unsigned long &o_phase) {
+	const	unsigned long	PMSK = (1ul << PW) - 1;
+	long		ex, ey, xv, yv;
+	unsigned long	ph;
+
+	// Sign extend our inputs to the working width
+	ex = topolar_sext(i_xval, IW) * (1l << (WW-IW-2));
+	ey = topolar_sext(i_yval, IW) * (1l << (WW-IW-2));
+
+	// Pre-CORDIC rotation, to within +/- 45 degrees
+	switch(((i_xval >> (IW-1))&1)*2 + ((i_yval >> (IW-1))&1)) {
+	case 1:	// Rotate by -315 degrees
+		xv =  ex - ey; yv =  ex + ey;
+		ph = 7ul << (PW-3);
+		break;
+	case 2:	// Rotate by -135 degrees
+		xv = -ex + ey; yv = -ex - ey;
+		ph = 3ul << (PW-3);
+		break;
+	case 3:	// Rotate by -225 degrees
+		xv = -ex - ey; yv =  ex - ey;
+		ph = 5ul << (PW-3);
+		break;
+	default:	// Rotate by -45 degrees
+		xv =  ex + ey; yv = -ex + ey;
+		ph = 1ul << (PW-3);
+		break;
+	}
+
+	xv = topolar_sext(xv, WW);
+	yv = topolar_sext(yv, WW);
+
+	// CORDIC rotations
+	for(int k=0; k<NSTAGES; k++) {
+		long	dx, dy;
+
+		if ((TOPOLAR_ANGLE[k] == 0)||(k >= WW))
+			continue;
+
+		dx = xv >> (k+1);
+		dy = yv >> (k+1);
+		if (yv < 0) {
+			// Below the axis, rotate counter-clockwise
+			xv = topolar_sext(xv - dy, WW);
+			yv = topolar_sext(yv + dx, WW);
+			ph = (ph - TOPOLAR_ANGLE[k]) & PMSK;
+		} else {
+			// Above the axis, rotate clockwise
+			xv = topolar_sext(xv + dy, WW);
+			yv = topolar_sext(yv - dx, WW);
+			ph = (ph + TOPOLAR_ANGLE[k]) & PMSK;
+		}
+	}
+
+	// Round towards even, then drop the extra bits
+	if ((xv >> (WW-OW)) & 1)
+		xv += (1l << (WW-OW-1));
+	else
+		xv += (1l << (WW-OW-1)) - 1;
+	xv = topolar_sext(xv, WW);
+
+	o_mag   = xv >> (WW-OW);
+	o_phase = ph;
+}
+// }}}
 #endif	// TOPOLAR_H
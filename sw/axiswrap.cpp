@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/axiswrap.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Wraps any of the generated cores in an AXI-Stream interface,
+//		with valid/ready handshaking on both sides.  The core itself
+//	always runs.  Results are instead caught in an output FIFO deep enough
+//	to hold everything the core might still produce, and the input only
+//	accepts a new sample while the FIFO has room for it.  Hence, an
+//	intermittent stall on the output costs no throughput, and a stall
+//	longer than the FIFO is deep only stalls the input.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "axiswrap.h"
+
+// axis_fields
+// {{{
+// Connects each field of a core port list to its slice of a packed bus
+static	int	axis_fields(FILE *fp, const char *bus, int nports,
+			const AXISPORT *ports) {
+	int	lsb = 0;
+
+	for(int k=0; k<nports; k++) {
+		fprintf(fp, "\t\t.%s(%s[%d:%d]),\n", ports[k].m_name, bus,
+			lsb + ports[k].m_width-1, lsb);
+		lsb += ports[k].m_width;
+	}
+
+	return lsb;
+}
+// }}}
+
+// axis_lgfifo
+// {{{
+int	axis_lgfifo(bool sequential, int latency) {
+	int	lgfifo;
+
+	// A result occupies a credit from the clock after it is accepted
+	// until the clock after it leaves the FIFO, or latency+1 clocks.
+	// s_ready, however, is registered: it can't see a credit returned on
+	// the same clock another is taken, and so drops one clock early
+	// whenever the FIFO would otherwise fill.  The core can only run at
+	// full speed, then, if the FIFO can hold latency+2 results.  The
+	// sequential cores have at most one result in flight, and so need
+	// only one more slot to start the next while the last one waits.
+	if (sequential)
+		lgfifo = 1;
+	else
+		lgfifo = nextlg((unsigned)latency+2);
+	if (lgfifo < 1)
+		lgfifo = 1;
+
+	return lgfifo;
+}
+// }}}
+
+void	axiswrap(FILE *fp, const char *fname, bool sequential, int latency,
+		int nin, const AXISPORT *inputs,
+		int nout, const AXISPORT *outputs,
+		bool with_reset, bool async_reset) {
+	// {{{
+	char	*name;
+	int	idw = 0, odw = 0, lgfifo;
+
+	name = modulename(fname);
+	for(int k=0; k<nin; k++)
+		idw += inputs[k].m_width;
+	for(int k=0; k<nout; k++)
+		odw += outputs[k].m_width;
+
+	lgfifo = axis_lgfifo(sequential, latency);
+
+	std::string	resetw = (!with_reset) ? ""
+				: (async_reset) ? "i_areset_n":"i_reset";
+	std::string	always_reset;
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+			"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+			"\tif (i_reset)\n";
+	else
+		always_reset = "\talways @(posedge i_clk)\n\t";
+
+	// Module declaration
+	// {{{
+	fprintf(fp,
+"\n"
+"////////////////////////////////////////////////////////////////////////////////\n"
+"//\n"
+"// AXI-Stream wrapper\n"
+"// {{{\n"
+"// Fields are packed into TDATA in the order they appear on the core, the\n"
+"// first in the least significant bits:\n");
+	for(int k=0, lsb=0; k<nin; k++) {
+		fprintf(fp, "//\tS_AXIS_TDATA[%d:%d]\t%s\n",
+			lsb+inputs[k].m_width-1, lsb, inputs[k].m_name);
+		lsb += inputs[k].m_width;
+	} for(int k=0, lsb=0; k<nout; k++) {
+		fprintf(fp, "//\tM_AXIS_TDATA[%d:%d]\t%s\n",
+			lsb+outputs[k].m_width-1, lsb, outputs[k].m_name);
+		lsb += outputs[k].m_width;
+	}
+	fprintf(fp,
+"//\n"
+"////////////////////////////////////////////////////////////////////////////////\n"
+"// }}}\n"
+"module	%s_axis #(\n"
+"\t\t// {{{\n"
+"\t\tlocalparam\tIDW = %d,\t// Bits in S_AXIS_TDATA\n"
+"\t\t\t\tODW = %d,\t// Bits in M_AXIS_TDATA\n"
+"\t\t\t\tLGFIFO = %d\t// Log_2 of the output FIFO depth\n"
+"\t\t// }}}\n"
+"\t) (\n"
+"\t\t// {{{\n"
+"\t\tinput\twire\t\t\ti_clk%s%s,\n"
+"\t\t//\n"
+"\t\tinput\twire\t\t\tS_AXIS_TVALID,\n"
+"\t\toutput\twire\t\t\tS_AXIS_TREADY,\n"
+"\t\tinput\twire\t[(IDW-1):0]\tS_AXIS_TDATA,\n"
+"\t\t//\n"
+"\t\toutput\twire\t\t\tM_AXIS_TVALID,\n"
+"\t\tinput\twire\t\t\tM_AXIS_TREADY,\n"
+"\t\toutput\twire\t[(ODW-1):0]\tM_AXIS_TDATA\n"
+"\t\t// }}}\n"
+"\t);\n\n",
+		name, idw, odw, lgfifo,
+		(with_reset) ? ", ":"", resetw.c_str());
+	// }}}
+
+	// Declarations
+	// {{{
+	fprintf(fp,
+"\t// Local declarations\n"
+"\t// {{{\n"
+"\tlocalparam\tDEPTH = (1<<LGFIFO);\n"
+"\n"
+"\twire\t\t\ts_accept, m_accept, core_valid;\n"
+"\twire\t[(ODW-1):0]\tcore_data;\n"
+"\treg\t[LGFIFO:0]\tcredits_used;\n"
+"\treg\t\t\ts_ready;\n"
+"\treg\t[(ODW-1):0]\tfifo\t[0:(DEPTH-1)];\n"
+"\treg\t[LGFIFO:0]\twr_addr, rd_addr;\n");
+	if (sequential)
+		fprintf(fp, "\twire\t\t\tcore_busy;\n");
+	fprintf(fp,
+"\n"
+"\tassign\ts_accept = S_AXIS_TVALID && S_AXIS_TREADY;\n"
+"\tassign\tm_accept = M_AXIS_TVALID && M_AXIS_TREADY;\n"
+"\t// }}}\n\n");
+	// }}}
+
+	// The core itself
+	// {{{
+	fprintf(fp,
+"\t// The core\n"
+"\t// {{{\n");
+	if (sequential)
+		fprintf(fp,
+"\t// The core starts on every accepted sample, and marks its result with\n"
+"\t// o_done.\n");
+	else
+		fprintf(fp,
+"\t// The core is never stalled.  Instead, the aux bit marks which of its\n"
+"\t// outputs hold accepted samples.\n");
+	fprintf(fp,
+"\t%s\n"
+"\tu_core (\n"
+"\t\t.i_clk(i_clk),\n", name);
+	if (with_reset)
+		fprintf(fp, "\t\t.%s(%s),\n", resetw.c_str(), resetw.c_str());
+	if (sequential)
+		fprintf(fp, "\t\t.i_stb(s_accept),\n");
+	else
+		fprintf(fp, "\t\t.i_ce(1\'b1), .i_aux(s_accept),\n");
+	axis_fields(fp, "S_AXIS_TDATA", nin, inputs);
+	axis_fields(fp, "core_data", nout, outputs);
+	if (sequential)
+		fprintf(fp, "\t\t.o_busy(core_busy), .o_done(core_valid)\n");
+	else
+		fprintf(fp, "\t\t.o_aux(core_valid)\n");
+	fprintf(fp, "\t);\n\t// }}}\n\n");
+	// }}}
+
+	// Credits, and S_AXIS_TREADY
+	// {{{
+	fprintf(fp,
+"\t// credits_used, s_ready\n"
+"\t// {{{\n"
+"\t// Every accepted sample holds one FIFO slot, from the time it is\n"
+"\t// accepted through the core until it is read from the FIFO.  Since the\n"
+"\t// FIFO is never asked to hold more than it can, it never overflows,\n"
+"\t// and the core never needs to be stalled.\n"
+"\tinitial\tcredits_used = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tcredits_used <= 0;\n\telse ");
+	fprintf(fp,
+"case({ s_accept, m_accept })\n"
+"\t2\'b10: credits_used <= credits_used + 1;\n"
+"\t2\'b01: credits_used <= credits_used - 1;\n"
+"\tdefault: begin end\n"
+"\tendcase\n\n"
+"\tinitial\ts_ready = 1\'b1;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\ts_ready <= 1\'b1;\n\telse ");
+	fprintf(fp,
+"case({ s_accept, m_accept })\n"
+"\t2\'b10: s_ready <= (credits_used < DEPTH-1);\n"
+"\t2\'b01: s_ready <= 1\'b1;\n"
+"\tdefault: begin end\n"
+"\tendcase\n\n");
+	if (sequential)
+		fprintf(fp, "\tassign\tS_AXIS_TREADY = s_ready && !core_busy;\n");
+	else
+		fprintf(fp, "\tassign\tS_AXIS_TREADY = s_ready;\n");
+	fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	// The output FIFO
+	// {{{
+	fprintf(fp,
+"\t// Output FIFO\n"
+"\t// {{{\n"
+"\talways @(posedge i_clk)\n"
+"\tif (core_valid)\n"
+"\t\tfifo[wr_addr[(LGFIFO-1):0]] <= core_data;\n\n"
+"\tinitial\twr_addr = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\twr_addr <= 0;\n\telse ");
+	fprintf(fp,
+"if (core_valid)\n"
+"\t\twr_addr <= wr_addr + 1;\n\n"
+"\tinitial\trd_addr = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\trd_addr <= 0;\n\telse ");
+	fprintf(fp,
+"if (m_accept)\n"
+"\t\trd_addr <= rd_addr + 1;\n\n"
+"\tassign\tM_AXIS_TVALID = (wr_addr != rd_addr);\n"
+"\tassign\tM_AXIS_TDATA  = fifo[rd_addr[(LGFIFO-1):0]];\n"
+"\t// }}}\n"
+"endmodule\n");
+	// }}}
+
+	free(name);
+	// }}}
+}
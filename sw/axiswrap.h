@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/axiswrap.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Wraps any of the generated cores in an AXI-Stream interface,
+//		with valid/ready handshaking on both sides.  The core itself
+//	always runs.  Results are instead caught in an output FIFO deep enough
+//	to hold everything the core might still produce, and the input only
+//	accepts a new sample while the FIFO has room for it.  Hence, an
+//	intermittent stall on the output costs no throughput, and a stall
+//	longer than the FIFO is deep only stalls the input.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	AXISWRAP_H
+#define	AXISWRAP_H
+
+#include <stdio.h>
+
+// AXISPORT
+// {{{
+// One field of the core's input or output.  Fields are packed into TDATA in
+// the order given, the first in the least significant bits.
+typedef	struct	AXISPORT_S {
+	const char	*m_name;	// Port name on the core, i.e. "i_xval"
+	int		m_width;	// Port width, across all lanes
+} AXISPORT;
+// }}}
+
+// axiswrap()
+// {{{
+// Appends a module named <core>_axis to fp, wrapping the core in fname.  For
+// pipelined cores, latency is the number of clocks from i_ce to the output,
+// and the core must have been built with an aux bit, which is used to track
+// which outputs are valid.  The sequential cores are instead driven by i_stb,
+// and report their results with o_done.
+// }}}
+extern	void	axiswrap(FILE *fp, const char *fname, bool sequential,
+			int latency,
+			int nin, const AXISPORT *inputs,
+			int nout, const AXISPORT *outputs,
+			bool with_reset, bool async_reset);
+
+// axis_lgfifo()
+// {{{
+// Returns the log_2 of the output FIFO depth axiswrap() will use: the
+// smallest FIFO that still lets the core accept a new sample every clock
+// while M_AXIS_TREADY is held high.
+// }}}
+extern	int	axis_lgfifo(bool sequential, int latency);
+
+#endif	// AXISWRAP_H
@@ -37,6 +37,7 @@
 //
 // }}}
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <string.h>
 #include <string>
@@ -47,11 +48,206 @@
 #include "cordiclib.h"
 #include "basiccordic.h"
 
-void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+static	void	basiccordic_model(FILE *fhp, int nstages, int iw, int ow, int ww,
+		int phase_bits, bool radix4, bool unit_gain) {
+	// {{{
+	int	nr4 = (radix4) ? radix4_stages(nstages, ww, phase_bits) : 0;
+
+	assert(ww < 64);
+	assert(phase_bits < 64);
+
+	fprintf(fhp,
+"\n"
+"// Bit-exact model\n"
+"// {{{\n"
+"// The following duplicates, in integer arithmetic, the logic of the core\n"
+"// above: the same octant pre-rotation, the same truncated CORDIC angles,\n"
+"// the same shifts, and the same round-towards-even output stage.  Given\n"
+"// the same inputs, cordic_model() will return exactly what the core will\n"
+"// produce on o_xval and o_yval LATENCY clocks later.\n"
+"//\n"
+"#define\tHAS_CORDIC_MODEL\n\n");
+
+	if (unit_gain)
+		fprintf(fhp, "static const unsigned long\tGAIN_COMP = 0x%lxul;\n\n",
+			gain_coefficient((nr4 > 0)
+				? radix4_gain(nstages, ww, phase_bits)
+				: cordic_gain(nstages), ww));
+
+	fprintf(fhp, "static const unsigned long\tCORDIC_ANGLE[%d] = {", nstages);
+	for(int k=0; k<nstages; k++) {
+		fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+			(0 == (k%4)) ? "\n\t" : " ",
+			(phase_bits+3)/4, cordic_angle(k, phase_bits));
+	} fprintf(fhp, "\n};\n\n");
+
+	if (nr4 > 0) {
+		// {{{
+		int	s0 = radix4_start(ww);
+
+		fprintf(fhp, "static const unsigned long\tCORDIC_ANGLE4[%d] = {",
+			2*nr4);
+		for(int k=0; k<2*nr4; k++) {
+			fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+				(0 == (k%4)) ? "\n\t" : " ",
+				(phase_bits+3)/4,
+				radix4_angle(s0+2*(k/2), 1+(k&1), phase_bits));
+		} fprintf(fhp, "\n};\n\n");
+
+		fprintf(fhp, "static const unsigned long\tCORDIC_THRESH4[%d] = {",
+			2*nr4);
+		for(int k=0; k<2*nr4; k++) {
+			unsigned long	a1 = radix4_angle(s0+2*(k/2), 1, phase_bits),
+					a2 = radix4_angle(s0+2*(k/2), 2, phase_bits);
+
+			fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+				(0 == (k%4)) ? "\n\t" : " ",
+				(phase_bits+3)/4, (k&1) ? (a1+a2)/2 : a1/2);
+		} fprintf(fhp, "\n};\n\n");
+		// }}}
+	}
+
+	fprintf(fhp,
+"// Sign extend the bottom w bits of v\n"
+"static inline long\tcordic_sext(unsigned long v, int w) {\n"
+"\treturn ((long)(v << (64-w))) >> (64-w);\n"
+"}\n\n");
+
+	fprintf(fhp,
+"static inline void\tcordic_model(long i_xval, long i_yval,\n"
+"\t\tunsigned long i_phase, long &o_xval, long &o_yval) {\n"
+"\tconst\tunsigned long	PMSK = (1ul << PW) - 1;\n"
+"\tlong\t\txv, yv, tmp;\n"
+"\tunsigned long\tph;\n"
+"\n"
+"\t// Sign extend our inputs to the working width\n"
+"\txv = cordic_sext(i_xval, IW) * (1l << (WW-IW-1));\n"
+"\tyv = cordic_sext(i_yval, IW) * (1l << (WW-IW-1));\n"
+"\tph = i_phase & PMSK;\n"
+"\n"
+"\t// Pre-CORDIC rotation, to within +/- 45 degrees\n"
+"\tswitch((ph >> (PW-3)) & 7) {\n"
+"\tcase 1: case 2:\t// 45 .. 135\n"
+"\t\ttmp = xv; xv = -yv; yv = tmp;\n"
+"\t\tph -= (1ul << (PW-2));\n"
+"\t\tbreak;\n"
+"\tcase 3: case 4:\t// 135 .. 225\n"
+"\t\txv = -xv; yv = -yv;\n"
+"\t\tph -= (2ul << (PW-2));\n"
+"\t\tbreak;\n"
+"\tcase 5: case 6:\t// 225 .. 315\n"
+"\t\ttmp = xv; xv = yv; yv = -tmp;\n"
+"\t\tph -= (3ul << (PW-2));\n"
+"\t\tbreak;\n"
+"\tdefault:\t// 315 .. 45, no change\n"
+"\t\tbreak;\n"
+"\t}\n"
+"\n"
+"\txv = cordic_sext(xv, WW);\n"
+"\tyv = cordic_sext(yv, WW);\n"
+"\tph &= PMSK;\n"
+"\n"
+"\t// CORDIC rotations\n"
+"\tfor(int k=0; k<%s; k++) {\n"
+"\t\tlong\tdx, dy;\n"
+"\n"
+"\t\tif ((CORDIC_ANGLE[k] == 0)||(k >= WW))\n"
+"\t\t\tcontinue;\n"
+"\n"
+"\t\tdx = xv >> (k+1);\n"
+"\t\tdy = yv >> (k+1);\n"
+"\t\tif ((ph >> (PW-1))&1) {\n"
+"\t\t\t// Negative phase, rotate clockwise\n"
+"\t\t\txv = cordic_sext(xv + dy, WW);\n"
+"\t\t\tyv = cordic_sext(yv - dx, WW);\n"
+"\t\t\tph = (ph + CORDIC_ANGLE[k]) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\t// Positive phase, rotate counter-clockwise\n"
+"\t\t\txv = cordic_sext(xv - dy, WW);\n"
+"\t\t\tyv = cordic_sext(yv + dx, WW);\n"
+"\t\t\tph = (ph - CORDIC_ANGLE[k]) & PMSK;\n"
+"\t\t}\n"
+"\t}\n"
+"\n", (nr4 > 0) ? "NR2" : "NSTAGES");
+
+	if (nr4 > 0) {
+		fprintf(fhp,
+"\t// Radix-4 rotations, each by atan(d*2^-sh) for d in {-2..2}\n"
+"\tfor(int k=0; k<NR4; k++) {\n"
+"\t\tconst\tint\tsh = R4_SHIFT0 + 2*k;\n"
+"\t\tlong\tsph = cordic_sext(ph, PW), dx, dy;\n"
+"\t\tint\td;\n"
+"\n"
+"\t\tif (sph >= (long)CORDIC_THRESH4[2*k+1])\n"
+"\t\t\td = 2;\n"
+"\t\telse if (sph >= (long)CORDIC_THRESH4[2*k])\n"
+"\t\t\td = 1;\n"
+"\t\telse if (sph > -(long)CORDIC_THRESH4[2*k])\n"
+"\t\t\td = 0;\n"
+"\t\telse if (sph > -(long)CORDIC_THRESH4[2*k+1])\n"
+"\t\t\td = -1;\n"
+"\t\telse\n"
+"\t\t\td = -2;\n"
+"\n"
+"\t\tif (d == 0)\n"
+"\t\t\tcontinue;\n"
+"\n"
+"\t\tdx = xv >> ((d == 2 || d == -2) ? sh-1 : sh);\n"
+"\t\tdy = yv >> ((d == 2 || d == -2) ? sh-1 : sh);\n"
+"\t\tif (d > 0) {\n"
+"\t\t\txv = cordic_sext(xv - dy, WW);\n"
+"\t\t\tyv = cordic_sext(yv + dx, WW);\n"
+"\t\t\tph = (ph - CORDIC_ANGLE4[2*k+d-1]) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\txv = cordic_sext(xv + dy, WW);\n"
+"\t\t\tyv = cordic_sext(yv - dx, WW);\n"
+"\t\t\tph = (ph + CORDIC_ANGLE4[2*k-d-1]) & PMSK;\n"
+"\t\t}\n"
+"\t}\n"
+"\n");
+	}
+
+	if (unit_gain)
+		fprintf(fhp,
+"\t// Gain compensation, rounded back to the working width\n"
+"\txv = cordic_sext((long)(((__int128)xv * GAIN_COMP\n"
+"\t\t\t+ ((__int128)1 << (WW-1))) >> WW), WW);\n"
+"\tyv = cordic_sext((long)(((__int128)yv * GAIN_COMP\n"
+"\t\t\t+ ((__int128)1 << (WW-1))) >> WW), WW);\n"
+"\n");
+
+	if (ww > ow+1) {
+		fprintf(fhp,
+"\t// Round towards even, then drop the extra bits\n"
+"\tif ((xv >> (WW-OW)) & 1)\n"
+"\t\txv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\txv += (1l << (WW-OW-1)) - 1;\n"
+"\tif ((yv >> (WW-OW)) & 1)\n"
+"\t\tyv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\tyv += (1l << (WW-OW-1)) - 1;\n"
+"\txv = cordic_sext(xv, WW);\n"
+"\tyv = cordic_sext(yv, WW);\n\n");
+	} else
+		fprintf(fhp,
+"\t// No rounding required\n");
+
+	fprintf(fhp,
+"\to_xval = xv >> (WW-OW);\n"
+"\to_yval = yv >> (WW-OW);\n"
+"}\n"
+"// }}}\n");
+	// }}}
+}
+
+int	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		int nstages, int iw, int ow, int nxtra,
 		int phase_bits,
-		bool with_reset, bool with_aux, bool async_reset) {
-	int	working_width = iw;
+		bool with_reset, bool with_aux, bool async_reset, int lanes,
+		int regs, bool radix4, bool unit_gain) {
+	int	working_width = iw, nregs, nr2 = nstages, nr4 = 0;
+	double	gain;
 	const	char *name;
 	const	char PURPOSE[] =
 	"This file executes a vector rotation on the values\n"
@@ -72,6 +268,61 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		working_width = ow;
 	working_width += nxtra;
 
+	// A stage whose angle rounds to zero, or whose shift would clear the
+	// working width, only ever passes its inputs along.  Such stages can
+	// only come at the end, so drop them.
+	nstages = active_stages(nstages, working_width, phase_bits);
+	nr2 = nstages;
+
+	// With more than one CORDIC stage between registers, the pipeline
+	// holds only nregs registered stages.  Throughout, depth names the
+	// last of these.
+	if (regs < 1)
+		regs = 1;
+	nregs = (nstages + regs - 1) / regs;
+
+	// A radix-4 core follows its first nr2 radix-2 stages with nr4
+	// radix-4 ones.  If there's no room for any radix-4 stages, it's
+	// just a radix-2 core.
+	if (radix4) {
+		nr4 = radix4_stages(nstages, working_width, phase_bits);
+		if (nr4 > 0) {
+			nr2 = radix2_stages(nstages, working_width);
+			nregs = nr2 + nr4;
+		} else
+			radix4 = false;
+	}
+
+	const	char	*depth = (regs > 1) ? "NREGS"
+				: (radix4) ? "NPIPE" : "NSTAGES";
+
+	gain = (radix4) ? radix4_gain(nstages, working_width, phase_bits)
+			: cordic_gain(nstages);
+
+	// Gain compensation takes one more clock.  The rounding stage then
+	// reads from its registers, rather than the last CORDIC stage, and the
+	// aux pipeline grows by one.
+	std::string	xsrc = std::string("xv[") + depth + "]",
+			ysrc = std::string("yv[") + depth + "]",
+			axdepth = depth;
+	if (unit_gain)
+		axdepth += "+1";
+	std::string	regparams = "";
+	if (regs > 1) {
+		char	buf[128];
+		sprintf(buf, "\t\t\tNREGS=%2d,\t// Registered CORDIC stages\n"
+			"\t\t\tREGS_EVERY=%2d,\t// CORDIC stages per register\n",
+			nregs, regs);
+		regparams = buf;
+	} else if (radix4) {
+		char	buf[160];
+		sprintf(buf, "\t\t\tNR2=%2d,\t// Radix-2 stages\n"
+			"\t\t\tNR4=%2d,\t// Radix-4 stages, following them\n"
+			"\t\t\tNPIPE=%2d,\t// Registered CORDIC stages\n",
+			nr2, nr4, nregs);
+		regparams = buf;
+	}
+
 	std::string	resetw = (!with_reset)?""
 			: ((async_reset)?"i_areset_n" : "i_reset");
 	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
@@ -84,13 +335,53 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 
 	name = modulename(fname);
 
+	// With more than one lane, the datapath is first written into a
+	// buffer, and then copied into a generate block covering every lane.
+	// The angle table and the aux pipeline are shared by all lanes.
+	FILE	*dp = fp;
+	char	*dpbuf = NULL;
+	size_t	dplen = 0;
+	bool	lane_aux = (with_aux)&&(lanes <= 1);
+
+	if (lanes > 1) {
+		dp = open_memstream(&dpbuf, &dplen);
+		assert(dp);
+	}
+
 	fprintf(fp, "`default_nettype\tnone\n");
+	if (lanes > 1) {
+		// {{{
+		fprintf(fp,
+		"module	%s#(\n"
+		"\t\t// {{{\n"
+		"\tlocalparam\tNLANES=%2d,\t// Samples processed per clock\n"
+		"\t\t\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\n%s"
+		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d\t// Bits in our phase variables\n"
+		"\t\t// }}}\n"
+		"\t) (\n"
+		"\t\t// {{{\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce,\n"
+		"\t// Lane k occupies bits [k*IW +: IW] of i_xval and i_yval,\n"
+		"\t// bits [k*PW +: PW] of i_phase, and so on.\n"
+		"\tinput\twire\tsigned\t[(NLANES*IW-1):0]\ti_xval, i_yval,\n"
+		"\tinput\twire\t\t[(NLANES*PW-1):0]\ti_phase,\n"
+		"\toutput\twire\tsigned\t[(NLANES*OW-1):0]\to_xval, o_yval%s\n",
+		name, lanes,
+		iw, ow, nstages, regparams.c_str(), nxtra,
+		working_width, phase_bits,
+		resetw.c_str(), (with_reset)?", ":"", (with_aux)?",":"");
+		// }}}
+	} else
 	fprintf(fp,
 		"module	%s#(\n"
 		"\t\t// {{{\n"
 		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
 		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
-		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\tNSTAGES=%2d,\n%s"
 		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
 		"\t\t\tWW=%2d,\t// Our working bit-width\n"
 		"\t\t\tPW=%2d\t// Bits in our phase variables\n"
@@ -102,7 +393,8 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\tinput\twire\t\t[(PW-1):0]\t\t\ti_phase,\n"
 		"\toutput\treg\tsigned\t[(OW-1):0]\to_xval, o_yval%s\n",
 		name,
-		iw, ow, nstages, nxtra, working_width, phase_bits,
+		iw, ow, nstages, regparams.c_str(), nxtra,
+		working_width, phase_bits,
 		resetw.c_str(), (with_reset)?", ":"", (with_aux)?",":"");
 
 	if (with_aux) {
@@ -111,19 +403,22 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 			"\toutput\treg\t\t\t\to_aux\n");
 	} fprintf(fp, "\t\t// }}}\n\t);\n\n");
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t// Declare variables for all of the separate stages\n"
 		"\t// {{{\n"
 		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n"
-		"\treg	signed	[(WW-1):0]\txv\t[0:(NSTAGES)];\n"
-		"\treg	signed	[(WW-1):0]\tyv\t[0:(NSTAGES)];\n"
-		"\treg		[(PW-1):0]\tph\t[0:(NSTAGES)];\n");
-	if (with_aux)
-		fprintf(fp, "\treg\t\t[(NSTAGES):0]\tax;\n");
-	fprintf(fp,
+		"\treg	signed	[(WW-1):0]\txv\t[0:(%s)];\n"
+		"\treg	signed	[(WW-1):0]\tyv\t[0:(%s)];\n"
+		"\treg		[(PW-1):0]\tph\t[0:(%s)];\n",
+		depth, depth, depth);
+	if (lane_aux)
+		fprintf(dp, "\treg\t\t[(%s):0]\tax;\n", axdepth.c_str());
+	fprintf(dp,
 		"\t// }}}\n\n");
+	if ((with_aux)&&(lanes > 1))
+		fprintf(fp, "\treg\t\t[(%s):0]\tax;\n\n", axdepth.c_str());
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t// Sign extend our inputs\n"
 		"\t// {{{\n"
 		"\t// First step: expand our input to our working width.\n"
@@ -135,14 +430,14 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t// \n");
 
 	if (working_width-iw-1 > 0) {
-		fprintf(fp,
+		fprintf(dp,
 			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };\n"
 			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };\n\n");
 	} else {
-		fprintf(fp,
+		fprintf(dp,
 			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval };\n"
 			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval };\n\n");
-	} fprintf(fp, "\t// }}}\n");
+	} fprintf(dp, "\t// }}}\n");
 
 	if (with_aux) {
 		fprintf(fp,
@@ -165,35 +460,35 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 			fprintf(fp,
 				"\t\tax <= 0;\n\telse ");
 		fprintf(fp, "if (i_ce)\n"
-			"\t\tax <= { ax[(NSTAGES-1):0], i_aux };\n"
-			"\t// }}}\n\n");
+			"\t\tax <= { ax[(%s-1):0], i_aux };\n"
+			"\t// }}}\n\n", axdepth.c_str());
 	}
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t// Pre-CORDIC rotation\n"
 		"\t// {{{\n"
 		"\t// First stage, get rid of all but 45 degrees\n"
 		"\t//\tThe resulting phase needs to be between -45 and 45\n"
 		"\t//\t\tdegrees but in units of normalized phase\n");
 
-	fprintf(fp,
+	fprintf(dp,
 		"\tinitial begin\n"
 		"\t\txv[0] = 0;\n"
 		"\t\tyv[0] = 0;\n"
 		"\t\tph[0] = 0;\n"
 		"\tend\n");
 
-	fprintf(fp, "%s", always_reset.c_str());
+	fprintf(dp, "%s", always_reset.c_str());
 
 	if (with_reset)
-		fprintf(fp,
+		fprintf(dp,
 			"\tbegin\n"
 			"\t\txv[0] <= 0;\n"
 			"\t\tyv[0] <= 0;\n"
 			"\t\tph[0] <= 0;\n"
 			"\tend else ");
 
-	fprintf(fp, "if (i_ce)\n"
+	fprintf(dp, "if (i_ce)\n"
 		"\tbegin\n"
 		"\t\t// {{{\n"
 		"\t\t// Walk through all possible quick phase shifts necessary\n"
@@ -202,7 +497,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t// adjustments.\n"
 		"\t\tcase(i_phase[(PW-1):(PW-3)])\n");
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b000: begin	// 0 .. 45, No change\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= e_xval;\n"
@@ -211,7 +506,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\tend\n"
 		"\t\t\t// }}}\n");
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b001: begin	// 45 .. 90\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= -e_yval;\n"
@@ -221,7 +516,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\t// }}}\n",
 			phase_bits, (1ul << (phase_bits-2)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b010: begin	// 90 .. 135\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= -e_yval;\n"
@@ -231,7 +526,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\t// }}}\n",
 			phase_bits, (1ul << (phase_bits-2)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b011: begin	// 135 .. 180\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= -e_xval;\n"
@@ -241,7 +536,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\t// }}}\n",
 			phase_bits, (2ul << (phase_bits-2)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b100: begin	// 180 .. 225\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= -e_xval;\n"
@@ -251,7 +546,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\t// }}}\n",
 			phase_bits, (2ul << (phase_bits-2)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b101: begin	// 225 .. 270\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= e_yval;\n"
@@ -261,7 +556,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\t// }}}\n",
 		phase_bits, (3ul << (phase_bits-2)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b110: begin	// 270 .. 315\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= e_yval;\n"
@@ -271,7 +566,7 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\t// }}}\n",
 		phase_bits, (3ul << (phase_bits-2)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\t3'b111: begin	// 315 .. 360, No change\n"
 		"\t\t// {{{\n"
 		"\t\t\txv[0] <= e_xval;\n"
@@ -280,121 +575,242 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t\tend\n"
 		"\t\t\t// }}}\n");
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t\tendcase\n"
 		"\t\t// }}}\n"
 		"\tend\n"
 		"\t// }}}\n");
 
 	cordic_angles(fp, nstages, phase_bits);
-
-	fprintf(fp,"\n"
-		"\t// CORDIC rotations\n"
-		"\t// {{{\n"
-		"\tgenvar	i;\n"
-		"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops\n");
-	fprintf(fp,
-		"\t\t// Here\'s where we are going to put the actual CORDIC\n"
-		"\t\t// we\'ve been studying and discussing.  Everything up to\n"
-		"\t\t// this point has simply been necessary preliminaries.\n");
-	if (with_reset) {
-		fprintf(fp,
-			"\t\tinitial begin\n"
-			"\t\t\txv[i+1] = 0;\n"
-			"\t\t\tyv[i+1] = 0;\n"
-			"\t\t\tph[i+1] = 0;\n"
-			"\t\tend\n\n\t");
-	}
-	fprintf(fp, "%s", always_reset.c_str());
-	if (with_reset) {
-		fprintf(fp,
+	if (radix4)
+		radix4_angles(fp, nstages, working_width, phase_bits, true);
+	if (regs <= 1)
+		residual_phase_widths(fp, nr2, 0, working_width, phase_bits,
+			(radix4) ? "NR2" : "NSTAGES");
+
+	if (regs > 1) {
+		// {{{
+		fprintf(dp,"\n"
+			"\t// CORDIC rotations\n"
+			"\t// {{{\n"
+			"\t// Each registered stage applies REGS_EVERY CORDIC rotations,\n"
+			"\t// one after the other, before registering the result.\n"
+			"\tgenvar	i, j;\n"
+			"\t%sfor(i=0; i<NREGS; i=i+1) begin : CORDICops\n",
+			(lanes > 1) ? "" : "generate ");
+		fprintf(dp,
+			"\t\twire\tsigned\t[(WW-1):0]\tcx\t[0:REGS_EVERY];\n"
+			"\t\twire\tsigned\t[(WW-1):0]\tcy\t[0:REGS_EVERY];\n"
+			"\t\twire\t\t[(PW-1):0]\tcph\t[0:REGS_EVERY];\n"
+			"\n"
+			"\t\tassign\tcx[0]  = xv[i];\n"
+			"\t\tassign\tcy[0]  = yv[i];\n"
+			"\t\tassign\tcph[0] = ph[i];\n"
+			"\n"
+			"\t\tfor(j=0; j<REGS_EVERY; j=j+1) begin : ITER\n"
+			"\t\t\tlocalparam\tS = i*REGS_EVERY+j;\n"
+			"\n"
+			"\t\t\tif (S >= NSTAGES)\n"
+			"\t\t\tbegin : PASS\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// The last register may be only partially\n"
+			"\t\t\t\t// used, if REGS_EVERY doesn't divide NSTAGES\n"
+			"\t\t\t\tassign\tcx[j+1]  = cx[j];\n"
+			"\t\t\t\tassign\tcy[j+1]  = cy[j];\n"
+			"\t\t\t\tassign\tcph[j+1] = cph[j];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else begin : ROTATE\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// As before, a negative phase rotates\n"
+			"\t\t\t\t// clockwise, a positive one counter-clockwise\n"
+			"\t\t\t\twire\tskip;\n"
+			"\n"
+			"\t\t\t\tassign\tskip = (cordic_angle[S] == 0)||(S >= WW);\n"
+			"\t\t\t\tassign\tcx[j+1] = (skip) ? cx[j]\n"
+			"\t\t\t\t\t: (cph[j][PW-1]) ? (cx[j] + (cy[j]>>>(S+1)))\n"
+			"\t\t\t\t\t: (cx[j] - (cy[j]>>>(S+1)));\n"
+			"\t\t\t\tassign\tcy[j+1] = (skip) ? cy[j]\n"
+			"\t\t\t\t\t: (cph[j][PW-1]) ? (cy[j] - (cx[j]>>>(S+1)))\n"
+			"\t\t\t\t\t: (cy[j] + (cx[j]>>>(S+1)));\n"
+			"\t\t\t\tassign\tcph[j+1] = (skip) ? cph[j]\n"
+			"\t\t\t\t\t: (cph[j][PW-1]) ? (cph[j] + cordic_angle[S])\n"
+			"\t\t\t\t\t: (cph[j] - cordic_angle[S]);\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend\n"
+			"\t\tend\n\n");
+		if (with_reset) {
+			fprintf(dp,
+				"\t\tinitial begin\n"
+				"\t\t\txv[i+1] = 0;\n"
+				"\t\t\tyv[i+1] = 0;\n"
+				"\t\t\tph[i+1] = 0;\n"
+				"\t\tend\n\n\t");
+		}
+		fprintf(dp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(dp,
+				"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tph[i+1] <= 0;\n"
+				"\t\t\t// }}}\n"
+				"\t\tend else ");
+		} else
+			fprintf(dp, "\t\t");
+
+		fprintf(dp,
+			"if (i_ce)\n"
 			"\t\tbegin\n"
 			"\t\t\t// {{{\n"
-			"\t\t\txv[i+1] <= 0;\n"
-			"\t\t\tyv[i+1] <= 0;\n"
-			"\t\t\tph[i+1] <= 0;\n"
+			"\t\t\txv[i+1] <= cx[REGS_EVERY];\n"
+			"\t\t\tyv[i+1] <= cy[REGS_EVERY];\n"
+			"\t\t\tph[i+1] <= cph[REGS_EVERY];\n"
 			"\t\t\t// }}}\n"
-			"\t\tend else ");
-	} else
-		fprintf(fp, "\t\t");
+			"\t\tend\n"
+			"\tend%s\n\t// }}}\n\n",
+			(lanes > 1) ? "" : " endgenerate");
+		// }}}
+	} else {
+		// {{{
+		fprintf(dp,"\n"
+			"\t// CORDIC rotations\n"
+			"\t// {{{\n"
+			"\tgenvar	i;\n"
+			"\t%sfor(i=0; i<%s; i=i+1) begin : CORDICops\n",
+			(lanes > 1) ? "" : "generate ",
+			(radix4) ? "NR2" : "NSTAGES");
+		fprintf(dp,
+			"\t\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t\t// we\'ve been studying and discussing.  Everything up to\n"
+			"\t\t// this point has simply been necessary preliminaries.\n"
+			"\t\t//\n"
+			"\t\t// The phase following this stage needs only PWN bits.\n"
+			"\t\t// Those above are copies of its sign, and so the adder\n"
+			"\t\t// need be no wider.\n"
+			"\t\tlocalparam\tPWN = PHW[8*i +: 8];\n"
+			"\t\twire\t[(PWN-1):0]\tnph;\n"
+			"\n"
+			"\t\tassign\tnph = (ph[i][PW-1])\n"
+			"\t\t\t\t? (ph[i][(PWN-1):0] + cordic_angle[i][(PWN-1):0])\n"
+			"\t\t\t\t: (ph[i][(PWN-1):0] - cordic_angle[i][(PWN-1):0]);\n"
+			"\n");
+		if (with_reset) {
+			fprintf(dp,
+				"\t\tinitial begin\n"
+				"\t\t\txv[i+1] = 0;\n"
+				"\t\t\tyv[i+1] = 0;\n"
+				"\t\t\tph[i+1] = 0;\n"
+				"\t\tend\n\n\t");
+		}
+		fprintf(dp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(dp,
+				"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tph[i+1] <= 0;\n"
+				"\t\t\t// }}}\n"
+				"\t\tend else ");
+		} else
+			fprintf(dp, "\t\t");
+
+		fprintf(dp,
+			"if (i_ce)\n"
+			"\t\tbegin\n"
+			"\t\t\t// {{{\n"
+			"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
+			"\t\t\tbegin // Do nothing but move our outputs\n"
+			"\t\t\t// forward one stage, since we have more\n"
+			"\t\t\t// stages than valid data\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\txv[i+1] <= xv[i];\n"
+			"\t\t\t\tyv[i+1] <= yv[i];\n"
+			"\t\t\t\tph[i+1] <= ph[i];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else if (ph[i][(PW-1)]) // Negative phase\n"
+			"\t\t\tbegin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// If the phase is negative, rotate by the\n"
+			"\t\t\t\t// CORDIC angle in a clockwise direction.\n"
+			"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else begin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// On the other hand, if the phase is\n"
+			"\t\t\t\t// positive ... rotate in the\n"
+			"\t\t\t\t// counter-clockwise direction\n"
+			"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend\n"
+			"\t\t\t// }}}\n"
+			"\t\tend\n"
+			"\tend%s\n\t// }}}\n\n",
+			(lanes > 1) ? "" : " endgenerate");
+
+		if (radix4)
+			radix4_rotations(dp, nstages, working_width,
+				phase_bits, nr2, false, always_reset.c_str(),
+				with_reset);
+		// }}}
+	}
 
-	fprintf(fp,
-		"if (i_ce)\n"
-		"\t\tbegin\n"
-		"\t\t\t// {{{\n"
-		"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
-		"\t\t\tbegin // Do nothing but move our outputs\n"
-		"\t\t\t// forward one stage, since we have more\n"
-		"\t\t\t// stages than valid data\n"
-		"\t\t\t\t// {{{\n"
-		"\t\t\t\txv[i+1] <= xv[i];\n"
-		"\t\t\t\tyv[i+1] <= yv[i];\n"
-		"\t\t\t\tph[i+1] <= ph[i];\n"
-		"\t\t\t\t// }}}\n"
-		"\t\t\tend else if (ph[i][(PW-1)]) // Negative phase\n"
-		"\t\t\tbegin\n"
-		"\t\t\t\t// {{{\n"
-		"\t\t\t\t// If the phase is negative, rotate by the\n"
-		"\t\t\t\t// CORDIC angle in a clockwise direction.\n"
-		"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
-		"\t\t\t\t// }}}\n"
-		"\t\t\tend else begin\n"
-		"\t\t\t\t// {{{\n"
-		"\t\t\t\t// On the other hand, if the phase is\n"
-		"\t\t\t\t// positive ... rotate in the\n"
-		"\t\t\t\t// counter-clockwise direction\n"
-		"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
-		"\t\t\t\t// }}}\n"
-		"\t\t\tend\n"
-		"\t\t\t// }}}\n"
-		"\t\tend\n"
-		"\tend endgenerate\n\t// }}}\n\n");
+	if (unit_gain) {
+		const	char	*src[2] = { xsrc.c_str(), ysrc.c_str() },
+				*dst[2] = { "gxv", "gyv" };
+
+		gain_compensation(dp, working_width, gain, 2, src, dst, "i_ce");
+		xsrc = dst[0];
+		ysrc = dst[1];
+	}
 
 	if (working_width > ow+1) {
-		fprintf(fp,
+		fprintf(dp,
 			"\t// Round our result towards even\n"
 			"\t// {{{\n"
 			"\twire\t[(WW-1):0]\tpre_xval, pre_yval;\n\n"
-			"\tassign\tpre_xval = xv[NSTAGES] + $signed({ {(OW){1\'b0}},\n"
-				"\t\t\t\txv[NSTAGES][(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!xv[NSTAGES][WW-OW]}} });\n"
-			"\tassign\tpre_yval = yv[NSTAGES] + $signed({ {(OW){1\'b0}},\n"
-				"\t\t\t\tyv[NSTAGES][(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!yv[NSTAGES][WW-OW]}} });\n"
-			"\n\n");
-
-		fprintf(fp, "\tinitial begin\n"
+			"\tassign\tpre_xval = %s + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n"
+			"\tassign\tpre_yval = %s + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n"
+			"\n\n", xsrc.c_str(), xsrc.c_str(), xsrc.c_str(),
+			ysrc.c_str(), ysrc.c_str(), ysrc.c_str());
+
+		fprintf(dp, "\tinitial begin\n"
 			"\t\to_xval = 0;\n"
 			"\t\to_yval = 0;\n");
-		if (with_aux)
-			fprintf(fp, "\t\to_aux  = 0;\n");
-		fprintf(fp, "\tend\n");
-		fprintf(fp, "%s", always_reset.c_str());
+		if (lane_aux)
+			fprintf(dp, "\t\to_aux  = 0;\n");
+		fprintf(dp, "\tend\n");
+		fprintf(dp, "%s", always_reset.c_str());
 
 		if (with_reset) {
-			fprintf(fp, "\tbegin\n"
+			fprintf(dp, "\tbegin\n"
 				"\t\to_xval <= 0;\n"
 				"\t\to_yval <= 0;\n");
-			if (with_aux)
-				fprintf(fp, "\t\to_aux  <= 0;\n");
-			fprintf(fp, "\tend else ");
+			if (lane_aux)
+				fprintf(dp, "\t\to_aux  <= 0;\n");
+			fprintf(dp, "\tend else ");
 		}
 
-		fprintf(fp,
+		fprintf(dp,
 			"if (i_ce)\n"
 			"\tbegin\n"
 			"\t\to_xval <= pre_xval[(WW-1):(WW-OW)];\n"
 			"\t\to_yval <= pre_yval[(WW-1):(WW-OW)];\n");
-		if (with_aux)
-			fprintf(fp,
-			"\t\to_aux <= ax[NSTAGES];\n");
-		fprintf(fp, "\tend\n\t// }}}\n");
+		if (lane_aux)
+			fprintf(dp,
+			"\t\to_aux <= ax[%s];\n", axdepth.c_str());
+		fprintf(dp, "\tend\n\t// }}}\n");
 
-		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+		fprintf(dp, "\t// Make Verilator happy with pre_.val\n"
 			"\t// {{{\n"
 			"\t// verilator lint_off UNUSED\n"
 			"\twire	unused_val;\n"
@@ -406,43 +822,93 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 			"\t// verilator lint_on UNUSED\n");
 	} else {
 
-		fprintf(fp,
+		fprintf(dp,
 			"\t// No rounding required\n"
 			"\t// {{{\n"
 			"\tinitial begin\n"
 			"\t\to_xval = 0;\n"
 			"\t\to_yval = 0;\n");
-		if (with_aux)
-			fprintf(fp, "\t\to_aux  = 0;\n");
-		fprintf(fp, "\tend\n\t// }}}");
-		fprintf(fp, "%s", always_reset.c_str());
+		if (lane_aux)
+			fprintf(dp, "\t\to_aux  = 0;\n");
+		fprintf(dp, "\tend\n\t// }}}");
+		fprintf(dp, "%s", always_reset.c_str());
 
 		if (with_reset) {
-			fprintf(fp,
+			fprintf(dp,
 			"\tbegin\n"
 			"\t\t// {{{\n"
 			"\t\to_xval <= 0;\n"
 			"\t\to_yval <= 0;\n");
-			if (with_aux)
-				fprintf(fp, "\t\to_aux  <= 0;\n");
-			fprintf(fp,
+			if (lane_aux)
+				fprintf(dp, "\t\to_aux  <= 0;\n");
+			fprintf(dp,
 			"\t\t// }}}\n"
 			"\tend else ");
 		}
 
-		fprintf(fp,
+		fprintf(dp,
 			"if (i_ce)\n"
 			"\t// {{{\n"
 			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
-			"\t\to_xval <= xv[NSTAGES][(WW-1):(WW-OW)];\n"
-			"\t\to_yval <= yv[NSTAGES][(WW-1):(WW-OW)];\n");
-		if (with_aux)
-			fprintf(fp, "\t\to_aux  <= ax[NSTAGES];\n");
-		fprintf(fp,
+			"\t\to_xval <= %s[(WW-1):(WW-OW)];\n"
+			"\t\to_yval <= %s[(WW-1):(WW-OW)];\n",
+			xsrc.c_str(), ysrc.c_str());
+		if (lane_aux)
+			fprintf(dp, "\t\to_aux  <= ax[%s];\n", axdepth.c_str());
+		fprintf(dp,
 			"\t// }}}\n"
 			"\tend\n\n");
 	}
 
+	if (lanes > 1) {
+		// {{{
+		const	char *const	rename[] = {
+			"i_xval", "li_xval", "i_yval", "li_yval",
+			"i_phase", "li_phase",
+			"o_xval", "lo_xval", "o_yval", "lo_yval", NULL };
+
+		fclose(dp);
+
+		if (with_aux) {
+			fprintf(fp,
+				"\t// Aux output, shared by all lanes\n"
+				"\t// {{{\n"
+				"\tinitial\to_aux = 0;\n");
+			fprintf(fp, "%s", always_reset.c_str());
+			if (with_reset)
+				fprintf(fp, "\t\to_aux <= 0;\n\telse ");
+			fprintf(fp, "if (i_ce)\n"
+				"\t\to_aux <= ax[%s];\n"
+				"\t// }}}\n\n", axdepth.c_str());
+		}
+
+		fprintf(fp,
+			"\t// Parallel CORDIC lanes\n"
+			"\t// {{{\n"
+			"\tgenvar\tlane;\n"
+			"\tgenerate for(lane=0; lane<NLANES; lane=lane+1)\n"
+			"\tbegin : LANE\n"
+			"\t\twire\tsigned\t[(IW-1):0]\tli_xval, li_yval;\n"
+			"\t\twire\t\t[(PW-1):0]\tli_phase;\n"
+			"\t\treg\tsigned\t[(OW-1):0]\tlo_xval, lo_yval;\n"
+			"\n"
+			"\t\tassign\tli_xval  = i_xval[lane*IW +: IW];\n"
+			"\t\tassign\tli_yval  = i_yval[lane*IW +: IW];\n"
+			"\t\tassign\tli_phase = i_phase[lane*PW +: PW];\n"
+			"\n");
+
+		lane_copy(fp, dpbuf, rename);
+
+		fprintf(fp,
+			"\n"
+			"\t\tassign\to_xval[lane*OW +: OW] = lo_xval;\n"
+			"\t\tassign\to_yval[lane*OW +: OW] = lo_yval;\n"
+			"\tend endgenerate\n"
+			"\t// }}}\n");
+		free(dpbuf);
+		// }}}
+	}
+
 	fprintf(fp, "endmodule\n");
 
 
@@ -462,37 +928,82 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 
 		if (async_reset)
 			fprintf(fhp, "#define\tASYNC_RESET\n");
+		fprintf(fhp, "const int	NLANES = %d;\n", (lanes > 1) ? lanes : 1);
 		fprintf(fhp, "const int	IW = %d;\n", iw);
 		fprintf(fhp, "const int	OW = %d;\n", ow);
 		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
 		fprintf(fhp, "const int	WW = %d;\n", working_width);
 		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
 		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
-		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
-			transform_quantization_variance(nstages,
-				working_width-iw,
-				working_width-ow));
-		fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
-			phase_variance(nstages, phase_bits));
-		fprintf(fhp, "const double	GAIN = %.16f;\n",
-			cordic_gain(nstages));
-		{
-			double	amplitude = (1ul<<(iw-1))-1.,
-				signal_energy, noise_energy;
-			amplitude *= (1ul<<((working_width-iw)));
-			amplitude *= cordic_gain(nstages);
-			amplitude *= pow(2.0,-(working_width-ow));
-			signal_energy = amplitude * amplitude;
-
-			noise_energy = transform_quantization_variance(nstages,
-				working_width-iw, working_width-ow);
-
-			noise_energy += signal_energy * phase_variance(nstages, phase_bits)
-				* pow(2,cordic_gain(nstages));
+		fprintf(fhp, "const int	LATENCY = %d;\t// Clocks from i_ce to output\n",
+			nregs+((unit_gain) ? 3:2));
+		if (radix4) {
+			fprintf(fhp, "#define\tRADIX4\n");
+			fprintf(fhp, "const int	NR2 = %d;\t// Radix-2 stages\n", nr2);
+			fprintf(fhp, "const int	NR4 = %d;\t// Radix-4 stages\n", nr4);
+			fprintf(fhp, "const int	R4_SHIFT0 = %d;\t// Shift of the first\n",
+				radix4_start(working_width));
+		}
 
+		if (unit_gain) {
+			// {{{
+			// The quantization noise is that of the working width,
+			// compensated along with the signal
+			double	qv, pv;
+
+			if (radix4) {
+				qv = radix4_quantization_variance(nstages,
+					working_width, phase_bits,
+					working_width-iw, 0);
+				pv = radix4_phase_variance(nstages,
+					working_width, phase_bits);
+				qv = unit_gain_variance(qv, gain,
+					working_width-ow);
+			} else {
+				qv = unit_gain_rotation_variance(nstages,
+					working_width, phase_bits, gain,
+					working_width-ow);
+				pv = phase_variance(nstages, phase_bits);
+			}
+
+			fprintf(fhp, "#define\tUNIT_GAIN\n");
+			fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n", qv);
+			fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n", pv);
+			fprintf(fhp, "const double	CORDIC_GAIN = %.16f;\t// Compensated\n",
+				gain);
+			fprintf(fhp, "const double	GAIN = 1.0;\n");
+			fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+				unit_gain_cnr(iw, ow, working_width, qv, pv));
+			// }}}
+		} else if (radix4) {
+			// {{{
+			fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+				radix4_quantization_variance(nstages,
+					working_width, phase_bits,
+					working_width-iw,
+					working_width-ow));
+			fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
+				radix4_phase_variance(nstages, working_width,
+					phase_bits));
+			fprintf(fhp, "const double	GAIN = %.16f;\n",
+				radix4_gain(nstages, working_width,
+					phase_bits));
+			fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+				radix4_cnr(nstages, iw, ow, working_width,
+					phase_bits));
+			// }}}
+		} else {
+			fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+				transform_quantization_variance(nstages,
+					working_width-iw,
+					working_width-ow));
+			fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
+				phase_variance(nstages, phase_bits));
+			fprintf(fhp, "const double	GAIN = %.16f;\n",
+				cordic_gain(nstages));
 			fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
-				10.0 * log(signal_energy / noise_energy)
-					/log(10.0));
+				best_possible_cnr(nstages, iw, ow, working_width,
+					phase_bits));
 		}
 		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
 		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
@@ -500,7 +1011,13 @@ void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
 		if (with_aux)
 			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+
+		basiccordic_model(fhp, nstages, iw, ow, working_width, phase_bits,
+			radix4, unit_gain);
+
 		fprintf(fhp, "#endif\t// %s\n", str);
 		delete[] str;
 	}
+
+	return nregs + ((unit_gain) ? 3:2);
 }
@@ -43,10 +43,12 @@
 
 #include "basiccordic.h"
 
-void	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+// Returns the number of clocks from i_ce to the output
+int	basiccordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		int nstages, int iw, int ow, int nxtra,
 		int phase_bits=32,
 		bool with_reset=true, bool with_aux = true,
-		bool async_reset=false);
+		bool async_reset=false, int lanes=1, int regs=1,
+		bool radix4=false, bool unit_gain=false);
 
 #endif	// BASICCORDIC_H
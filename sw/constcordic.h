@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/constcordic.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Compile-time versions of the calculations in cordiclib.cpp.
+//		Given a configuration as template parameters, these produce
+//	the CORDIC angle table, the number of stages, the gain and
+//	its inverse as constants, so that a C++ model built upon them
+//	can be fully unrolled by the compiler.  Other than the gain,
+//	each returns exactly the value its run-time counterpart does.
+//
+//	Since <math.h> is not constexpr, the transcendental functions
+//	are evaluated by series in long double, and then rounded to
+//	double before being used exactly as cordiclib.cpp uses them.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	CONSTCORDIC_H
+#define	CONSTCORDIC_H
+
+namespace cordic {
+	// Constants
+	// {{{
+	// This is the same value as M_PI, once rounded to a double
+	constexpr	double	PI = 3.14159265358979323846;
+	// }}}
+
+	// sqrt_ld
+	// {{{
+	// Newton's method, for the values near one used below
+	constexpr long double	sqrt_ld(long double v) {
+		long double	r = (v < 1.0L) ? 1.0L : v;
+
+		for(int k=0; k<64; k++)
+			r = 0.5L * (r + v / r);
+		return r;
+	}
+	// }}}
+
+	// atan_pow2
+	// {{{
+	// Returns atan(2^-(k+1)), or equivalently atan2(1, 2^(k+1)), as a
+	// double
+	constexpr double	atan_pow2(int k) {
+		long double	t = 1.0L, t2 = 0.0L, term = 0.0L, sum = 0.0L;
+
+		for(int i=0; i<=k; i++)
+			t *= 0.5L;
+		t2 = t * t;
+		// atan(t) = t - t^3/3 + t^5/5 - ...  Since t <= 1/2, each term
+		// is at least 4x smaller than the last.
+		term = t;
+		for(int n=0; n<40; n++) {
+			sum += ((n&1) ? -term : term) / (2*n+1);
+			term *= t2;
+		}
+		return (double)sum;
+	}
+	// }}}
+
+	// sin_small
+	// {{{
+	// Returns sin(a), as a double, for the small angles needed by
+	// phase_bits() below
+	constexpr double	sin_small(double a) {
+		long double	x = a, term = a, sum = 0.0L;
+
+		for(int n=0; n<20; n++) {
+			sum += term;
+			term *= -x * x / ((2*n+2) * (2*n+3));
+		}
+		return (double)sum;
+	}
+	// }}}
+
+	// angle
+	// {{{
+	// The k'th CORDIC angle, in units of 2^phase_bits per circle.  Same
+	// as cordic_angle().
+	constexpr unsigned long	angle(int k, int phase_bits) {
+		double	x = atan_pow2(k);
+
+		x *= (4.0 * (1ul<<(phase_bits-2))) / (PI * 2.0);
+		return (unsigned long)x;
+	}
+	// }}}
+
+	// angle_table<PW, NSTAGES>
+	// {{{
+	// The CORDIC angle ROM, as used by the generated cores.  Usage:
+	//
+	//	constexpr cordic::angle_table<PW, NSTAGES>	ANGLE;
+	//	... ph += ANGLE[k];
+	//
+	template<int PW, int NSTAGES> struct	angle_table {
+		static_assert(PW >= 3 && PW < 64, "Unsupported phase width");
+		static_assert(NSTAGES > 0, "Unsupported number of stages");
+
+		unsigned long	v[NSTAGES];
+
+		constexpr angle_table(void) : v() {
+			for(int k=0; k<NSTAGES; k++)
+				v[k] = angle(k, PW);
+		}
+
+		constexpr unsigned long	operator[](int k) const {
+			return v[k];
+		}
+
+		constexpr int	size(void) const { return NSTAGES; }
+	};
+	// }}}
+
+	// gain<NSTAGES>
+	// {{{
+	// The CORDIC gain, prod sqrt(1+2^(-2(k+1))).  This is calculated in
+	// long double, and so may differ from cordic_gain() in its last bit.
+	constexpr long double	gain(int nstages) {
+		long double	g2 = 1.0L, p = 1.0L;
+
+		for(int k=0; k<nstages; k++) {
+			p *= 0.25L;
+			g2 *= 1.0L + p;
+		}
+		return sqrt_ld(g2);
+	}
+
+	template<int NSTAGES> constexpr double	gain(void) {
+		return (double)gain(NSTAGES);
+	}
+
+	template<int NSTAGES> constexpr double	inverse_gain(void) {
+		return (double)(1.0L / gain(NSTAGES));
+	}
+
+	// The multiplier, as given in the comments of the generated Verilog,
+	// which annihilates the gain when followed by a right shift of 32 bits
+	template<int NSTAGES> constexpr unsigned	inverse_gain_q32(void) {
+		return (unsigned)(1.0/gain<NSTAGES>() * (4.0 * (1ul<<30)));
+	}
+	// }}}
+
+	// stages<WW, PW>, stages<PW>
+	// {{{
+	// The number of useful CORDIC stages.  Same as calc_stages().
+	constexpr int	calc_stages(int working_width, int phase_bits) {
+		int	nstages = 0;
+
+		for(nstages=0; nstages<64; nstages++) {
+			if (angle(nstages, phase_bits) == 0)
+				break;
+			if (working_width > 0 && working_width <= nstages)
+				break;
+		} return nstages;
+	}
+
+	template<int WW, int PW> constexpr int	stages(void) {
+		return calc_stages(WW, PW);
+	}
+
+	template<int PW> constexpr int	stages(void) {
+		return calc_stages(0, PW);
+	}
+	// }}}
+
+	// phase_bits<OW>
+	// {{{
+	// The number of phase bits needed for an output of OW bits.  Same as
+	// calc_phase_bits().
+	constexpr int	calc_phase_bits(int output_width) {
+		int	pb = 3;
+
+		for(pb=3; pb < 64; pb++) {
+			double	ds = 0.0, a = 0.0;
+
+			a = (2.0*PI/(double)(1ul<<pb));
+			ds = sin_small(a);
+			ds *= ((1ul<<output_width)-1);
+			if (ds < 0.5)
+				break;
+		}
+
+		return pb;
+	}
+
+	template<int OW> constexpr int	phase_bits(void) {
+		return calc_phase_bits(OW);
+	}
+	// }}}
+
+	// phase_variance<NSTAGES, PW>
+	// {{{
+	// The variance, in radians^2, of the phase due to the truncated
+	// angles.  Same as phase_variance().
+	constexpr double	calc_phase_variance(int nstages, int phase_bits) {
+		double	RAD_TO_PHASE = (1ul << (phase_bits-1)) / PI;
+		double	variance = 1./12.;
+
+		for(int k=0; k<nstages; k++) {
+			double	x = 0.0, err = 0.0;
+
+			x = atan_pow2(k) * RAD_TO_PHASE;
+			err = (unsigned long)x - x;
+			variance += err * err;
+		}
+
+		return variance / (RAD_TO_PHASE * RAD_TO_PHASE);
+	}
+
+	template<int NSTAGES, int PW> constexpr double	phase_variance(void) {
+		return calc_phase_variance(NSTAGES, PW);
+	}
+	// }}}
+}
+
+#endif	// CONSTCORDIC_H
@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
+#include <ctype.h>
 #include <assert.h>
 
 #include "cordiclib.h"
@@ -129,6 +130,43 @@ double	transform_quantization_variance(int nstages, int xtrabits,
 // }}}
 }
 
+double	best_possible_cnr(int nstages, int iw, int ow, int working_width,
+		int phase_bits) {
+// {{{
+	double	amplitude = (1ul<<(iw-1))-1.,
+		signal_energy, noise_energy;
+
+	amplitude *= (1ul<<((working_width-iw)));
+	amplitude *= cordic_gain(nstages);
+	amplitude *= pow(2.0,-(working_width-ow));
+	signal_energy = amplitude * amplitude;
+
+	noise_energy = transform_quantization_variance(nstages,
+		working_width-iw, working_width-ow);
+
+	noise_energy += signal_energy * phase_variance(nstages, phase_bits)
+		* pow(2,cordic_gain(nstages));
+
+	// Return the result in dB
+	return 10.0 * log(signal_energy / noise_energy) / log(10.0);
+// }}}
+}
+
+unsigned long	cordic_angle(int k, int phase_bits) {
+// {{{
+	double		x;
+
+	x = atan2(1., pow(2,k+1));
+
+	// Convert this value from radians to our integer phase units
+	x *= (4.0 * (1ul<<(phase_bits-2))) / (M_PI * 2.0);
+
+	// Here's where we truncate our phase from a double to an
+	// integer
+	return (unsigned)x;
+// }}}
+}
+
 void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem) {
 // {{{
 	fprintf(fp,
@@ -161,12 +199,7 @@ void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem) {
 		x = atan2(1., pow(2,k+1));
 		deg = x * 180.0 / M_PI;
 
-		// Convert this value from radians to our integer phase units
-		x *= (4.0 * (1ul<<(phase_bits-2))) / (M_PI * 2.0);
-
-		// Here's where we truncate our phase from a double to an
-		// integer
-		phase_value = (unsigned)x;
+		phase_value = cordic_angle(k, phase_bits);
 
 		if (phase_bits <= 16) {
 			if (mem) {
@@ -266,3 +299,999 @@ int	calc_phase_bits(const int output_width) {
 		phase_bits = 3;
 	return phase_bits;
 }
+
+// lane_copy
+// {{{
+// Copy the Verilog in body to fp, one tab deeper, so that it may be placed
+// within a generate block.  Along the way, every identifier matching an
+// even entry of the NULL terminated rename list is replaced by the entry
+// following it.
+void	lane_copy(FILE *fp, const char *body, const char *const *rename) {
+	const	char	*ptr = body;
+	bool	sol = true;
+
+	while(*ptr) {
+		if (sol && *ptr != '\n')
+			fputc('\t', fp);
+		sol = false;
+
+		if (isalpha(*ptr) || *ptr == '_') {
+			const	char	*end = ptr;
+			int		k;
+
+			while(isalnum(*end) || *end == '_' || *end == '$')
+				end++;
+			for(k=0; rename && rename[k]; k+=2) {
+				if ((strlen(rename[k]) == (size_t)(end-ptr))
+					&& (0 == strncmp(rename[k], ptr, end-ptr)))
+					break;
+			}
+
+			if (rename && rename[k])
+				fputs(rename[k+1], fp);
+			else
+				fwrite(ptr, 1, end-ptr, fp);
+			ptr = end;
+		} else {
+			if (*ptr == '\n')
+				sol = true;
+			fputc(*ptr++, fp);
+		}
+	}
+}
+// }}}
+
+// active_stages
+// {{{
+// Count the CORDIC stages that actually do something.  A stage whose angle
+// rounds to zero, or whose shift would clear the entire working width, is
+// skipped by the generators.  Since both conditions only get worse with
+// the stage index, the useful stages are always the first ones.
+int	active_stages(int nstages, int working_width, int phase_bits) {
+	int	k;
+
+	for(k=0; k<nstages; k++) {
+		if (cordic_angle(k, phase_bits) == 0 || k >= working_width)
+			break;
+	} return k;
+}
+// }}}
+
+// residual_phase_bits
+// {{{
+// The number of bits, sign included, needed to hold the phase remaining to a
+// rotating (p2r) core once CORDIC stages first through nstages-1 have been
+// applied.  The phase starts within +/- 2^(PW-3-first), as it does following
+// the octant pre-rotation when first is zero.  Each stage then moves a
+// positive phase down, or a negative one up, by its angle.  The range the
+// phase can reach is tracked exactly, so the width is never too small.
+int	residual_phase_bits(int nstages, int first, int working_width,
+		int phase_bits) {
+	long	lo = -(1l << (phase_bits-3-first)),
+		hi =  (1l << (phase_bits-3-first)) - 1;
+	int	w;
+
+	for(int k=first; k<nstages; k++) {
+		long	a = (long)cordic_angle(k, phase_bits);
+
+		if ((a == 0)||(k >= working_width))
+			continue;
+		// Negative phases, [lo,-1], move to [lo+a,a-1]
+		// Positive phases, [0,hi], move to [-a,hi-a]
+		lo = (lo + a < -a) ? lo + a : -a;
+		hi = (hi - a > a - 1) ? hi - a : a - 1;
+	}
+
+	for(w=1; (lo < -(1l << (w-1)))||(hi > (1l << (w-1))-1); w++)
+		;
+	return w;
+}
+// }}}
+
+// residual_phase_widths
+// {{{
+// Declare PHW, holding in eight bits apiece the width of the phase following
+// each of the stages first through nstages-1, as residual_phase_bits()
+// finds it.  Entries before first are unused, and given the full width.
+// The table is sized by bound, the name of the loop limit, NSTAGES or NR2.
+void	residual_phase_widths(FILE *fp, int nstages, int first,
+		int working_width, int phase_bits, const char *bound) {
+	fprintf(fp,
+		"\t// Residual phase widths\n"
+		"\t// {{{\n"
+		"\t// Each stage leaves less phase for those following it.  Entry\n"
+		"\t// i of PHW holds the bits, sign included, that the phase can\n"
+		"\t// use following stage i.  Any bits above these are only ever\n"
+		"\t// copies of the sign bit.\n"
+		"\tlocalparam\t[(8*%s-1):0]\tPHW = {", bound);
+
+	for(int k=nstages-1; k>=0; k--)
+		fprintf(fp, "%s%s8\'d%d", (k < nstages-1) ? ",":"",
+			(0 == ((nstages-1-k)%8)) ? "\n\t\t\t" : " ",
+			(k < first) ? phase_bits
+			: residual_phase_bits(k+1, first, working_width,
+							phase_bits));
+	fprintf(fp, " };\n\t// }}}\n\n");
+}
+// }}}
+
+// unrolled_rotations
+// {{{
+// Write out iters CORDIC stages as a chain of combinational logic, for use
+// by the sequential cores.  The chain starts from xv, yv, and ph, and ends
+// in kx[iters], ky[iters], and kph[iters].  The first stage of the chain is
+// given by the lgbase-bit register base.  Any stage at or beyond nactive
+// simply passes its inputs through, so that the last clock may be only
+// partially used.  The direction of each rotation is set by the sign of the
+// remaining phase, or--when vectoring--by the sign of y.
+void	unrolled_rotations(FILE *fp, int nactive, int iters, int lgbase,
+		bool vectoring) {
+	fprintf(fp,
+		"\t// Unrolled CORDIC stages\n"
+		"\t// {{{\n"
+		"\t// Each clock applies the %d stages starting with stage base,\n"
+		"\t// one after the other.  Any stage beyond the last useful one\n"
+		"\t// just passes its values through.\n"
+		"\twire\tsigned\t[(WW-1):0]\tkx\t[0:%d];\n"
+		"\twire\tsigned\t[(WW-1):0]\tky\t[0:%d];\n"
+		"\twire\t\t[(PW-1):0]\tkph\t[0:%d];\n\n"
+		"\tassign\tkx[0]  = xv;\n"
+		"\tassign\tky[0]  = yv;\n"
+		"\tassign\tkph[0] = ph;\n",
+		iters, iters, iters, iters);
+
+	for(int k=0; k<iters; k++) {
+		char	sel[64], shift[64], angle[64];
+
+		fprintf(fp, "\n\t// Stage base+%d\n", k);
+		if (nactive - k <= 0) {
+			fprintf(fp,
+				"\tassign\tkx[%d]  = kx[%d];\n"
+				"\tassign\tky[%d]  = ky[%d];\n"
+				"\tassign\tkph[%d] = kph[%d];\n",
+				k+1, k, k+1, k, k+1, k);
+			continue;
+		}
+
+		if (vectoring)
+			sprintf(sel, "ky[%d][WW-1]", k);
+		else
+			sprintf(sel, "kph[%d][PW-1]", k);
+		sprintf(shift, "(base + %d'd%d)", lgbase, k+1);
+		if (k == 0)
+			sprintf(angle, "cordic_angle[base]");
+		else
+			sprintf(angle, "cordic_angle[base + %d'd%d]", lgbase, k);
+
+		fprintf(fp,
+			"\tassign\tkx[%d] = (base >= %d'd%d) ? kx[%d]\n"
+			"\t\t\t: (%s) ? (kx[%d] %c (ky[%d] >>> %s))\n"
+			"\t\t\t: (kx[%d] %c (ky[%d] >>> %s));\n",
+			k+1, lgbase, nactive-k, k,
+			sel, k, vectoring ? '-':'+', k, shift,
+			k, vectoring ? '+':'-', k, shift);
+		fprintf(fp,
+			"\tassign\tky[%d] = (base >= %d'd%d) ? ky[%d]\n"
+			"\t\t\t: (%s) ? (ky[%d] %c (kx[%d] >>> %s))\n"
+			"\t\t\t: (ky[%d] %c (kx[%d] >>> %s));\n",
+			k+1, lgbase, nactive-k, k,
+			sel, k, vectoring ? '+':'-', k, shift,
+			k, vectoring ? '-':'+', k, shift);
+		fprintf(fp,
+			"\tassign\tkph[%d] = (base >= %d'd%d) ? kph[%d]\n"
+			"\t\t\t: (%s) ? (kph[%d] %c %s)\n"
+			"\t\t\t: (kph[%d] %c %s);\n",
+			k+1, lgbase, nactive-k, k,
+			sel, k, vectoring ? '-':'+', angle,
+			k, vectoring ? '+':'-', angle);
+	}
+
+	fprintf(fp, "\t// }}}\n\n");
+}
+// }}}
+
+// Radix-4 stages
+// {{{
+// A radix-4 stage at shift s rotates by atan(d*2^-s), for d in {-2..2}, and
+// so resolves two bits of angle at once.  Its gain, sqrt(1+d^2 4^-s), depends
+// upon d.  Once 2s-1 >= WW, however, that variation is less than one part
+// in 2^WW, and can be treated as a constant.  Hence the radix-4 cores use
+// radix-2 stages up to that point, and radix-4 stages (shifts s0, s0+2, ...)
+// thereafter.
+
+// radix4_start
+// {{{
+// Return the shift of the first radix-4 stage.  Stages with smaller shifts
+// are radix-2.
+int	radix4_start(int working_width) {
+	return (working_width + 2) / 2;
+}
+// }}}
+
+// radix2_stages
+// {{{
+// The number of radix-2 stages preceding the radix-4 ones
+int	radix2_stages(int nstages, int working_width) {
+	int	nr2 = radix4_start(working_width) - 1;
+
+	return (nr2 < nstages) ? nr2 : nstages;
+}
+// }}}
+
+// radix4_angle
+// {{{
+// The angle, atan(d*2^-shift), in phase units, truncated the same way
+// cordic_angle() truncates its angles.
+unsigned long	radix4_angle(int shift, int d, int phase_bits) {
+	double		x;
+
+	x = atan2((double)d, pow(2,shift));
+	x *= (4.0 * (1ul<<(phase_bits-2))) / (M_PI * 2.0);
+	return (unsigned long)x;
+}
+// }}}
+
+// radix4_stages
+// {{{
+// Count the radix-4 stages needed so that the last one, at shift s, leaves
+// no more than the 2^-(nstages) residual of the radix-2 CORDIC it replaces.
+// Stages that would shift everything away, or whose angle rounds to zero,
+// are dropped.
+int	radix4_stages(int nstages, int working_width, int phase_bits) {
+	int	s0 = radix4_start(working_width), n4, k;
+
+	if (nstages < s0)
+		return 0;
+	n4 = (nstages - s0) / 2 + 1;
+	for(k=0; k<n4; k++) {
+		int	s = s0 + 2*k;
+
+		if (s > working_width || radix4_angle(s, 1, phase_bits) == 0)
+			break;
+	} return k;
+}
+// }}}
+
+// radix4_gain
+// {{{
+// The gain of the radix-2 stages, times the gain of the radix-4 stages
+// taken halfway between their extremes (d^2 = 2).
+double	radix4_gain(int nstages, int working_width, int phase_bits) {
+	int	s0 = radix4_start(working_width),
+		n4 = radix4_stages(nstages, working_width, phase_bits);
+	double	gain = cordic_gain(radix2_stages(nstages, working_width));
+
+	for(int k=0; k<n4; k++)
+		gain *= sqrt(1.0 + 2.0 * pow(4.0, -(s0+2*k)));
+	return gain;
+}
+// }}}
+
+// radix4_phase_variance
+// {{{
+// As with phase_variance(), but accumulating the truncation error of the
+// radix-4 angles as well.  Each radix-4 stage uses one of its two angles,
+// so we average their squared errors.
+double	radix4_phase_variance(int nstages, int working_width, int phase_bits) {
+	double	RAD_TO_PHASE = (1ul << (phase_bits-1)) / M_PI;
+	int	s0 = radix4_start(working_width),
+		nr2 = radix2_stages(nstages, working_width),
+		n4 = radix4_stages(nstages, working_width, phase_bits);
+	double	variance;
+
+	// Start with the radix-2 stages, converted back to phase units
+	variance = phase_variance(nr2, phase_bits) * pow(RAD_TO_PHASE, 2.);
+	for(int k=0; k<n4; k++) {
+		double	err = 0.0;
+
+		for(int d=1; d<=2; d++) {
+			double	x = atan2((double)d, pow(2,s0+2*k))
+						* RAD_TO_PHASE;
+
+			err += pow(radix4_angle(s0+2*k, d, phase_bits) - x, 2.);
+		} variance += err / 2.0;
+	}
+
+	return variance / pow(RAD_TO_PHASE,2.);
+}
+// }}}
+
+// radix4_quantization_variance
+// {{{
+// As with transform_quantization_variance(), but for the mixed radix
+// pipeline.  The radix-4 stages add the variation in their gain, which
+// can be up to 2^(1-2s) of the (up to 2^(WW-2)) amplitude, as a
+// uniformly distributed error.
+double	radix4_quantization_variance(int nstages, int working_width,
+		int phase_bits, int xtrabits, int dropped_bits) {
+	int	s0 = radix4_start(working_width),
+		nr2 = radix2_stages(nstages, working_width),
+		n4 = radix4_stages(nstages, working_width, phase_bits);
+	double	current_variance;
+
+	current_variance = pow(2,2*xtrabits)/12.;
+
+	for(int k=0; k<nr2; k++)
+		current_variance = (1+pow(4,-k-1))*current_variance + 1./3.;
+	for(int k=0; k<n4; k++) {
+		double	dg = pow(2.0, 1-2*(s0+2*k)) * pow(2.0, working_width-2);
+
+		current_variance = (1+2.*pow(4,-s0-2*k))*current_variance
+				+ 1./3. + dg*dg/12.;
+	}
+
+	if (dropped_bits > 0)
+		current_variance = pow(2,-2*dropped_bits)*current_variance + 1/12.;
+	return current_variance;
+}
+// }}}
+
+// radix4_cnr
+// {{{
+// As with best_possible_cnr(), but for the mixed radix pipeline
+double	radix4_cnr(int nstages, int iw, int ow, int working_width,
+		int phase_bits) {
+	double	amplitude = (1ul<<(iw-1))-1., gain,
+		signal_energy, noise_energy;
+
+	gain = radix4_gain(nstages, working_width, phase_bits);
+	amplitude *= (1ul<<((working_width-iw)));
+	amplitude *= gain;
+	amplitude *= pow(2.0,-(working_width-ow));
+	signal_energy = amplitude * amplitude;
+
+	noise_energy = radix4_quantization_variance(nstages, working_width,
+		phase_bits, working_width-iw, working_width-ow);
+
+	noise_energy += signal_energy
+		* radix4_phase_variance(nstages, working_width, phase_bits)
+		* pow(2,gain);
+
+	return 10.0 * log(signal_energy / noise_energy) / log(10.0);
+}
+// }}}
+
+// radix4_angles
+// {{{
+// Write out the angle table of the radix-4 stages, alongside the one that
+// cordic_angles() writes for the radix-2 stages.  Entry 2k holds the angle
+// of stage k for d=1, and entry 2k+1 the angle for d=2.  When thresholds is
+// set, a second table holds the phase at or above which stage k rotates by
+// d=1 (entry 2k) or by d=2 (entry 2k+1): the points halfway between the
+// angles.  Rotating by the nearest angle leaves a residual the next stage,
+// at twice the shift, can absorb.
+void	radix4_angles(FILE *fp, int nstages, int working_width,
+		int phase_bits, bool thresholds) {
+	int	s0 = radix4_start(working_width),
+		n4 = radix4_stages(nstages, working_width, phase_bits);
+
+	if (n4 <= 0)
+		return;
+
+	fprintf(fp,
+		"\t// Radix-4 angle table\n"
+		"\t// {{{\n"
+		"\t// Radix-4 stage k rotates by atan(d*2^-(%d+2k)), d in {-2..2}\n"
+		"\twire\t[%d:0]\tcordic_angle4 [0:(2*NR4-1)];\n",
+		s0, phase_bits-1);
+	if (thresholds)
+		fprintf(fp, "\twire\t[%d:0]\tcordic_thresh4 [0:(2*NR4-1)];\n",
+			phase_bits-1);
+	fprintf(fp, "\n");
+
+	for(int k=0; k<n4; k++) {
+		int		s = s0 + 2*k;
+		unsigned long	a1 = radix4_angle(s, 1, phase_bits),
+				a2 = radix4_angle(s, 2, phase_bits);
+
+		fprintf(fp,
+			"\tassign\tcordic_angle4[%2d] = %2d\'h%0*lx; // atan(1*2^-%d)\n"
+			"\tassign\tcordic_angle4[%2d] = %2d\'h%0*lx; // atan(2*2^-%d)\n",
+			2*k,   phase_bits, (phase_bits+3)/4, a1, s,
+			2*k+1, phase_bits, (phase_bits+3)/4, a2, s);
+		if (thresholds)
+			fprintf(fp,
+			"\tassign\tcordic_thresh4[%2d] = %2d\'h%0*lx;\n"
+			"\tassign\tcordic_thresh4[%2d] = %2d\'h%0*lx;\n",
+			2*k,   phase_bits, (phase_bits+3)/4, a1/2,
+			2*k+1, phase_bits, (phase_bits+3)/4, (a1+a2)/2);
+	}
+
+	fprintf(fp, "\t// Gain is %.6f, varying by less than one part in 2^%d\n",
+		radix4_gain(nstages, working_width, phase_bits),
+		2*s0-1);
+	fprintf(fp, "\t// }}}\n");
+}
+// }}}
+
+// radix4_rotations
+// {{{
+// Write out the radix-4 stages of a pipelined CORDIC.  These follow the
+// first radix-2 stages, so stage k reads xv[first+k], yv[first+k], and
+// ph[first+k], and sets xv[first+k+1] and so on.  The rotation is chosen
+// by comparing the remaining phase against cordic_thresh4 or, when
+// vectoring, y against x*2^-s times 1/2 (for d=1) and 3/2 (for d=2).
+void	radix4_rotations(FILE *fp, int nstages, int working_width,
+		int phase_bits, int first, bool vectoring,
+		const char *always_reset, bool with_reset) {
+	int	s0 = radix4_start(working_width),
+		n4 = radix4_stages(nstages, working_width, phase_bits);
+
+	for(int k=0; k<n4; k++) {
+		int	s = s0 + 2*k, p = first + k;
+		char	cond[5][96];
+		// Conditions for d = +2, +1, 0, and -1, else d = -2.  When
+		// vectoring, a positive d rotates the other way.
+		const char *const	xop[2] = { "-", "+" };
+
+		if (vectoring) {
+			sprintf(cond[0], "yv[%d] >= r4hi_%d", p, k);
+			sprintf(cond[1], "yv[%d] >= r4lo_%d", p, k);
+			sprintf(cond[2], "yv[%d] > -r4lo_%d", p, k);
+			sprintf(cond[3], "yv[%d] > -r4hi_%d", p, k);
+		} else {
+			sprintf(cond[0], "$signed(ph[%d]) >= $signed(cordic_thresh4[%d])", p, 2*k+1);
+			sprintf(cond[1], "$signed(ph[%d]) >= $signed(cordic_thresh4[%d])", p, 2*k);
+			sprintf(cond[2], "$signed(ph[%d]) > -$signed(cordic_thresh4[%d])", p, 2*k);
+			sprintf(cond[3], "$signed(ph[%d]) > -$signed(cordic_thresh4[%d])", p, 2*k+1);
+		}
+
+		fprintf(fp,
+			"\t// Radix-4 stage %d: rotate by atan(d*2^-%d)\n"
+			"\t// {{{\n", k, s);
+		if (vectoring)
+			fprintf(fp,
+			"\twire\tsigned\t[(WW-1):0]\tr4lo_%d, r4hi_%d;\n\n"
+			"\tassign\tr4lo_%d = xv[%d] >>> %d;\n"
+			"\tassign\tr4hi_%d = r4lo_%d + (xv[%d] >>> %d);\n\n",
+			k, k, k, p, s+1, k, k, p, s);
+		if (with_reset)
+			fprintf(fp,
+			"\tinitial begin\n"
+			"\t\txv[%d] = 0;\n"
+			"\t\tyv[%d] = 0;\n"
+			"\t\tph[%d] = 0;\n"
+			"\tend\n\n", p+1, p+1, p+1);
+		fprintf(fp, "%s", always_reset);
+		if (with_reset)
+			fprintf(fp,
+			"\tbegin\n"
+			"\t\txv[%d] <= 0;\n"
+			"\t\tyv[%d] <= 0;\n"
+			"\t\tph[%d] <= 0;\n"
+			"\tend else ", p+1, p+1, p+1);
+		fprintf(fp, "if (i_ce)\n\tbegin\n");
+
+		for(int c=0; c<5; c++) {
+			int	d = 2 - c, sh = (d == 2 || d == -2) ? s-1 : s;
+			bool	neg = (d < 0) != vectoring;
+
+			if (c == 0)
+				fprintf(fp, "\t\tif (%s)\n\t\tbegin // d = %+d\n", cond[c], d);
+			else if (c < 4)
+				fprintf(fp, "\t\tend else if (%s)\n\t\tbegin // d = %+d\n", cond[c], d);
+			else
+				fprintf(fp, "\t\tend else begin // d = %+d\n", d);
+
+			if (d == 0) {
+				fprintf(fp,
+				"\t\t\txv[%d] <= xv[%d];\n"
+				"\t\t\tyv[%d] <= yv[%d];\n"
+				"\t\t\tph[%d] <= ph[%d];\n",
+				p+1, p, p+1, p, p+1, p);
+				continue;
+			}
+
+			fprintf(fp,
+				"\t\t\txv[%d] <= xv[%d] %s (yv[%d]>>>%d);\n"
+				"\t\t\tyv[%d] <= yv[%d] %s (xv[%d]>>>%d);\n"
+				"\t\t\tph[%d] <= ph[%d] %s cordic_angle4[%d];\n",
+				p+1, p, xop[neg ? 1:0], p, sh,
+				p+1, p, xop[neg ? 0:1], p, sh,
+				p+1, p, ((d > 0) != vectoring) ? "-" : "+",
+				2*k + ((d == 2 || d == -2) ? 1:0));
+		}
+		fprintf(fp, "\t\tend\n\tend\n\t// }}}\n\n");
+	}
+}
+// }}}
+// }}}
+
+// gain_coefficient
+// {{{
+// Returns 1/gain, scaled by 2^working_width and rounded to the nearest
+// integer.  Since every CORDIC gain lies between one half and two, this fits
+// within working_width+1 bits.
+unsigned long	gain_coefficient(double gain, int working_width) {
+	assert(working_width < 62);
+	return (unsigned long)(ldexp(1.0 / gain, working_width) + 0.5);
+}
+// }}}
+
+// unit_gain_variance
+// {{{
+// Given the variance within the working width, before any bits are dropped,
+// returns the output variance of a core whose gain has been compensated.
+// The noise is scaled along with the signal, and rounding the product back
+// to the working width adds another 1/12th.
+double	unit_gain_variance(double working_variance, double gain,
+		int dropped_bits) {
+	double	current_variance;
+
+	current_variance = working_variance / (gain * gain) + 1./12.;
+	if (dropped_bits > 0)
+		current_variance = pow(2,-2*dropped_bits)*current_variance + 1/12.;
+	return current_variance;
+}
+// }}}
+
+// unit_gain_rotation_variance
+// {{{
+// The quantization variance of a unit gain rotator's output vector, summed
+// across o_xval and o_yval, in output units squared.
+//
+// unit_gain_variance() inherits transform_quantization_variance()'s working
+// variance, and rounds only one output, so it understates a rotator's error
+// by about a fifth.  Here, as with hybrid_quantization_variance(), each stage
+// truncates its shifted operands by (k+1) bits, the gain compensation then
+// scales that error along with the signal and rounds both products, and the
+// output stage drops the extra bits from both outputs.
+double	unit_gain_rotation_variance(int nstages, int working_width,
+		int phase_bits, double gain, int dropped_bits) {
+	double	variance = 0.0, dv, mean;
+
+	for(int k=0; k<nstages; k++) {
+		if ((cordic_angle(k, phase_bits) == 0)||(k >= working_width))
+			continue;
+		mean = (1.0 - pow(2.0, -(k+1))) / 2.0;
+		dv   = mean * mean + (1.0 - pow(4.0, -(k+1))) / 12.0;
+
+		variance = (1.0 + pow(4.0, -(k+1))) * variance + 2.0 * dv;
+	}
+
+	// Gain compensation
+	variance = variance / (gain * gain) + 2.0 / 12.0;
+
+	variance *= pow(4.0, -dropped_bits);
+
+	// The output stage drops the extra bits
+	if (dropped_bits > 1)
+		// Round towards even
+		dv = (pow(4.0, dropped_bits) + 2.0) / 12.0
+			/ pow(4.0, dropped_bits);
+	else {
+		// Truncate a single bit
+		mean = 0.25;
+		dv   = mean * mean + (1.0 - 0.25) / 12.0;
+	}
+
+	return variance + 2.0 * dv;
+}
+// }}}
+
+// unit_gain_cnr
+// {{{
+// As with best_possible_cnr(), but for a core with a unit gain
+double	unit_gain_cnr(int iw, int ow, int working_width,
+		double variance, double phase_var) {
+	double	amplitude = (1ul<<(iw-1))-1.,
+		signal_energy, noise_energy;
+
+	amplitude *= (1ul<<((working_width-iw)));
+	amplitude *= pow(2.0,-(working_width-ow));
+	signal_energy = amplitude * amplitude;
+
+	noise_energy = variance + signal_energy * phase_var;
+
+	return 10.0 * log(signal_energy / noise_energy) / log(10.0);
+}
+// }}}
+
+// gain_compensation
+// {{{
+// Emits one pipeline stage, multiplying each of the nv values src[k] by the
+// constant 1/gain and rounding the result back to WW bits in dst[k].  The
+// stage captures its inputs on any clock where ce is true.  Since the
+// coefficient is a constant, synthesis is free to map this multiply either
+// onto a DSP or into a network of shifts and adds.
+void	gain_compensation(FILE *fp, int working_width, double gain, int nv,
+		const char *const *src, const char *const *dst,
+		const char *ce) {
+	fprintf(fp,
+		"\t// Gain compensation\n"
+		"\t// {{{\n"
+		"\t// Multiply by 1/GAIN, as GAIN_COMP / 2^WW, and round back to\n"
+		"\t// our working width.\n"
+		"\tlocalparam\t[(WW+1):0]\tGAIN_COMP = %d\'h%lx;\n\n",
+		working_width+2, gain_coefficient(gain, working_width));
+
+	for(int k=0; k<nv; k++)
+		fprintf(fp,
+		"\twire\tsigned\t[(2*WW+1):0]\t%s_prod, %s_round;\n"
+		"\treg\tsigned\t[(WW-1):0]\t%s;\n",
+			dst[k], dst[k], dst[k]);
+	fprintf(fp, "\n");
+
+	for(int k=0; k<nv; k++)
+		fprintf(fp,
+		"\tassign\t%s_prod  = %s * $signed(GAIN_COMP);\n"
+		"\tassign\t%s_round = %s_prod + $signed({ {(WW+2){1\'b0}},\n"
+			"\t\t\t\t1\'b1, {(WW-1){1\'b0}} });\n",
+			dst[k], src[k], dst[k], dst[k]);
+
+	fprintf(fp, "\n\tinitial begin\n");
+	for(int k=0; k<nv; k++)
+		fprintf(fp, "\t\t%s = 0;\n", dst[k]);
+	fprintf(fp, "\tend\n"
+		"\talways @(posedge i_clk)\n"
+		"\tif (%s)\n"
+		"\tbegin\n", ce);
+	for(int k=0; k<nv; k++)
+		fprintf(fp, "\t\t%s <= %s_round[(2*WW-1):WW];\n",
+			dst[k], dst[k]);
+	fprintf(fp, "\tend\n\n");
+
+	fprintf(fp,
+		"\t// verilator lint_off UNUSED\n"
+		"\twire\tunused_gain;\n"
+		"\tassign\tunused_gain = &{ 1\'b0");
+	for(int k=0; k<nv; k++)
+		fprintf(fp, ", %s_round[(2*WW+1):(2*WW)], %s_round[(WW-1):0]",
+			dst[k], dst[k]);
+	fprintf(fp, " };\n"
+		"\t// verilator lint_on UNUSED\n"
+		"\t// }}}\n");
+}
+// }}}
+
+// hyperbolic_shift
+// {{{
+// The shift used by hyperbolic CORDIC stage k.  These run 1, 2, 3, 4, 4,
+// 5, ... 13, 13, 14, ... 40, 40, ..., with each shift of the form
+// (3^j-1)/2 repeated once.  Without these repeats, the angles following
+// any stage would sum to less than that stage's own angle, and the
+// hyperbolic CORDIC would fail to converge.
+int	hyperbolic_shift(int k) {
+	int	shift = 1, repeat = 4;
+
+	for(int j=0; j<k; j++) {
+		if (shift == repeat)
+			// Use this shift a second time, then move on
+			repeat = 3*repeat+1;
+		else
+			shift++;
+	}
+
+	return shift;
+}
+// }}}
+
+// hyperbolic_angle
+// {{{
+// The hyperbolic angle, atanh(2^-shift), of stage k.  Hyperbolic angles
+// don't wrap, so they are kept in signed units of 2^-(PW-2), covering the
+// range -2 to 2.
+unsigned long	hyperbolic_angle(int k, int phase_bits) {
+	double		x;
+
+	x = atanh(pow(2.0, -hyperbolic_shift(k)));
+	x *= (double)(1ul << (phase_bits-2));
+
+	return (unsigned long)x;
+}
+// }}}
+
+int	calc_hyperbolic_stages(const int working_width, const int phase_bits) {
+	int	nstages;
+
+	for(nstages=0; nstages<64; nstages++) {
+		if (hyperbolic_angle(nstages, phase_bits) == 0l)
+			break;
+		if (hyperbolic_shift(nstages) >= working_width)
+			break;
+	} return nstages;
+}
+
+// hyperbolic_gain
+// {{{
+// Unlike the circular CORDIC, each hyperbolic stage shrinks its vector, by
+// sqrt(1-2^(-2*shift)).  Stages the core skips, as having either no angle or
+// a shift beyond the working width, don't count.
+double	hyperbolic_gain(int nstages, int working_width, int phase_bits) {
+	double	gain = 1.0;
+
+	for(int k=0; k<nstages; k++) {
+		int	sh = hyperbolic_shift(k);
+
+		if ((hyperbolic_angle(k, phase_bits) == 0)
+				||(sh >= working_width))
+			continue;
+		gain *= sqrt(1.0 - pow(2.0, -2.*sh));
+	}
+
+	return gain;
+}
+// }}}
+
+// hyperbolic_phase_variance
+// {{{
+// As with phase_variance(), the variance of the error in the final angle, in
+// units of the (hyperbolic) angle squared.
+double	hyperbolic_phase_variance(int nstages, int phase_bits) {
+	double	UNITS = (double)(1ul << (phase_bits-2));
+	double	variance;
+
+	variance = 1./12.;
+	for(int k=0; k<nstages; k++) {
+		double	x, err;
+
+		x = atanh(pow(2.0, -hyperbolic_shift(k))) * UNITS;
+		err = (double)hyperbolic_angle(k, phase_bits) - x;
+		variance += err * err;
+	}
+
+	return variance / (UNITS * UNITS);
+}
+// }}}
+
+// hyperbolic_quantization_variance
+// {{{
+// As with transform_quantization_variance().  The noise power of each stage
+// still grows as 1+2^(-2*shift), even though the signal itself shrinks.
+double	hyperbolic_quantization_variance(int nstages, int xtrabits,
+		int dropped_bits) {
+	double	current_variance;
+
+	current_variance = pow(2,2*xtrabits)/12.;
+
+	for(int k=0; k<nstages; k++)
+		current_variance = (1+pow(4,-hyperbolic_shift(k)))
+					* current_variance + 1./3.;
+
+	if (dropped_bits > 0)
+		current_variance = pow(2,-2*dropped_bits)*current_variance + 1/12.;
+	return current_variance;
+}
+// }}}
+
+// hyperbolic_cnr
+// {{{
+// The best possible CNR of a hyperbolic core, given a full scale input.
+// Inputs are placed two bits below the top of the working width.
+double	hyperbolic_cnr(int nstages, int iw, int ow, int working_width,
+		int phase_bits) {
+	double	amplitude = (1ul<<(iw-1))-1.,
+		signal_energy, noise_energy;
+
+	amplitude *= (1ul<<((working_width-iw-2)));
+	amplitude *= hyperbolic_gain(nstages, working_width, phase_bits);
+	amplitude *= pow(2.0,-(working_width-ow));
+	signal_energy = amplitude * amplitude;
+
+	noise_energy = hyperbolic_quantization_variance(nstages,
+		working_width-iw-2, working_width-ow);
+	noise_energy += signal_energy
+		* hyperbolic_phase_variance(nstages, phase_bits);
+
+	return 10.0 * log(signal_energy / noise_energy) / log(10.0);
+}
+// }}}
+
+// hyperbolic_angles
+// {{{
+// The hyperbolic analogue of cordic_angles().  Along with the table of
+// angles, this declares HSHIFT, holding the shift of every stage in eight
+// bits apiece.
+void	hyperbolic_angles(FILE *fp, int nstages, int phase_bits) {
+	fprintf(fp,
+		"\t// Hyperbolic angle table\n"
+		"\t// {{{\n"
+		"\t// Stage k rotates by atanh(2^-HSHIFT[k]), where the shifts run\n"
+		"\t// 1, 2, 3, 4, 4, 5, ... 13, 13, ... 40, 40, ...  Shifts 4, 13,\n"
+		"\t// 40, and so on are repeated, else the angles following them\n"
+		"\t// would be too small to make up for them.  Angles are in signed\n"
+		"\t// units of 2^-(PW-2), so the PW-bit angle runs from -2 to 2.\n"
+		"\t//\n"
+		"\twire\t[%d:0]\thyperbolic_angle [0:(NSTAGES-1)];\n"
+		"\tlocalparam\t[(8*NSTAGES-1):0]\tHSHIFT = {",
+		phase_bits-1);
+
+	for(int k=nstages-1; k>=0; k--)
+		fprintf(fp, "%s%s8\'d%d", (k < nstages-1) ? ",":"",
+			(0 == ((nstages-1-k)%8)) ? "\n\t\t\t" : " ",
+			hyperbolic_shift(k));
+	fprintf(fp, " };\n\n");
+
+	for(int k=0; k<nstages; k++) {
+		unsigned long	angle = hyperbolic_angle(k, phase_bits);
+		int		sh = hyperbolic_shift(k);
+
+		if (phase_bits <= 16)
+			fprintf(fp, "\tassign\thyperbolic_angle[%2d] = %2d\'h%0*lx; // atanh(2^-%d)\n",
+				k, phase_bits, (phase_bits+3)/4, angle, sh);
+		else
+			fprintf(fp, "\tassign\thyperbolic_angle[%2d] "
+				"= %2d\'h%0*lx_%04lx; // atanh(2^-%d)\n",
+				k, phase_bits, (phase_bits-16+3)/4,
+				angle >> 16, angle & 0x0ffff, sh);
+	}
+
+	fprintf(fp, "\t// {{{\n");
+	fprintf(fp, "\t// Angle Quantization: %.6f\n",
+			sqrt(hyperbolic_phase_variance(nstages, phase_bits)));
+	fprintf(fp, "\t// }}}\n");
+	fprintf(fp, "\t// }}}\n");
+}
+// }}}
+
+// calc_linear_stages
+// {{{
+// Linear CORDIC stage k adds or subtracts 2^-(k+1) of x from y.  There's no
+// point in going past the last bit of either z or the working width.
+int	calc_linear_stages(const int working_width, const int phase_bits) {
+	int	nstages = phase_bits-1;
+
+	if (nstages > working_width-1)
+		nstages = working_width-1;
+	return nstages;
+}
+// }}}
+
+// linear_residual_variance
+// {{{
+// The linear CORDIC angles, 2^-(k+1), are exact, so the only error in z is
+// what's left over once the last stage is done: something uniform within
+// +/- 2^-nstages.  Returned in units of z^2, where z runs from -1 to 1.
+double	linear_residual_variance(int nstages) {
+	return pow(4.0, -nstages) / 3.;
+}
+// }}}
+
+// linear_quantization_variance
+// {{{
+// As with transform_quantization_variance().  Since x never changes, the
+// noise in y doesn't grow from one stage to the next: each stage adds only
+// its own truncation, and the (shifted) noise of x.
+double	linear_quantization_variance(int nstages, int xtrabits,
+		int dropped_bits) {
+	double	xvar, current_variance;
+
+	xvar = pow(2,2*xtrabits)/12.;
+	current_variance = xvar;
+
+	for(int k=0; k<nstages; k++)
+		current_variance += pow(4,-k-1) * xvar + 1./3.;
+
+	if (dropped_bits > 0)
+		current_variance = pow(2,-2*dropped_bits)*current_variance + 1/12.;
+	return current_variance;
+}
+// }}}
+
+// linear_cnr
+// {{{
+// The best possible CNR of a linear core, given a full scale product.  As
+// with the hyperbolic cores, the inputs are placed one bit down from the top
+// of the working width, to make room for y+x*z.
+double	linear_cnr(int nstages, int iw, int ow, int working_width) {
+	double	amplitude = (1ul<<(iw-1))-1.,
+		signal_energy, noise_energy;
+
+	amplitude *= (1ul<<((working_width-iw-1)));
+	amplitude *= pow(2.0,-(working_width-ow));
+	signal_energy = amplitude * amplitude;
+
+	noise_energy = linear_quantization_variance(nstages,
+		working_width-iw-1, working_width-ow);
+	noise_energy += signal_energy * linear_residual_variance(nstages);
+
+	return 10.0 * log(signal_energy / noise_energy) / log(10.0);
+}
+// }}}
+
+// hybrid_gain
+// {{{
+// The gain of a hybrid ROM+CORDIC core.  The ROM's coarse rotation has a gain
+// of one, so only the CORDIC stages following it, rom_bits and up, count.
+double	hybrid_gain(int nstages, int rom_bits) {
+	return cordic_gain(nstages) / cordic_gain(rom_bits);
+}
+// }}}
+
+// hybrid_phase_variance
+// {{{
+// As with phase_variance(), but only for the CORDIC stages that follow the
+// ROM.  The ROM's angles sit exactly upon the phase grid, and so add no phase
+// error of their own.
+double	hybrid_phase_variance(int nstages, int rom_bits, int phase_bits) {
+	double	RAD_TO_PHASE = (1ul << (phase_bits-1)) / M_PI;
+	double	variance;
+
+	variance = 1./12.;
+	for(int k=rom_bits; k<nstages; k++) {
+		double	x, err;
+
+		x = atan2(1., pow(2,k+1)) * RAD_TO_PHASE;
+		err = (double)cordic_angle(k, phase_bits) - x;
+		variance += err * err;
+	}
+
+	return variance / pow(RAD_TO_PHASE,2.);
+}
+// }}}
+
+// hybrid_quantization_variance
+// {{{
+// The quantization variance of a hybrid core's output vector, summed across
+// o_xval and o_yval, in output units squared.
+//
+// transform_quantization_variance() doesn't fit this core.  It charges an
+// input quantization to inputs that are shifted up exactly, and it charges
+// each stage 1/3 unit^2, the second moment of a full truncation, to each
+// coordinate.  Here, the first error comes from the coarse rotation: its
+// table_width bit cosines and sines are rounded, an error proportional to
+// the (2^(WW-2)) amplitude, and then so are its products.  Each remaining
+// stage truncates its shifted operands by only (k+1) bits, dropping
+// j/2^(k+1) for j uniform on [0,2^(k+1)).  Those errors are then divided by
+// 4^dropped_bits, and the final rounding adds its own.
+double	hybrid_quantization_variance(int nstages, int rom_bits,
+		int working_width, int table_width, int phase_bits,
+		int dropped_bits) {
+	double	amplitude = pow(2.0, working_width-2),
+		variance, dv, mean;
+
+	// The coarse rotation
+	variance = 2.0 * amplitude * amplitude
+			* pow(4.0, -(table_width-1)) / 12.0 + 2.0 / 12.0;
+
+	for(int k=rom_bits; k<nstages; k++) {
+		if ((cordic_angle(k, phase_bits) == 0)||(k >= working_width))
+			continue;
+		mean = (1.0 - pow(2.0, -(k+1))) / 2.0;
+		dv   = mean * mean + (1.0 - pow(4.0, -(k+1))) / 12.0;
+
+		// Any prior error grows with this stage's gain
+		variance = (1.0 + pow(4.0, -(k+1))) * variance + 2.0 * dv;
+	}
+
+	variance *= pow(4.0, -dropped_bits);
+
+	// The output stage drops the extra bits
+	if (dropped_bits > 1)
+		// Round towards even
+		dv = (pow(4.0, dropped_bits) + 2.0) / 12.0
+			/ pow(4.0, dropped_bits);
+	else {
+		// Truncate a single bit
+		mean = 0.25;
+		dv   = mean * mean + (1.0 - 0.25) / 12.0;
+	}
+
+	return variance + 2.0 * dv;
+}
+// }}}
+
+// hybrid_cnr
+// {{{
+// The best possible CNR of a hybrid core, given a full scale input.  As with
+// the basic CORDIC, the inputs are placed one bit down from the top of the
+// working width.
+double	hybrid_cnr(int nstages, int rom_bits, int iw, int ow,
+		int working_width, int table_width, int phase_bits) {
+	double	amplitude = (1ul<<(iw-1))-1.,
+		signal_energy, noise_energy;
+
+	amplitude *= (1ul<<((working_width-iw-1)));
+	amplitude *= hybrid_gain(nstages, rom_bits);
+	amplitude *= pow(2.0,-(working_width-ow));
+	signal_energy = amplitude * amplitude;
+
+	noise_energy = hybrid_quantization_variance(nstages, rom_bits,
+		working_width, table_width, phase_bits,
+		working_width-ow);
+	noise_energy += signal_energy
+		* hybrid_phase_variance(nstages, rom_bits, phase_bits);
+
+	return 10.0 * log(signal_energy / noise_energy) / log(10.0);
+}
+// }}}
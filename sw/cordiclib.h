@@ -46,9 +46,70 @@ extern	int	nextlg(unsigned);
 extern	double	cordic_gain(int nstages);
 extern	double	phase_variance(int nstages, int phase_bits);
 extern	double	transform_quantization_variance(int nstages, int xtrabits, int dropped_bits);
+extern	double	best_possible_cnr(int nstages, int iw, int ow, int working_width, int phase_bits);
+extern	unsigned long	cordic_angle(int k, int phase_bits);
 extern	void	cordic_angles(FILE *fp, int nstages, int phase_bits, bool mem = false);
 extern	int	calc_stages(const int working_width, const int phase_bits);
 extern	int	calc_stages(const int phase_bits);
 extern	int	calc_phase_bits(const int output_width);
+extern	void	lane_copy(FILE *fp, const char *body, const char *const *rename);
+extern	int	active_stages(int nstages, int working_width, int phase_bits);
+extern	int	residual_phase_bits(int nstages, int first, int working_width,
+			int phase_bits);
+extern	void	residual_phase_widths(FILE *fp, int nstages, int first,
+			int working_width, int phase_bits, const char *bound);
+extern	void	unrolled_rotations(FILE *fp, int nactive, int iters,
+			int lgbase, bool vectoring);
+extern	int	radix4_start(int working_width);
+extern	int	radix2_stages(int nstages, int working_width);
+extern	unsigned long	radix4_angle(int shift, int d, int phase_bits);
+extern	int	radix4_stages(int nstages, int working_width, int phase_bits);
+extern	double	radix4_gain(int nstages, int working_width, int phase_bits);
+extern	double	radix4_phase_variance(int nstages, int working_width,
+			int phase_bits);
+extern	double	radix4_quantization_variance(int nstages, int working_width,
+			int phase_bits, int xtrabits, int dropped_bits);
+extern	double	radix4_cnr(int nstages, int iw, int ow, int working_width,
+			int phase_bits);
+extern	void	radix4_angles(FILE *fp, int nstages, int working_width,
+			int phase_bits, bool thresholds);
+extern	void	radix4_rotations(FILE *fp, int nstages, int working_width,
+			int phase_bits, int first, bool vectoring,
+			const char *always_reset, bool with_reset);
+extern	unsigned long	gain_coefficient(double gain, int working_width);
+extern	double	unit_gain_variance(double working_variance, double gain,
+			int dropped_bits);
+extern	double	unit_gain_rotation_variance(int nstages, int working_width,
+			int phase_bits, double gain, int dropped_bits);
+extern	double	unit_gain_cnr(int iw, int ow, int working_width,
+			double variance, double phase_var);
+extern	void	gain_compensation(FILE *fp, int working_width, double gain,
+			int nv, const char *const *src, const char *const *dst,
+			const char *ce);
+extern	int	hyperbolic_shift(int k);
+extern	unsigned long	hyperbolic_angle(int k, int phase_bits);
+extern	int	calc_hyperbolic_stages(const int working_width,
+			const int phase_bits);
+extern	double	hyperbolic_gain(int nstages, int working_width, int phase_bits);
+extern	double	hyperbolic_phase_variance(int nstages, int phase_bits);
+extern	double	hyperbolic_quantization_variance(int nstages, int xtrabits,
+			int dropped_bits);
+extern	double	hyperbolic_cnr(int nstages, int iw, int ow, int working_width,
+			int phase_bits);
+extern	void	hyperbolic_angles(FILE *fp, int nstages, int phase_bits);
+extern	int	calc_linear_stages(const int working_width,
+			const int phase_bits);
+extern	double	linear_residual_variance(int nstages);
+extern	double	linear_quantization_variance(int nstages, int xtrabits,
+			int dropped_bits);
+extern	double	linear_cnr(int nstages, int iw, int ow, int working_width);
+extern	double	hybrid_gain(int nstages, int rom_bits);
+extern	double	hybrid_phase_variance(int nstages, int rom_bits,
+			int phase_bits);
+extern	double	hybrid_quantization_variance(int nstages, int rom_bits,
+			int working_width, int table_width, int phase_bits,
+			int dropped_bits);
+extern	double	hybrid_cnr(int nstages, int rom_bits, int iw, int ow,
+			int working_width, int table_width, int phase_bits);
 
 #endif
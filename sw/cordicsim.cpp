@@ -0,0 +1,755 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/cordicsim.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Software models of the pipelined polar to rectangular and
+//		rectangular to polar CORDICs generated by basiccordic() and
+//	topolar().  See cordicsim.h for details.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "cordiclib.h"
+#include "cordicsim.h"
+
+#if	defined(__x86_64__)
+#include <immintrin.h>
+#define	CORDICSIM_SIMD
+#endif
+
+// sext
+// {{{
+// Sign extend the bottom w bits of v
+static inline long	sext(unsigned long v, int w) {
+	return ((long)(v << (64-w))) >> (64-w);
+}
+// }}}
+
+// simd_lanes
+// {{{
+// Returns the number of samples the vector kernels will process at once, or
+// one if we'll be processing them in scalar code
+static	int	simd_lanes(bool vector_ok) {
+#ifdef	CORDICSIM_SIMD
+	if (vector_ok) {
+		if (__builtin_cpu_supports("avx512f"))
+			return 16;
+		if (__builtin_cpu_supports("avx2"))
+			return 8;
+	}
+#endif
+	return 1;
+}
+// }}}
+
+P2RSIM::P2RSIM(int nstages, int iw, int ow, int nxtra, int phase_bits) {
+	// {{{
+	// Duplicate the width calculations of basiccordic()
+	if (nxtra < 1)
+		nxtra = 1;
+	assert(phase_bits >= 3);
+	assert(iw <= 32 && ow <= 32);
+
+	m_iw = iw;
+	m_ow = ow;
+	m_ww = ((iw < ow) ? ow : iw) + nxtra;
+	m_pw = phase_bits;
+	m_nstages = nstages;
+	assert(m_ww < 64);
+	assert(m_pw < 64);
+
+	// Our angle table is identical to the one in the Verilog
+	m_angle = new unsigned long[nstages];
+	for(int k=0; k<nstages; k++)
+		m_angle[k] = cordic_angle(k, phase_bits);
+	// }}}
+}
+
+P2RSIM::~P2RSIM(void) {
+	delete[] m_angle;
+}
+
+bool	P2RSIM::vector_ok(void) const {
+	return (m_ww <= 32)&&(m_pw <= 32);
+}
+
+int	P2RSIM::lanes(void) const {
+	return simd_lanes(vector_ok());
+}
+
+void	P2RSIM::rotate_scalar(int n, const int *i_xv, const int *i_yv,
+		const unsigned *i_ph, int *o_xv, int *o_yv) const {
+	// {{{
+	const	unsigned long	PMSK = (1ul << m_pw) - 1;
+
+	for(int k=0; k<n; k++) {
+		long		xv, yv, tmp;
+		unsigned long	ph;
+
+		// Sign extend our inputs to the working width
+		xv = sext(i_xv[k], m_iw) * (1l << (m_ww-m_iw-1));
+		yv = sext(i_yv[k], m_iw) * (1l << (m_ww-m_iw-1));
+		ph = i_ph[k] & PMSK;
+
+		// Pre-CORDIC rotation, to within +/- 45 degrees
+		switch((ph >> (m_pw-3)) & 7) {
+		case 1: case 2:	// 45 .. 135
+			tmp = xv; xv = -yv; yv = tmp;
+			ph -= (1ul << (m_pw-2));
+			break;
+		case 3: case 4:	// 135 .. 225
+			xv = -xv; yv = -yv;
+			ph -= (2ul << (m_pw-2));
+			break;
+		case 5: case 6:	// 225 .. 315
+			tmp = xv; xv = yv; yv = -tmp;
+			ph -= (3ul << (m_pw-2));
+			break;
+		default:	// 315 .. 45, no change
+			break;
+		}
+
+		xv = sext(xv, m_ww);
+		yv = sext(yv, m_ww);
+		ph &= PMSK;
+
+		// CORDIC rotations
+		for(int s=0; s<m_nstages; s++) {
+			long	dx, dy;
+
+			if ((m_angle[s] == 0)||(s >= m_ww))
+				continue;
+
+			dx = xv >> (s+1);
+			dy = yv >> (s+1);
+			if ((ph >> (m_pw-1))&1) {
+				xv = sext(xv + dy, m_ww);
+				yv = sext(yv - dx, m_ww);
+				ph = (ph + m_angle[s]) & PMSK;
+			} else {
+				xv = sext(xv - dy, m_ww);
+				yv = sext(yv + dx, m_ww);
+				ph = (ph - m_angle[s]) & PMSK;
+			}
+		}
+
+		// Round towards even, then drop the extra bits
+		if (m_ww > m_ow+1) {
+			xv += (1l << (m_ww-m_ow-1)) - 1 + ((xv >> (m_ww-m_ow))&1);
+			yv += (1l << (m_ww-m_ow-1)) - 1 + ((yv >> (m_ww-m_ow))&1);
+			xv = sext(xv, m_ww);
+			yv = sext(yv, m_ww);
+		}
+
+		o_xv[k] = (int)(xv >> (m_ww-m_ow));
+		o_yv[k] = (int)(yv >> (m_ww-m_ow));
+	}
+	// }}}
+}
+
+#ifdef	CORDICSIM_SIMD
+//
+// The vector kernels
+// {{{
+// Within these kernels, every lane holds one sample.  x and y are kept sign
+// extended from WW bits, so an arithmetic shift right is identical to the
+// Verilog >>> operator.  The phase is kept left aligned within each 32-bit
+// lane, so that wrapping modulo 2^PW comes for free, and the sign of the
+// phase is the sign of the lane.
+//
+// Rather than branching on the phase, each stage calculates
+//	s = (phase < 0) ? 0 : -1
+// and then adds or subtracts by way of (v ^ s) - s, which is v when s is
+// zero and -v otherwise.
+//
+
+// p2r_avx2
+// {{{
+__attribute__((target("avx2")))
+static	int	p2r_avx2(int nstages, int iw, int ow, int ww, int pw,
+		const unsigned long *angle, int n,
+		const int *i_xv, const int *i_yv, const unsigned *i_ph,
+		int *o_xv, int *o_yv) {
+	const	__m128i	INSH = _mm_cvtsi32_si128(32-iw),
+			EXSH = _mm_cvtsi32_si128(33-ww),
+			PHSH = _mm_cvtsi32_si128(32-pw),
+			WWSH = _mm_cvtsi32_si128(32-ww),
+			OWSH = _mm_cvtsi32_si128(ww-ow);
+	const	__m256i	ZERO = _mm256_setzero_si256(),
+			ONE  = _mm256_set1_epi32(1),
+			TWO  = _mm256_set1_epi32(2),
+			OCTANT = _mm256_set1_epi32(1<<29),
+			HALF = _mm256_set1_epi32((ww > ow+1)
+					? (1<<(ww-ow-1))-1 : 0);
+	int	k;
+
+	for(k=0; k+8 <= n; k+=8) {
+		__m256i	xv, yv, ph, q, msk, tmp;
+
+		xv = _mm256_loadu_si256((const __m256i *)&i_xv[k]);
+		yv = _mm256_loadu_si256((const __m256i *)&i_yv[k]);
+		ph = _mm256_loadu_si256((const __m256i *)&i_ph[k]);
+
+		// Sign extend from IW bits, and shift up to the working width
+		xv = _mm256_sra_epi32(_mm256_sll_epi32(xv, INSH), EXSH);
+		yv = _mm256_sra_epi32(_mm256_sll_epi32(yv, INSH), EXSH);
+		ph = _mm256_sll_epi32(ph, PHSH);
+
+		// Pre-CORDIC rotation: q = the nearest multiple of 90 degrees
+		q  = _mm256_srli_epi32(_mm256_add_epi32(ph, OCTANT), 30);
+		ph = _mm256_sub_epi32(ph, _mm256_slli_epi32(q, 30));
+
+		// Rotate by 90 degrees for odd q
+		msk = _mm256_cmpeq_epi32(_mm256_and_si256(q, ONE), ONE);
+		tmp = xv;
+		xv = _mm256_blendv_epi8(xv, _mm256_sub_epi32(ZERO, yv), msk);
+		yv = _mm256_blendv_epi8(yv, tmp, msk);
+
+		// Rotate by 180 degrees for q = 2 or 3
+		msk = _mm256_cmpeq_epi32(_mm256_and_si256(q, TWO), TWO);
+		xv = _mm256_blendv_epi8(xv, _mm256_sub_epi32(ZERO, xv), msk);
+		yv = _mm256_blendv_epi8(yv, _mm256_sub_epi32(ZERO, yv), msk);
+
+		if (ww < 32) {
+			xv = _mm256_sra_epi32(_mm256_sll_epi32(xv, WWSH), WWSH);
+			yv = _mm256_sra_epi32(_mm256_sll_epi32(yv, WWSH), WWSH);
+		}
+
+		// CORDIC rotations
+		for(int s=0; s<nstages; s++) {
+			__m256i	sgn, dx, dy, da;
+			__m128i	sh;
+
+			if ((angle[s] == 0)||(s >= ww))
+				continue;
+
+			sh = _mm_cvtsi32_si128(s+1);
+			da = _mm256_set1_epi32((int)(angle[s] << (32-pw)));
+			sgn= _mm256_xor_si256(_mm256_srai_epi32(ph, 31),
+					_mm256_set1_epi32(-1));
+			dx = _mm256_sra_epi32(xv, sh);
+			dy = _mm256_sra_epi32(yv, sh);
+			dx = _mm256_sub_epi32(_mm256_xor_si256(dx, sgn), sgn);
+			dy = _mm256_sub_epi32(_mm256_xor_si256(dy, sgn), sgn);
+			da = _mm256_sub_epi32(_mm256_xor_si256(da, sgn), sgn);
+
+			xv = _mm256_add_epi32(xv, dy);
+			yv = _mm256_sub_epi32(yv, dx);
+			ph = _mm256_add_epi32(ph, da);
+
+			if (ww < 32) {
+				xv = _mm256_sra_epi32(_mm256_sll_epi32(xv, WWSH), WWSH);
+				yv = _mm256_sra_epi32(_mm256_sll_epi32(yv, WWSH), WWSH);
+			}
+		}
+
+		// Round towards even, then drop the extra bits
+		if (ww > ow+1) {
+			xv = _mm256_add_epi32(xv, _mm256_add_epi32(HALF,
+				_mm256_and_si256(_mm256_srl_epi32(xv, OWSH), ONE)));
+			yv = _mm256_add_epi32(yv, _mm256_add_epi32(HALF,
+				_mm256_and_si256(_mm256_srl_epi32(yv, OWSH), ONE)));
+			if (ww < 32) {
+				xv = _mm256_sra_epi32(_mm256_sll_epi32(xv, WWSH), WWSH);
+				yv = _mm256_sra_epi32(_mm256_sll_epi32(yv, WWSH), WWSH);
+			}
+		}
+
+		_mm256_storeu_si256((__m256i *)&o_xv[k], _mm256_sra_epi32(xv, OWSH));
+		_mm256_storeu_si256((__m256i *)&o_yv[k], _mm256_sra_epi32(yv, OWSH));
+	}
+
+	return k;
+}
+// }}}
+
+// p2r_avx512
+// {{{
+__attribute__((target("avx512f")))
+static	int	p2r_avx512(int nstages, int iw, int ow, int ww, int pw,
+		const unsigned long *angle, int n,
+		const int *i_xv, const int *i_yv, const unsigned *i_ph,
+		int *o_xv, int *o_yv) {
+	const	__m128i	INSH = _mm_cvtsi32_si128(32-iw),
+			EXSH = _mm_cvtsi32_si128(33-ww),
+			PHSH = _mm_cvtsi32_si128(32-pw),
+			WWSH = _mm_cvtsi32_si128(32-ww),
+			OWSH = _mm_cvtsi32_si128(ww-ow);
+	const	__m512i	ZERO = _mm512_setzero_si512(),
+			ONE  = _mm512_set1_epi32(1),
+			TWO  = _mm512_set1_epi32(2),
+			OCTANT = _mm512_set1_epi32(1<<29),
+			HALF = _mm512_set1_epi32((ww > ow+1)
+					? (1<<(ww-ow-1))-1 : 0);
+	// The unmasked shifts are the same instructions, but GCC's headers
+	// trip over -Wmaybe-uninitialized when using them
+	const	__mmask16	ALL = 0xffff;
+	int	k;
+
+	for(k=0; k+16 <= n; k+=16) {
+		__m512i		xv, yv, ph, q, tmp;
+		__mmask16	msk;
+
+		xv = _mm512_loadu_si512(&i_xv[k]);
+		yv = _mm512_loadu_si512(&i_yv[k]);
+		ph = _mm512_loadu_si512(&i_ph[k]);
+
+		// Sign extend from IW bits, and shift up to the working width
+		xv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, xv, INSH), EXSH);
+		yv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, yv, INSH), EXSH);
+		ph = _mm512_maskz_sll_epi32(ALL, ph, PHSH);
+
+		// Pre-CORDIC rotation: q = the nearest multiple of 90 degrees
+		q  = _mm512_maskz_srli_epi32(ALL, _mm512_add_epi32(ph, OCTANT), 30);
+		ph = _mm512_sub_epi32(ph, _mm512_maskz_slli_epi32(ALL, q, 30));
+
+		// Rotate by 90 degrees for odd q
+		msk = _mm512_test_epi32_mask(q, ONE);
+		tmp = xv;
+		xv = _mm512_mask_blend_epi32(msk, xv, _mm512_sub_epi32(ZERO, yv));
+		yv = _mm512_mask_blend_epi32(msk, yv, tmp);
+
+		// Rotate by 180 degrees for q = 2 or 3
+		msk = _mm512_test_epi32_mask(q, TWO);
+		xv = _mm512_mask_sub_epi32(xv, msk, ZERO, xv);
+		yv = _mm512_mask_sub_epi32(yv, msk, ZERO, yv);
+
+		if (ww < 32) {
+			xv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, xv, WWSH), WWSH);
+			yv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, yv, WWSH), WWSH);
+		}
+
+		// CORDIC rotations
+		for(int s=0; s<nstages; s++) {
+			__m512i	sgn, dx, dy, da;
+			__m128i	sh;
+
+			if ((angle[s] == 0)||(s >= ww))
+				continue;
+
+			sh = _mm_cvtsi32_si128(s+1);
+			da = _mm512_set1_epi32((int)(angle[s] << (32-pw)));
+			sgn= _mm512_xor_si512(_mm512_maskz_srai_epi32(ALL, ph, 31),
+					_mm512_set1_epi32(-1));
+			dx = _mm512_maskz_sra_epi32(ALL, xv, sh);
+			dy = _mm512_maskz_sra_epi32(ALL, yv, sh);
+			dx = _mm512_sub_epi32(_mm512_xor_si512(dx, sgn), sgn);
+			dy = _mm512_sub_epi32(_mm512_xor_si512(dy, sgn), sgn);
+			da = _mm512_sub_epi32(_mm512_xor_si512(da, sgn), sgn);
+
+			xv = _mm512_add_epi32(xv, dy);
+			yv = _mm512_sub_epi32(yv, dx);
+			ph = _mm512_add_epi32(ph, da);
+
+			if (ww < 32) {
+				xv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, xv, WWSH), WWSH);
+				yv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, yv, WWSH), WWSH);
+			}
+		}
+
+		// Round towards even, then drop the extra bits
+		if (ww > ow+1) {
+			xv = _mm512_add_epi32(xv, _mm512_add_epi32(HALF,
+				_mm512_and_si512(_mm512_maskz_srl_epi32(ALL, xv, OWSH), ONE)));
+			yv = _mm512_add_epi32(yv, _mm512_add_epi32(HALF,
+				_mm512_and_si512(_mm512_maskz_srl_epi32(ALL, yv, OWSH), ONE)));
+			if (ww < 32) {
+				xv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, xv, WWSH), WWSH);
+				yv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, yv, WWSH), WWSH);
+			}
+		}
+
+		_mm512_storeu_si512(&o_xv[k], _mm512_maskz_sra_epi32(ALL, xv, OWSH));
+		_mm512_storeu_si512(&o_yv[k], _mm512_maskz_sra_epi32(ALL, yv, OWSH));
+	}
+
+	return k;
+}
+// }}}
+// }}}
+#endif	// CORDICSIM_SIMD
+
+void	P2RSIM::rotate(int n, const int *i_xv, const int *i_yv,
+		const unsigned *i_ph, int *o_xv, int *o_yv) const {
+	// {{{
+	int	k = 0;
+
+#ifdef	CORDICSIM_SIMD
+	if (!vector_ok())
+		k = 0;
+	else if (__builtin_cpu_supports("avx512f"))
+		k = p2r_avx512(m_nstages, m_iw, m_ow, m_ww, m_pw, m_angle,
+			n, i_xv, i_yv, i_ph, o_xv, o_yv);
+	else if (__builtin_cpu_supports("avx2"))
+		k = p2r_avx2(m_nstages, m_iw, m_ow, m_ww, m_pw, m_angle,
+			n, i_xv, i_yv, i_ph, o_xv, o_yv);
+#endif
+
+	// Whatever is left over, we do one at a time
+	if (k < n)
+		rotate_scalar(n-k, &i_xv[k], &i_yv[k], &i_ph[k],
+			&o_xv[k], &o_yv[k]);
+	// }}}
+}
+
+R2PSIM::R2PSIM(int nstages, int iw, int ow, int nxtra, int phase_bits) {
+	// {{{
+	// Duplicate the width calculations of topolar(), which adds nxtra
+	// to the working width twice
+	if (nxtra < 2)
+		nxtra = 2;
+	assert(phase_bits >= 3);
+	assert(iw <= 32 && ow <= 32);
+
+	m_iw = iw;
+	m_ow = ow;
+	m_ww = ((iw < ow) ? ow : iw) + 2 * nxtra;
+	m_pw = phase_bits;
+	m_nstages = nstages;
+	assert(m_ww < 64);
+	assert(m_pw < 64);
+
+	m_angle = new unsigned long[nstages];
+	for(int k=0; k<nstages; k++)
+		m_angle[k] = cordic_angle(k, phase_bits);
+	// }}}
+}
+
+R2PSIM::~R2PSIM(void) {
+	delete[] m_angle;
+}
+
+bool	R2PSIM::vector_ok(void) const {
+	return (m_ww <= 32)&&(m_pw <= 32);
+}
+
+int	R2PSIM::lanes(void) const {
+	return simd_lanes(vector_ok());
+}
+
+void	R2PSIM::topolar_scalar(int n, const int *i_xv, const int *i_yv,
+		int *o_mag, unsigned *o_ph) const {
+	// {{{
+	const	unsigned long	PMSK = (1ul << m_pw) - 1;
+
+	for(int k=0; k<n; k++) {
+		long		ex, ey, xv, yv;
+		unsigned long	ph;
+
+		// Sign extend our inputs to the working width
+		ex = sext(i_xv[k], m_iw) * (1l << (m_ww-m_iw-2));
+		ey = sext(i_yv[k], m_iw) * (1l << (m_ww-m_iw-2));
+
+		// Pre-CORDIC rotation, to within +/- 45 degrees
+		switch(((i_xv[k] >> (m_iw-1))&1)*2 + ((i_yv[k] >> (m_iw-1))&1)) {
+		case 1:	// Rotate by -315 degrees
+			xv =  ex - ey; yv =  ex + ey;
+			ph = 7ul << (m_pw-3);
+			break;
+		case 2:	// Rotate by -135 degrees
+			xv = -ex + ey; yv = -ex - ey;
+			ph = 3ul << (m_pw-3);
+			break;
+		case 3:	// Rotate by -225 degrees
+			xv = -ex - ey; yv =  ex - ey;
+			ph = 5ul << (m_pw-3);
+			break;
+		default: // Rotate by -45 degrees
+			xv =  ex + ey; yv = -ex + ey;
+			ph = 1ul << (m_pw-3);
+			break;
+		}
+
+		xv = sext(xv, m_ww);
+		yv = sext(yv, m_ww);
+
+		// CORDIC rotations, driving yv towards zero
+		for(int s=0; s<m_nstages; s++) {
+			long	dx, dy;
+
+			if ((m_angle[s] == 0)||(s >= m_ww))
+				continue;
+
+			dx = xv >> (s+1);
+			dy = yv >> (s+1);
+			if (yv < 0) {
+				xv = sext(xv - dy, m_ww);
+				yv = sext(yv + dx, m_ww);
+				ph = (ph - m_angle[s]) & PMSK;
+			} else {
+				xv = sext(xv + dy, m_ww);
+				yv = sext(yv - dx, m_ww);
+				ph = (ph + m_angle[s]) & PMSK;
+			}
+		}
+
+		// Round towards even, then drop the extra bits
+		if (m_ww > m_ow+1) {
+			xv += (1l << (m_ww-m_ow-1)) - 1 + ((xv >> (m_ww-m_ow))&1);
+			xv = sext(xv, m_ww);
+		}
+
+		o_mag[k] = (int)(xv >> (m_ww-m_ow));
+		o_ph[k]  = (unsigned)ph;
+	}
+	// }}}
+}
+
+#ifdef	CORDICSIM_SIMD
+//
+// The vector kernels
+// {{{
+// These follow the same conventions as the p2r kernels above, save that
+// the direction of each rotation is set by the sign of y rather than the
+// sign of the phase.  The quadrant pre-rotation is done without branches
+// as well.  If a = |x| and b = |y|, each with the sign of the input
+// quadrant applied, then in every quadrant
+//	x' = a + b
+//	y' = (b - a), negated if x and y have different signs
+// and the starting phase is (1 + 2*(sx ^ sy) + 4*sy) * 45 degrees.
+//
+
+// r2p_avx2
+// {{{
+__attribute__((target("avx2")))
+static	int	r2p_avx2(int nstages, int iw, int ow, int ww, int pw,
+		const unsigned long *angle, int n,
+		const int *i_xv, const int *i_yv,
+		int *o_mag, unsigned *o_ph) {
+	const	__m128i	INSH = _mm_cvtsi32_si128(32-iw),
+			EXSH = _mm_cvtsi32_si128(34-ww),
+			PHSH = _mm_cvtsi32_si128(32-pw),
+			WWSH = _mm_cvtsi32_si128(32-ww),
+			OWSH = _mm_cvtsi32_si128(ww-ow);
+	const	__m256i	ONE  = _mm256_set1_epi32(1),
+			PH45 = _mm256_set1_epi32(1<<29),
+			PH90 = _mm256_set1_epi32(2<<29),
+			PH180= _mm256_set1_epi32(4<<29),
+			HALF = _mm256_set1_epi32((ww > ow+1)
+					? (1<<(ww-ow-1))-1 : 0);
+	int	k;
+
+	for(k=0; k+8 <= n; k+=8) {
+		__m256i	xv, yv, ph, sx, sy, m, a, b;
+
+		xv = _mm256_loadu_si256((const __m256i *)&i_xv[k]);
+		yv = _mm256_loadu_si256((const __m256i *)&i_yv[k]);
+
+		// Sign extend from IW bits, and shift up to the working width
+		xv = _mm256_sll_epi32(xv, INSH);
+		yv = _mm256_sll_epi32(yv, INSH);
+		sx = _mm256_srai_epi32(xv, 31);
+		sy = _mm256_srai_epi32(yv, 31);
+		xv = _mm256_sra_epi32(xv, EXSH);
+		yv = _mm256_sra_epi32(yv, EXSH);
+
+		// Pre-CORDIC rotation
+		m  = _mm256_xor_si256(sx, sy);
+		a  = _mm256_sub_epi32(_mm256_xor_si256(xv, sx), sx);
+		b  = _mm256_sub_epi32(_mm256_xor_si256(yv, sy), sy);
+		xv = _mm256_add_epi32(a, b);
+		yv = _mm256_sub_epi32(b, a);
+		yv = _mm256_sub_epi32(_mm256_xor_si256(yv, m), m);
+		ph = _mm256_add_epi32(PH45, _mm256_add_epi32(
+				_mm256_and_si256(m, PH90),
+				_mm256_and_si256(sy, PH180)));
+
+		if (ww < 32) {
+			xv = _mm256_sra_epi32(_mm256_sll_epi32(xv, WWSH), WWSH);
+			yv = _mm256_sra_epi32(_mm256_sll_epi32(yv, WWSH), WWSH);
+		}
+
+		// CORDIC rotations
+		for(int s=0; s<nstages; s++) {
+			__m256i	sgn, dx, dy, da;
+			__m128i	sh;
+
+			if ((angle[s] == 0)||(s >= ww))
+				continue;
+
+			sh = _mm_cvtsi32_si128(s+1);
+			da = _mm256_set1_epi32((int)(angle[s] << (32-pw)));
+			sgn= _mm256_srai_epi32(yv, 31);
+			dx = _mm256_sra_epi32(xv, sh);
+			dy = _mm256_sra_epi32(yv, sh);
+			dx = _mm256_sub_epi32(_mm256_xor_si256(dx, sgn), sgn);
+			dy = _mm256_sub_epi32(_mm256_xor_si256(dy, sgn), sgn);
+			da = _mm256_sub_epi32(_mm256_xor_si256(da, sgn), sgn);
+
+			xv = _mm256_add_epi32(xv, dy);
+			yv = _mm256_sub_epi32(yv, dx);
+			ph = _mm256_add_epi32(ph, da);
+
+			if (ww < 32) {
+				xv = _mm256_sra_epi32(_mm256_sll_epi32(xv, WWSH), WWSH);
+				yv = _mm256_sra_epi32(_mm256_sll_epi32(yv, WWSH), WWSH);
+			}
+		}
+
+		// Round towards even, then drop the extra bits
+		if (ww > ow+1) {
+			xv = _mm256_add_epi32(xv, _mm256_add_epi32(HALF,
+				_mm256_and_si256(_mm256_srl_epi32(xv, OWSH), ONE)));
+			if (ww < 32)
+				xv = _mm256_sra_epi32(_mm256_sll_epi32(xv, WWSH), WWSH);
+		}
+
+		_mm256_storeu_si256((__m256i *)&o_mag[k], _mm256_sra_epi32(xv, OWSH));
+		_mm256_storeu_si256((__m256i *)&o_ph[k], _mm256_srl_epi32(ph, PHSH));
+	}
+
+	return k;
+}
+// }}}
+
+// r2p_avx512
+// {{{
+__attribute__((target("avx512f")))
+static	int	r2p_avx512(int nstages, int iw, int ow, int ww, int pw,
+		const unsigned long *angle, int n,
+		const int *i_xv, const int *i_yv,
+		int *o_mag, unsigned *o_ph) {
+	const	__m128i	INSH = _mm_cvtsi32_si128(32-iw),
+			EXSH = _mm_cvtsi32_si128(34-ww),
+			PHSH = _mm_cvtsi32_si128(32-pw),
+			WWSH = _mm_cvtsi32_si128(32-ww),
+			OWSH = _mm_cvtsi32_si128(ww-ow);
+	const	__m512i	ONE  = _mm512_set1_epi32(1),
+			PH45 = _mm512_set1_epi32(1<<29),
+			PH90 = _mm512_set1_epi32(2<<29),
+			PH180= _mm512_set1_epi32(4<<29),
+			HALF = _mm512_set1_epi32((ww > ow+1)
+					? (1<<(ww-ow-1))-1 : 0);
+	// As with p2r_avx512(), the zero-masked shifts keep GCC quiet
+	const	__mmask16	ALL = 0xffff;
+	int	k;
+
+	for(k=0; k+16 <= n; k+=16) {
+		__m512i	xv, yv, ph, sx, sy, m, a, b;
+
+		xv = _mm512_loadu_si512(&i_xv[k]);
+		yv = _mm512_loadu_si512(&i_yv[k]);
+
+		// Sign extend from IW bits, and shift up to the working width
+		xv = _mm512_maskz_sll_epi32(ALL, xv, INSH);
+		yv = _mm512_maskz_sll_epi32(ALL, yv, INSH);
+		sx = _mm512_maskz_srai_epi32(ALL, xv, 31);
+		sy = _mm512_maskz_srai_epi32(ALL, yv, 31);
+		xv = _mm512_maskz_sra_epi32(ALL, xv, EXSH);
+		yv = _mm512_maskz_sra_epi32(ALL, yv, EXSH);
+
+		// Pre-CORDIC rotation
+		m  = _mm512_xor_si512(sx, sy);
+		a  = _mm512_sub_epi32(_mm512_xor_si512(xv, sx), sx);
+		b  = _mm512_sub_epi32(_mm512_xor_si512(yv, sy), sy);
+		xv = _mm512_add_epi32(a, b);
+		yv = _mm512_sub_epi32(b, a);
+		yv = _mm512_sub_epi32(_mm512_xor_si512(yv, m), m);
+		ph = _mm512_add_epi32(PH45, _mm512_add_epi32(
+				_mm512_and_si512(m, PH90),
+				_mm512_and_si512(sy, PH180)));
+
+		if (ww < 32) {
+			xv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, xv, WWSH), WWSH);
+			yv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, yv, WWSH), WWSH);
+		}
+
+		// CORDIC rotations
+		for(int s=0; s<nstages; s++) {
+			__m512i	sgn, dx, dy, da;
+			__m128i	sh;
+
+			if ((angle[s] == 0)||(s >= ww))
+				continue;
+
+			sh = _mm_cvtsi32_si128(s+1);
+			da = _mm512_set1_epi32((int)(angle[s] << (32-pw)));
+			sgn= _mm512_maskz_srai_epi32(ALL, yv, 31);
+			dx = _mm512_maskz_sra_epi32(ALL, xv, sh);
+			dy = _mm512_maskz_sra_epi32(ALL, yv, sh);
+			dx = _mm512_sub_epi32(_mm512_xor_si512(dx, sgn), sgn);
+			dy = _mm512_sub_epi32(_mm512_xor_si512(dy, sgn), sgn);
+			da = _mm512_sub_epi32(_mm512_xor_si512(da, sgn), sgn);
+
+			xv = _mm512_add_epi32(xv, dy);
+			yv = _mm512_sub_epi32(yv, dx);
+			ph = _mm512_add_epi32(ph, da);
+
+			if (ww < 32) {
+				xv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, xv, WWSH), WWSH);
+				yv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, yv, WWSH), WWSH);
+			}
+		}
+
+		// Round towards even, then drop the extra bits
+		if (ww > ow+1) {
+			xv = _mm512_add_epi32(xv, _mm512_add_epi32(HALF,
+				_mm512_and_si512(_mm512_maskz_srl_epi32(ALL, xv, OWSH), ONE)));
+			if (ww < 32)
+				xv = _mm512_maskz_sra_epi32(ALL, _mm512_maskz_sll_epi32(ALL, xv, WWSH), WWSH);
+		}
+
+		_mm512_storeu_si512(&o_mag[k], _mm512_maskz_sra_epi32(ALL, xv, OWSH));
+		_mm512_storeu_si512(&o_ph[k], _mm512_maskz_srl_epi32(ALL, ph, PHSH));
+	}
+
+	return k;
+}
+// }}}
+// }}}
+#endif	// CORDICSIM_SIMD
+
+void	R2PSIM::topolar(int n, const int *i_xv, const int *i_yv,
+		int *o_mag, unsigned *o_ph) const {
+	// {{{
+	int	k = 0;
+
+#ifdef	CORDICSIM_SIMD
+	if (!vector_ok())
+		k = 0;
+	else if (__builtin_cpu_supports("avx512f"))
+		k = r2p_avx512(m_nstages, m_iw, m_ow, m_ww, m_pw, m_angle,
+			n, i_xv, i_yv, o_mag, o_ph);
+	else if (__builtin_cpu_supports("avx2"))
+		k = r2p_avx2(m_nstages, m_iw, m_ow, m_ww, m_pw, m_angle,
+			n, i_xv, i_yv, o_mag, o_ph);
+#endif
+
+	// Whatever is left over, we do one at a time
+	if (k < n)
+		topolar_scalar(n-k, &i_xv[k], &i_yv[k], &o_mag[k], &o_ph[k]);
+	// }}}
+}
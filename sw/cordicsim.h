@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/cordicsim.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Software models of the pipelined CORDICs: P2RSIM for the polar
+//		to rectangular core generated by basiccordic(), and R2PSIM
+//	for the rectangular to polar core generated by topolar().  Given a
+//	batch of inputs, held as a structure of arrays, these calculate
+//	exactly the outputs the generated core would produce.  The arithmetic
+//	is done eight (AVX2) or sixteen (AVX-512) samples at a time, when the
+//	host supports it, and one sample at a time otherwise.  The two
+//	approaches are bit-identical.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	CORDICSIM_H
+#define	CORDICSIM_H
+
+class	P2RSIM {
+	int	m_iw, m_ow, m_ww, m_pw, m_nstages;
+	unsigned long	*m_angle;
+
+	bool	vector_ok(void) const;
+public:
+	// The arguments are the same as those given to basiccordic()
+	P2RSIM(int nstages, int iw, int ow, int nxtra, int phase_bits);
+	~P2RSIM(void);
+
+	// rotate_scalar
+	// {{{
+	// Rotates n samples, (xv[k], yv[k]), by ph[k], one at a time, placing
+	// the results into ox[k] and oy[k].  Inputs are expected to be sign
+	// extended (x and y) or zero extended (phase), just as the core
+	// would receive them.
+	// }}}
+	void	rotate_scalar(int n, const int *xv, const int *yv,
+			const unsigned *ph, int *ox, int *oy) const;
+
+	// rotate
+	// {{{
+	// Same as rotate_scalar(), only using the widest vector instructions
+	// this host supports.  Configurations too wide for 32-bit lanes
+	// (WW > 32 or PW > 32) fall back to rotate_scalar().
+	// }}}
+	void	rotate(int n, const int *xv, const int *yv,
+			const unsigned *ph, int *ox, int *oy) const;
+
+	int	nstages(void) const { return m_nstages; }
+	int	working_width(void) const { return m_ww; }
+	// Returns the number of lanes rotate() will process at once
+	int	lanes(void) const;
+};
+
+class	R2PSIM {
+	int	m_iw, m_ow, m_ww, m_pw, m_nstages;
+	unsigned long	*m_angle;
+
+	bool	vector_ok(void) const;
+public:
+	// The arguments are the same as those given to topolar()
+	R2PSIM(int nstages, int iw, int ow, int nxtra, int phase_bits);
+	~R2PSIM(void);
+
+	// topolar_scalar
+	// {{{
+	// Converts n samples, (xv[k], yv[k]), to polar form, one at a time,
+	// placing the magnitude into mag[k] and the phase into ph[k].  As with
+	// the core, the magnitude includes the CORDIC gain, and the phase is
+	// returned as an unsigned PW-bit value.
+	// }}}
+	void	topolar_scalar(int n, const int *xv, const int *yv,
+			int *mag, unsigned *ph) const;
+
+	// topolar
+	// {{{
+	// Same as topolar_scalar(), only using the widest vector instructions
+	// this host supports, under the same restrictions as P2RSIM::rotate().
+	// }}}
+	void	topolar(int n, const int *xv, const int *yv,
+			int *mag, unsigned *ph) const;
+
+	int	nstages(void) const { return m_nstages; }
+	int	working_width(void) const { return m_ww; }
+	// Returns the number of lanes topolar() will process at once
+	int	lanes(void) const;
+};
+
+#endif	// CORDICSIM_H
@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/explore.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Searches the design space of the CORDIC cores, rather than
+//		generating any one of them.  Every combination of extra bits,
+//	phase bits, and stages is evaluated, across a pool of threads, for its
+//	best possible carrier to noise ratio and an estimate of its hardware
+//	cost.  The designs that are not beaten on both counts by some other
+//	design of the same type--the Pareto front--are then printed, together
+//	with the command line that will generate each.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "cordiclib.h"
+#include "explore.h"
+
+// The ranges we sweep over, when not given a fixed value
+static	const	int	MAX_XTRA = 8,	// -x values of 0 through 8
+			PHASE_BELOW = 6,// Phase bits below the default
+			PHASE_ABOVE = 4,// Phase bits above the default
+			MIN_STAGES = 4;
+
+// CORE_TYPE
+// {{{
+typedef	enum	{ CT_P2R, CT_R2P, CT_SP2R, CT_SR2P, CT_NTYPES } CORE_TYPE;
+
+static	const char	*CORE_NAME[CT_NTYPES] = {
+	"p2r", "r2p", "sp2r", "sr2p"
+};
+// }}}
+
+// DESIGN_POINT
+// {{{
+// One point in our design space, and what we learned about it
+typedef	struct	{
+	CORE_TYPE	m_type;
+	int	m_xtra,	// The -x argument, as given on the command line
+		m_ww,	// The working width the core will use internally
+		m_pw, m_nstages;
+	// Outputs
+	long	m_regs, m_logic;
+	int	m_clocks;	// Clocks per output
+	double	m_cnr;		// Best possible CNR, in dB
+} DESIGN_POINT;
+// }}}
+
+// working_width
+// {{{
+// Calculate the working width each core type will use, duplicating the
+// adjustments main() makes to -x, and those each generator then makes in
+// turn.
+static	int	working_width(CORE_TYPE ct, int iw, int ow, int xtra) {
+	int	ww = (iw > ow) ? iw : ow, nxtra;
+
+	switch(ct) {
+	case CT_P2R: case CT_SP2R:
+		// main() adds one, basiccordic() requires at least one
+		nxtra = xtra + 1;
+		if (nxtra < 1)
+			nxtra = 1;
+		return ww + nxtra;
+	default:
+		// main() adds two, topolar() requires at least two, and
+		// then uses them twice
+		nxtra = xtra + 2;
+		if (nxtra < 2)
+			nxtra = 2;
+		return ww + 2 * nxtra;
+	}
+}
+// }}}
+
+// evaluate
+// {{{
+// Estimate the accuracy and cost of one design point.  The cost is an
+// estimate only: it counts the bits of every register in the design, and
+// the bits of every adder and shifter multiplexer, but ignores control
+// logic.
+static	void	evaluate(DESIGN_POINT &d, int iw, int ow) {
+	const	int	ww = d.m_ww, pw = d.m_pw, ns = d.m_nstages;
+	const	long	stage = 2*ww + pw;	// One x, y, and phase
+	const	bool	round = (ww > ow+1);
+
+	switch(d.m_type) {
+	case CT_P2R:
+		// {{{
+		// A pre-rotation stage, NSTAGES CORDIC stages, then an output
+		// stage of two OW-bit values
+		d.m_regs  = (ns + 1) * stage + 2 * ow;
+		d.m_logic = stage + ns * stage + (round ? 2 * ww : 0);
+		d.m_clocks= 1;
+		break;
+		// }}}
+	case CT_R2P:
+		// {{{
+		// As above, but only a magnitude is rounded and returned
+		d.m_regs  = (ns + 1) * stage + ow + pw;
+		d.m_logic = stage + ns * stage + (round ? ww : 0);
+		d.m_clocks= 1;
+		break;
+		// }}}
+	case CT_SP2R:
+		// {{{
+		// One stage, used NSTAGES times, plus the registered angle and
+		// a state counter.  Each shifter costs one mux bit per bit
+		// per shift stage.
+		d.m_regs  = stage + pw + nextlg(ns+1) + 2 * ow;
+		d.m_logic = stage + stage + 2 * ww * nextlg(ns)
+				+ (round ? 2 * ww : 0);
+		d.m_clocks= ns + 1;
+		break;
+		// }}}
+	case CT_SR2P:
+		// {{{
+		d.m_regs  = stage + pw + nextlg(ns+1) + ow + pw;
+		d.m_logic = stage + stage + 2 * ww * nextlg(ns)
+				+ (round ? ww : 0);
+		d.m_clocks= ns + 3;
+		break;
+		// }}}
+	default:
+		assert(0);
+	}
+
+	// best_possible_cnr() assumes enough stages that the CORDIC has
+	// converged.  Here, we may have fewer.  The angle left over after
+	// the last stage is (roughly) uniform over +/- atan(2^-NSTAGES), so
+	// add that to our phase noise.
+	{
+		double	residual = atan2(1., pow(2., ns)), signal, noise;
+
+		signal = pow(10., best_possible_cnr(ns, iw, ow, ww, pw) / 10.);
+		noise  = 1.0 + signal * residual * residual / 3.;
+		d.m_cnr = 10.0 * log10(signal / noise);
+	}
+}
+// }}}
+
+void	explore(FILE *fp, const char *ctype, int iw, int ow,
+		int nxtra, int phase_bits, int nstages, int nthreads) {
+	// {{{
+	std::vector<DESIGN_POINT>	points;
+
+	// Enumerate the design space
+	// {{{
+	for(int ct=0; ct<CT_NTYPES; ct++) {
+		if ((ctype)&&(strcmp(ctype, CORE_NAME[ct]) != 0))
+			continue;
+
+		for(int xtra = (nxtra >= 0) ? nxtra : 0;
+				xtra <= ((nxtra >= 0) ? nxtra : MAX_XTRA);
+				xtra++) {
+			int	ww, pwlo, pwhi;
+
+			ww = working_width((CORE_TYPE)ct, iw, ow, xtra);
+			if (phase_bits > 0)
+				pwlo = pwhi = phase_bits;
+			else {
+				pwlo = calc_phase_bits(ww) - PHASE_BELOW;
+				pwhi = calc_phase_bits(ww) + PHASE_ABOVE;
+				if (pwlo < 3)
+					pwlo = 3;
+				if (pwhi > 48)
+					pwhi = 48;
+			}
+
+			for(int pw=pwlo; pw <= pwhi; pw++) {
+				int	nslo, nshi;
+
+				if (nstages > 0)
+					nslo = nshi = nstages;
+				else {
+					nshi = ((ct == CT_P2R)||(ct == CT_SP2R))
+						? calc_stages(ww, pw)
+						: calc_stages(pw);
+					nslo = (nshi < MIN_STAGES)
+						? nshi : MIN_STAGES;
+				}
+
+				for(int ns=nslo; ns<=nshi; ns++) {
+					DESIGN_POINT	d;
+
+					memset(&d, 0, sizeof(d));
+					d.m_type    = (CORE_TYPE)ct;
+					d.m_xtra    = xtra;
+					d.m_ww      = ww;
+					d.m_pw      = pw;
+					d.m_nstages = ns;
+					points.push_back(d);
+				}
+			}
+		}
+	}
+	// }}}
+
+	// Evaluate every point, across a pool of threads
+	// {{{
+	{
+		std::atomic<size_t>		next(0);
+		std::vector<std::thread>	pool;
+
+		if (nthreads <= 0)
+			nthreads = std::thread::hardware_concurrency();
+		if (nthreads <= 0)
+			nthreads = 1;
+
+		for(int k=0; k<nthreads; k++) {
+			pool.push_back(std::thread([&]() {
+				size_t	idx;
+
+				while((idx = next++) < points.size())
+					evaluate(points[idx], iw, ow);
+			}));
+		}
+
+		for(auto &t : pool)
+			t.join();
+	}
+	// }}}
+
+	fprintf(fp, "Explored %ld designs, IW = %d, OW = %d, using %d thread%s\n",
+		(long)points.size(), iw, ow, nthreads,
+		(nthreads == 1) ? "" : "s");
+
+	// Report the Pareto front of each core type
+	// {{{
+	// Sort by type, then by cost, and then by descending CNR.  Walking
+	// through the list, a point is on the front if it has a better CNR
+	// than every cheaper point of its type, by at least the 0.01dB we
+	// print.
+	std::sort(points.begin(), points.end(),
+		[](const DESIGN_POINT &a, const DESIGN_POINT &b) {
+			if (a.m_type != b.m_type)
+				return a.m_type < b.m_type;
+			if (a.m_regs + a.m_logic != b.m_regs + b.m_logic)
+				return a.m_regs + a.m_logic
+					< b.m_regs + b.m_logic;
+			return a.m_cnr > b.m_cnr;
+		});
+
+	for(int ct=0; ct<CT_NTYPES; ct++) {
+		double	best = -1e9;
+		bool	header = false;
+
+		for(const DESIGN_POINT &d : points) {
+			if (d.m_type != ct)
+				continue;
+			// Require an improvement we can see in our output
+			if (d.m_cnr < best + 0.01)
+				continue;
+			best = d.m_cnr;
+
+			if (!header) {
+				fprintf(fp, "\n%s Pareto front:\n"
+				"%8s %5s %4s %4s %4s %6s %6s %6s   %s\n",
+					CORE_NAME[ct],
+					"CNR(dB)", "Clks", "WW", "PW", "NS",
+					"Regs", "Logic", "Cost",
+					"Command line");
+				header = true;
+			}
+
+			fprintf(fp, "%8.2f %5d %4d %4d %4d %6ld %6ld %6ld   "
+				"gencordic -t %s -i %d -o %d -x %d -p %d -n %d\n",
+				d.m_cnr, d.m_clocks, d.m_ww, d.m_pw,
+				d.m_nstages, d.m_regs, d.m_logic,
+				d.m_regs + d.m_logic,
+				CORE_NAME[ct], iw, ow, d.m_xtra, d.m_pw,
+				d.m_nstages);
+		}
+	}
+	// }}}
+	// }}}
+}
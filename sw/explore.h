@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/explore.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Searches the design space of the CORDIC cores, rather than
+//		generating any one of them.  Every combination of extra bits,
+//	phase bits, and stages is evaluated, across a pool of threads, for its
+//	best possible carrier to noise ratio and an estimate of its hardware
+//	cost.  The designs that are not beaten on both counts by some other
+//	design of the same type--the Pareto front--are then printed, together
+//	with the command line that will generate each.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	EXPLORE_H
+#define	EXPLORE_H
+
+#include <stdio.h>
+
+// explore()
+// {{{
+// Any of nxtra, phase_bits, or nstages given as a positive value (or, for
+// nxtra, zero or more) is held fixed.  Otherwise it is swept.  If ctype is
+// non-NULL, only that type of core ("p2r", "r2p", "sp2r", or "sr2p") is
+// explored.  nthreads <= 0 uses every available processor.
+// }}}
+extern	void	explore(FILE *fp, const char *ctype, int iw, int ow,
+			int nxtra, int phase_bits, int nstages,
+			int nthreads = 0);
+
+#endif	// EXPLORE_H
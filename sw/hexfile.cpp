@@ -42,16 +42,39 @@
 #include <math.h>
 #include <assert.h>
 
+#include "hexfile.h"
+
 const	char	*DEFAULT_EXTENSION = ".hex";
 
+// Output is formatted into a local buffer, and only handed to stdio once
+// the buffer is (nearly) full.  Each line of the file is an address of at
+// most sixteen hex digits plus eight entries of at most sixteen hex digits
+// each, so HEXLINE bytes is always enough room for one more line.
+#define	HEXBUFLEN	(1<<16)
+#define	HEXLINE		160
+
+static	const	char	HEXDIGITS[] = "0123456789abcdef";
+
+// hexout
+// {{{
+// Write v as exactly nc lower case hex digits, zero padded, and return a
+// pointer to the character following them.
+static inline char *hexout(char *ptr, unsigned long v, int nc) {
+	for(int i=nc-1; i>=0; i--) {
+		ptr[i] = HEXDIGITS[v & 0x0f];
+		v >>= 4;
+	} return ptr + nc;
+}
+// }}}
+
 void	hextable(const char *fname, const int lgtable, const int ow,
-		const long *data, const char *extension) {
+		HEXGEN gen, void *arg, const char *extension) {
 	FILE	*hexfp;
 	char	*hexfname;
 
-	if (ow >= 31) {
+	if (ow > MAX_HEXTABLE_OW) {
 		printf("Internal err: output width too large for internal data type");
-		assert(ow < 31);
+		assert(ow <= MAX_HEXTABLE_OW);
 	}
 
 	if (lgtable < 2) {
@@ -59,6 +82,11 @@ void	hextable(const char *fname, const int lgtable, const int ow,
 		assert(lgtable >= 2);
 	}
 
+	if (lgtable > MAX_HEXTABLE_LG) {
+		printf("Internal err: Hex-table size is too large\n");
+		assert(lgtable <= MAX_HEXTABLE_LG);
+	}
+
 	// Append .hex to the filename
 	int slen = strlen(fname);
 	hexfname = new char [strlen(fname)+strlen(extension)+3];
@@ -74,21 +102,57 @@ void	hextable(const char *fname, const int lgtable, const int ow,
 		fprintf(stderr, "ERR: Cannot open %s for writing\n",
 			hexfname);
 	} else {
-		// Write the entriess to it.
-		int	tbl_entries = (1<<lgtable), nc = (ow+3)/4;
-		long	msk = (1l<<ow)-1l;
+		// Write the entries to it.  Addresses are written with
+		// (at least) eight hex digits, more only if the table needs
+		// them.
+		long	tbl_entries = (1l<<lgtable),
+			msk = (long)((1ul<<ow)-1ul);
+		int	nc = (ow+3)/4, na = (lgtable+3)/4;
+		char	*buf = new char[HEXBUFLEN], *ptr = buf;
+
+		if (na < 8)
+			na = 8;
+		for(long k=0; k<tbl_entries; k++) {
+			long	v = gen(k, arg);
 
-		for(int k=0; k<tbl_entries; k++) {
-			if (data[k] > 0)
-				assert(data[k] <= msk);
+			if (v > 0)
+				assert(v <= msk);
 			else
-				assert(data[k] >= -msk-1);
-			if (0 == (k%8))
-				fprintf(hexfp, "%s@%08x ", (k!=0)?"\n":"", k);
-			fprintf(hexfp, "%0*lx ", nc, data[k] & msk);
-		} fprintf(hexfp, "\n");
+				assert(v >= -msk-1);
+			if (0 == (k%8)) {
+				if (ptr - buf > HEXBUFLEN - HEXLINE) {
+					fwrite(buf, 1, ptr-buf, hexfp);
+					ptr = buf;
+				}
+
+				if (k != 0)
+					*ptr++ = '\n';
+				*ptr++ = '@';
+				ptr = hexout(ptr, k, na);
+				*ptr++ = ' ';
+			}
+			ptr = hexout(ptr, v & msk, nc);
+			*ptr++ = ' ';
+		} *ptr++ = '\n';
+
+		fwrite(buf, 1, ptr-buf, hexfp);
+		fclose(hexfp);
+		delete[] buf;
 	}
 
-	fclose(hexfp);
 	delete[] hexfname;
 }
+
+// arraygen
+// {{{
+// The generator behind the array form of hextable(): entry k of the table
+// is simply element k of the array.
+static	long	arraygen(long k, void *arg) {
+	return ((const long *)arg)[k];
+}
+// }}}
+
+void	hextable(const char *fname, const int lgtable, const int ow,
+		const long *data, const char *extension) {
+	hextable(fname, lgtable, ow, arraygen, (void *)data, extension);
+}
@@ -40,6 +40,19 @@
 #define	HEXTABLE_H
 
 extern const char *DEFAULT_EXTENSION; // =".hex";
+
+// A table generator: returns the value of table entry k.  The arg pointer
+// is passed through from hextable() untouched.
+typedef	long	(*HEXGEN)(long k, void *arg);
+
+// Tables may hold entries of up to 63 bits, and up to 2^MAX_HEXTABLE_LG
+// entries.
+#define	MAX_HEXTABLE_OW	63
+#define	MAX_HEXTABLE_LG	40
+
+void	hextable(const char *fname, const int lgtable, const int ow,
+		HEXGEN gen, void *arg,
+		const char *extension = DEFAULT_EXTENSION);
 void	hextable(const char *fname, const int lgtable, const int ow,
 		const long *data, const char *extension = DEFAULT_EXTENSION);
 
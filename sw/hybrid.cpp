@@ -0,0 +1,759 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/hybrid.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates a hybrid ROM and CORDIC polar to rectangular core.
+//	See hybrid.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "hexfile.h"
+#include "hybrid.h"
+
+// hybrid_rom
+// {{{
+// Entry addr of the coarse rotation table.  The address is the signed
+// number of ROM steps, each 90/2^rom_bits degrees wide, between the top of
+// the (octant reduced) phase and zero.  Each entry holds the cosine (or sine)
+// of the angle in the middle of its step, scaled by 2^(TW-1).  The header's
+// model repeats this calculation, so any change here must be made there too.
+typedef	struct	HYBRIDROM_S {
+	int	m_lgrom, m_width;
+	bool	m_sine;
+} HYBRIDROM;
+
+static	long	hybrid_rom(long addr, void *arg) {
+	const	HYBRIDROM *hr = (const HYBRIDROM *)arg;
+	long	idx, v;
+	double	angle;
+
+	idx = (addr < (1l << (hr->m_lgrom-1))) ? addr
+					: addr - (1l << hr->m_lgrom);
+	angle = M_PI * (2*idx+1) / (double)(1l << (hr->m_lgrom+2));
+	v = lround(ldexp((hr->m_sine) ? sin(angle) : cos(angle),
+					hr->m_width-1));
+	if (v >= (1l << (hr->m_width-1)))
+		v = (1l << (hr->m_width-1)) - 1;
+	return v;
+}
+// }}}
+
+static	void	hybrid_model(FILE *fhp, int nstages, int ow, int ww,
+		int phase_bits) {
+	// {{{
+	assert(ww < 64);
+	assert(phase_bits < 64);
+
+	fprintf(fhp,
+"\n"
+"// Bit-exact model\n"
+"// {{{\n"
+"// The following duplicates, in integer arithmetic, the logic of the core\n"
+"// above: the same octant pre-rotation, the same coarse rotation table and\n"
+"// rounded products, the same truncated CORDIC angles, the same shifts, and\n"
+"// the same round-towards-even output stage.  Given the same inputs,\n"
+"// cordic_model() will return exactly what the core will produce on o_xval\n"
+"// and o_yval LATENCY clocks later.\n"
+"//\n"
+"#define\tHAS_CORDIC_MODEL\n\n"
+"#include <math.h>\n\n");
+
+	fprintf(fhp, "static const unsigned long\tCORDIC_ANGLE[%d] = {", nstages);
+	for(int k=0; k<nstages; k++) {
+		fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+			(0 == (k%4)) ? "\n\t" : " ",
+			(phase_bits+3)/4, cordic_angle(k, phase_bits));
+	} fprintf(fhp, "\n};\n\n");
+
+	fprintf(fhp,
+"// Sign extend the bottom w bits of v\n"
+"static inline long\tcordic_sext(unsigned long v, int w) {\n"
+"\treturn ((long)(v << (64-w))) >> (64-w);\n"
+"}\n\n");
+
+	fprintf(fhp,
+"// Entry addr of the coarse rotation table, as written to the .hex files\n"
+"static inline long\thybrid_rom(unsigned long addr, bool sine) {\n"
+"\tlong\tidx, v;\n"
+"\tdouble\tangle;\n"
+"\n"
+"\tidx = (addr < (1ul << (LGROM-1))) ? (long)addr\n"
+"\t\t\t\t\t: (long)addr - (1l << LGROM);\n"
+"\tangle = M_PI * (2*idx+1) / (double)(1l << (LGROM+2));\n"
+"\tv = lround(ldexp((sine) ? sin(angle) : cos(angle), TW-1));\n"
+"\tif (v >= (1l << (TW-1)))\n"
+"\t\tv = (1l << (TW-1)) - 1;\n"
+"\treturn v;\n"
+"}\n\n");
+
+	fprintf(fhp,
+"static inline void\tcordic_model(long i_xval, long i_yval,\n"
+"\t\tunsigned long i_phase, long &o_xval, long &o_yval) {\n"
+"\tconst\tunsigned long	PMSK = (1ul << PW) - 1;\n"
+"\tlong\t\txv, yv, tmp, cv, sv;\n"
+"\tunsigned long\tph, addr;\n"
+"\t__int128\tpx, py;\n"
+"\n"
+"\t// Sign extend our inputs to the working width\n"
+"\txv = cordic_sext(i_xval, IW) * (1l << (WW-IW-1));\n"
+"\tyv = cordic_sext(i_yval, IW) * (1l << (WW-IW-1));\n"
+"\tph = i_phase & PMSK;\n"
+"\n"
+"\t// Pre-CORDIC rotation, to within +/- 45 degrees\n"
+"\tswitch((ph >> (PW-3)) & 7) {\n"
+"\tcase 1: case 2:\t// 45 .. 135\n"
+"\t\ttmp = xv; xv = -yv; yv = tmp;\n"
+"\t\tbreak;\n"
+"\tcase 3: case 4:\t// 135 .. 225\n"
+"\t\txv = -xv; yv = -yv;\n"
+"\t\tbreak;\n"
+"\tcase 5: case 6:\t// 225 .. 315\n"
+"\t\ttmp = xv; xv = yv; yv = -tmp;\n"
+"\t\tbreak;\n"
+"\tdefault:\t// 315 .. 45, no change\n"
+"\t\tbreak;\n"
+"\t}\n"
+"\n"
+"\txv = cordic_sext(xv, WW);\n"
+"\tyv = cordic_sext(yv, WW);\n"
+"\n"
+"\t// Coarse rotation, by the angle in the middle of this ROM step\n"
+"\taddr = (ph >> (PW-2-LGROM)) & ((1ul << LGROM)-1);\n"
+"\tcv = hybrid_rom(addr, false);\n"
+"\tsv = hybrid_rom(addr, true);\n"
+"\tph = ((long)(ph & ((1ul << (PW-2-LGROM))-1))\n"
+"\t\t\t- (1l << (PW-3-LGROM))) & PMSK;\n"
+"\n"
+"\tpx = (__int128)xv * cv - (__int128)yv * sv\n"
+"\t\t\t+ ((__int128)1 << (TW-2));\n"
+"\tpy = (__int128)xv * sv + (__int128)yv * cv\n"
+"\t\t\t+ ((__int128)1 << (TW-2));\n"
+"\txv = cordic_sext((long)(px >> (TW-1)), WW);\n"
+"\tyv = cordic_sext((long)(py >> (TW-1)), WW);\n"
+"\n"
+"\t// The remaining CORDIC rotations\n"
+"\tfor(int k=LGROM; k<NSTAGES; k++) {\n"
+"\t\tlong\tdx, dy;\n"
+"\n"
+"\t\tif ((CORDIC_ANGLE[k] == 0)||(k >= WW))\n"
+"\t\t\tcontinue;\n"
+"\n"
+"\t\tdx = xv >> (k+1);\n"
+"\t\tdy = yv >> (k+1);\n"
+"\t\tif ((ph >> (PW-1))&1) {\n"
+"\t\t\t// Negative phase, rotate clockwise\n"
+"\t\t\txv = cordic_sext(xv + dy, WW);\n"
+"\t\t\tyv = cordic_sext(yv - dx, WW);\n"
+"\t\t\tph = (ph + CORDIC_ANGLE[k]) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\t// Positive phase, rotate counter-clockwise\n"
+"\t\t\txv = cordic_sext(xv - dy, WW);\n"
+"\t\t\tyv = cordic_sext(yv + dx, WW);\n"
+"\t\t\tph = (ph - CORDIC_ANGLE[k]) & PMSK;\n"
+"\t\t}\n"
+"\t}\n"
+"\n");
+
+	if (ww > ow+1) {
+		fprintf(fhp,
+"\t// Round towards even, then drop the extra bits\n"
+"\tif ((xv >> (WW-OW)) & 1)\n"
+"\t\txv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\txv += (1l << (WW-OW-1)) - 1;\n"
+"\tif ((yv >> (WW-OW)) & 1)\n"
+"\t\tyv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\tyv += (1l << (WW-OW-1)) - 1;\n"
+"\txv = cordic_sext(xv, WW);\n"
+"\tyv = cordic_sext(yv, WW);\n\n");
+	} else
+		fprintf(fhp,
+"\t// No rounding required\n");
+
+	fprintf(fhp,
+"\to_xval = xv >> (WW-OW);\n"
+"\to_yval = yv >> (WW-OW);\n"
+"}\n"
+"// }}}\n");
+	// }}}
+}
+
+int	hybridcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+		int nstages, int iw, int ow, int nxtra, int phase_bits,
+		int rom_bits, bool with_reset, bool with_aux, bool async_reset) {
+	// {{{
+	int	working_width = iw, table_width, latency;
+	const	char *name;
+	char	*noext;
+	const	char PURPOSE[] =
+	"This file executes a vector rotation on the values\n"
+	"//\t\t(i_xval, i_yval).  This vector is rotated left by\n"
+	"//\ti_phase.  i_phase is given by the angle, in radians, multiplied by\n"
+	"//\t2^32/(2pi).  In that fashion, a two pi value is zero just as a zero\n"
+	"//\tangle is zero.\n"
+	"//\n"
+	"//\tRather than starting with the largest CORDIC angles, this core\n"
+	"//\tlooks up the cosine and sine of the top LGROM bits of the phase\n"
+	"//\t(following the octant), and rotates by them with one complex\n"
+	"//\tmultiply.  Only the CORDIC stages from LGROM on are then required.",
+		HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+
+	legal(fp, fname, PROJECT, PURPOSE, cmdline);
+	if (nxtra < 1)
+		nxtra = 1;
+	assert(phase_bits >= rom_bits + 4);
+	assert(fname);
+
+	if (working_width < ow)
+		working_width = ow;
+	working_width += nxtra;
+
+	// As with the basic core, drop any stages at the end that would only
+	// pass their inputs along
+	nstages = active_stages(nstages, working_width, phase_bits);
+	assert(rom_bits >= 2);
+	assert(rom_bits < nstages);
+
+	// The table entries are as wide as the working width.  The error in
+	// each is then at most a quarter of a working LSB, for a full scale
+	// (2^(WW-2)) input.
+	table_width = working_width;
+	assert(table_width <= MAX_HEXTABLE_OW);
+
+	// One clock each for the pre-rotation and table lookup, the products,
+	// and their sums, then one for each CORDIC stage, and one to round.
+	latency = nstages - rom_bits + 4;
+
+	std::string	resetw = (!with_reset)?""
+			: ((async_reset)?"i_areset_n" : "i_reset");
+	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+				"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+				"\tif (i_reset)\n";
+
+	name = modulename(fname);
+	noext = strdup(fname);
+	{
+		char *ptr;
+		if (NULL != (ptr = strrchr(noext, '.')))
+			*ptr = '\0';
+	}
+
+	// Write out the two coarse rotation tables
+	// {{{
+	{
+		HYBRIDROM	hr;
+		std::string	tname;
+
+		hr.m_lgrom = rom_bits;
+		hr.m_width = table_width;
+
+		hr.m_sine  = false;
+		tname = std::string(noext) + "_cos";
+		hextable(tname.c_str(), rom_bits, table_width, hybrid_rom, &hr);
+
+		hr.m_sine  = true;
+		tname = std::string(noext) + "_sin";
+		hextable(tname.c_str(), rom_bits, table_width, hybrid_rom, &hr);
+	}
+	// }}}
+
+	// Module declaration
+	// {{{
+	fprintf(fp, "`default_nettype\tnone\n");
+	fprintf(fp,
+		"module	%s#(\n"
+		"\t\t// {{{\n"
+		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\tLGROM=%2d,\t// Phase bits looking up the ROM\n"
+		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tTW=%2d,\t// Bits in each ROM entry\n"
+		"\t\t\tPW=%2d\t// Bits in our phase variables\n"
+		"\t\t// }}}\n"
+		"\t) (\n"
+		"\t\t// {{{\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce,\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\t\ti_xval, i_yval,\n"
+		"\tinput\twire\t\t[(PW-1):0]\t\t\ti_phase,\n"
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_xval, o_yval%s\n",
+		name, iw, ow, nstages, rom_bits, nxtra,
+		working_width, table_width, phase_bits,
+		resetw.c_str(), (with_reset)?", ":"", (with_aux)?",":"");
+
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux,\n"
+			"\toutput\treg\t\t\t\to_aux\n");
+	} fprintf(fp, "\t\t// }}}\n\t);\n\n");
+	// }}}
+
+	// Declarations
+	// {{{
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n"
+		"\t// {{{\n"
+		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n"
+		"\treg	signed	[(WW-1):0]\tpre_xv, pre_yv;\n"
+		"\treg		[(PW-1):0]\tpre_ph, mpy_ph;\n"
+		"\treg	signed	[(TW-1):0]\tcostbl\t[0:((1<<LGROM)-1)];\n"
+		"\treg	signed	[(TW-1):0]\tsintbl\t[0:((1<<LGROM)-1)];\n"
+		"\treg	signed	[(TW-1):0]\tr_cos, r_sin;\n"
+		"\treg	signed	[(WW+TW-1):0]\tp_xcos, p_ysin, p_xsin, p_ycos;\n"
+		"\twire	signed	[(WW+TW):0]\tw_xrot, w_yrot;\n"
+		"\treg	signed	[(WW-1):0]\txv\t[LGROM:(NSTAGES)];\n"
+		"\treg	signed	[(WW-1):0]\tyv\t[LGROM:(NSTAGES)];\n"
+		"\treg		[(PW-1):0]\tph\t[LGROM:(NSTAGES)];\n");
+	if (with_aux)
+		fprintf(fp, "\treg\t\t[(NSTAGES-LGROM+2):0]\tax;\n");
+	fprintf(fp,
+		"\t// }}}\n\n");
+	// }}}
+
+	// Sign extend our inputs
+	// {{{
+	fprintf(fp,
+		"\t// Sign extend our inputs\n"
+		"\t// {{{\n"
+		"\t// First step: expand our input to our working width.\n"
+		"\t// This is going to involve extending our input by one\n"
+		"\t// (or more) bits in addition to adding any xtra bits on\n"
+		"\t// bits on the right.  The one bit extra on the left is to\n"
+		"\t// allow for any accumulation due to the cordic gain\n"
+		"\t// within the algorithm.\n"
+		"\t// \n");
+
+	if (working_width-iw-1 > 0) {
+		fprintf(fp,
+			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval, {(WW-IW-1){1'b0}} };\n"
+			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval, {(WW-IW-1){1'b0}} };\n\n");
+	} else {
+		fprintf(fp,
+			"\tassign\te_xval = { {i_xval[(IW-1)]}, i_xval };\n"
+			"\tassign\te_yval = { {i_yval[(IW-1)]}, i_yval };\n\n");
+	} fprintf(fp, "\t// }}}\n");
+	// }}}
+
+	cordic_angles(fp, nstages, phase_bits);
+	residual_phase_widths(fp, nstages, rom_bits, working_width, phase_bits,
+		"NSTAGES");
+
+	if (with_aux) {
+		// {{{
+		fprintf(fp,
+"\t//\n"
+"\t// Handle the auxilliary logic.\n"
+"\t// {{{\n"
+"\t// The auxilliary bit is designed so that you can place a valid bit into\n"
+"\t// the CORDIC function, and see when it comes out.  While the bit is\n"
+"\t// allowed to be anything, the requirement of this bit is that it *must*\n"
+"\t// be aligned with the output when done.  That is, if i_xval and i_yval\n"
+"\t// are input together with i_aux, then when o_xval and o_yval are set\n"
+"\t// to this value, o_aux *must* contain the value that was in i_aux.\n"
+"\t//\n"
+"\n"
+"\tinitial\tax = 0;\n");
+
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp,
+				"\t\tax <= 0;\n\telse ");
+		fprintf(fp, "if (i_ce)\n"
+			"\t\tax <= { ax[(NSTAGES-LGROM+1):0], i_aux };\n"
+			"\t// }}}\n\n");
+		// }}}
+	}
+
+	// Pre-CORDIC rotation
+	// {{{
+	fprintf(fp,
+		"\t// Pre-CORDIC rotation\n"
+		"\t// {{{\n"
+		"\t// First stage, get rid of all but 45 degrees.  Since each\n"
+		"\t// octant is reduced by a multiple of 90 degrees, the bottom\n"
+		"\t// PW-2 bits of the phase are left unchanged.  The top LGROM\n"
+		"\t// of them then select the coarse rotation, and what\'s left\n"
+		"\t// below them, less the half step the ROM has already rotated\n"
+		"\t// by, is left for the CORDIC.\n");
+
+	fprintf(fp,
+		"\tinitial begin\n"
+		"\t\tpre_xv = 0;\n"
+		"\t\tpre_yv = 0;\n"
+		"\t\tpre_ph = 0;\n"
+		"\tend\n");
+
+	fprintf(fp, "%s", always_reset.c_str());
+
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\tpre_xv <= 0;\n"
+			"\t\tpre_yv <= 0;\n"
+			"\t\tpre_ph <= 0;\n"
+			"\tend else ");
+
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\t// {{{\n"
+		"\t\t// This is a zero-gain operation, involving only sign\n"
+		"\t\t// adjustments.\n"
+		"\t\tcase(i_phase[(PW-1):(PW-3)])\n"
+		"\t\t3\'b001, 3\'b010: begin	// 45 .. 135\n"
+		"\t\t\tpre_xv <= -e_yval;\n"
+		"\t\t\tpre_yv <= e_xval;\n"
+		"\t\t\tend\n"
+		"\t\t3\'b011, 3\'b100: begin	// 135 .. 225\n"
+		"\t\t\tpre_xv <= -e_xval;\n"
+		"\t\t\tpre_yv <= -e_yval;\n"
+		"\t\t\tend\n"
+		"\t\t3\'b101, 3\'b110: begin	// 225 .. 315\n"
+		"\t\t\tpre_xv <= e_yval;\n"
+		"\t\t\tpre_yv <= -e_xval;\n"
+		"\t\t\tend\n"
+		"\t\tdefault: begin	// 315 .. 45, No change\n"
+		"\t\t\tpre_xv <= e_xval;\n"
+		"\t\t\tpre_yv <= e_yval;\n"
+		"\t\t\tend\n"
+		"\t\tendcase\n"
+		"\n"
+		"\t\tpre_ph <= { {(LGROM+3){!i_phase[PW-3-LGROM]}},\n"
+		"\t\t\t\ti_phase[(PW-4-LGROM):0] };\n"
+		"\t\t// }}}\n"
+		"\tend\n\t// }}}\n\n");
+	// }}}
+
+	// Coarse rotation
+	// {{{
+	fprintf(fp,
+		"\t// Coarse rotation\n"
+		"\t// {{{\n"
+		"\t// Entry k of the tables holds the cosine and sine of the angle\n"
+		"\t// in the middle of the k\'th step of 90/2^LGROM degrees, with k\n"
+		"\t// taken as a signed number, scaled by 2^(TW-1).  Neither the\n"
+		"\t// table reads nor the products are reset, so that they may be\n"
+		"\t// placed into block RAM and hardware multiplies.\n"
+		"\tinitial begin\n"
+		"\t\t$readmemh(\"%s_cos.hex\", costbl);\n"
+		"\t\t$readmemh(\"%s_sin.hex\", sintbl);\n"
+		"\tend\n\n", name, name);
+
+	fprintf(fp,
+		"\talways @(posedge i_clk)\n"
+		"\tif (i_ce)\n"
+		"\tbegin\n"
+		"\t\tr_cos <= costbl[i_phase[(PW-3):(PW-2-LGROM)]];\n"
+		"\t\tr_sin <= sintbl[i_phase[(PW-3):(PW-2-LGROM)]];\n"
+		"\tend\n\n");
+
+	fprintf(fp,
+		"\talways @(posedge i_clk)\n"
+		"\tif (i_ce)\n"
+		"\tbegin\n"
+		"\t\tp_xcos <= pre_xv * r_cos;\n"
+		"\t\tp_ysin <= pre_yv * r_sin;\n"
+		"\t\tp_xsin <= pre_xv * r_sin;\n"
+		"\t\tp_ycos <= pre_yv * r_cos;\n"
+		"\tend\n\n");
+
+	fprintf(fp, "\tinitial\tmpy_ph = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tmpy_ph <= 0;\n\telse ");
+	fprintf(fp, "if (i_ce)\n"
+		"\t\tmpy_ph <= pre_ph;\n\n");
+
+	fprintf(fp,
+		"\t// Round the products back to the working width\n"
+		"\tassign\tw_xrot = p_xcos - p_ysin\n"
+		"\t\t\t+ $signed({ {(WW+2){1\'b0}}, 1\'b1, {(TW-2){1\'b0}} });\n"
+		"\tassign\tw_yrot = p_xsin + p_ycos\n"
+		"\t\t\t+ $signed({ {(WW+2){1\'b0}}, 1\'b1, {(TW-2){1\'b0}} });\n\n");
+
+	fprintf(fp,
+		"\tinitial begin\n"
+		"\t\txv[LGROM] = 0;\n"
+		"\t\tyv[LGROM] = 0;\n"
+		"\t\tph[LGROM] = 0;\n"
+		"\tend\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\txv[LGROM] <= 0;\n"
+			"\t\tyv[LGROM] <= 0;\n"
+			"\t\tph[LGROM] <= 0;\n"
+			"\tend else ");
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\txv[LGROM] <= w_xrot[(WW+TW-2):(TW-1)];\n"
+		"\t\tyv[LGROM] <= w_yrot[(WW+TW-2):(TW-1)];\n"
+		"\t\tph[LGROM] <= mpy_ph;\n"
+		"\tend\n\n");
+
+	fprintf(fp, "\t// Make Verilator happy with the bits we don\'t use\n"
+		"\t// {{{\n"
+		"\t// verilator lint_off UNUSED\n"
+		"\twire	unused_rot;\n"
+		"\tassign\tunused_rot = &{ 1\'b0,\n"
+		"\t\tw_xrot[(WW+TW):(WW+TW-1)], w_xrot[(TW-2):0],\n"
+		"\t\tw_yrot[(WW+TW):(WW+TW-1)], w_yrot[(TW-2):0]\n"
+		"\t\t};\n"
+		"\t// verilator lint_on UNUSED\n"
+		"\t// }}}\n"
+		"\t// }}}\n\n");
+	// }}}
+
+	// CORDIC rotations
+	// {{{
+	fprintf(fp,
+		"\t// CORDIC rotations\n"
+		"\t// {{{\n"
+		"\t// The coarse rotation has left a phase of no more than half a\n"
+		"\t// ROM step, 45/2^LGROM degrees, either way.  The CORDIC stages\n"
+		"\t// from LGROM on can still rotate by more than that, so the\n"
+		"\t// first LGROM stages aren\'t needed.\n"
+		"\tgenvar	i;\n"
+		"\tgenerate for(i=LGROM; i<NSTAGES; i=i+1) begin : CORDICops\n"
+		"\t\t// The phase following this stage needs only PWN bits.\n"
+		"\t\t// Those above are copies of its sign, and so the adder\n"
+		"\t\t// need be no wider.\n"
+		"\t\tlocalparam\tPWN = PHW[8*i +: 8];\n"
+		"\t\twire\t[(PWN-1):0]\tnph;\n"
+		"\n"
+		"\t\tassign\tnph = (ph[i][PW-1])\n"
+		"\t\t\t\t? (ph[i][(PWN-1):0] + cordic_angle[i][(PWN-1):0])\n"
+		"\t\t\t\t: (ph[i][(PWN-1):0] - cordic_angle[i][(PWN-1):0]);\n"
+		"\n");
+	if (with_reset) {
+		fprintf(fp,
+			"\t\tinitial begin\n"
+			"\t\t\txv[i+1] = 0;\n"
+			"\t\t\tyv[i+1] = 0;\n"
+			"\t\t\tph[i+1] = 0;\n"
+			"\t\tend\n\n\t");
+	}
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset) {
+		fprintf(fp,
+			"\t\tbegin\n"
+			"\t\t\t// {{{\n"
+			"\t\t\txv[i+1] <= 0;\n"
+			"\t\t\tyv[i+1] <= 0;\n"
+			"\t\t\tph[i+1] <= 0;\n"
+			"\t\t\t// }}}\n"
+			"\t\tend else ");
+	} else
+		fprintf(fp, "\t\t");
+
+	fprintf(fp,
+		"if (i_ce)\n"
+		"\t\tbegin\n"
+		"\t\t\t// {{{\n"
+		"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
+		"\t\t\tbegin // Do nothing but move our outputs\n"
+		"\t\t\t// forward one stage, since we have more\n"
+		"\t\t\t// stages than valid data\n"
+		"\t\t\t\t// {{{\n"
+		"\t\t\t\txv[i+1] <= xv[i];\n"
+		"\t\t\t\tyv[i+1] <= yv[i];\n"
+		"\t\t\t\tph[i+1] <= ph[i];\n"
+		"\t\t\t\t// }}}\n"
+		"\t\t\tend else if (ph[i][(PW-1)]) // Negative phase\n"
+		"\t\t\tbegin\n"
+		"\t\t\t\t// {{{\n"
+		"\t\t\t\t// If the phase is negative, rotate by the\n"
+		"\t\t\t\t// CORDIC angle in a clockwise direction.\n"
+		"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
+		"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
+		"\t\t\t\tph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };\n"
+		"\t\t\t\t// }}}\n"
+		"\t\t\tend else begin\n"
+		"\t\t\t\t// {{{\n"
+		"\t\t\t\t// On the other hand, if the phase is\n"
+		"\t\t\t\t// positive ... rotate in the\n"
+		"\t\t\t\t// counter-clockwise direction\n"
+		"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
+		"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
+		"\t\t\t\tph[i+1] <= { {(PW-PWN){nph[PWN-1]}}, nph };\n"
+		"\t\t\t\t// }}}\n"
+		"\t\t\tend\n"
+		"\t\t\t// }}}\n"
+		"\t\tend\n"
+		"\tend endgenerate\n\t// }}}\n\n");
+	// }}}
+
+	// Outputs
+	// {{{
+	std::string	xout, yout;
+	bool		rounding = (working_width > ow+1);
+
+	if (rounding) {
+		fprintf(fp,
+			"\t// Round our result towards even\n"
+			"\t// {{{\n"
+			"\twire\t[(WW-1):0]\tpre_xval, pre_yval;\n\n"
+			"\tassign\tpre_xval = xv[NSTAGES] + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\txv[NSTAGES][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[NSTAGES][WW-OW]}} });\n"
+			"\tassign\tpre_yval = yv[NSTAGES] + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\tyv[NSTAGES][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!yv[NSTAGES][WW-OW]}} });\n"
+			"\t// }}}\n\n");
+		xout = "pre_xval[(WW-1):(WW-OW)]";
+		yout = "pre_yval[(WW-1):(WW-OW)]";
+	} else {
+		fprintf(fp, "\t// No rounding required\n");
+		xout = "xv[NSTAGES][(WW-1):(WW-OW)]";
+		yout = "yv[NSTAGES][(WW-1):(WW-OW)]";
+	}
+
+	fprintf(fp, "\t// Output assignments\n\t// {{{\n"
+		"\tinitial begin\n"
+		"\t\to_xval = 0;\n"
+		"\t\to_yval = 0;\n");
+	if (with_aux)
+		fprintf(fp, "\t\to_aux  = 0;\n");
+	fprintf(fp, "\tend\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset) {
+		fprintf(fp, "\tbegin\n"
+			"\t\to_xval <= 0;\n"
+			"\t\to_yval <= 0;\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux  <= 0;\n");
+		fprintf(fp, "\tend else ");
+	}
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\to_xval <= %s;\n"
+		"\t\to_yval <= %s;\n", xout.c_str(), yout.c_str());
+	if (with_aux)
+		fprintf(fp, "\t\to_aux  <= ax[NSTAGES-LGROM+2];\n");
+	fprintf(fp, "\tend\n\t// }}}\n\n");
+
+	if (rounding)
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// {{{\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	unused_val;\n"
+			"\tassign\tunused_val = &{ 1\'b0, \n"
+			"\t\tpre_xval[(WW-OW-1):0],\n"
+			"\t\tpre_yval[(WW-OW-1):0]\n"
+			"\t\t};\n"
+			"\t// verilator lint_on UNUSED\n"
+			"\t// }}}\n");
+	// }}}
+
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp) {
+		// {{{
+		char	*str = new char[strlen(name)+4], *ptr;
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef	%s\n", str);
+		fprintf(fhp, "#define	%s\n", str);
+
+		if (async_reset)
+			fprintf(fhp, "#define\tASYNC_RESET\n");
+		fprintf(fhp, "#define\tHYBRID\n");
+		fprintf(fhp, "const int	NLANES = 1;\n");
+		fprintf(fhp, "const int	IW = %d;\n", iw);
+		fprintf(fhp, "const int	OW = %d;\n", ow);
+		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
+		fprintf(fhp, "const int	WW = %d;\n", working_width);
+		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
+		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+		fprintf(fhp, "const int	LGROM = %d;\t// Stages replaced by the ROM\n",
+			rom_bits);
+		fprintf(fhp, "const int	TW = %d;\t// Bits per ROM entry\n",
+			table_width);
+		fprintf(fhp, "const int	LATENCY = %d;\t// Clocks from i_ce to output\n",
+			latency);
+		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+			hybrid_quantization_variance(nstages, rom_bits,
+				working_width, table_width,
+				phase_bits, working_width-ow));
+		fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
+			hybrid_phase_variance(nstages, rom_bits, phase_bits));
+		fprintf(fhp, "const double	GAIN = %.16f;\n",
+			hybrid_gain(nstages, rom_bits));
+		fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+			hybrid_cnr(nstages, rom_bits, iw, ow, working_width,
+				table_width, phase_bits));
+		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+
+		hybrid_model(fhp, nstages, ow, working_width, phase_bits);
+
+		fprintf(fhp, "#endif\t// %s\n", str);
+		delete[] str;
+		// }}}
+	}
+
+	free(noext);
+	return latency;
+	// }}}
+}
@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/hybrid.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates a hybrid ROM and CORDIC polar to rectangular core.
+//		The first CORDIC stages are replaced by a single rotation,
+//	by an angle looked up from a small table of cosines and sines and
+//	applied with one complex multiply.  Only the remaining, finer, stages
+//	are then left for the CORDIC.  With rom_bits bits of phase looking up
+//	the table, rom_bits CORDIC stages are removed from the pipeline.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	HYBRID_H
+#define	HYBRID_H
+
+#include <stdio.h>
+
+// Returns the number of clocks from i_ce to the output
+extern	int	hybridcordic(FILE *fp, FILE *fhp, const char *cmdline,
+			const char *fname, int nstages, int iw, int ow,
+			int nxtra, int phase_bits, int rom_bits,
+			bool with_reset, bool with_aux, bool async_reset);
+
+#endif	// HYBRID_H
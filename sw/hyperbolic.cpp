@@ -0,0 +1,747 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/hyperbolic.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates the hyperbolic CORDIC cores, in rotation or vectoring
+//		mode, either pipelined or sequential.  See hyperbolic.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "hyperbolic.h"
+
+static	void	hyperbolic_model(FILE *fhp, int nstages, int ow, int ww,
+		int phase_bits, bool vectoring) {
+	// {{{
+	assert(ww < 64);
+	assert(phase_bits < 64);
+
+	fprintf(fhp,
+"\n"
+"// Bit-exact model\n"
+"// {{{\n"
+"// The following duplicates, in integer arithmetic, the logic of the core\n"
+"// above: the same truncated hyperbolic angles, the same repeated shifts,\n"
+"// and the same round-towards-even output stage.  Given the same inputs,\n"
+"// %s() will return exactly what the core will produce\n"
+"// once it has finished.\n"
+"//\n"
+"#define\tHAS_HYPERBOLIC_MODEL\n\n",
+		(vectoring) ? "hvector_model" : "hrotate_model");
+
+	fprintf(fhp, "static const unsigned long\tHYPERBOLIC_ANGLE[%d] = {",
+		nstages);
+	for(int k=0; k<nstages; k++) {
+		fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+			(0 == (k%4)) ? "\n\t" : " ",
+			(phase_bits+3)/4, hyperbolic_angle(k, phase_bits));
+	} fprintf(fhp, "\n};\n\n");
+
+	fprintf(fhp, "static const int\tHYPERBOLIC_SHIFT[%d] = {", nstages);
+	for(int k=0; k<nstages; k++) {
+		fprintf(fhp, "%s%s%2d", (k > 0) ? ",":"",
+			(0 == (k%8)) ? "\n\t" : " ", hyperbolic_shift(k));
+	} fprintf(fhp, "\n};\n\n");
+
+	fprintf(fhp,
+"// Sign extend the bottom w bits of v\n"
+"static inline long\thyperbolic_sext(unsigned long v, int w) {\n"
+"\treturn ((long)(v << (64-w))) >> (64-w);\n"
+"}\n\n");
+
+	if (vectoring)
+		fprintf(fhp,
+"static inline void\thvector_model(long i_xval, long i_yval,\n"
+"\t\tlong &o_mag, unsigned long &o_phase) {\n");
+	else
+		fprintf(fhp,
+"static inline void\throtate_model(long i_xval, long i_yval,\n"
+"\t\tunsigned long i_phase, long &o_xval, long &o_yval) {\n");
+
+	fprintf(fhp,
+"\tconst\tunsigned long	PMSK = (1ul << PW) - 1;\n"
+"\tlong\t\txv, yv;\n"
+"\tunsigned long\tph;\n"
+"\n"
+"\t// Sign extend our inputs to the working width, two bits down\n"
+"\txv = hyperbolic_sext(i_xval, IW) * (1l << (WW-IW-2));\n"
+"\tyv = hyperbolic_sext(i_yval, IW) * (1l << (WW-IW-2));\n");
+	if (vectoring)
+		fprintf(fhp,
+"\n"
+"\t// (-x,-y) has the same hyperbolic angle and magnitude as (x,y)\n"
+"\tif (xv < 0) {\n"
+"\t\txv = -xv;\n"
+"\t\tyv = -yv;\n"
+"\t}\n"
+"\tph = 0;\n");
+	else
+		fprintf(fhp,
+"\tph = i_phase & PMSK;\n");
+
+	fprintf(fhp,
+"\n"
+"\t// Hyperbolic CORDIC rotations\n"
+"\tfor(int k=0; k<NSTAGES; k++) {\n"
+"\t\tconst\tint\tsh = HYPERBOLIC_SHIFT[k];\n"
+"\t\tlong\tdx, dy;\n"
+"\n"
+"\t\tif ((HYPERBOLIC_ANGLE[k] == 0)||(sh >= WW))\n"
+"\t\t\tcontinue;\n"
+"\n"
+"\t\tdx = xv >> sh;\n"
+"\t\tdy = yv >> sh;\n"
+"\t\tif (%s) {\n"
+"\t\t\txv = hyperbolic_sext(xv + dy, WW);\n"
+"\t\t\tyv = hyperbolic_sext(yv + dx, WW);\n"
+"\t\t\tph = (ph - HYPERBOLIC_ANGLE[k]) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\txv = hyperbolic_sext(xv - dy, WW);\n"
+"\t\t\tyv = hyperbolic_sext(yv - dx, WW);\n"
+"\t\t\tph = (ph + HYPERBOLIC_ANGLE[k]) & PMSK;\n"
+"\t\t}\n"
+"\t}\n"
+"\n", (vectoring) ? "yv < 0" : "0 == ((ph >> (PW-1))&1)");
+
+	if (ww > ow+1) {
+		fprintf(fhp,
+"\t// Round towards even, then drop the extra bits\n"
+"\tif ((xv >> (WW-OW)) & 1)\n"
+"\t\txv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\txv += (1l << (WW-OW-1)) - 1;\n"
+"\txv = hyperbolic_sext(xv, WW);\n");
+		if (!vectoring)
+			fprintf(fhp,
+"\tif ((yv >> (WW-OW)) & 1)\n"
+"\t\tyv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\tyv += (1l << (WW-OW-1)) - 1;\n"
+"\tyv = hyperbolic_sext(yv, WW);\n");
+		fprintf(fhp, "\n");
+	} else
+		fprintf(fhp,
+"\t// No rounding required\n");
+
+	if (vectoring)
+		fprintf(fhp,
+"\to_mag   = xv >> (WW-OW);\n"
+"\to_phase = ph;\n"
+"}\n"
+"// }}}\n");
+	else
+		fprintf(fhp,
+"\to_xval = xv >> (WW-OW);\n"
+"\to_yval = yv >> (WW-OW);\n"
+"}\n"
+"// }}}\n");
+	// }}}
+}
+
+int	hyperbolic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+		int nstages, int iw, int ow, int nxtra, int phase_bits,
+		bool vectoring, bool sequential,
+		bool with_reset, bool with_aux, bool async_reset) {
+	// {{{
+	int	working_width = iw;
+	double	gain;
+	const	char *name;
+	std::string	purpose;
+	const	char	HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+
+	if (vectoring)
+		purpose =
+	"This file rotates the vector (i_xval, i_yval) through\n"
+	"//\t\twhatever hyperbolic angle will bring its y component to zero.\n"
+	"//\tThe result is GAIN*sqrt(x^2-y^2) in o_mag, and atanh(y/x) in\n"
+	"//\to_phase, in signed units of 2^-(PW-2).  For the CORDIC to\n"
+	"//\tconverge, |i_yval| must be less than 0.8 |i_xval|.";
+	else
+		purpose =
+	"This file rotates the vector (i_xval, i_yval) through\n"
+	"//\t\tthe hyperbolic angle i_phase.  i_phase is a signed value, in\n"
+	"//\tunits of 2^-(PW-2).  For the CORDIC to converge, it must lie\n"
+	"//\twithin +/- 1.118.";
+	if (sequential)
+		purpose += "\n//\n"
+	"//\tThis particular version processes one value at a time, in a\n"
+	"//\tsequential, vs pipelined, fashion.";
+
+	legal(fp, fname, PROJECT, purpose.c_str(), cmdline);
+	// The inputs are placed two bits down, since a rotation may grow
+	// them by as much as e^1.118, times the hyperbolic gain, or 2.53
+	if (nxtra < 2)
+		nxtra = 2;
+	assert(phase_bits >= 3);
+
+	if (working_width < ow)
+		working_width = ow;
+	working_width += nxtra;
+
+	gain = hyperbolic_gain(nstages, working_width, phase_bits);
+
+	std::string	resetw = (!with_reset)?""
+			: ((async_reset)?"i_areset_n" : "i_reset");
+	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+				"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+				"\tif (i_reset)\n";
+
+	// The direction of each rotation.  In rotation mode, a positive
+	// angle drives the angle down.  In vectoring mode, a negative y
+	// drives y back up.
+	const	char	*positive;
+	std::string	xsrc, ysrc, psrc;
+	if (sequential) {
+		positive = (vectoring) ? "yv[WW-1]" : "!ph[PW-1]";
+		xsrc = "xv"; ysrc = "yv"; psrc = "ph";
+	} else {
+		positive = (vectoring) ? "yv[i][WW-1]" : "!ph[i][PW-1]";
+		xsrc = "xv[NSTAGES]"; ysrc = "yv[NSTAGES]"; psrc = "ph[NSTAGES]";
+	}
+
+	name = modulename(fname);
+
+	// Module declaration
+	// {{{
+	fprintf(fp, "`default_nettype\tnone\n");
+	fprintf(fp,
+		"module	%s#(\n"
+		"\t\t// {{{\n"
+		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d\t// Bits in our phase variables\n"
+		"\t\t// }}}\n"
+		"\t) (\n"
+		"\t\t// {{{\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%s%s,\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\t\ti_xval, i_yval,\n",
+		name, iw, ow, nstages, nxtra, working_width, phase_bits,
+		resetw.c_str(), (with_reset)?", ":"",
+		(sequential) ? "i_stb" : "i_ce");
+	if (!vectoring)
+		fprintf(fp,
+		"\tinput\twire\tsigned\t[(PW-1):0]\t\ti_phase,\n");
+	if (sequential)
+		fprintf(fp,
+		"\toutput\twire\t\t\t\to_busy,\n"
+		"\toutput\treg\t\t\t\to_done,\n");
+	if (vectoring)
+		fprintf(fp,
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_mag,\n"
+		"\toutput\treg\tsigned\t[(PW-1):0]\to_phase%s\n",
+		(with_aux)?",":"");
+	else
+		fprintf(fp,
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_xval, o_yval%s\n",
+		(with_aux)?",":"");
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux,\n"
+			"\toutput\treg\t\t\t\to_aux\n");
+	} fprintf(fp, "\t\t// }}}\n\t);\n\n");
+	// }}}
+
+	// Declarations
+	// {{{
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n"
+		"\t// {{{\n"
+		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n");
+	if (sequential) {
+		fprintf(fp,
+		"\treg	signed	[(WW-1):0]	xv, prex, yv, prey;\n"
+		"\treg		[(PW-1):0]	ph, preph;\n"
+		"\treg\t\t\t\tidle, pre_valid;\n"
+		"\treg\t\t[%d:0]\t\tstate;\n"
+		"\twire\t\t\t\tlast_state;\n"
+		"\twire\t\t[7:0]\t\tcshift;\n"
+		"\twire\t\t[(PW-1):0]\tcangle;\n",
+		nextlg((unsigned)nstages+1)-1);
+		if (with_aux)
+			fprintf(fp, "\treg\t\t\t\taux;\n");
+	} else {
+		fprintf(fp,
+		"\treg	signed	[(WW-1):0]\txv\t[0:(NSTAGES)];\n"
+		"\treg	signed	[(WW-1):0]\tyv\t[0:(NSTAGES)];\n"
+		"\treg		[(PW-1):0]\tph\t[0:(NSTAGES)];\n");
+		if (with_aux)
+			fprintf(fp, "\treg\t\t[(NSTAGES):0]\tax;\n");
+	}
+	fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	// Sign extend our inputs
+	// {{{
+	fprintf(fp,
+		"\t// Sign extend our inputs\n"
+		"\t// {{{\n"
+		"\t// Extend our inputs by two bits on the left, to allow for the\n"
+		"\t// growth of a hyperbolic rotation, and by any extra bits on\n"
+		"\t// the right.\n");
+	if (working_width-iw-2 > 0) {
+		fprintf(fp,
+			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval, {(WW-IW-2){1'b0}} };\n"
+			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval, {(WW-IW-2){1'b0}} };\n");
+	} else {
+		fprintf(fp,
+			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval };\n"
+			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval };\n");
+	} fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	if (with_aux) {
+		// {{{
+		fprintf(fp,
+"\t//\n"
+"\t// Handle the auxilliary logic.\n"
+"\t// {{{\n"
+"\t// The auxilliary bit is designed so that you can place a valid bit into\n"
+"\t// the CORDIC function, and see when it comes out.  While the bit is\n"
+"\t// allowed to be anything, the requirement of this bit is that it *must*\n"
+"\t// be aligned with the output when done.  That is, if i_xval and i_yval\n"
+"\t// are input together with i_aux, then when the outputs are set to\n"
+"\t// their result, o_aux *must* contain the value that was in i_aux.\n"
+"\t//\n"
+"\n");
+
+		if (sequential) {
+			fprintf(fp, "\tinitial\taux = 0;\n");
+			fprintf(fp, "%s", always_reset.c_str());
+			if (with_reset)
+				fprintf(fp, "\t\taux <= 0;\n\telse ");
+			fprintf(fp, "if ((i_stb)&&(!o_busy))\n"
+				"\t\taux <= i_aux;\n");
+		} else {
+			fprintf(fp, "\tinitial\tax = 0;\n");
+			fprintf(fp, "%s", always_reset.c_str());
+			if (with_reset)
+				fprintf(fp, "\t\tax <= 0;\n\telse ");
+			fprintf(fp, "if (i_ce)\n"
+				"\t\tax <= { ax[(NSTAGES-1):0], i_aux };\n");
+		}
+		fprintf(fp, "\t// }}}\n\n");
+		// }}}
+	}
+
+	// Pre-rotation
+	// {{{
+	std::string	x0 = (sequential) ? "prex"  : "xv[0]",
+			y0 = (sequential) ? "prey"  : "yv[0]",
+			p0 = (sequential) ? "preph" : "ph[0]";
+
+	fprintf(fp,
+		"\t// Pre-rotation\n"
+		"\t// {{{\n");
+	if (vectoring)
+		fprintf(fp,
+		"\t// There\'s no quadrant to rotate out of here.  However, since\n"
+		"\t// (-x,-y) has the same hyperbolic angle and magnitude as (x,y),\n"
+		"\t// we can still make certain x is positive.\n");
+	else
+		fprintf(fp,
+		"\t// Unlike the circular CORDIC, there\'s no symmetry to reduce the\n"
+		"\t// angle with.  The inputs are simply registered.\n");
+
+	if (sequential) {
+		fprintf(fp, "\talways @(posedge i_clk)\n");
+	} else {
+		fprintf(fp,
+			"\tinitial begin\n"
+			"\t\txv[0] = 0;\n"
+			"\t\tyv[0] = 0;\n"
+			"\t\tph[0] = 0;\n"
+			"\tend\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp,
+				"\tbegin\n"
+				"\t\txv[0] <= 0;\n"
+				"\t\tyv[0] <= 0;\n"
+				"\t\tph[0] <= 0;\n"
+				"\tend else ");
+		fprintf(fp, "if (i_ce)\n");
+	}
+
+	if (vectoring)
+		fprintf(fp,
+		"\tbegin\n"
+		"\t\t// {{{\n"
+		"\t\tif (i_xval[IW-1])\n"
+		"\t\tbegin\n"
+		"\t\t\t%s <= -e_xval;\n"
+		"\t\t\t%s <= -e_yval;\n"
+		"\t\tend else begin\n"
+		"\t\t\t%s <= e_xval;\n"
+		"\t\t\t%s <= e_yval;\n"
+		"\t\tend\n"
+		"\t\t%s <= 0;\n"
+		"\t\t// }}}\n"
+		"\tend\n",
+		x0.c_str(), y0.c_str(), x0.c_str(), y0.c_str(), p0.c_str());
+	else
+		fprintf(fp,
+		"\tbegin\n"
+		"\t\t// {{{\n"
+		"\t\t%s <= e_xval;\n"
+		"\t\t%s <= e_yval;\n"
+		"\t\t%s <= i_phase;\n"
+		"\t\t// }}}\n"
+		"\tend\n",
+		x0.c_str(), y0.c_str(), p0.c_str());
+	fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	hyperbolic_angles(fp, nstages, phase_bits);
+
+	if (sequential) {
+		// {{{
+		fprintf(fp,
+			"\n\tassign\tlast_state = (!idle)&&(state == %d\'d%d);\n",
+			nextlg((unsigned)nstages+1), nstages);
+
+		fprintf(fp, "\n\t// idle\n\t// {{{\n"
+			"\tinitial\tidle = 1\'b1;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tidle <= 1\'b1;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if ((i_stb)&&(idle))\n"
+				"\t\tidle <= 1\'b0;\n"
+				"\telse if (last_state)\n"
+				"\t\tidle <= 1\'b1;\n");
+		fprintf(fp, "\t// }}}\n\n");
+
+		fprintf(fp, "\t// pre_valid\n\t// {{{\n");
+		fprintf(fp, "\tinitial\tpre_valid = 1\'b0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tpre_valid <= 1\'b0;\n\telse\n");
+		fprintf(fp, "\t\tpre_valid <= (i_stb)&&(idle);\n\t// }}}\n\n");
+
+		fprintf(fp, "\t// state -- the stage applied on this clock\n"
+			"\t// {{{\n\tinitial\tstate = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tstate <= 0;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if ((idle)||(pre_valid))\n"
+				"\t\tstate <= 0;\n"
+				"\telse if (!last_state)\n"
+				"\t\tstate <= state + 1;\n\t// }}}\n\n");
+
+		fprintf(fp,
+			"\tassign\tcshift = HSHIFT[{ state, 3\'b000 } +: 8];\n"
+			"\tassign\tcangle = hyperbolic_angle[state];\n\n");
+
+		fprintf(fp,
+			"\t// Hyperbolic CORDIC rotations\n"
+			"\t// {{{\n"
+			"\t// Unlike the circular CORDIC, a positive rotation adds both\n"
+			"\t// cross terms, so x and y move together.\n"
+			"\talways @(posedge i_clk)\n"
+			"\tif (pre_valid)\n"
+			"\tbegin\n"
+				"\t\t// {{{\n"
+				"\t\txv <= prex;\n"
+				"\t\tyv <= prey;\n"
+				"\t\tph <= preph;\n"
+				"\t\t// }}}\n"
+			"\tend else if ((!idle)&&(!last_state)\n"
+			"\t\t\t&&(cangle != 0)&&(cshift < WW))\n"
+			"\tbegin\n"
+			"\t\tif (%s)\n"
+			"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv <= xv + (yv >>> cshift);\n"
+				"\t\t\tyv <= yv + (xv >>> cshift);\n"
+				"\t\t\tph <= ph - cangle;\n"
+				"\t\t\t// }}}\n"
+			"\t\tend else begin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv <= xv - (yv >>> cshift);\n"
+				"\t\t\tyv <= yv - (xv >>> cshift);\n"
+				"\t\t\tph <= ph + cangle;\n"
+				"\t\t\t// }}}\n"
+			"\t\tend\n"
+			"\tend\n\t// }}}\n", positive);
+		// }}}
+	} else {
+		// {{{
+		fprintf(fp,"\n"
+			"\t// Hyperbolic CORDIC rotations\n"
+			"\t// {{{\n"
+			"\t// Unlike the circular CORDIC, a positive rotation adds both\n"
+			"\t// cross terms, so x and y move together.\n"
+			"\tgenvar	i;\n"
+			"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops\n"
+			"\t\tlocalparam\tS = HSHIFT[8*i +: 8];\n\n");
+		if (with_reset) {
+			fprintf(fp,
+				"\t\tinitial begin\n"
+				"\t\t\txv[i+1] = 0;\n"
+				"\t\t\tyv[i+1] = 0;\n"
+				"\t\t\tph[i+1] = 0;\n"
+				"\t\tend\n\n\t");
+		}
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(fp,
+				"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tph[i+1] <= 0;\n"
+				"\t\t\t// }}}\n"
+				"\t\tend else ");
+		} else
+			fprintf(fp, "\t\t");
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\t\tbegin\n"
+			"\t\t\t// {{{\n"
+			"\t\t\tif ((hyperbolic_angle[i] == 0)||(S >= WW))\n"
+			"\t\t\tbegin // Do nothing but move our outputs\n"
+			"\t\t\t// forward one stage, since we have more\n"
+			"\t\t\t// stages than valid data\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\txv[i+1] <= xv[i];\n"
+			"\t\t\t\tyv[i+1] <= yv[i];\n"
+			"\t\t\t\tph[i+1] <= ph[i];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else if (%s)\n"
+			"\t\t\tbegin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>S);\n"
+			"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>S);\n"
+			"\t\t\t\tph[i+1] <= ph[i] - hyperbolic_angle[i];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else begin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>S);\n"
+			"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>S);\n"
+			"\t\t\t\tph[i+1] <= ph[i] + hyperbolic_angle[i];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend\n"
+			"\t\t\t// }}}\n"
+			"\t\tend\n"
+			"\tend endgenerate\n\t// }}}\n\n", positive);
+		// }}}
+	}
+
+	// Outputs
+	// {{{
+	const	char	*oname[2] = { (vectoring) ? "o_mag"   : "o_xval",
+				(vectoring) ? "o_phase" : "o_yval" },
+			*prename[2] = { (vectoring) ? "pre_mag" : "pre_xval",
+				"pre_yval" };
+	std::string	osrc[2] = { xsrc, (vectoring) ? psrc : ysrc },
+			oval[2];
+	int		nround = (vectoring) ? 1 : 2;
+
+	for(int k=0; k<2; k++) {
+		if (k >= nround)
+			oval[k] = osrc[k];
+		else if (working_width > ow+1)
+			oval[k] = std::string(prename[k]) + "[(WW-1):(WW-OW)]";
+		else
+			oval[k] = osrc[k] + "[(WW-1):(WW-OW)]";
+	}
+
+	if (working_width > ow+1) {
+		fprintf(fp,
+			"\n\t// Round our result towards even\n"
+			"\t// {{{\n"
+			"\twire\t[(WW-1):0]\t%s%s%s;\n\n",
+			prename[0], (nround > 1) ? ", " : "",
+			(nround > 1) ? prename[1] : "");
+		for(int k=0; k<nround; k++)
+			fprintf(fp,
+			"\tassign\t%s = %s + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n",
+				prename[k], osrc[k].c_str(), osrc[k].c_str(),
+				osrc[k].c_str());
+		fprintf(fp, "\t// }}}\n");
+	}
+
+	fprintf(fp, "\n\t// Output assignments: %s, %s%s\n\t// {{{\n",
+		oname[0], oname[1], (with_aux) ? ", o_aux" : "");
+	if (sequential) {
+		fprintf(fp, "\tinitial\to_done = 1\'b0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\to_done <= 1\'b0;\n\telse\n");
+		fprintf(fp, "\t\to_done <= last_state;\n\n");
+
+		if (with_aux)
+			fprintf(fp, "\tinitial\to_aux = 0;\n");
+		fprintf(fp, "\talways @(posedge i_clk)\n"
+			"\tif (last_state)\n"
+			"\tbegin\n");
+		for(int k=0; k<2; k++)
+			fprintf(fp, "\t\t%s <= %s;\n", oname[k], oval[k].c_str());
+		if (with_aux)
+			fprintf(fp, "\t\to_aux <= aux;\n");
+		fprintf(fp, "\tend\n");
+	} else {
+		fprintf(fp, "\tinitial begin\n");
+		for(int k=0; k<2; k++)
+			fprintf(fp, "\t\t%s = 0;\n", oname[k]);
+		if (with_aux)
+			fprintf(fp, "\t\to_aux = 0;\n");
+		fprintf(fp, "\tend\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(fp, "\tbegin\n");
+			for(int k=0; k<2; k++)
+				fprintf(fp, "\t\t%s <= 0;\n", oname[k]);
+			if (with_aux)
+				fprintf(fp, "\t\to_aux <= 0;\n");
+			fprintf(fp, "\tend else ");
+		}
+		fprintf(fp, "if (i_ce)\n"
+			"\tbegin\n");
+		for(int k=0; k<2; k++)
+			fprintf(fp, "\t\t%s <= %s;\n", oname[k], oval[k].c_str());
+		if (with_aux)
+			fprintf(fp, "\t\to_aux <= ax[NSTAGES];\n");
+		fprintf(fp, "\tend\n");
+	}
+	fprintf(fp, "\t// }}}\n\n");
+
+	if (sequential)
+		fprintf(fp, "\tassign\to_busy = !idle;\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// {{{\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire\tunused_val;\n"
+			"\tassign\tunused_val = &{ 1\'b0");
+		for(int k=0; k<nround; k++)
+			fprintf(fp, ", %s[(WW-OW-1):0]", prename[k]);
+		fprintf(fp, " };\n"
+			"\t// verilator lint_on UNUSED\n"
+			"\t// }}}\n");
+	}
+	// }}}
+
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp) {
+		// {{{
+		char	*str = new char[strlen(name)+4], *ptr;
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef	%s\n", str);
+		fprintf(fhp, "#define	%s\n", str);
+
+		if (async_reset)
+			fprintf(fhp, "#define\tASYNC_RESET\n");
+		if (sequential) {
+			fprintf(fhp, "#ifdef\tCLOCKS_PER_OUTPUT\n");
+			fprintf(fhp, "#undef\tCLOCKS_PER_OUTPUT\n");
+			fprintf(fhp, "#endif\t// CLOCKS_PER_OUTPUT\n");
+			fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n\n",
+				nstages+3);
+		}
+		fprintf(fhp, "#define\tHYPERBOLIC\n");
+		if (vectoring)
+			fprintf(fhp, "#define\tVECTORING\n");
+		fprintf(fhp, "const int	IW = %d;\n", iw);
+		fprintf(fhp, "const int	OW = %d;\n", ow);
+		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
+		fprintf(fhp, "const int	WW = %d;\n", working_width);
+		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
+		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+		if (!sequential)
+			fprintf(fhp, "const int	LATENCY = %d;\t// Clocks from i_ce to output\n",
+				nstages+2);
+		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+			hyperbolic_quantization_variance(nstages,
+				working_width-iw-2, working_width-ow));
+		fprintf(fhp, "const double	PHASE_VARIANCE = %.4e; // (Angle^2)\n",
+			hyperbolic_phase_variance(nstages, phase_bits));
+		fprintf(fhp, "const double	HYPERBOLIC_GAIN = %.16f;\n", gain);
+		// With the inputs two bits down, the output is
+		// GAIN * result * 2^(OW-IW-1), as with the other cores
+		fprintf(fhp, "const double	GAIN = %.16f;\n", gain / 2.0);
+		fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+			hyperbolic_cnr(nstages, iw, ow, working_width,
+				phase_bits));
+		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+
+		hyperbolic_model(fhp, nstages, ow, working_width, phase_bits,
+			vectoring);
+
+		fprintf(fhp, "#endif\t// %s\n", str);
+		delete[] str;
+		// }}}
+	}
+
+	return (sequential) ? nstages+3 : nstages+2;
+	// }}}
+}
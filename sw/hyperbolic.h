@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/hyperbolic.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates hyperbolic CORDIC cores, either pipelined or
+//		sequential.  In rotation mode, (i_xval, i_yval) is rotated
+//	through the hyperbolic angle i_phase, producing
+//
+//		o_xval = GAIN * (i_xval * cosh(i_phase) + i_yval * sinh(i_phase))
+//		o_yval = GAIN * (i_yval * cosh(i_phase) + i_xval * sinh(i_phase))
+//
+//	In vectoring mode, (i_xval, i_yval) is instead rotated until its y
+//	component is zero, producing
+//
+//		o_mag   = GAIN * sqrt(i_xval^2 - i_yval^2)
+//		o_phase = atanh(i_yval / i_xval)
+//
+//	From these come exp(z) (rotate (v,v) by z), cosh and sinh (rotate
+//	(v,0)), tanh (o_yval/o_xval of the same), ln(a) (vector (a+1,a-1),
+//	for ln(a)/2), and sqrt(a) (vector (a+1/4, a-1/4)).
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	HYPERBOLIC_H
+#define	HYPERBOLIC_H
+
+#include <stdio.h>
+
+// Returns the number of clocks from i_ce to the output for the pipelined
+// cores, or the number of clocks per output for the sequential ones
+extern	int	hyperbolic(FILE *fp, FILE *fhp, const char *cmdline,
+			const char *fname, int nstages, int iw, int ow,
+			int nxtra, int phase_bits, bool vectoring,
+			bool sequential, bool with_reset, bool with_aux,
+			bool async_reset);
+
+#endif	// HYPERBOLIC_H
@@ -0,0 +1,709 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/linear.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates the linear CORDIC cores, in rotation (multiply) or
+//		vectoring (divide) mode, either pipelined or sequential.
+//	See linear.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "linear.h"
+
+static	void	linear_model(FILE *fhp, int ow, int ww, bool vectoring) {
+	// {{{
+	assert(ww < 64);
+
+	fprintf(fhp,
+"\n"
+"// Bit-exact model\n"
+"// {{{\n"
+"// The following duplicates, in integer arithmetic, the logic of the core\n"
+"// above.  Given the same inputs, %s() will return exactly\n"
+"// what the core will produce once it has finished.\n"
+"//\n"
+"#define\tHAS_LINEAR_MODEL\n\n",
+		(vectoring) ? "lvector_model" : "lrotate_model");
+
+	fprintf(fhp,
+"// Sign extend the bottom w bits of v\n"
+"static inline long\tlinear_sext(unsigned long v, int w) {\n"
+"\treturn ((long)(v << (64-w))) >> (64-w);\n"
+"}\n\n");
+
+	if (vectoring)
+		fprintf(fhp,
+"static inline void\tlvector_model(long i_xval, long i_yval,\n"
+"\t\tunsigned long &o_zval) {\n");
+	else
+		fprintf(fhp,
+"static inline void\tlrotate_model(long i_xval, long i_yval,\n"
+"\t\tunsigned long i_zval, long &o_yval) {\n");
+
+	fprintf(fhp,
+"\tconst\tunsigned long	PMSK = (1ul << PW) - 1;\n"
+"\tlong\t\txv, yv;\n"
+"\tunsigned long\tzv;\n"
+"\n"
+"\t// Sign extend our inputs to the working width, one bit down\n"
+"\txv = linear_sext(i_xval, IW) * (1l << (WW-IW-1));\n"
+"\tyv = linear_sext(i_yval, IW) * (1l << (WW-IW-1));\n");
+	if (vectoring)
+		fprintf(fhp,
+"\n"
+"\t// y/x is the same as (-y)/(-x)\n"
+"\tif (xv < 0) {\n"
+"\t\txv = -xv;\n"
+"\t\tyv = -yv;\n"
+"\t}\n"
+"\tzv = 0;\n");
+	else
+		fprintf(fhp,
+"\tzv = i_zval & PMSK;\n");
+
+	fprintf(fhp,
+"\n"
+"\t// Linear CORDIC stages\n"
+"\tfor(int k=0; k<NSTAGES; k++) {\n"
+"\t\tconst\tunsigned long\tzstep = (1ul << (PW-2)) >> k;\n");
+	if (vectoring)
+		fprintf(fhp,
+"\n"
+"\t\t// y is kept scaled by 2^(k+1), so x is never shifted\n"
+"\t\tif (yv < 0) {\n"
+"\t\t\tyv = linear_sext(2*yv + xv, WW);\n"
+"\t\t\tzv = (zv - zstep) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\tyv = linear_sext(2*yv - xv, WW);\n"
+"\t\t\tzv = (zv + zstep) & PMSK;\n"
+"\t\t}\n");
+	else
+		fprintf(fhp,
+"\t\tlong\tdx = xv >> (k+1);\n"
+"\n"
+"\t\tif (0 == ((zv >> (PW-1))&1)) {\n"
+"\t\t\tyv = linear_sext(yv + dx, WW);\n"
+"\t\t\tzv = (zv - zstep) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\tyv = linear_sext(yv - dx, WW);\n"
+"\t\t\tzv = (zv + zstep) & PMSK;\n"
+"\t\t}\n");
+	fprintf(fhp,
+"\t}\n"
+"\n");
+
+	if (vectoring) {
+		fprintf(fhp,
+"\to_zval = zv;\n"
+"}\n"
+"// }}}\n");
+		return;
+	}
+
+	if (ww > ow+1)
+		fprintf(fhp,
+"\t// Round towards even, then drop the extra bits\n"
+"\tif ((yv >> (WW-OW)) & 1)\n"
+"\t\tyv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\tyv += (1l << (WW-OW-1)) - 1;\n"
+"\tyv = linear_sext(yv, WW);\n"
+"\n");
+	else
+		fprintf(fhp,
+"\t// No rounding required\n");
+
+	fprintf(fhp,
+"\to_yval = yv >> (WW-OW);\n"
+"}\n"
+"// }}}\n");
+	// }}}
+}
+
+int	linear(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+		int nstages, int iw, int ow, int nxtra, int phase_bits,
+		bool vectoring, bool sequential,
+		bool with_reset, bool with_aux, bool async_reset) {
+	// {{{
+	int	working_width = iw;
+	const	char *name;
+	std::string	purpose;
+	const	char	HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+
+	if (vectoring)
+		purpose =
+	"This file divides i_yval by i_xval, using a linear CORDIC\n"
+	"//\t\tin vectoring mode: y is driven to zero, leaving the quotient\n"
+	"//\tin o_zval, a signed fraction in units of 2^-(PW-1).  For the\n"
+	"//\tCORDIC to converge, |i_yval| must be less than |i_xval|.";
+	else
+		purpose =
+	"This file calculates i_yval + i_xval * i_zval, using a linear\n"
+	"//\t\tCORDIC in rotation mode, and so without any multiplies.\n"
+	"//\ti_zval is a signed fraction, in units of 2^-(PW-1), and so runs\n"
+	"//\tfrom -1 to 1.";
+	if (sequential)
+		purpose += "\n//\n"
+	"//\tThis particular version processes one value at a time, in a\n"
+	"//\tsequential, vs pipelined, fashion.";
+
+	legal(fp, fname, PROJECT, purpose.c_str(), cmdline);
+	// The inputs are placed one bit down, since y + x*z may be as large
+	// as twice either input
+	if (nxtra < 1)
+		nxtra = 1;
+	assert(phase_bits >= 3);
+
+	if (working_width < ow)
+		working_width = ow;
+	working_width += nxtra;
+	assert(nstages <= calc_linear_stages(working_width, phase_bits));
+
+	std::string	resetw = (!with_reset)?""
+			: ((async_reset)?"i_areset_n" : "i_reset");
+	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+				"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+				"\tif (i_reset)\n";
+
+	// The direction of each step.  In rotation mode, a positive z adds
+	// x to y and drives z down.  In vectoring mode, a negative y drives
+	// y back up.  When dividing, y is kept scaled up by 2^(k+1) rather
+	// than shifting x down, so the quotient is exact to its last bit.
+	const	char	*positive, *ynext, *xstep;
+	const	char	*stage_note = (vectoring)
+		? "\t// x never changes.  Rather than shifting x down by i+1, stage\n"
+		  "\t// i keeps y scaled up by 2^(i+1), so no bits are ever lost.\n"
+		  "\t// Stage i then steps z by 2^-(i+1).\n"
+		: "\t// x never changes.  Each stage only adds (or subtracts) a\n"
+		  "\t// shifted copy of it to y.  Stage i shifts x by i+1, and\n"
+		  "\t// steps z by 2^-(i+1).\n";
+	std::string	ysrc, zsrc;
+	if (sequential) {
+		positive = (vectoring) ? "yv[WW-1]" : "!zv[PW-1]";
+		ynext = (vectoring) ? "{ yv[(WW-2):0], 1\'b0 }" : "yv";
+		xstep = (vectoring) ? "xv" : "(xv >>> cshift)";
+		ysrc = "yv"; zsrc = "zv";
+	} else {
+		positive = (vectoring) ? "yv[i][WW-1]" : "!zv[i][PW-1]";
+		ynext = (vectoring) ? "{ yv[i][(WW-2):0], 1\'b0 }" : "yv[i]";
+		xstep = (vectoring) ? "xv[i]" : "(xv[i]>>>S)";
+		ysrc = "yv[NSTAGES]"; zsrc = "zv[NSTAGES]";
+	}
+
+	name = modulename(fname);
+
+	// Module declaration
+	// {{{
+	fprintf(fp, "`default_nettype\tnone\n");
+	fprintf(fp,
+		"module	%s#(\n"
+		"\t\t// {{{\n"
+		"\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d\t// Bits in our z variables\n"
+		"\t\t// }}}\n"
+		"\t) (\n"
+		"\t\t// {{{\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%s%s,\n"
+		"\tinput\twire\tsigned\t[(IW-1):0]\t\ti_xval, i_yval,\n",
+		name, iw, ow, nstages, nxtra, working_width, phase_bits,
+		resetw.c_str(), (with_reset)?", ":"",
+		(sequential) ? "i_stb" : "i_ce");
+	if (!vectoring)
+		fprintf(fp,
+		"\tinput\twire\tsigned\t[(PW-1):0]\t\ti_zval,\n");
+	if (sequential)
+		fprintf(fp,
+		"\toutput\twire\t\t\t\to_busy,\n"
+		"\toutput\treg\t\t\t\to_done,\n");
+	if (vectoring)
+		fprintf(fp,
+		"\toutput\treg\tsigned\t[(PW-1):0]\to_zval%s\n",
+		(with_aux)?",":"");
+	else
+		fprintf(fp,
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_yval%s\n",
+		(with_aux)?",":"");
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux,\n"
+			"\toutput\treg\t\t\t\to_aux\n");
+	} fprintf(fp, "\t\t// }}}\n\t);\n\n");
+	// }}}
+
+	// Declarations
+	// {{{
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n"
+		"\t// {{{\n"
+		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n");
+	if (sequential) {
+		fprintf(fp,
+		"\treg	signed	[(WW-1):0]	xv, prex, yv, prey;\n"
+		"\treg		[(PW-1):0]	zv, prez;\n"
+		"\treg\t\t\t\tidle, pre_valid;\n"
+		"\treg\t\t[%d:0]\t\tstate;\n"
+		"\twire\t\t\t\tlast_state;\n"
+		"\twire\t\t[(PW-1):0]\tzstep;\n",
+		nextlg((unsigned)nstages+1)-1);
+		if (!vectoring)
+			fprintf(fp, "\twire\t\t[%d:0]\t\tcshift;\n",
+				nextlg((unsigned)nstages+1)-1);
+		if (with_aux)
+			fprintf(fp, "\treg\t\t\t\taux;\n");
+	} else {
+		fprintf(fp,
+		"\treg	signed	[(WW-1):0]\txv\t[0:(NSTAGES)];\n"
+		"\treg	signed	[(WW-1):0]\tyv\t[0:(NSTAGES)];\n"
+		"\treg		[(PW-1):0]\tzv\t[0:(NSTAGES)];\n");
+		if (with_aux)
+			fprintf(fp, "\treg\t\t[(NSTAGES):0]\tax;\n");
+	}
+	fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	// Sign extend our inputs
+	// {{{
+	fprintf(fp,
+		"\t// Sign extend our inputs\n"
+		"\t// {{{\n"
+		"\t// Extend our inputs by one bit on the left, to make room for\n"
+		"\t// y + x*z, and by any extra bits on the right.\n");
+	if (working_width-iw-1 > 0) {
+		fprintf(fp,
+			"\tassign\te_xval = { i_xval[(IW-1)], i_xval, {(WW-IW-1){1'b0}} };\n"
+			"\tassign\te_yval = { i_yval[(IW-1)], i_yval, {(WW-IW-1){1'b0}} };\n");
+	} else {
+		fprintf(fp,
+			"\tassign\te_xval = { i_xval[(IW-1)], i_xval };\n"
+			"\tassign\te_yval = { i_yval[(IW-1)], i_yval };\n");
+	} fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	if (with_aux) {
+		// {{{
+		fprintf(fp,
+"\t//\n"
+"\t// Handle the auxilliary logic.\n"
+"\t// {{{\n"
+"\t// The auxilliary bit is designed so that you can place a valid bit into\n"
+"\t// the CORDIC function, and see when it comes out.  While the bit is\n"
+"\t// allowed to be anything, the requirement of this bit is that it *must*\n"
+"\t// be aligned with the output when done.  That is, if i_xval and i_yval\n"
+"\t// are input together with i_aux, then when the outputs are set to\n"
+"\t// their result, o_aux *must* contain the value that was in i_aux.\n"
+"\t//\n"
+"\n");
+
+		if (sequential) {
+			fprintf(fp, "\tinitial\taux = 0;\n");
+			fprintf(fp, "%s", always_reset.c_str());
+			if (with_reset)
+				fprintf(fp, "\t\taux <= 0;\n\telse ");
+			fprintf(fp, "if ((i_stb)&&(!o_busy))\n"
+				"\t\taux <= i_aux;\n");
+		} else {
+			fprintf(fp, "\tinitial\tax = 0;\n");
+			fprintf(fp, "%s", always_reset.c_str());
+			if (with_reset)
+				fprintf(fp, "\t\tax <= 0;\n\telse ");
+			fprintf(fp, "if (i_ce)\n"
+				"\t\tax <= { ax[(NSTAGES-1):0], i_aux };\n");
+		}
+		fprintf(fp, "\t// }}}\n\n");
+		// }}}
+	}
+
+	// Pre-rotation
+	// {{{
+	std::string	x0 = (sequential) ? "prex" : "xv[0]",
+			y0 = (sequential) ? "prey" : "yv[0]",
+			z0 = (sequential) ? "prez" : "zv[0]";
+
+	fprintf(fp,
+		"\t// Pre-rotation\n"
+		"\t// {{{\n");
+	if (vectoring)
+		fprintf(fp,
+		"\t// Since y/x is the same as (-y)/(-x), we can make certain x\n"
+		"\t// is positive.  The quotient, z, starts at zero.\n");
+	else
+		fprintf(fp,
+		"\t// There\'s nothing to reduce in the linear CORDIC.  The inputs\n"
+		"\t// are simply registered.\n");
+
+	if (sequential) {
+		fprintf(fp, "\talways @(posedge i_clk)\n");
+	} else {
+		fprintf(fp,
+			"\tinitial begin\n"
+			"\t\txv[0] = 0;\n"
+			"\t\tyv[0] = 0;\n"
+			"\t\tzv[0] = 0;\n"
+			"\tend\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp,
+				"\tbegin\n"
+				"\t\txv[0] <= 0;\n"
+				"\t\tyv[0] <= 0;\n"
+				"\t\tzv[0] <= 0;\n"
+				"\tend else ");
+		fprintf(fp, "if (i_ce)\n");
+	}
+
+	if (vectoring)
+		fprintf(fp,
+		"\tbegin\n"
+		"\t\t// {{{\n"
+		"\t\tif (i_xval[IW-1])\n"
+		"\t\tbegin\n"
+		"\t\t\t%s <= -e_xval;\n"
+		"\t\t\t%s <= -e_yval;\n"
+		"\t\tend else begin\n"
+		"\t\t\t%s <= e_xval;\n"
+		"\t\t\t%s <= e_yval;\n"
+		"\t\tend\n"
+		"\t\t%s <= 0;\n"
+		"\t\t// }}}\n"
+		"\tend\n",
+		x0.c_str(), y0.c_str(), x0.c_str(), y0.c_str(), z0.c_str());
+	else
+		fprintf(fp,
+		"\tbegin\n"
+		"\t\t// {{{\n"
+		"\t\t%s <= e_xval;\n"
+		"\t\t%s <= e_yval;\n"
+		"\t\t%s <= i_zval;\n"
+		"\t\t// }}}\n"
+		"\tend\n",
+		x0.c_str(), y0.c_str(), z0.c_str());
+	fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	if (sequential) {
+		// {{{
+		fprintf(fp,
+			"\tassign\tlast_state = (!idle)&&(state == %d\'d%d);\n",
+			nextlg((unsigned)nstages+1), nstages);
+
+		fprintf(fp, "\n\t// idle\n\t// {{{\n"
+			"\tinitial\tidle = 1\'b1;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tidle <= 1\'b1;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if ((i_stb)&&(idle))\n"
+				"\t\tidle <= 1\'b0;\n"
+				"\telse if (last_state)\n"
+				"\t\tidle <= 1\'b1;\n");
+		fprintf(fp, "\t// }}}\n\n");
+
+		fprintf(fp, "\t// pre_valid\n\t// {{{\n");
+		fprintf(fp, "\tinitial\tpre_valid = 1\'b0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tpre_valid <= 1\'b0;\n\telse\n");
+		fprintf(fp, "\t\tpre_valid <= (i_stb)&&(idle);\n\t// }}}\n\n");
+
+		fprintf(fp, "\t// state -- the stage applied on this clock\n"
+			"\t// {{{\n\tinitial\tstate = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tstate <= 0;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if ((idle)||(pre_valid))\n"
+				"\t\tstate <= 0;\n"
+				"\telse if (!last_state)\n"
+				"\t\tstate <= state + 1;\n\t// }}}\n\n");
+
+		if (!vectoring)
+			fprintf(fp, "\tassign\tcshift = state + 1;\n");
+		fprintf(fp,
+			"\tassign\tzstep = { 2\'b01, {(PW-2){1\'b0}} } >> state;\n\n");
+
+		fprintf(fp,
+			"\t// Linear CORDIC stages\n"
+			"\t// {{{\n"
+			"%s"
+			"\talways @(posedge i_clk)\n"
+			"\tif (pre_valid)\n"
+			"\tbegin\n"
+				"\t\t// {{{\n"
+				"\t\txv <= prex;\n"
+				"\t\tyv <= prey;\n"
+				"\t\tzv <= prez;\n"
+				"\t\t// }}}\n"
+			"\tend else if ((!idle)&&(!last_state))\n"
+			"\tbegin\n"
+			"\t\tif (%s)\n"
+			"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\tyv <= %s + %s;\n"
+				"\t\t\tzv <= zv - zstep;\n"
+				"\t\t\t// }}}\n"
+			"\t\tend else begin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\tyv <= %s - %s;\n"
+				"\t\t\tzv <= zv + zstep;\n"
+				"\t\t\t// }}}\n"
+			"\t\tend\n"
+			"\tend\n\t// }}}\n",
+			stage_note, positive,
+			ynext, xstep, ynext, xstep);
+		// }}}
+	} else {
+		// {{{
+		fprintf(fp,
+			"\t// Linear CORDIC stages\n"
+			"\t// {{{\n"
+			"%s"
+			"\tgenvar	i;\n"
+			"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops\n",
+			stage_note);
+		if (!vectoring)
+			fprintf(fp, "\t\tlocalparam\t\t\tS = i+1;\n");
+		fprintf(fp,
+			"\t\tlocalparam\t[(PW-1):0]\tZSTEP\n"
+			"\t\t\t\t= { 2\'b01, {(PW-2){1\'b0}} } >> i;\n\n");
+		if (with_reset) {
+			fprintf(fp,
+				"\t\tinitial begin\n"
+				"\t\t\txv[i+1] = 0;\n"
+				"\t\t\tyv[i+1] = 0;\n"
+				"\t\t\tzv[i+1] = 0;\n"
+				"\t\tend\n\n\t");
+		}
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(fp,
+				"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tzv[i+1] <= 0;\n"
+				"\t\t\t// }}}\n"
+				"\t\tend else ");
+		} else
+			fprintf(fp, "\t\t");
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\t\tbegin\n"
+			"\t\t\t// {{{\n"
+			"\t\t\txv[i+1] <= xv[i];\n"
+			"\t\t\tif (%s)\n"
+			"\t\t\tbegin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\tyv[i+1] <= %s + %s;\n"
+			"\t\t\t\tzv[i+1] <= zv[i] - ZSTEP;\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else begin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\tyv[i+1] <= %s - %s;\n"
+			"\t\t\t\tzv[i+1] <= zv[i] + ZSTEP;\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend\n"
+			"\t\t\t// }}}\n"
+			"\t\tend\n"
+			"\tend endgenerate\n\t// }}}\n\n", positive,
+			ynext, xstep, ynext, xstep);
+		// }}}
+	}
+
+	// Outputs
+	// {{{
+	const	char	*oname = (vectoring) ? "o_zval" : "o_yval";
+	std::string	oval;
+	bool		rounding = (!vectoring)&&(working_width > ow+1);
+
+	if (vectoring)
+		oval = zsrc;
+	else if (rounding)
+		oval = "pre_yval[(WW-1):(WW-OW)]";
+	else
+		oval = ysrc + "[(WW-1):(WW-OW)]";
+
+	if (rounding) {
+		fprintf(fp,
+			"\n\t// Round our result towards even\n"
+			"\t// {{{\n"
+			"\twire\t[(WW-1):0]\tpre_yval;\n\n"
+			"\tassign\tpre_yval = %s + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n"
+			"\t// }}}\n",
+			ysrc.c_str(), ysrc.c_str(), ysrc.c_str());
+	}
+
+	fprintf(fp, "\n\t// Output assignments: %s%s\n\t// {{{\n",
+		oname, (with_aux) ? ", o_aux" : "");
+	if (sequential) {
+		fprintf(fp, "\tinitial\to_done = 1\'b0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\to_done <= 1\'b0;\n\telse\n");
+		fprintf(fp, "\t\to_done <= last_state;\n\n");
+
+		if (with_aux)
+			fprintf(fp, "\tinitial\to_aux = 0;\n");
+		fprintf(fp, "\talways @(posedge i_clk)\n"
+			"\tif (last_state)\n"
+			"\tbegin\n");
+		fprintf(fp, "\t\t%s <= %s;\n", oname, oval.c_str());
+		if (with_aux)
+			fprintf(fp, "\t\to_aux <= aux;\n");
+		fprintf(fp, "\tend\n");
+	} else {
+		fprintf(fp, "\tinitial begin\n");
+		fprintf(fp, "\t\t%s = 0;\n", oname);
+		if (with_aux)
+			fprintf(fp, "\t\to_aux = 0;\n");
+		fprintf(fp, "\tend\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset) {
+			fprintf(fp, "\tbegin\n");
+			fprintf(fp, "\t\t%s <= 0;\n", oname);
+			if (with_aux)
+				fprintf(fp, "\t\to_aux <= 0;\n");
+			fprintf(fp, "\tend else ");
+		}
+		fprintf(fp, "if (i_ce)\n"
+			"\tbegin\n");
+		fprintf(fp, "\t\t%s <= %s;\n", oname, oval.c_str());
+		if (with_aux)
+			fprintf(fp, "\t\to_aux <= ax[NSTAGES];\n");
+		fprintf(fp, "\tend\n");
+	}
+	fprintf(fp, "\t// }}}\n\n");
+
+	if (sequential)
+		fprintf(fp, "\tassign\to_busy = !idle;\n\n");
+
+	if (rounding) {
+		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+			"\t// {{{\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire\tunused_val;\n"
+			"\tassign\tunused_val = &{ 1\'b0, pre_yval[(WW-OW-1):0] };\n"
+			"\t// verilator lint_on UNUSED\n"
+			"\t// }}}\n");
+	}
+	// }}}
+
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp) {
+		// {{{
+		char	*str = new char[strlen(name)+4], *ptr;
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef	%s\n", str);
+		fprintf(fhp, "#define	%s\n", str);
+
+		if (async_reset)
+			fprintf(fhp, "#define\tASYNC_RESET\n");
+		if (sequential) {
+			fprintf(fhp, "#ifdef\tCLOCKS_PER_OUTPUT\n");
+			fprintf(fhp, "#undef\tCLOCKS_PER_OUTPUT\n");
+			fprintf(fhp, "#endif\t// CLOCKS_PER_OUTPUT\n");
+			fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n\n",
+				nstages+3);
+		}
+		fprintf(fhp, "#define\tLINEAR\n");
+		if (vectoring)
+			fprintf(fhp, "#define\tVECTORING\n");
+		fprintf(fhp, "const int	IW = %d;\n", iw);
+		fprintf(fhp, "const int	OW = %d;\n", ow);
+		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
+		fprintf(fhp, "const int	WW = %d;\n", working_width);
+		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
+		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+		if (!sequential)
+			fprintf(fhp, "const int	LATENCY = %d;\t// Clocks from i_ce to output\n",
+				nstages+2);
+		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+			linear_quantization_variance(nstages,
+				working_width-iw-1, working_width-ow));
+		fprintf(fhp, "const double	PHASE_VARIANCE = %.4e; // (Z^2)\n",
+			linear_residual_variance(nstages));
+		// With the inputs one bit down, the output is
+		// y+x*z * 2^(OW-IW-1), as with the other cores
+		fprintf(fhp, "const double	GAIN = 1.0;\n");
+		fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+			linear_cnr(nstages, iw, ow, working_width));
+		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+
+		linear_model(fhp, ow, working_width, vectoring);
+
+		fprintf(fhp, "#endif\t// %s\n", str);
+		delete[] str;
+		// }}}
+	}
+
+	return (sequential) ? nstages+3 : nstages+2;
+	// }}}
+}
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/linear.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Generates linear CORDIC cores, either pipelined or sequential,
+//		for multiplying and dividing with nothing more than shifts
+//	and adds.  In rotation mode, z is driven to zero, producing
+//
+//		o_yval = i_yval + i_xval * i_zval
+//
+//	In vectoring mode, y is driven to zero instead, producing
+//
+//		o_zval = i_yval / i_xval
+//
+//	z is a signed fraction, running from -1 to 1, so the quotient
+//	requires |i_yval| < |i_xval|.  Unlike the circular and hyperbolic
+//	CORDICs, the linear CORDIC has no gain to correct for.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	LINEAR_H
+#define	LINEAR_H
+
+#include <stdio.h>
+
+// Returns the number of clocks from i_ce to the output for the pipelined
+// cores, or the number of clocks per output for the sequential ones
+extern	int	linear(FILE *fp, FILE *fhp, const char *cmdline,
+			const char *fname, int nstages, int iw, int ow,
+			int nxtra, int phase_bits, bool vectoring,
+			bool sequential, bool with_reset, bool with_aux,
+			bool async_reset);
+
+#endif	// LINEAR_H
@@ -43,6 +43,7 @@
 #include <math.h>
 #include <string.h>
 #include <unistd.h>
+#include <getopt.h>
 #include <ctype.h>
 #include <assert.h>
 
@@ -53,24 +54,52 @@
 #include "seqcordic.h"
 #include "sintable.h"
 #include "quadtbl.h"
+#include "sincos.h"
+#include "hyperbolic.h"
+#include "linear.h"
+#include "ncowrap.h"
+#include "hybrid.h"
+#include "hexfile.h"
+#include "explore.h"
+#include "axiswrap.h"
 
 void	usage(void) {
 	fprintf(stderr,
-"USAGE: gencordic [-ahrv] [-f <fname>] [-i <iw>] [-o <ow>]\n"
+"USAGE: gencordic [-ahrSv] [-f <fname>] [-i <iw>] [-o <ow>] [-L <lanes>]\n"
+"\t   [-k <stages-per-clock>] [--regs-every <n>] [--radix4] [--unit-gain]\n"
+"\t   [--rom <bits>]\n"
 "\t   [-n <stages>] [-p <phasebits>] [-t <type-of-cordic>] [-x <xtrabits>]\n"
+"       gencordic --explore [-i <iw>] [-o <ow>] [-t <type-of-cordic>]\n"
+"\t   [-n <stages>] [-p <phasebits>] [-x <xtrabits>]\n"
 "\n"
 "\t-a\t\tCreate an auxilliary bit, useful for tracking logic\n"
 "\t\t\tthrough the cordic stages, and knowing when a valid\n"
 "\t\t\toutput is ready.\n"
 "\t-c\t\tCreate\'s a C-header file containing the numbers of bits\n"
-"\t\t\tthe cordic has been built for.\n"
+"\t\t\tthe cordic has been built for.  For p2r and r2p, this\n"
+"\t\t\theader also contains a bit-exact C++ model of the core.\n"
 "\t-f <fname>\tSets the output filename to <fname>\n"
 "\t-h\t\tShow this message\n"
 "\t-i <iw>\tSets the input bit-width\n"
+"\t-k <k>\t\tFor the sp2r and sr2p cores, apply <k> CORDIC stages\n"
+"\t\t\tper clock instead of one.  Each result then takes\n"
+"\t\t\tceil(stages/<k>)+3 clocks, at the cost of <k> copies\n"
+"\t\t\tof the rotation logic.\n"
+"\t-L <lanes>\tBuilds a p2r or r2p core processing <lanes> samples\n"
+"\t\t\tper clock.  Each port becomes a vector of <lanes>\n"
+"\t\t\tvalues, with lane k in the k'th (lowest first) slot.\n"
+"\t\t\tAll lanes share one angle table and one aux pipeline.\n"
 "\t-n <stages>\tForces the number of cordic stages to <stages>\n"
 "\t-o <ow>\tSets the output bit-width\n"
 "\t-p <pw>\tSets the number of bits in the phase processor\n"
 "\t-r\tCreate reset logic in the produced cordic\n"
+"\t-S\t\tAppend an AXI-Stream wrapper, <module>_axis, to the\n"
+"\t\t\toutput file.  The wrapper adds valid/ready handshaking\n"
+"\t\t\tto either side, and an output FIFO deep enough to\n"
+"\t\t\tabsorb every result still within the core, so that the\n"
+"\t\t\tcore keeps its full throughput through intermittent\n"
+"\t\t\tstalls.  For the pipelined cores, the aux bit is then\n"
+"\t\t\tused by the wrapper, and so is no longer available.\n"
 "\t-t <type-of-cordic>\tDetermines which type of logic is created.  Two\n"
 "\t\t\tbase types of cordic\'s are supported, and three methods\n"
 "\t\t\tof straight sinewave generation:\n"
@@ -83,24 +112,88 @@ void	usage(void) {
 "\t\tsp2r\tPolar to rectangular, but sequential instead of\n"
 "\t\t\tpipelined\n"
 "\t\tsr2p\tSequential rectangular to polar\n"
+"\t\tsincos\tA p2r CORDIC specialized to produce the cosine and\n"
+"\t\t\tsine of its phase, as o_cos and o_sin.  The constant\n"
+"\t\t\tinput vector, pre-scaled by 1/GAIN, is folded into the\n"
+"\t\t\tdesign, leaving the phase as the only input.\n"
+"\t\throt\tHyperbolic rotation.  Rotate (x,y) through the\n"
+"\t\t\thyperbolic angle i_phase, for cosh, sinh, and exp.\n"
+"\t\thvec\tHyperbolic vectoring.  Produce sqrt(x^2-y^2) and\n"
+"\t\t\tatanh(y/x), for sqrt and ln.\n"
+"\t\tshrot\tSequential hyperbolic rotation\n"
+"\t\tshvec\tSequential hyperbolic vectoring\n"
+"\t\tlrot\tLinear rotation.  Produce y+x*z, a multiply using only\n"
+"\t\t\tshifts and adds.  z, set by -p, runs from -1 to 1.\n"
+"\t\tlvec\tLinear vectoring.  Produce z=y/x, a divide using only\n"
+"\t\t\tshifts and adds.  Requires |y| < |x|.\n"
+"\t\tslrot\tSequential linear rotation\n"
+"\t\tslvec\tSequential linear vectoring\n"
 "\t\tqtr\tQuarter-wave table lookup sinewave generator\n"
+"\t\tlinqtr\tQuarter-wave table lookup sinewave generator, with\n"
+"\t\t\ta linear interpolation between table entries\n"
 "\t\tqtbl\tQuadratically interpolated sinewave generator\n"
 "\t\ttbl\tStraight table lookup sinewave generator\n"
 "\t-v\tTurns on any verbose outputting\n"
 "\t-x <xtrabits>\tUses this many extra bits in rectangular\n"
-"\t\t\tvalue processing\n");
+"\t\t\tvalue processing\n"
+"\t--regs-every <n>  For the p2r and r2p cores, place a register only\n"
+"\t\t\tafter every <n> CORDIC stages, rather than after each\n"
+"\t\t\tone.  This cuts both the latency and the number of\n"
+"\t\t\tflip-flops, at the cost of <n> adders in series.\n"
+"\t--radix4\tFor the p2r and r2p cores, replace the later CORDIC\n"
+"\t\t\tstages with radix-4 stages, each rotating by one of\n"
+"\t\t\tatan(d*2^-s), d in {-2..2}, and so resolving two bits.\n"
+"\t\t\tThe earlier stages, where the gain of a radix-4 stage\n"
+"\t\t\twould depend upon d, remain radix-2.\n"
+"\t--unit-gain\tFor the p2r, r2p, sp2r, and sr2p cores, add one more\n"
+"\t\t\tstage multiplying the result by the constant 1/GAIN.\n"
+"\t\t\tThe core then has a gain of one, as does its header.\n"
+"\t--rom <bits>\tFor the (single lane) p2r core, replace the first\n"
+"\t\t\t<bits> CORDIC stages with one rotation, by the cosine and\n"
+"\t\t\tsine of the <bits> phase bits below the octant, read\n"
+"\t\t\tfrom a ROM and applied with one complex multiply.\n"
+"\t\t\tThe ROM is written to <fname>_cos.hex and _sin.hex.\n"
+"\t--order <n>\tFor the qtbl core, interpolate between table entries\n"
+"\t\t\twith a polynomial of order <n>, either 2 (quadratic, the\n"
+"\t\t\tdefault) or 3 (cubic).  A cubic costs one more multiply\n"
+"\t\t\tand two more clocks, but needs a much smaller table.\n"
+"\t--dual\t\tFor the qtr and qtbl cores, produce both o_sin and\n"
+"\t\t\to_cos, sharing one table (and header) between them.\n"
+"\t\t\tThe qtbl multiplies can't be shared, so this doubles\n"
+"\t\t\tthem.  The header lists NMULTS and NDSPS.\n"
+"\t--nco <bits>\tFor the tbl, qtr, linqtr, qtbl, sincos, and p2r cores,\n"
+"\t\t\tappend a numerically controlled oscillator,\n"
+"\t\t\t<module>_nco, driving the core\'s phase from a <bits>\n"
+"\t\t\twide phase accumulator.  <bits> must be wider than the\n"
+"\t\t\tcore\'s phase.\n"
+"\t--dither <bits>  With --nco, add dither from a <bits> long LFSR\n"
+"\t\t\tbelow the core\'s phase bits before truncating the\n"
+"\t\t\taccumulator, trading phase truncation spurs for noise.\n"
+"\t--explore\tRather than generating a core, evaluate the best\n"
+"\t\t\tpossible CNR and an estimate of the hardware cost for\n"
+"\t\t\tevery combination of extra bits, phase bits, and stages,\n"
+"\t\t\tfor each of the p2r, r2p, sp2r, and sr2p cores.  Then\n"
+"\t\t\tprint the designs for which no other design is both\n"
+"\t\t\tcheaper and more accurate.  Any of -n, -p, -t, or -x\n"
+"\t\t\tgiven restricts the search to that value.\n");
 }
 
 int	main(int argc, char **argv) {
 	const int	DEFAULT_BITWIDTH = 24;
-	int	nstages = -1, iw=-1, ow=-1, nxtra=2, phase_bits=-1, ww;
+	int	nstages = -1, iw=-1, ow=-1, nxtra=2, phase_bits=-1, ww,
+		lanes = 1, iters = 1, regs = 1, latency = 0,
+		nco_bits = 0, dither_bits = 0, rom_bits = 0, order = 0;
 	const char	*fname = NULL;
 	char	*cmdline;
 	bool	with_reset = true, with_aux = false;
 	bool	polar_to_rect = false, rect_to_polar = true, verbose=false,
 		gen_sintable = false, gen_quarterwav = false, c_header = false,
-		gen_quadtbl = false, async_reset = false,
-		sequential = false;
+		gen_quadtbl = false, gen_sincos = false, async_reset = false,
+		gen_hyperbolic = false, vectoring = false,
+		gen_linear = false, gen_linqtr = false,
+		sequential = false, do_explore = false, fixed_xtra = false,
+		radix4 = false, axis = false, unit_gain = false, dual = false;
+	const char	*ctype = NULL;
 	int	c, cmdlen;
 	FILE	*fp, *fhp;
 
@@ -136,7 +229,25 @@ int	main(int argc, char **argv) {
 	// {{{
 	////////////////////////////////////////////////////////////////////////
 	//
-	while((c = getopt(argc, argv, "aAcf:hi:n:o:p:Rrt:vx:"))!=-1) {
+	const int	OPT_EXPLORE = 256, OPT_REGS_EVERY = 257,
+			OPT_RADIX4 = 258, OPT_UNIT_GAIN = 259,
+			OPT_NCO = 260, OPT_DITHER = 261, OPT_ROM = 262,
+			OPT_ORDER = 263, OPT_DUAL = 264;
+	static	const struct option	long_options[] = {
+		{ "explore", no_argument, NULL, OPT_EXPLORE },
+		{ "regs-every", required_argument, NULL, OPT_REGS_EVERY },
+		{ "radix4", no_argument, NULL, OPT_RADIX4 },
+		{ "unit-gain", no_argument, NULL, OPT_UNIT_GAIN },
+		{ "nco", required_argument, NULL, OPT_NCO },
+		{ "dither", required_argument, NULL, OPT_DITHER },
+		{ "rom", required_argument, NULL, OPT_ROM },
+		{ "order", required_argument, NULL, OPT_ORDER },
+		{ "dual", no_argument, NULL, OPT_DUAL },
+		{ NULL, 0, NULL, 0 }
+	};
+
+	while((c = getopt_long(argc, argv, "aAcf:hi:k:L:n:o:p:RrSt:vx:",
+					long_options, NULL))!=-1) {
 		switch(c) {
 		case 'a':
 			with_aux = true;
@@ -158,6 +269,12 @@ int	main(int argc, char **argv) {
 		case 'i':
 			iw = atoi(optarg);
 			break;
+		case 'k':
+			iters = atoi(optarg);
+			break;
+		case 'L':
+			lanes = atoi(optarg);
+			break;
 		case 'n':
 			nstages = atoi(optarg);
 			break;
@@ -173,11 +290,19 @@ int	main(int argc, char **argv) {
 		case 'r':
 			with_reset = true;
 			break;
+		case 'S':
+			axis = true;
+			break;
 		case 't':
 			rect_to_polar  = false;
 			polar_to_rect  = false;
 			gen_sintable   = false;
 			gen_quarterwav = false;
+			gen_linqtr     = false;
+			gen_sincos     = false;
+			gen_hyperbolic = false;
+			gen_linear     = false;
+			ctype = optarg;
 			if (strcmp(optarg, "r2p")==0) {
 				if (fname == NULL)
 					fname = "topolar.v";
@@ -196,6 +321,42 @@ int	main(int argc, char **argv) {
 					fname = "seqcordic.v";
 				polar_to_rect = true;
 				sequential = true;
+			} else if ((strcmp(optarg, "hrot")==0)
+					||(strcmp(optarg, "shrot")==0)) {
+				sequential = (optarg[0] == 's');
+				if (NULL == fname)
+					fname = (sequential) ? "seqhrotate.v"
+						: "hrotate.v";
+				gen_hyperbolic = true;
+				vectoring = false;
+			} else if ((strcmp(optarg, "hvec")==0)
+					||(strcmp(optarg, "shvec")==0)) {
+				sequential = (optarg[0] == 's');
+				if (NULL == fname)
+					fname = (sequential) ? "seqhvector.v"
+						: "hvector.v";
+				gen_hyperbolic = true;
+				vectoring = true;
+			} else if ((strcmp(optarg, "lrot")==0)
+					||(strcmp(optarg, "slrot")==0)) {
+				sequential = (optarg[0] == 's');
+				if (NULL == fname)
+					fname = (sequential) ? "seqlinrotate.v"
+						: "linrotate.v";
+				gen_linear = true;
+				vectoring = false;
+			} else if ((strcmp(optarg, "lvec")==0)
+					||(strcmp(optarg, "slvec")==0)) {
+				sequential = (optarg[0] == 's');
+				if (NULL == fname)
+					fname = (sequential) ? "seqlinvector.v"
+						: "linvector.v";
+				gen_linear = true;
+				vectoring = true;
+			} else if (strcmp(optarg, "sincos")==0) {
+				if (NULL == fname)
+					fname = "sincos.v";
+				gen_sincos = true;
 			} else if (strcmp(optarg, "tbl")==0) {
 				if (NULL == fname)
 					fname = "sintable.v";
@@ -204,6 +365,10 @@ int	main(int argc, char **argv) {
 				if (NULL == fname)
 					fname = "quarterwav.v";
 				gen_quarterwav = true;
+			} else if (strcmp(optarg, "linqtr")==0) {
+				if (NULL == fname)
+					fname = "linqtr.v";
+				gen_linqtr = true;
 			} else if (strcmp(optarg, "qtbl")==0) {
 				if (NULL == fname)
 					fname = "quadtbl.v";
@@ -217,6 +382,34 @@ int	main(int argc, char **argv) {
 			break;
 		case 'x':
 			nxtra = atoi(optarg);
+			fixed_xtra = true;
+			break;
+		case OPT_EXPLORE:
+			do_explore = true;
+			break;
+		case OPT_REGS_EVERY:
+			regs = atoi(optarg);
+			break;
+		case OPT_RADIX4:
+			radix4 = true;
+			break;
+		case OPT_UNIT_GAIN:
+			unit_gain = true;
+			break;
+		case OPT_NCO:
+			nco_bits = atoi(optarg);
+			break;
+		case OPT_DITHER:
+			dither_bits = atoi(optarg);
+			break;
+		case OPT_ROM:
+			rom_bits = atoi(optarg);
+			break;
+		case OPT_ORDER:
+			order = atoi(optarg);
+			break;
+		case OPT_DUAL:
+			dual = true;
 			break;
 		case '?':
 			if (isprint(optopt))
@@ -231,6 +424,123 @@ int	main(int argc, char **argv) {
 		}
 	}
 	// }}}
+
+	if (lanes < 1) {
+		fprintf(stderr, "ERR: At least one lane is required\n");
+		exit(EXIT_FAILURE);
+	} else if ((lanes > 1)&&((sequential)
+			||((!polar_to_rect)&&(!rect_to_polar)))) {
+		fprintf(stderr, "ERR: Only the p2r and r2p cores support multiple lanes\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (iters < 1) {
+		fprintf(stderr, "ERR: At least one stage per clock is required\n");
+		exit(EXIT_FAILURE);
+	} else if ((iters > 1)&&((!sequential)
+			||((!polar_to_rect)&&(!rect_to_polar)))) {
+		fprintf(stderr, "ERR: Only the sp2r and sr2p cores support multiple stages per clock\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (regs < 1) {
+		fprintf(stderr, "ERR: --regs-every requires at least one stage per register\n");
+		exit(EXIT_FAILURE);
+	} else if ((regs > 1)&&((sequential)
+			||((!polar_to_rect)&&(!rect_to_polar)))) {
+		fprintf(stderr, "ERR: Only the p2r and r2p cores support --regs-every\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if ((radix4)&&((sequential)
+			||((!polar_to_rect)&&(!rect_to_polar)))) {
+		fprintf(stderr, "ERR: Only the p2r and r2p cores support --radix4\n");
+		exit(EXIT_FAILURE);
+	} else if ((radix4)&&(regs > 1)) {
+		fprintf(stderr, "ERR: --radix4 and --regs-every may not be combined\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if ((unit_gain)&&(!polar_to_rect)&&(!rect_to_polar)) {
+		fprintf(stderr, "ERR: Only the CORDIC cores support --unit-gain\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if ((order != 0)&&(!gen_quadtbl)) {
+		fprintf(stderr, "ERR: Only the qtbl core supports --order\n");
+		exit(EXIT_FAILURE);
+	} else if (order == 0) {
+		order = 2;
+	} else if ((order != 2)&&(order != 3)) {
+		fprintf(stderr, "ERR: The qtbl interpolation order must be either 2 or 3\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if ((dual)&&(!gen_quarterwav)&&(!gen_quadtbl)) {
+		fprintf(stderr, "ERR: Only the qtr and qtbl cores support --dual\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if ((rom_bits != 0)&&((sequential)||(!polar_to_rect)||(lanes > 1))) {
+		fprintf(stderr, "ERR: Only the (single lane) p2r core supports --rom\n");
+		exit(EXIT_FAILURE);
+	} else if ((rom_bits != 0)&&((regs > 1)||(radix4)||(unit_gain))) {
+		fprintf(stderr, "ERR: --rom may not be combined with --regs-every, --radix4, or --unit-gain\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (nco_bits > 0) {
+		if ((sequential)||(lanes > 1)||((!polar_to_rect)
+				&&(!gen_sintable)&&(!gen_quarterwav)
+				&&(!gen_linqtr)&&(!gen_quadtbl)
+				&&(!gen_sincos))) {
+			fprintf(stderr, "ERR: Only the tbl, qtr, linqtr, qtbl, sincos, and (single lane) p2r cores support --nco\n");
+			exit(EXIT_FAILURE);
+		} else if (axis) {
+			fprintf(stderr, "ERR: --nco and -S may not be combined\n");
+			exit(EXIT_FAILURE);
+		}
+	} if ((dither_bits != 0)&&(nco_bits <= 0)) {
+		fprintf(stderr, "ERR: --dither requires --nco\n");
+		exit(EXIT_FAILURE);
+	} else if ((dither_bits != 0)&&((dither_bits < 3)||(dither_bits > 32))) {
+		fprintf(stderr, "ERR: The dithering LFSR must be between 3 and 32 bits\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (axis) {
+		// The pipelined cores are wrapped by tracking their aux bit.
+		// The sequential cores signal their results with o_done, and
+		// don't need it.
+		with_aux = !sequential;
+	}
+
+	if (do_explore) {
+		// {{{
+		if ((ctype)&&(strcmp(ctype, "p2r") != 0)
+				&&(strcmp(ctype, "r2p") != 0)
+				&&(strcmp(ctype, "sp2r") != 0)
+				&&(strcmp(ctype, "sr2p") != 0)) {
+			fprintf(stderr, "ERR: Only CORDIC types may be explored, not %s\n", ctype);
+			exit(EXIT_FAILURE);
+		}
+
+		if ((iw <= 0)&&(ow > 0))
+			iw = ow;
+		if (ow <= 0)
+			ow = iw;
+		if ((iw <= 0)||(ow <= 0)) {
+			fprintf(stderr, "WARNING: Assuming an input and output bit-width of %d bits\n", DEFAULT_BITWIDTH);
+			iw = DEFAULT_BITWIDTH;
+			ow = DEFAULT_BITWIDTH;
+		}
+
+		explore(stdout, ctype, iw, ow, (fixed_xtra) ? nxtra : -1,
+			phase_bits, nstages);
+		exit(EXIT_SUCCESS);
+		// }}}
+	}
+
 	////////////////////////////////////////////////////////////////////////
 	//
 	// Open output files
@@ -245,7 +555,8 @@ int	main(int argc, char **argv) {
 		fprintf(stderr, "ERR: Cannot open to %s for writing\n", fname);
 		perror("O/S Err:");
 		exit(EXIT_FAILURE);
-	} else if ((c_header)&&(!gen_sintable)&&(!gen_quarterwav)) {
+	} else if ((c_header)&&(((!gen_sintable)&&(!gen_quarterwav))
+				||(nco_bits > 0)||(dual))) {
 		char *strp = strdup(fname);
 		int	slen = strlen(fname);
 		if ((slen>2)&&(strp[slen-1] == 'v')&&(strp[slen-2]=='.')) {
@@ -276,6 +587,20 @@ int	main(int argc, char **argv) {
 			phase_bits = calc_phase_bits(ww);
 		if (nstages <= 0)
 			nstages = calc_stages(ww, phase_bits);
+		if ((rom_bits != 0)&&((rom_bits < 2)
+				||(rom_bits >= active_stages(nstages, ww,
+							phase_bits))
+				||(rom_bits > phase_bits-4))) {
+			int	mxrom = active_stages(nstages, ww, phase_bits)-1;
+
+			fprintf(stderr, "ERR: --rom requires between 2 and %d bits\n",
+				(mxrom < phase_bits-4) ? mxrom : phase_bits-4);
+			exit(EXIT_FAILURE);
+		} else if ((rom_bits != 0)&&(ww > MAX_HEXTABLE_OW)) {
+			fprintf(stderr, "ERR: --rom tables are limited to %d bits\n",
+				MAX_HEXTABLE_OW);
+			exit(EXIT_FAILURE);
+		}
 
 		if (verbose) {
 			// {{{
@@ -289,6 +614,19 @@ int	main(int argc, char **argv) {
 			(sequential)?"sequential":"basic",
 			(fp == stdout)?"(stdout)":fname,
 			iw, nxtra, ow, phase_bits, nstages);
+			if (lanes > 1)
+				printf("\tLanes           : %2d\n", lanes);
+			if (iters > 1)
+				printf("\tStages per clock: %2d\n", iters);
+			if (regs > 1)
+				printf("\tStages per reg  : %2d\n", regs);
+			if (radix4)
+				printf("\tRadix-4 stages  : %2d\n",
+					radix4_stages(nstages, ww, phase_bits));
+			if (rom_bits > 0)
+				printf("\tROM bits        : %2d\n", rom_bits);
+			if (unit_gain)
+				printf("\tThe CORDIC gain will be compensated for\n");
 			if ((with_reset)&&(async_reset))
 				printf("\tDesign will include an async reset signal\n");
 			else if (with_reset)
@@ -302,12 +640,40 @@ int	main(int argc, char **argv) {
 			seqcordic(fp, fhp, cmdline,
 				(fname) ? fname : "seqcordic.v",
 				nstages, iw, ow, nxtra, phase_bits,
+				with_reset, with_aux, async_reset, iters,
+				unit_gain);
+		else if (rom_bits > 0)
+			latency = hybridcordic(fp, fhp, cmdline,
+				(fname) ? fname : "cordic.v",
+				nstages, iw, ow, nxtra, phase_bits, rom_bits,
 				with_reset, with_aux, async_reset);
 		else
-			basiccordic(fp, fhp, cmdline,
+			latency = basiccordic(fp, fhp, cmdline,
 				(fname) ? fname : "cordic.v",
 				nstages, iw, ow, nxtra, phase_bits,
-				with_reset, with_aux, async_reset);
+				with_reset, with_aux, async_reset, lanes, regs,
+				radix4, unit_gain);
+
+		if ((axis)||(nco_bits > 0)) {
+			const AXISPORT	inputs[3] = {
+				{ "i_xval",  lanes * iw },
+				{ "i_yval",  lanes * iw },
+				{ "i_phase", lanes * phase_bits } },
+					outputs[2] = {
+				{ "o_xval",  lanes * ow },
+				{ "o_yval",  lanes * ow } };
+
+			if (axis)
+				axiswrap(fp, (fname) ? fname
+					: (sequential) ? "seqcordic.v" : "cordic.v",
+					sequential, latency, 3, inputs, 2, outputs,
+					with_reset, async_reset);
+			else
+				ncowrap(fp, fhp, (fname) ? fname : "cordic.v",
+					latency, 3, inputs, 2, outputs,
+					nco_bits, dither_bits,
+					with_reset, with_aux, async_reset);
+		}
 		// }}}
 	} if (rect_to_polar) {
 		// {{{
@@ -337,6 +703,18 @@ int	main(int argc, char **argv) {
 			"\tNumber of stages: %2d\n",
 			(fp == stdout)?"(stdout)":fname,
 			iw, nxtra, ow, phase_bits, nstages);
+			if (lanes > 1)
+				printf("\tLanes           : %2d\n", lanes);
+			if (iters > 1)
+				printf("\tStages per clock: %2d\n", iters);
+			if (regs > 1)
+				printf("\tStages per reg  : %2d\n", regs);
+			if (radix4)
+				printf("\tRadix-4 stages  : %2d\n",
+					radix4_stages(nstages, ww+nxtra,
+						phase_bits));
+			if (unit_gain)
+				printf("\tThe CORDIC gain will be compensated for\n");
 			if (with_reset)
 				printf("\tDesign will include a reset signal\n");
 			if (with_aux)
@@ -348,12 +726,218 @@ int	main(int argc, char **argv) {
 			seqpolar(fp, fhp, cmdline,
 				(fname) ? fname : "seqtopolar.v",
 				nstages, iw, ow, nxtra, phase_bits,
-				with_reset, with_aux, async_reset);
+				with_reset, with_aux, async_reset, iters,
+				unit_gain);
 		else
-			topolar(fp, fhp, cmdline,
+			latency = topolar(fp, fhp, cmdline,
 				(fname) ? fname : "topolar.v",
 				nstages, iw, ow, nxtra, phase_bits,
-				with_reset, with_aux, async_reset);
+				with_reset, with_aux, async_reset, lanes, regs,
+				radix4, unit_gain);
+
+		if (axis) {
+			const AXISPORT	inputs[2] = {
+				{ "i_xval",  lanes * iw },
+				{ "i_yval",  lanes * iw } },
+					outputs[2] = {
+				{ "o_mag",   lanes * ow },
+				{ "o_phase", lanes * phase_bits } };
+
+			axiswrap(fp, (fname) ? fname
+				: (sequential) ? "seqtopolar.v" : "topolar.v",
+				sequential, latency, 2, inputs, 2, outputs,
+				with_reset, async_reset);
+		}
+		// }}}
+	} if (gen_sincos) {
+		// {{{
+		if (iw >= 0)
+			fprintf(stderr, "WARNING: Input width parameter, -i %d, ignored for sin/cos generation\n", iw);
+		if (ow <= 0) {
+			fprintf(stderr, "WARNING: Assuming an output bit-width of %d bits\n", DEFAULT_BITWIDTH);
+			ow = DEFAULT_BITWIDTH;
+		}
+		// Unlike p2r, there's no need for an extra bit to hold the
+		// CORDIC gain
+		ww = ow + nxtra;
+		if (phase_bits <= 0)
+			phase_bits = calc_phase_bits(ww);
+		if (nstages <= 0)
+			nstages = calc_stages(ww, phase_bits);
+
+		if (verbose) {
+			// {{{
+			printf("Building a CORDIC based sine and cosine generator with the\nfollowing parameters:\n"
+			"\tOutput file     : %s\n"
+			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
+			"\tOutput bits     : %2d\n"
+			"\tPhase  bits     : %2d\n"
+			"\tNumber of stages: %2d\n",
+			(fp == stdout)?"(stdout)":fname,
+			nxtra, ow, phase_bits, nstages);
+			if ((with_reset)&&(async_reset))
+				printf("\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				printf("\tDesign will include a reset signal\n");
+			if (with_aux)
+				printf("\tAux bits will be added to the design\n");
+			// }}}
+		}
+
+		latency = sincos(fp, fhp, cmdline,
+			(fname) ? fname : "sincos.v",
+			nstages, ow, nxtra, phase_bits,
+			with_reset, with_aux, async_reset);
+
+		if ((axis)||(nco_bits > 0)) {
+			const AXISPORT	inputs[1] = {{ "i_phase", phase_bits }},
+					outputs[2] = {
+				{ "o_cos", ow },
+				{ "o_sin", ow } };
+
+			if (axis)
+				axiswrap(fp, (fname) ? fname : "sincos.v", false,
+					latency, 1, inputs, 2, outputs,
+					with_reset, async_reset);
+			else
+				ncowrap(fp, fhp, (fname) ? fname : "sincos.v",
+					latency, 1, inputs, 2, outputs,
+					nco_bits, dither_bits,
+					with_reset, with_aux, async_reset);
+		}
+		// }}}
+	} if (gen_hyperbolic) {
+		// {{{
+		if ((iw <= 0)&&(ow > 0))
+			iw = ow;
+		if (ow <= 0)
+			ow = iw;
+		if ((iw <= 0)||(ow <= 0)) {
+			fprintf(stderr, "WARNING: Assuming an input and output bit-width of %d bits\n", DEFAULT_BITWIDTH);
+			iw = DEFAULT_BITWIDTH;
+			ow = DEFAULT_BITWIDTH;
+		}
+		ww = (ow > iw) ? ow:iw;
+		nxtra += 2;
+		ww += nxtra;
+		if (phase_bits <= 0)
+			phase_bits = calc_phase_bits(ww);
+		if (nstages <= 0)
+			nstages = calc_hyperbolic_stages(ww, phase_bits);
+
+		if (verbose) {
+			// {{{
+			printf("Building a %s hyperbolic CORDIC %s with the\nfollowing parameters:\n"
+			"\tOutput file     : %s\n"
+			"\tInput  bits     : %2d\n"
+			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
+			"\tOutput bits     : %2d\n"
+			"\tPhase  bits     : %2d\n"
+			"\tNumber of stages: %2d\n",
+			(sequential) ? "sequential" : "pipelined",
+			(vectoring) ? "vectoring core" : "rotator",
+			(fp == stdout)?"(stdout)":fname,
+			iw, nxtra, ow, phase_bits, nstages);
+			if ((with_reset)&&(async_reset))
+				printf("\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				printf("\tDesign will include a reset signal\n");
+			if (with_aux)
+				printf("\tAux bits will be added to the design\n");
+			// }}}
+		}
+
+		latency = hyperbolic(fp, fhp, cmdline,
+			(fname) ? fname : "hrotate.v",
+			nstages, iw, ow, nxtra, phase_bits, vectoring,
+			sequential, with_reset, with_aux, async_reset);
+
+		if (axis) {
+			const AXISPORT	rinputs[3] = {
+				{ "i_xval",  iw },
+				{ "i_yval",  iw },
+				{ "i_phase", phase_bits } },
+					routputs[2] = {
+				{ "o_xval",  ow },
+				{ "o_yval",  ow } },
+					voutputs[2] = {
+				{ "o_mag",   ow },
+				{ "o_phase", phase_bits } };
+
+			axiswrap(fp, (fname) ? fname : "hrotate.v",
+				sequential, latency, (vectoring) ? 2:3,
+				rinputs, 2, (vectoring) ? voutputs : routputs,
+				with_reset, async_reset);
+		}
+		// }}}
+	} if (gen_linear) {
+		// {{{
+		if ((iw <= 0)&&(ow > 0))
+			iw = ow;
+		if (ow <= 0)
+			ow = iw;
+		if ((iw <= 0)||(ow <= 0)) {
+			fprintf(stderr, "WARNING: Assuming an input and output bit-width of %d bits\n", DEFAULT_BITWIDTH);
+			iw = DEFAULT_BITWIDTH;
+			ow = DEFAULT_BITWIDTH;
+		}
+		ww = (ow > iw) ? ow:iw;
+		nxtra += 1;
+		ww += nxtra;
+		// z gets as many bits as x and y have to work with
+		if (phase_bits <= 0)
+			phase_bits = ww;
+		if (phase_bits < 3) {
+			fprintf(stderr, "ERR: Linear CORDIC requires at least three z bits\n");
+			exit(EXIT_FAILURE);
+		} if (nstages <= 0)
+			nstages = calc_linear_stages(ww, phase_bits);
+		else if (nstages > calc_linear_stages(ww, phase_bits)) {
+			fprintf(stderr, "WARNING: Only %d linear CORDIC stages are useful\n",
+				calc_linear_stages(ww, phase_bits));
+			nstages = calc_linear_stages(ww, phase_bits);
+		}
+
+		if (verbose) {
+			// {{{
+			printf("Building a %s linear CORDIC %s with the\nfollowing parameters:\n"
+			"\tOutput file     : %s\n"
+			"\tInput  bits     : %2d\n"
+			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
+			"\tOutput bits     : %2d\n"
+			"\tZ      bits     : %2d\n"
+			"\tNumber of stages: %2d\n",
+			(sequential) ? "sequential" : "pipelined",
+			(vectoring) ? "divider" : "multiplier",
+			(fp == stdout)?"(stdout)":fname,
+			iw, nxtra, ow, phase_bits, nstages);
+			if ((with_reset)&&(async_reset))
+				printf("\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				printf("\tDesign will include a reset signal\n");
+			if (with_aux)
+				printf("\tAux bits will be added to the design\n");
+			// }}}
+		}
+
+		latency = linear(fp, fhp, cmdline,
+			(fname) ? fname : "linrotate.v",
+			nstages, iw, ow, nxtra, phase_bits, vectoring,
+			sequential, with_reset, with_aux, async_reset);
+
+		if (axis) {
+			const AXISPORT	rinputs[3] = {
+				{ "i_xval", iw },
+				{ "i_yval", iw },
+				{ "i_zval", phase_bits } },
+					routputs[1] = {{ "o_yval", ow }},
+					voutputs[1] = {{ "o_zval", phase_bits }};
+
+			axiswrap(fp, (fname) ? fname : "linrotate.v",
+				sequential, latency, (vectoring) ? 2:3,
+				rinputs, 1, (vectoring) ? voutputs : routputs,
+				with_reset, async_reset);
+		}
 		// }}}
 	} if (gen_sintable) {
 		// {{{
@@ -395,8 +979,24 @@ int	main(int argc, char **argv) {
 			// }}}
 		}
 
-		sintable(fp, cmdline, (fname) ? fname : "sintable.v",
+		latency = sintable(fp, cmdline,
+			(fname) ? fname : "sintable.v",
 			phase_bits, ow, with_reset, with_aux, async_reset);
+
+		if ((axis)||(nco_bits > 0)) {
+			const AXISPORT	inputs[1] = {{ "i_phase", phase_bits }},
+					outputs[1] = {{ "o_val", ow }};
+
+			if (axis)
+				axiswrap(fp, (fname) ? fname : "sintable.v", false,
+					latency, 1, inputs, 1, outputs,
+					with_reset, async_reset);
+			else
+				ncowrap(fp, fhp, (fname) ? fname : "sintable.v",
+					latency, 1, inputs, 1, outputs,
+					nco_bits, dither_bits,
+					with_reset, with_aux, async_reset);
+		}
 		// }}}
 	} if (gen_quarterwav) {
 		// {{{
@@ -438,8 +1038,78 @@ int	main(int argc, char **argv) {
 			// }}}
 		}
 
-		quarterwav(fp, cmdline, (fname) ? fname : "quarterwav.v",
-			phase_bits, ow, with_reset, with_aux, async_reset);
+		latency = quarterwav(fp, fhp, cmdline,
+			(fname) ? fname : "quarterwav.v",
+			phase_bits, ow, dual, with_reset, with_aux,
+			async_reset);
+
+		if ((axis)||(nco_bits > 0)) {
+			const AXISPORT	inputs[1] = {{ "i_phase", phase_bits }},
+					outputs[2] = {{ (dual) ? "o_sin" : "o_val", ow },
+							{ "o_cos", ow }};
+			const int	nout = (dual) ? 2 : 1;
+
+			if (axis)
+				axiswrap(fp, (fname) ? fname : "quarterwav.v", false,
+					latency, 1, inputs, nout, outputs,
+					with_reset, async_reset);
+			else
+				ncowrap(fp, fhp, (fname) ? fname : "quarterwav.v",
+					latency, 1, inputs, nout, outputs,
+					nco_bits, dither_bits,
+					with_reset, with_aux, async_reset);
+		}
+		// }}}
+	} if (gen_linqtr) {
+		// {{{
+		if ((iw >= 0)&&(phase_bits < 0)) {
+			phase_bits = iw;
+			iw = -1;
+		}
+		if (iw >= 0)
+			fprintf(stderr, "WARNING: Input width parameter, -i %d, ignored for sine table generation\n", iw);
+		if (ow <= 0) {
+			fprintf(stderr, "WARNING: Assuming an output bit-width of %d bits\n", DEFAULT_BITWIDTH);
+			ow = DEFAULT_BITWIDTH;
+		} if (phase_bits <= 0)
+			phase_bits = calc_phase_bits(ow+nxtra);
+		if (verbose) {
+			// {{{
+			printf("Building a linearly interpolated quarter-wave table based sine-wave calculator\n"
+			"\tOutput file     : %s\n"
+			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
+			"\tOutput bits     : %2d\n"
+			"\tPhase  bits     : %2d\n",
+			(fp == stdout)?"(stdout)":fname,
+			nxtra, ow, phase_bits);
+			if ((with_reset)&&(async_reset))
+				printf("\tDesign will include an async reset signal\n");
+			else if (with_reset)
+				printf("\tDesign will include a reset signal\n");
+			if (with_aux)
+				printf("\tAux bits will be added to the design\n");
+			// }}}
+		}
+
+		latency = linqtr(fp, fhp, cmdline,
+			(fname) ? fname : "linqtr.v",
+			phase_bits, ow, nxtra, with_reset, with_aux,
+			async_reset);
+
+		if ((axis)||(nco_bits > 0)) {
+			const AXISPORT	inputs[1] = {{ "i_phase", phase_bits }},
+					outputs[1] = {{ "o_val", ow }};
+
+			if (axis)
+				axiswrap(fp, (fname) ? fname : "linqtr.v", false,
+					latency, 1, inputs, 1, outputs,
+					with_reset, async_reset);
+			else
+				ncowrap(fp, fhp, (fname) ? fname : "linqtr.v",
+					latency, 1, inputs, 1, outputs,
+					nco_bits, dither_bits,
+					with_reset, with_aux, async_reset);
+		}
 		// }}}
 	} if (gen_quadtbl) {
 		// {{{
@@ -467,10 +1137,12 @@ int	main(int argc, char **argv) {
 			// "\tInput  bits     : %2d\n"
 			"\tExtra  bits     : %2d (used in computation, dropped when done)\n"
 			"\tOutput bits     : %2d\n"
-			"\tPhase  bits     : %2d\n",
+			"\tPhase  bits     : %2d\n"
+			"\tInterpolation   : %s\n",
 			// "\tNumber of stages: %2d\n",
 			(fp == stdout)?"(stdout)":fname, // iw,
-			nxtra, ow, phase_bits);
+			nxtra, ow, phase_bits,
+			(order == 3) ? "cubic" : "quadratic");
 			if ((with_reset)&&(async_reset))
 				printf("\tDesign will include an async reset signal\n");
 			else if (with_reset)
@@ -480,9 +1152,26 @@ int	main(int argc, char **argv) {
 			// }}}
 		}
 
-		quadtbl(fp, fhp, cmdline, (fname) ? fname : "quadtbl.v",
-			phase_bits, ow, nxtra, with_reset, with_aux,
-			async_reset);
+		latency = quadtbl(fp, fhp, cmdline,
+			(fname) ? fname : "quadtbl.v",
+			phase_bits, ow, nxtra, order, dual, with_reset,
+			with_aux, async_reset);
+
+		if ((axis)||(nco_bits > 0)) {
+			const AXISPORT	inputs[1] = {{ "i_phase", phase_bits }},
+					outputs[2] = {{ "o_sin", ow }, { "o_cos", ow }};
+			const int	nout = (dual) ? 2 : 1;
+
+			if (axis)
+				axiswrap(fp, (fname) ? fname : "quadtbl.v", false,
+					latency, 1, inputs, nout, outputs,
+					with_reset, async_reset);
+			else
+				ncowrap(fp, fhp, (fname) ? fname : "quadtbl.v",
+					latency, 1, inputs, nout, outputs,
+					nco_bits, dither_bits,
+					with_reset, with_aux, async_reset);
+		}
 		// }}}
 	}
 }
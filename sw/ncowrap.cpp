@@ -0,0 +1,437 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/ncowrap.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Wraps one of the pipelined sinewave generators (tbl, qtr, qtbl,
+//		sincos, or p2r) into a complete numerically controlled
+//	oscillator (NCO).  A phase accumulator, wider than the core's PW bits
+//	of phase, steps by a programmable frequency word every i_ce.  Its top
+//	PW bits then drive the core's i_phase.  Truncating the accumulator to
+//	PW bits creates spurs.  Optionally, an LFSR dither may be added below
+//	the PW bits before truncation, trading these spurs for a (slightly
+//	higher) noise floor.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "ncowrap.h"
+
+// LFSR_TAPS
+// {{{
+// Taps for a maximal length Fibonacci LFSR of each length from 3 to 32 bits,
+// with bit t-1 set for tap t.  Each new bit is the XOR of the tapped bits.
+static	const	unsigned long	LFSR_TAPS[33] = { 0, 0, 0,
+	0x00000006, 0x0000000c, 0x00000014, 0x00000030, 0x00000060,
+	0x000000b8, 0x00000110, 0x00000240, 0x00000500, 0x00000829,
+	0x0000100d, 0x00002015, 0x00006000, 0x0000d008, 0x00012000,
+	0x00020400, 0x00040023, 0x00090000, 0x00140000, 0x00300000,
+	0x00420000, 0x00e10000, 0x01200000, 0x02000023, 0x04000013,
+	0x09000000, 0x14000000, 0x20000029, 0x48000000, 0x80200003 };
+// }}}
+
+// lfsr_masks
+// {{{
+// Sets mask[k] to those bits of the LFSR whose XOR gives bit k of the LFSR
+// nsteps later.  Stepping the LFSR by as many bits as the dither uses lets
+// every dither word be made of fresh bits, rather than the last word
+// shifted over by one.
+static	void	lfsr_masks(int lw, int nsteps, unsigned long *mask) {
+	unsigned long	nxt[64];
+
+	assert((lw >= 3)&&(lw <= 32));
+	for(int k=0; k<lw; k++)
+		mask[k] = 1ul << k;
+
+	for(int s=0; s<nsteps; s++) {
+		nxt[0] = 0;
+		for(int k=0; k<lw; k++)
+			if ((LFSR_TAPS[lw] >> k)&1)
+				nxt[0] ^= mask[k];
+		for(int k=1; k<lw; k++)
+			nxt[k] = mask[k-1];
+		for(int k=0; k<lw; k++)
+			mask[k] = nxt[k];
+	}
+}
+// }}}
+
+static	unsigned long	gcd(unsigned long a, unsigned long b) {
+	while(b != 0) {
+		unsigned long	t = a % b;
+		a = b; b = t;
+	} return a;
+}
+
+// nco_phase_noise
+// {{{
+// The power of the phase error, relative to the carrier, in dBc.  Dropping
+// the fb = acc_bits-phase_bits bits below PW costs (1-4^-fb)/12 LSB^2, as
+// with phase_variance().  The dither then adds its own variance.  It is the
+// bottom dw bits of an lw bit LFSR, which never holds zero, so across the
+// LFSR's period each nonzero dither word appears 2^(lw-dw) times, and zero
+// one time fewer.  Only when lw is much longer than dw is that uniform, and
+// worth the full (1-4^-dw)/12 LSB^2.
+static	double	nco_phase_noise(int acc_bits, int phase_bits, int lw, int dw) {
+	double	lsb = 2.0 * M_PI / pow(2.0, phase_bits), variance;
+
+	variance = (1.0 - pow(4.0, -(acc_bits - phase_bits))) / 12.;
+	if (dw > 0) {
+		double	n = pow(2.0, dw), w, mean, sq;
+
+		// Each nonzero word's share of the period, and the first two
+		// moments of the dither in LSBs
+		w    = pow(2.0, lw-dw) / (pow(2.0, lw) - 1.0);
+		mean = w * (n - 1.0) / 2.0;
+		sq   = w * (n - 1.0) * (2.0 * n - 1.0) / 6.0 / n;
+		variance += sq - mean * mean;
+	}
+	variance *= lsb * lsb;
+
+	return 10.0 * log(variance) / log(10.0);
+}
+// }}}
+
+// nco_phase_spur
+// {{{
+// The largest spur from truncating the accumulator, in dBc.  Without dither,
+// this is the usual -6.02 dB per phase bit (plus 3.92 dB).  With dither, the
+// error is only periodic with the LFSR, so its power is spread across every
+// line of that period.
+static	double	nco_phase_spur(int acc_bits, int phase_bits, int lw, int dw) {
+	double	spur, period;
+
+	assert(acc_bits > phase_bits);
+	spur = -6.02 * phase_bits + 3.92;
+	if (dw <= 0)
+		return spur;
+
+	period = (double)((1ul << lw)-1) / gcd((1ul << lw)-1, dw);
+	if (nco_phase_noise(acc_bits, phase_bits, lw, dw)
+			- 10.0*log(period)/log(10.0) < spur)
+		spur = nco_phase_noise(acc_bits, phase_bits, lw, dw)
+			- 10.0*log(period)/log(10.0);
+	return spur;
+}
+// }}}
+
+void	ncowrap(FILE *fp, FILE *fhp, const char *fname, int latency,
+		int nin, const AXISPORT *inputs,
+		int nout, const AXISPORT *outputs,
+		int acc_bits, int dither_bits,
+		bool with_reset, bool with_aux, bool async_reset) {
+	// {{{
+	char	*name;
+	int	phase_bits = -1, dw;
+
+	name = modulename(fname);
+	for(int k=0; k<nin; k++)
+		if (0 == strcmp(inputs[k].m_name, "i_phase"))
+			phase_bits = inputs[k].m_width;
+	assert(phase_bits > 0);
+	if (acc_bits <= phase_bits) {
+		fprintf(stderr, "ERR: The NCO accumulator, %d bits, must be wider than the %d bits of phase\n",
+			acc_bits, phase_bits);
+		exit(EXIT_FAILURE);
+	}
+	assert((dither_bits == 0)||((dither_bits >= 3)&&(dither_bits <= 32)));
+
+	// Only so much dither can fit below the core's phase
+	dw = dither_bits;
+	if (dw > acc_bits - phase_bits)
+		dw = acc_bits - phase_bits;
+
+	std::string	resetw = (!with_reset) ? ""
+				: (async_reset) ? "i_areset_n":"i_reset";
+	std::string	always_reset;
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+			"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+			"\tif (i_reset)\n";
+	else
+		always_reset = "\talways @(posedge i_clk)\n\t";
+
+	// Module declaration
+	// {{{
+	fprintf(fp,
+"\n"
+"////////////////////////////////////////////////////////////////////////////////\n"
+"//\n"
+"// NCO wrapper\n"
+"// {{{\n"
+"// The phase accumulator steps by the frequency word, last loaded from i_step\n"
+"// by i_ld, on every i_ce.  The frequency, in cycles per sample, is then\n"
+"// i_step / 2^AW.  The top PW bits of the accumulator%s\n"
+"// drive the core\'s i_phase two clocks later.\n"
+"//\n"
+"////////////////////////////////////////////////////////////////////////////////\n"
+"// }}}\n"
+"module	%s_nco #(\n"
+"\t\t// {{{\n"
+"\t\tlocalparam\tAW = %d,\t// Bits in the phase accumulator\n"
+"\t\t\t\tPW = %d%s\t// Bits of phase given to the core\n",
+		(dw > 0) ? ", plus LFSR dither\n// below them," : "",
+		name, acc_bits, phase_bits, (dw > 0) ? ",":"");
+	if (dw > 0)
+		fprintf(fp,
+"\t\t\t\tLW = %d,\t// Bits in the dithering LFSR\n"
+"\t\t\t\tDW = %d\t// Bits of dither, added below PW\n",
+		dither_bits, dw);
+	fprintf(fp,
+"\t\t// }}}\n"
+"\t) (\n"
+"\t\t// {{{\n"
+"\t\tinput\twire\t\t\ti_clk%s%s, i_ce,\n"
+"\t\t// Frequency control\n"
+"\t\tinput\twire\t\t\ti_ld,\n"
+"\t\tinput\twire\t[(AW-1):0]\ti_step",
+		(with_reset) ? ", ":"", resetw.c_str());
+	for(int k=0; k<nin; k++) {
+		if (0 == strcmp(inputs[k].m_name, "i_phase"))
+			continue;
+		fprintf(fp, ",\n\t\tinput\twire\t[%d:0]\t\t%s",
+			inputs[k].m_width-1, inputs[k].m_name);
+	} for(int k=0; k<nout; k++)
+		fprintf(fp, ",\n\t\toutput\twire\t[%d:0]\t\t%s",
+			outputs[k].m_width-1, outputs[k].m_name);
+	if (with_aux)
+		fprintf(fp, ",\n"
+"\t\tinput\twire\t\t\ti_aux,\n"
+"\t\toutput\twire\t\t\to_aux");
+	fprintf(fp, "\n"
+"\t\t// }}}\n"
+"\t);\n\n");
+	// }}}
+
+	// Declarations
+	// {{{
+	fprintf(fp,
+"\t// Local declarations\n"
+"\t// {{{\n"
+"\treg\t[(AW-1):0]\tr_step, r_phase;\n"
+"\twire\t[(AW-1):0]\tdithered_phase;\n"
+"\treg\t[(PW-1):0]\tnco_phase;\n");
+	if (dw > 0)
+		fprintf(fp,
+"\treg\t[(LW-1):0]\tlfsr;\n"
+"\twire\t[(LW-1):0]\tlfsr_next;\n");
+	if (with_aux)
+		fprintf(fp,
+"\treg\t[1:0]\t\tr_aux;\n");
+	fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	// r_step
+	// {{{
+	fprintf(fp,
+"\t// r_step: the frequency word\n"
+"\t// {{{\n"
+"\tinitial\tr_step = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tr_step <= 0;\n\telse ");
+	fprintf(fp,
+"if (i_ld)\n"
+"\t\tr_step <= i_step;\n"
+"\t// }}}\n\n");
+	// }}}
+
+	// r_phase
+	// {{{
+	fprintf(fp,
+"\t// r_phase: the phase accumulator\n"
+"\t// {{{\n"
+"\tinitial\tr_phase = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tr_phase <= 0;\n\telse ");
+	fprintf(fp,
+"if (i_ce)\n"
+"\t\tr_phase <= r_phase + r_step;\n"
+"\t// }}}\n\n");
+	// }}}
+
+	if (dw > 0) {
+		// lfsr
+		// {{{
+		unsigned long	mask[64];
+
+		lfsr_masks(dither_bits, dw, mask);
+
+		fprintf(fp,
+"\t// lfsr: dither\n"
+"\t// {{{\n"
+"\t// The LFSR steps DW bits on every i_ce, so each dither word is made of\n"
+"\t// bits the last word never used.\n"
+"\tinitial\tlfsr = 1;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tlfsr <= 1;\n\telse ");
+		fprintf(fp,
+"if (i_ce)\n"
+"\t\tlfsr <= lfsr_next;\n\n"
+"\tassign\tlfsr_next = {");
+		for(int k=dither_bits-1; k>=0; k--)
+			fprintf(fp, "\n\t\t\t^(lfsr & %d\'h%0*lx)%s",
+				dither_bits, (dither_bits+3)/4, mask[k],
+				(k > 0) ? ",":"");
+		fprintf(fp, " };\n"
+"\t// }}}\n\n");
+		// }}}
+	}
+
+	// nco_phase
+	// {{{
+	fprintf(fp,
+"\t// nco_phase\n"
+"\t// {{{\n");
+	if (dw <= 0)
+		fprintf(fp,
+"\tassign\tdithered_phase = r_phase;\n\n");
+	else if (acc_bits - phase_bits > dw)
+		fprintf(fp,
+"\tassign\tdithered_phase = r_phase + { {(PW){1\'b0}}, lfsr[(DW-1):0],\n"
+"\t\t\t\t\t\t{(AW-PW-DW){1\'b0}} };\n\n");
+	else
+		fprintf(fp,
+"\tassign\tdithered_phase = r_phase + { {(PW){1\'b0}}, lfsr[(DW-1):0] };\n\n");
+
+	fprintf(fp,
+"\tinitial\tnco_phase = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tnco_phase <= 0;\n\telse ");
+	fprintf(fp,
+"if (i_ce)\n"
+"\t\tnco_phase <= dithered_phase[(AW-1):(AW-PW)];\n"
+"\t// }}}\n\n");
+	// }}}
+
+	if (with_aux) {
+		// r_aux
+		// {{{
+		fprintf(fp,
+"\t// r_aux\n"
+"\t// {{{\n"
+"\tinitial\tr_aux = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tr_aux <= 0;\n\telse ");
+		fprintf(fp,
+"if (i_ce)\n"
+"\t\tr_aux <= { r_aux[0], i_aux };\n"
+"\t// }}}\n\n");
+		// }}}
+	}
+
+	// The core itself
+	// {{{
+	fprintf(fp,
+"\t// The core\n"
+"\t// {{{\n"
+"\t%s\n"
+"\tu_core (\n"
+"\t\t.i_clk(i_clk),", name);
+	if (with_reset)
+		fprintf(fp, " .%s(%s),", resetw.c_str(), resetw.c_str());
+	fprintf(fp, " .i_ce(i_ce),\n");
+	for(int k=0; k<nin; k++) {
+		if (0 == strcmp(inputs[k].m_name, "i_phase"))
+			fprintf(fp, "\t\t.i_phase(nco_phase),\n");
+		else
+			fprintf(fp, "\t\t.%s(%s),\n", inputs[k].m_name,
+				inputs[k].m_name);
+	} for(int k=0; k<nout; k++)
+		fprintf(fp, "\t\t.%s(%s)%s\n", outputs[k].m_name,
+			outputs[k].m_name,
+			((with_aux)||(k+1 < nout)) ? ",":"");
+	if (with_aux)
+		fprintf(fp, "\t\t.i_aux(r_aux[1]), .o_aux(o_aux)\n");
+	fprintf(fp, "\t);\n\t// }}}\n\n");
+	// }}}
+
+	fprintf(fp,
+"\t// Make Verilator happy\n"
+"\t// {{{\n"
+"\t// verilator lint_off UNUSED\n"
+"\twire\tunused;\n"
+"\tassign\tunused = &{ 1\'b0, dithered_phase[(AW-PW-1):0] };\n"
+"\t// verilator lint_on UNUSED\n"
+"\t// }}}\n");
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp) {
+		// {{{
+		std::string	guard = std::string(name) + "_NCO_H";
+		for(unsigned k=0; k<guard.size(); k++)
+			guard[k] = toupper(guard[k]);
+
+		fprintf(fhp,
+"\n"
+"// NCO wrapper, %s_nco\n"
+"// {{{\n"
+"#ifndef\t%s\n"
+"#define\t%s\n"
+"#define\tHAS_NCO\n",
+			name, guard.c_str(), guard.c_str());
+		fprintf(fhp, "const int	NCO_AW = %d;\t// Bits in the phase accumulator\n", acc_bits);
+		fprintf(fhp, "const int	NCO_PW = %d;\t// Bits of phase given to the core\n", phase_bits);
+		fprintf(fhp, "const int	NCO_LW = %d;\t// Bits in the dithering LFSR\n",
+			(dw > 0) ? dither_bits : 0);
+		fprintf(fhp, "const int	NCO_DW = %d;\t// Bits of dither\n", dw);
+		if (dw > 0)
+			fprintf(fhp, "const unsigned long\tNCO_TAPS = 0x%08lx;\t// LFSR taps, bit t-1 for tap t\n",
+				LFSR_TAPS[dither_bits]);
+		fprintf(fhp, "const int	NCO_LATENCY = %d;\t// Clocks from i_ce to output\n",
+			latency+2);
+		fprintf(fhp, "const double	NCO_PHASE_NOISE_DBC = %.2f;\n",
+			nco_phase_noise(acc_bits, phase_bits, dither_bits, dw));
+		fprintf(fhp, "const double	NCO_PHASE_SPUR_DBC = %.2f;\n",
+			nco_phase_spur(acc_bits, phase_bits, dither_bits, dw));
+		fprintf(fhp, "#endif\t// %s\n// }}}\n", guard.c_str());
+		// }}}
+	}
+
+	free(name);
+	// }}}
+}
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/ncowrap.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Wraps one of the pipelined sinewave generators (tbl, qtr, qtbl,
+//		sincos, or p2r) into a complete numerically controlled
+//	oscillator (NCO).  A phase accumulator, wider than the core's PW bits
+//	of phase, steps by a programmable frequency word every i_ce.  Its top
+//	PW bits then drive the core's i_phase.  Truncating the accumulator to
+//	PW bits creates spurs.  Optionally, an LFSR dither may be added below
+//	the PW bits before truncation, trading these spurs for a (slightly
+//	higher) noise floor.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	NCOWRAP_H
+#define	NCOWRAP_H
+
+#include <stdio.h>
+#include "axiswrap.h"
+
+// ncowrap()
+// {{{
+// Appends a module named <core>_nco to fp, wrapping the pipelined core in
+// fname.  The core's ports are described as for axiswrap(), save that the
+// "i_phase" input is driven by the accumulator rather than brought out.
+// acc_bits is the width of the phase accumulator, and dither_bits the length
+// of the dithering LFSR, or zero for no dither.  If fhp isn't NULL, the
+// NCO's parameters and spur/noise estimates are appended to it.
+// }}}
+extern	void	ncowrap(FILE *fp, FILE *fhp, const char *fname, int latency,
+			int nin, const AXISPORT *inputs,
+			int nout, const AXISPORT *outputs,
+			int acc_bits, int dither_bits,
+			bool with_reset, bool with_aux, bool async_reset);
+
+#endif	// NCOWRAP_H
@@ -37,6 +37,8 @@
 //
 // }}}
 #include <string>
+#include <thread>
+#include <vector>
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -48,6 +50,7 @@
 #include "cordiclib.h"
 #include "quadtbl.h"
 #include "hexfile.h"
+#include "sinewave.h"
 
 static	const	bool	NO_QUADRATIC_COMPONENT = false;
 
@@ -60,53 +63,161 @@ static	long	max_integer(const int width) {
 	return (1l<<(width-1))-2l;
 }
 
+// dsp_count
+// {{{
+// Estimates how many 25x18 signed DSP multipliers, as found in many FPGAs, an
+// a by b bit signed multiply needs, splitting it up should it not fit in one
+static	int	dsp_count(const int a, const int b) {
+	int	x = ((a-2)/24+1) * ((b-2)/17+1),
+		y = ((b-2)/24+1) * ((a-2)/17+1);
+
+	return (x < y) ? x : y;
+}
+// }}}
+
 typedef	std::string	STRING;
 
 /*
  * x = xo + dx
- * er = TBL.c[xo]+(TBL.l[xo]+TBL.q[xo] * dx) * dx - sin(2PI(xo+dx)/N)
- * der/ddx = TBL.l[xo]+2TBL.q[xo] * dx - 2PI/N cos(2PI(xo+dx)/N)
+ * er = TBL.c[xo]+(TBL.l[xo]+(TBL.q[xo]+TBL.k[xo] * dx) * dx) * dx
+ *		- sin(2PI(xo+dx)/N)
+ * der/ddx = TBL.l[xo]+(2TBL.q[xo]+3TBL.k[xo] * dx) * dx
+ *		- 2PI/N cos(2PI(xo+dx)/N)
+ * d2er/ddx2 = 2TBL.q[xo] + 6TBL.k[xo] * dx + (2PI/N)^2 sin(2PI(xo+dx)/N)
+ *
+ * The cubic coefficient, k, is zero for all but a cubic table.  The interior
+ * extrema of er are the roots of der/ddx.  Within a single interval, the
+ * sine is so close to a cubic that der/ddx has at most a few roots, so we
+ * bracket them on a coarse grid and then polish each with a safeguarded
+ * Newton iteration.
  */
-double	est_max_err(double c, double l, double q, double idx, int N) {
+#define	QT_BRACKETS	8
+#define	QT_MAXITER	40
+
+// quad_root
+// {{{
+// Find the root of der/ddx within [lo,hi], given that der/ddx changes sign
+// across the interval.  Newton steps that leave the bracket are replaced by
+// bisection, so this always converges.
+static	double	quad_root(double l, double q, double k, double idx, int N,
+		double lo, double hi, double dlo) {
+	const double	w = 2.0 * M_PI / (double)N;
+	double	x = 0.5 * (lo + hi);
+
+	for(int iter=0; iter<QT_MAXITER; iter++) {
+		double	ph  = w * (idx + x);
+		double	der = l + (2.0 * q + 3.0 * k * x) * x - w * cos(ph);
+		double	dd  = 2.0 * q + 6.0 * k * x + w * w * sin(ph), nx;
+
+		if (der == 0.0)
+			break;
+		// Shrink the bracket
+		if ((der < 0.0) == (dlo < 0.0))
+			lo = x;
+		else
+			hi = x;
+
+		nx = (dd != 0.0) ? (x - der / dd) : lo;
+		if (nx <= lo || nx >= hi)
+			nx = 0.5 * (lo + hi);
+		if (fabs(nx - x) < 1e-14)
+			return nx;
+		x = nx;
+	} return x;
+}
+// }}}
+
+double	est_max_err(double c, double l, double q, double idx, int N,
+		double k = 0.0) {
 // {{{
-	double	lft, rht, mid, ph;
+	const double	w = 2.0 * M_PI / (double)N;
+	double	er = 0.0, xlast = 0.0, dlast = 0.0;
 
-	ph = 2.0 * M_PI * idx / (double)N;
-	lft = c - sin(ph);
-	ph = 2.0 * M_PI * (idx+1) / (double)N;
-	rht = c + l + q - sin(ph);
+	// Check the end points, the bracket points, and any extremum found
+	// between them.  The largest error may be in any of these places.
+	for(int b=0; b<=QT_BRACKETS; b++) {
+		double	x, ph, mer, der;
 
+		x   = b / (double)QT_BRACKETS;
+		ph  = w * (idx + x);
+		mer = c + (l + (q + k * x) * x) * x - sin(ph);
+		der = l + (2.0 * q + 3.0 * k * x) * x - w * cos(ph);
 
-	//
-	// The following is very brute force-ish.  It doesn't need to be.
-	// For large N, a sine-wave is *very* well behaved.  Brent's algorithm
-	// might make more sense here, *and* get us a better answer faster.
-	// This just gets me by until I look brents algorithm up in a text book
-	// (again).
-	//
-	mid = 0;
-	for(int k=0; k<64; k++) {
-		double	mer = 0.0, mph, mdx;
+		if (fabs(mer) > fabs(er))
+			er = mer;
 
-		mdx = k / 64.0;
-		mph = 2.0*M_PI*(idx + mdx)/N;
-		mer = c + (l + q * mdx) * mdx - sin(mph);
+		if (b > 0 && der != 0.0 && dlast != 0.0
+				&& ((der < 0.0) != (dlast < 0.0))) {
+			double	r = quad_root(l, q, k, idx, N, xlast, x, dlast);
 
-		if (fabs(mer) > fabs(mid))
-			mid = mer;
-	}
+			mer = c + (l + (q + k * r) * r) * r - sin(w * (idx + r));
+			if (fabs(mer) > fabs(er))
+				er = mer;
+		}
 
-	double	er;
-	er = lft;
-	if (fabs(er) < fabs(rht))
-		er = rht;
-	if (fabs(er) < fabs(mid))
-		er = mid;
+		xlast = x;
+		dlast = der;
+	}
 
 	return er;
 // }}}
 }
 
+// max_table_err
+// {{{
+// Find the largest error across all of the intervals of a table of ln
+// entries, taken from a wave of N intervals.  Large tables are split into
+// contiguous chunks, one per thread, and the chunk results are merged in
+// order so the result matches a serial search.  A linear table has no
+// dslope, and only a cubic table has a cubic term, so either may be NULL.
+#define	QT_PARALLEL	4096
+static	double	max_table_err(const double *table, const double *slope,
+		const double *dslope, int ln, int N,
+		const double *cubic = NULL) {
+	int	nthreads = 1;
+
+	if (ln >= QT_PARALLEL)
+		nthreads = std::thread::hardware_concurrency();
+	if (nthreads <= 1) {
+		double	mxerr = 0.0, err;
+
+		for(int i=0; i<ln; i++) {
+			err = est_max_err(table[i], slope[i],
+					(dslope) ? dslope[i] : 0.0, i, N,
+					(cubic) ? cubic[i] : 0.0);
+			if (fabs(err) > fabs(mxerr))
+				mxerr = err;
+		} return mxerr;
+	}
+
+	std::vector<double>		chunk(nthreads, 0.0);
+	std::vector<std::thread>	pool;
+
+	for(int k=0; k<nthreads; k++) {
+		pool.push_back(std::thread([&, k]() {
+			int	first = (int)((long)ln * k / nthreads),
+				last  = (int)((long)ln * (k+1) / nthreads);
+			double	mxerr = 0.0, err;
+
+			for(int i=first; i<last; i++) {
+				err = est_max_err(table[i], slope[i],
+						(dslope) ? dslope[i] : 0.0,
+						i, N, (cubic) ? cubic[i] : 0.0);
+				if (fabs(err) > fabs(mxerr))
+					mxerr = err;
+			} chunk[k] = mxerr;
+		}));
+	}
+
+	double	mxerr = 0.0;
+	for(int k=0; k<nthreads; k++) {
+		pool[k].join();
+		if (fabs(chunk[k]) > fabs(mxerr))
+			mxerr = chunk[k];
+	} return mxerr;
+}
+// }}}
+
 double	quadtbl_spur(int lgtbl) {
 // {{{
 	double	spur_magnitude;
@@ -129,15 +240,29 @@ int	pick_tbl_size(int ww) {
 // }}}
 }
 
-void	build_quadtbls(const char *fname, const int lgsz, const int wid,
-		int &cbits, int &lbits, int &qbits, double &tblerr) {
+// QUADTBL_COEFFS
+// {{{
+// The coefficients of one candidate table size, together with the bit widths
+// needed to hold them and the worst case error they produce.  Only cubic
+// tables have an m_cubic term, and only they use m_kbits and m_mxcubic.
+typedef	struct	{
+	int	m_lgsz, m_wid, m_cbits, m_lbits, m_qbits, m_kbits;
+	long	m_maxv;
+	double	m_mxerr, m_tblerr, m_mxtbl, m_mxslope, m_mxdslope, m_mxcubic;
+	double	*m_table, *m_slope, *m_dslope, *m_cubic;
+} QUADTBL_COEFFS;
+// }}}
+
+// calc_quadtbls
 // {{{
+// Calculate the coefficients for a table of 2^lgsz entries, without writing
+// anything out
+static	QUADTBL_COEFFS	*calc_quadtbls(const int lgsz, const int wid) {
+	QUADTBL_COEFFS	*qt = new QUADTBL_COEFFS;
 	int	tbl_entries = (1<<lgsz);
 	long	maxv = max_integer(wid);
-	double	dl = M_PI / (double)tbl_entries, dph= dl * 2.;
+	double	dl = M_PI / (double)tbl_entries;
 	// double	scl = pow(sinc(1./tbl_entries),3);
-	long	*tbldata = new long[tbl_entries];
-	STRING	name;
 
 	assert(lgsz > 2);
 	assert(wid > 6);
@@ -147,9 +272,16 @@ void	build_quadtbls(const char *fname, const int lgsz, const int wid,
 	double	*slope  = new double[ln];
 	double	*dslope = new double[ln];
 
+	// Every sine value we need, from index -1 through ln, calculated once.
+	SINEWAVE	*wave = sinewave(ln, true);
+	double	*sinv = new double[ln+2];
+	for(int i=-1; i<=ln; i++)
+		sinv[i+1] = sinewave_value(wave, i);
+	free_sinewave(wave);
+
 	// The base value, or constant term
 	for(int i=0; i<ln; i++)
-		table[i] = sin(dph * i + dl);
+		table[i] = sinv[i+1];
 
 	// The slope, or linear term
 	for(int i=1; i<ln-1; i++)
@@ -167,9 +299,10 @@ void	build_quadtbls(const char *fname, const int lgsz, const int wid,
 	// result you would get after filtering this with our
 	// quadratic.
 	for(int i=0; i<ln; i++)
-		table[i] = 0.75 * sin(dph*i+dl)
-			+ ( sin(dph*(i-1)+dl)
-			+   sin(dph*(i+1)+dl))/8.0;
+		table[i] = 0.75 * sinv[i+1]
+			+ ( sinv[i]
+			+   sinv[i+2])/8.0;
+	delete[] sinv;
 
 	// Now, shuffle this quadratic so that we can interpolate from
 	// the end, rather than the middle.
@@ -206,17 +339,7 @@ void	build_quadtbls(const char *fname, const int lgsz, const int wid,
 	for(int i=0; i<ln; i++)
 		dslope[i] *= 1./mxtbl;
 
-	double	mxerr = 0.0, err;
-	for(int i=0; i<ln; i++) {
-		err = est_max_err(table[i], slope[i], dslope[i], i, ln);
-		if (fabs(err) > fabs(mxerr))
-			mxerr = err;
-	}
-
-	printf("MXERR = %f * %ld (0x%08lx)\n", mxerr, maxv, maxv);
-	mxerr *= maxv;
-	printf("MXERR = %f\n", mxerr);
-	tblerr = mxerr;
+	double	mxerr = max_table_err(table, slope, dslope, ln, ln);
 
 	mxtbl = 0.0;
 	for(int i=0; i<ln; i++)
@@ -226,60 +349,457 @@ void	build_quadtbls(const char *fname, const int lgsz, const int wid,
 		mxdslope=(mxdslope>fabs(dslope[i]))?mxdslope:fabs(dslope[i]);
 	}
 
-	printf("MXVLS - TABLE:  %f -> 0x%lx\n", mxtbl, (long)(mxtbl * maxv));
-	printf("MXVLS - SLOPE:  %f -> 0x%lx\n", mxslope,(long)(mxslope*maxv));
-	printf("MXVLS - DSLOPE: %f -> 0x%lx\n", mxdslope,(long)(mxdslope*maxv));
+	qt->m_lgsz   = lgsz;
+	qt->m_wid    = wid;
+	qt->m_maxv   = maxv;
+	qt->m_mxerr  = mxerr;
+	qt->m_tblerr = mxerr * maxv;
+	qt->m_mxtbl  = mxtbl;
+	qt->m_mxslope  = mxslope;
+	qt->m_mxdslope = mxdslope;
+	qt->m_cbits  = wid + (int)ceil( log(mxtbl      )/log(2.0));
+	qt->m_lbits  = wid + (int)ceil(-log(1./mxslope )/log(2.0));
+	qt->m_qbits  = wid + (int)ceil(-log(1./mxdslope)/log(2.0));
+	qt->m_kbits  = 0;
+	qt->m_mxcubic = 0.0;
+	qt->m_table  = table;
+	qt->m_slope  = slope;
+	qt->m_dslope = dslope;
+	qt->m_cubic  = NULL;
+
+	return qt;
+}
+// }}}
+
+// calc_cubtbls
+// {{{
+// Calculate the coefficients of a cubic interpolation across a full wave,
+// using a table of 2^lgsz entries.  Each interval gets the cubic through
+// the sine wave at the four Chebyshev nodes of that interval.  This spreads
+// the error almost evenly across the interval, so it's nearly as good as
+// the minimax cubic, while being much easier to find.  The three products
+// of a cubic each truncate, so its peak, maxv, needs to leave more room
+// below full scale than max_integer() does.
+static	QUADTBL_COEFFS	*calc_cubtbls(const int lgsz, const int wid,
+		const long maxv) {
+	QUADTBL_COEFFS	*qt = new QUADTBL_COEFFS;
+	int	ln = (1<<lgsz);
+	const double	w = 2.0 * M_PI / (double)ln;
+	double	*table  = new double[ln];
+	double	*slope  = new double[ln];
+	double	*dslope = new double[ln];
+	double	*cubic  = new double[ln];
+	double	xn[4];
+
+	assert(lgsz > 2);
+	assert(wid > 6);
+
+	for(int k=0; k<4; k++)
+		xn[k] = 0.5 - 0.5 * cos((2*k+1) * M_PI / 8.0);
+
+	for(int i=0; i<ln; i++) {
+		double	a[4], p[4];
+
+		// Newton's divided differences, through each node
+		for(int k=0; k<4; k++)
+			a[k] = sin(w * (i + xn[k]));
+		for(int j=1; j<4; j++)
+			for(int k=3; k>=j; k--)
+				a[k] = (a[k] - a[k-1]) / (xn[k] - xn[k-j]);
+
+		// Expand the Newton form into coefficients of dx, from the
+		// inside out: p(x) = (p(x) * (x - xn[j])) + a[j]
+		p[0] = a[3]; p[1] = p[2] = p[3] = 0.0;
+		for(int j=2; j>=0; j--) {
+			for(int k=3; k>0; k--)
+				p[k] = p[k-1] - xn[j] * p[k];
+			p[0] = a[j] - xn[j] * p[0];
+		}
+
+		table[i]  = p[0];
+		slope[i]  = p[1];
+		dslope[i] = p[2];
+		cubic[i]  = p[3];
+	}
+
+	// Normalize the table so that its largest value is one
+	double	mxtbl = 0.0, mxslope = 0.0, mxdslope = 0.0, mxcubic = 0.0;
+
+	for(int i=0; i<ln; i++)
+		mxtbl = (mxtbl >fabs( table[i]))?mxtbl : fabs(table[i]);
+	for(int i=0; i<ln; i++) {
+		table[i]  *= 1./mxtbl;
+		slope[i]  *= 1./mxtbl;
+		dslope[i] *= 1./mxtbl;
+		cubic[i]  *= 1./mxtbl;
+	}
+
+	double	mxerr = max_table_err(table, slope, dslope, ln, ln, cubic);
+
+	mxtbl = 0.0;
+	for(int i=0; i<ln; i++) {
+		mxtbl  = (mxtbl  > fabs( table[i])) ? mxtbl  : fabs( table[i]);
+		mxslope= (mxslope> fabs( slope[i])) ? mxslope: fabs( slope[i]);
+		mxdslope=(mxdslope>fabs(dslope[i])) ? mxdslope:fabs(dslope[i]);
+		mxcubic= (mxcubic> fabs( cubic[i])) ? mxcubic: fabs( cubic[i]);
+	}
+
+	qt->m_lgsz   = lgsz;
+	qt->m_wid    = wid;
+	qt->m_maxv   = maxv;
+	qt->m_mxerr  = mxerr;
+	qt->m_tblerr = mxerr * maxv;
+	qt->m_mxtbl  = mxtbl;
+	qt->m_mxslope  = mxslope;
+	qt->m_mxdslope = mxdslope;
+	qt->m_mxcubic  = mxcubic;
+	qt->m_cbits  = wid + (int)ceil( log(mxtbl      )/log(2.0));
+	qt->m_lbits  = wid + (int)ceil(-log(1./mxslope )/log(2.0));
+	qt->m_qbits  = wid + (int)ceil(-log(1./mxdslope)/log(2.0));
+	qt->m_kbits  = wid + (int)ceil(-log(1./mxcubic )/log(2.0));
+	qt->m_table  = table;
+	qt->m_slope  = slope;
+	qt->m_dslope = dslope;
+	qt->m_cubic  = cubic;
+
+	return qt;
+}
+// }}}
+
+// calc_lintbls
+// {{{
+// Calculate the coefficients of a linear interpolation across the first
+// quarter wave alone, using a table of 2^lgsz entries.  Each interval gets
+// the line through its two end points, shifted by half of the largest
+// distance between that line and the sine wave.  Since the sine wave is
+// concave across the first quarter, this places the error at the ends and
+// at the middle of each interval equal and opposite, and so minimizes it.
+static	QUADTBL_COEFFS	*calc_lintbls(const int lgsz, const int wid,
+		const long maxv) {
+	QUADTBL_COEFFS	*qt = new QUADTBL_COEFFS;
+	int	ln = (1<<lgsz);
+	const double	w = M_PI / 2.0 / (double)ln;
+	double	*table  = new double[ln];
+	double	*slope  = new double[ln];
+	double	mxtbl = 0.0, mxslope = 0.0;
+
+	assert(lgsz > 2);
+	assert(wid > 6);
+
+	for(int i=0; i<ln; i++) {
+		double	y0 = sin(w * i), y1 = sin(w * (i+1)), xm, er;
+
+		slope[i] = y1 - y0;
+		// Where the slope of the sine wave matches that of the line
+		xm = acos(slope[i] / w) / w - i;
+		er = sin(w * (i + xm)) - (y0 + slope[i] * xm);
+		table[i] = y0 + er / 2.0;
+
+		mxtbl   = (mxtbl  > table[i]) ? mxtbl  : table[i];
+		mxslope = (mxslope> slope[i]) ? mxslope: slope[i];
+	}
+
+	double	mxerr = max_table_err(table, slope, NULL, ln, 4*ln);
+
+	qt->m_lgsz   = lgsz;
+	qt->m_wid    = wid;
+	qt->m_maxv   = maxv;
+	qt->m_mxerr  = mxerr;
+	qt->m_tblerr = mxerr * maxv;
+	qt->m_mxtbl  = mxtbl;
+	qt->m_mxslope  = mxslope;
+	qt->m_mxdslope = 0.0;
+	// The widths depend upon the rounding, and so are set by
+	// write_lintbls()
+	qt->m_cbits  = 0;
+	qt->m_lbits  = 0;
+	qt->m_qbits  = 0;
+	qt->m_kbits  = 0;
+	qt->m_mxcubic = 0.0;
+	qt->m_table  = table;
+	qt->m_slope  = slope;
+	qt->m_dslope = NULL;
+	qt->m_cubic  = NULL;
+
+	return qt;
+}
+// }}}
+
+// free_quadtbls
+// {{{
+static	void	free_quadtbls(QUADTBL_COEFFS *qt) {
+	if (!qt)
+		return;
+	delete[] qt->m_table;
+	delete[] qt->m_slope;
+	delete[] qt->m_dslope;
+	delete[] qt->m_cubic;
+	delete qt;
+}
+// }}}
+
+// coeffgen
+// {{{
+// Scales one of the (double) coefficient tables to integers, entry by
+// entry, as hextable() writes it out.  m_offset is then added to every entry.
+typedef	struct	COEFFGEN_S {
+	long		m_maxv, m_offset;
+	const double	*m_coeff;
+} COEFFGEN;
+
+static	long	coeffgen(long k, void *arg) {
+	const	COEFFGEN *cg = (const COEFFGEN *)arg;
+
+	return (long)(cg->m_maxv * cg->m_coeff[k]) + cg->m_offset;
+}
+// }}}
+
+// write_quadtbls
+// {{{
+// Report on, and then write out, the three (or, for a cubic, four) tables of
+// a chosen table size
+static	void	write_quadtbls(const char *fname, const QUADTBL_COEFFS *qt) {
+	int	tbl_entries = (1<<qt->m_lgsz), ln = tbl_entries;
+	int	lgsz = qt->m_lgsz, wid = qt->m_wid;
+	int	cbits = qt->m_cbits, lbits = qt->m_lbits, qbits = qt->m_qbits;
+	long	maxv = qt->m_maxv;
+	COEFFGEN	cg;
+	STRING	name;
+
+	printf("MXERR = %f * %ld (0x%08lx)\n", qt->m_mxerr, maxv, maxv);
+	printf("MXERR = %f\n", qt->m_tblerr);
 
-	cbits   = wid + (int)ceil( log(mxtbl      )/log(2.0));
-	lbits   = wid + (int)ceil(-log(1./mxslope )/log(2.0));
-	qbits   = wid + (int)ceil(-log(1./mxdslope)/log(2.0));
+	printf("MXVLS - TABLE:  %f -> 0x%lx\n", qt->m_mxtbl, (long)(qt->m_mxtbl * maxv));
+	printf("MXVLS - SLOPE:  %f -> 0x%lx\n", qt->m_mxslope,(long)(qt->m_mxslope*maxv));
+	printf("MXVLS - DSLOPE: %f -> 0x%lx\n", qt->m_mxdslope,(long)(qt->m_mxdslope*maxv));
+	if (qt->m_cubic)
+		printf("MXVLS - CUBIC:  %f -> 0x%lx\n", qt->m_mxcubic,(long)(qt->m_mxcubic*maxv));
 
-	printf("%d WID := CBITS:LBITS:QBITS = %d:%d:%d\n", wid, cbits, lbits, qbits);
+	if (qt->m_cubic)
+		printf("%d WID := CBITS:LBITS:QBITS:KBITS = %d:%d:%d:%d\n", wid,
+			cbits, lbits, qbits, qt->m_kbits);
+	else
+		printf("%d WID := CBITS:LBITS:QBITS = %d:%d:%d\n", wid, cbits, lbits, qbits);
 	// Double check that we are still within bounds
 	for(int i=0; i<ln; i++) {
-		assert(fabs(table[i])  <= (1<<(cbits-wid)));
-		assert(fabs(slope[i])  <= pow(2.,(lbits-wid)));
-		assert(fabs(dslope[i]) <= pow(2.,(qbits-wid)));
+		assert(fabs(qt->m_table[i])  <= (1<<(cbits-wid)));
+		assert(fabs(qt->m_slope[i])  <= pow(2.,(lbits-wid)));
+		assert(fabs(qt->m_dslope[i]) <= pow(2.,(qbits-wid)));
+		if (qt->m_cubic)
+			assert(fabs(qt->m_cubic[i]) <= pow(2.,(qt->m_kbits-wid)));
 	}
 
-	for(int k=0; k<tbl_entries; k++)
-		tbldata[k] = (long)(maxv * table[k]);
+	cg.m_maxv  = maxv;
+	cg.m_offset= 0;
 
+	// Each of the cubic's three products truncates, for an average loss
+	// of 1/2, 1/4 (1/2 times an average dx of 1/2), and 1/6 (1/2 times an
+	// average dx^2 of 1/3) of an LSB.  Adding one LSB to the constant
+	// gets rid of nearly all of that bias.
+	if (qt->m_cubic)
+		cg.m_offset = 1;
+	cg.m_coeff = qt->m_table;
 	name = STRING(fname) + STRING("_ctbl");
-	hextable(name.c_str(), lgsz, cbits, tbldata);
-
-	for(int k=0; k<tbl_entries; k++)
-		tbldata[k] = (long)(maxv * slope[k]);
+	hextable(name.c_str(), lgsz, cbits, coeffgen, &cg);
 
+	cg.m_offset= 0;
+	cg.m_coeff = qt->m_slope;
 	name = STRING(fname) + STRING("_ltbl");
-	hextable(name.c_str(), lgsz, lbits, tbldata);
-
-	for(int k=0; k<tbl_entries; k++)
-		tbldata[k] = (long)(maxv * dslope[k]);
+	hextable(name.c_str(), lgsz, lbits, coeffgen, &cg);
 
+	cg.m_coeff = qt->m_dslope;
 	name = STRING(fname) + STRING("_qtbl");
-	hextable(name.c_str(), lgsz, qbits, tbldata);
+	hextable(name.c_str(), lgsz, qbits, coeffgen, &cg);
+
+	if (qt->m_cubic) {
+		cg.m_coeff = qt->m_cubic;
+		name = STRING(fname) + STRING("_ktbl");
+		hextable(name.c_str(), lgsz, qt->m_kbits, coeffgen, &cg);
+	}
+}
+// }}}
+
+void	build_quadtbls(const char *fname, const int lgsz, const int wid,
+		int &cbits, int &lbits, int &qbits, double &tblerr) {
+// {{{
+	QUADTBL_COEFFS	*qt = calc_quadtbls(lgsz, wid);
+
+	write_quadtbls(fname, qt);
 
-	delete[] table;
-	delete[] slope;
-	delete[] dslope;
-	delete[] tbldata;
+	cbits  = qt->m_cbits;
+	lbits  = qt->m_lbits;
+	qbits  = qt->m_qbits;
+	tblerr = qt->m_tblerr;
+
+	free_quadtbls(qt);
 // }}}
 }
 
-void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
-		int phase_bits, int ow, int nxtra, bool with_reset,
-		bool with_aux, bool async_reset) {
+// size_quadtbls
+// {{{
+// Find the smallest table, from 2^MIN_LGTBL to 2^max_lg entries, whose
+// worst case error is within one unit, or else the largest table if none
+// are.  The error of a quadratic interpolator falls as the cube of the table
+// size, that of a linear one as the square, and that of a cubic one as the
+// fourth power, so one small table is enough to estimate the right
+// size.  From there, we step up or down to find the exact answer.  Each
+// candidate is calculated at most once, and the coefficients of the winner
+// are returned.  Linear (order one) tables hold only the first quarter
+// wave.  Both they and cubic tables are scaled to a peak of maxv.
+static	const	int	MIN_LGTBL = 4, MAX_LGTBL = 20;
+
+static	QUADTBL_COEFFS	*size_quadtbls(const int wid, const int order = 2,
+		const long maxv = 0, const int max_lg = MAX_LGTBL) {
+	QUADTBL_COEFFS	*cache[MAX_LGTBL+1];
+	const double	fctr = (double)(2<<order);
+	int	lgtbl;
+
+	assert((order >= 1)&&(order <= 3));
+	assert(max_lg >= MIN_LGTBL);
+	assert(max_lg <= MAX_LGTBL);
+	for(int k=0; k<=MAX_LGTBL; k++)
+		cache[k] = NULL;
+
+	// Look up (or calculate) the candidate of a given size
+	auto	candidate = [&](int lg) {
+		if (!cache[lg])
+			cache[lg] = (order == 1) ? calc_lintbls(lg, wid, maxv)
+				: (order == 3) ? calc_cubtbls(lg, wid, maxv)
+				: calc_quadtbls(lg, wid);
+		return cache[lg];
+	};
+	auto	good = [&](int lg) {
+		return fabs(candidate(lg)->m_tblerr) <= 1.0;
+	};
+
+	lgtbl = MIN_LGTBL;
+	if (!good(lgtbl)) {
+		// Each doubling of the table size cuts the error by fctr
+		double	err = fabs(candidate(MIN_LGTBL)->m_tblerr);
+
+		lgtbl = MIN_LGTBL + (int)ceil(log(err)/log(fctr));
+		if (lgtbl <= MIN_LGTBL)
+			lgtbl = MIN_LGTBL+1;
+		if (lgtbl > max_lg)
+			lgtbl = max_lg;
+
+		while((lgtbl < max_lg)&&(!good(lgtbl)))
+			lgtbl++;
+		while((lgtbl > MIN_LGTBL+1)&&(good(lgtbl-1)))
+			lgtbl--;
+	}
+
+	// Release everything but our answer, which may not have been
+	// calculated yet if it was clamped to the largest size
+	QUADTBL_COEFFS	*qt = candidate(lgtbl);
+	for(int k=0; k<=MAX_LGTBL; k++)
+		if (k != lgtbl)
+			free_quadtbls(cache[k]);
+
+	return qt;
+}
+// }}}
+
+// declare_quadregs
+// {{{
+// Declares the registers carrying the coefficients, dx, and the partial
+// products through the interpolation pipeline--everything that a second
+// (cosine) channel would need its own copy of.
+static	void	declare_quadregs(FILE *fp, bool cubic, bool with_aux,
+		int kbits, int qbits, int dxbits, int cbits) {
+	fprintf(fp,
+	"\t//\n"
+	"\t// Space for our coefficients, and their copies as we work through\n"
+	"\t// our processing stages\n");
+
+	if (NO_QUADRATIC_COMPONENT) {
+		fprintf(fp,
+		"\treg\tsigned\t[(CBITS-1):0]\tcv, cv_1;\n"
+		"\treg\tsigned\t[(LBITS-1):0]\tlv;\n"
+		"\treg\tsigned\t[(DXBITS-1):0]\tdx;\n\n");
+	} else {
+		fprintf(fp,
+		"\treg\tsigned\t[(CBITS-1):0]\tcv,\n"
+					"\t\t\t\t\tcv_1, cv_2, cv_3;\n"
+		"\treg\tsigned\t[(LBITS-1):0]\tlv, lv_1;\n"
+		"\treg\tsigned\t[(QBITS-1):0]\tqv;\n"
+		"\treg\tsigned\t[(DXBITS-1):0]\tdx, dx_1, dx_2;\n\n");
+	}
+	if (cubic) {
+		fprintf(fp,
+		"\t// ... and ahead of those, for the cubic term\n"
+		"\treg\tsigned\t[(KBITS-1):0]\tkv;\n"
+		"\treg\tsigned\t[(QBITS-1):0]\tkq, kq_1;\n"
+		"\treg\tsigned\t[(LBITS-1):0]\tkl, kl_1;\n"
+		"\treg\tsigned\t[(CBITS-1):0]\tkc, kc_1;\n"
+		"\treg\tsigned\t[(DXBITS-1):0]\tkdx, kdx_1;\n"
+		"\treg\tsigned\t[(KBITS+DXBITS-1):0]\tkprod; // [%d:%d]\n"
+		"\twire\t\t[(QBITS-1):0]\t\tw_kprod;\n\n",
+			kbits+dxbits-1, 0);
+	}
+
+	fprintf(fp, "\t//\n\t//\n");
+	if (!NO_QUADRATIC_COMPONENT)
+		fprintf(fp,
+		"\treg\tsigned\t[(QBITS+DXBITS-1):0]	qprod; // [%d:%d]\n",
+				qbits+dxbits-1, 0);
+	if (with_aux)
+		fprintf(fp,
+		"\treg\t\t[(NSTAGES-1):0]\t\taux;\n");
+
+	if (!NO_QUADRATIC_COMPONENT)
+		fprintf(fp,
+		"\treg\tsigned\t[(LBITS-1):0]\t\tlsum;\n");
+	fprintf(fp,
+		"\treg\tsigned\t[(LBITS+DXBITS-1):0]\tlprod;\n");
+	if (!NO_QUADRATIC_COMPONENT)
+		fprintf(fp,
+		"\twire\t\t[(LBITS-1):0]\t\tw_qprod;\n");
+	fprintf(fp,
+	"\treg	signed	[(CBITS-1):0]		r_value; // %d bits\n"
+	"\twire	signed	[(CBITS-1):0]		w_lprod;\n\n",
+			cbits);
+}
+// }}}
+
+int	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+		int phase_bits, int ow, int nxtra, int order, bool dual,
+		bool with_reset, bool with_aux, bool async_reset) {
 	// {{{
 	const	char	*name;
 	char	*noext;
 	int	lgtbl = pick_tbl_size(ow+nxtra);
 
-	int	cbits, lbits, qbits, dxbits = phase_bits-lgtbl+1;
+	int	cbits, lbits, qbits, kbits, dxbits;
 	int	ww = ow + nxtra;
+	// A cubic adds one multiply, and so two clocks, ahead of the rest
+	const	bool	cubic = (order == 3);
+	const	int	koff = (cubic) ? 2 : 0;
+	// With dual set, the datapath is generated twice, once for the sine
+	// and once for the cosine, from a local phase and into a local result.
+	//
+	// No multiply can be shared between the two.  Each channel evaluates
+	// its own polynomial in dx, from its own table entries, so every
+	// product has one operand only that channel knows.  Deriving the
+	// cosine from the sine's slope, L+2Q*dx, instead of from a second
+	// lookup, still needs the 2Q*dx product, and it is 3 to 6 bits less
+	// accurate: 4.7 LSBs at 13 bits, 33 LSBs at 20 bits.  Rotating a
+	// coarse (sin,cos) pair by the fine angle takes four products, the
+	// same as two quadratic channels.
+	const	char	*phase = (dual) ? "w_phase" : "i_phase",
+			*osin  = (dual) ? "r_out" : "o_sin";
+	const	int	nchan = (dual) ? 2 : 1;
+	int	nmults, ndsps;
+	long	scale;
 	double	tblerr;
 
 	assert(nxtra >= 0);
+	assert((order == 2)||(order == 3));
+	if (nxtra < 2)
+		nxtra = 2;
+	// A cubic peaks one output step below full scale, leaving 2^nxtra
+	// working units for its truncation errors
+	scale = (cubic) ? ((1l<<(ow-1))-1l) : max_integer(ow);
 	assert(fp);
 	assert(phase_bits>4);
 	assert(phase_bits>lgtbl);
@@ -294,26 +814,56 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 			*ptr = '\0';
 	}
 
-	lgtbl=3;
-	do {
-		lgtbl++;
-		build_quadtbls(noext, lgtbl, ow+nxtra, cbits, lbits, qbits, tblerr);
-	} while((fabs(tblerr) > 1.0)&&(lgtbl < 20));
+	{
+		// Size the tables first, then write only the ones we use
+		QUADTBL_COEFFS	*qt = size_quadtbls(ow+nxtra, order,
+						scale << nxtra);
+
+		write_quadtbls(noext, qt);
+		lgtbl  = qt->m_lgsz;
+		cbits  = qt->m_cbits;
+		lbits  = qt->m_lbits;
+		qbits  = qt->m_qbits;
+		kbits  = qt->m_kbits;
+		tblerr = qt->m_tblerr;
+		free_quadtbls(qt);
+	}
+	dxbits = phase_bits-lgtbl+1;
+	assert(phase_bits>lgtbl);
+	assert((!cubic)||(qbits > kbits));
+
+	// The multiplies in each channel: L and Q (unless skipped) times dx,
+	// and then K times dx for a cubic
+	nmults = 1;
+	ndsps  = dsp_count(lbits, dxbits);
+	if (!NO_QUADRATIC_COMPONENT) {
+		nmults++;
+		ndsps += dsp_count(qbits, dxbits);
+	} if (cubic) {
+		nmults++;
+		ndsps += dsp_count(kbits, dxbits);
+	}
+	nmults *= nchan;
+	ndsps  *= nchan;
 
 	printf("Rpt-Err: %f\n", tblerr);
-	const	char PURPOSE[] =
+	const	char QPURPOSE[] =
 	"This is a sine-wave table lookup algorithm, coupled with a\n"
 	"//\t\tquadratic interpolation of the result.  It's purpose is both\n"
 	"//\t to trade off logic, as well as to lower the phase noise associated\n"
 	"//\twith any phase truncation.",
+		KPURPOSE[] =
+	"This is a sine-wave table lookup algorithm, coupled with a\n"
+	"//\t\tcubic interpolation of the result.  The cubic costs one more\n"
+	"//\tmultiply than the quadratic, but allows a much smaller table for\n"
+	"//\tthe same accuracy.",
+		*PURPOSE = (cubic) ? KPURPOSE : QPURPOSE,
 		HPURPOSE[] =
 	"This .h file notes the default parameter values from\n"
 	"//\t\twithin the generated file.  It is used to communicate\n"
 	"//\tinformation about the design to the bench testing code.";
 
 	legal(fp, fname, PROJECT, PURPOSE, cmdline);
-	if (nxtra < 2)
-		nxtra = 2;
 	assert(phase_bits >= 3);
 
 	if (ww < ow)
@@ -346,14 +896,15 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\tinput\twire\t\t\t\ti_clk, %s%si_ce%s,\n"
 		"\t\t//\n"
 		"\t\tinput\twire\tsigned\t[(PW-1):0]\ti_phase,\n"
-		"\t\toutput\treg\tsigned\t[(OW-1):0]\to_sin%s\n",
+		"\t\toutput\t%s\tsigned\t[(OW-1):0]\t%s%s\n",
 		name,
 		// resetw.c_str(), (with_reset)?", ":"",
 		// (with_aux)?" i_aux,":"",
 		// (with_aux)?", o_aux":"",
 		phase_bits, ow, nxtra,
 		resetw.c_str(), (with_reset)?", ":"",
-		(with_aux)?", i_aux":"", (with_aux) ? ",":"");
+		(with_aux)?", i_aux":"", (dual) ? "wire" : "reg",
+		(dual) ? "o_sin, o_cos" : "o_sin", (with_aux) ? ",":"");
 
 
 	if (with_aux)
@@ -367,71 +918,51 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	fprintf(fp,
 	"\tlocalparam\tLGTBL=%d,\n"
 			"\t\t\tDXBITS  = (PW-LGTBL)+1,  // %d\n"
-			"\t\t\tTBLENTRIES = (1<<LGTBL), // %d\n"
+			"\t\t\tTBLENTRIES = (1<<LGTBL), // %d\n",
+			lgtbl, dxbits, (1<<lgtbl));
+	if (cubic)
+		fprintf(fp, "\t\t\tKBITS   = %d,\n", kbits);
+	fprintf(fp,
 			"\t\t\tQBITS   = %d,\n"
 			"\t\t\tLBITS   = %d,\n"
 			"\t\t\tCBITS   = %d,\n"
 			"\t\t\tWW      = (OW+XTRA); // Working width\n",
-			lgtbl, dxbits, (1<<lgtbl), qbits, lbits, cbits);
+			qbits, lbits, cbits);
 
 	if (with_aux) fprintf(fp,
 	"\tlocalparam\tNSTAGES = %d; // Hard-coded to the algorithm\n\n",
-			(NO_QUADRATIC_COMPONENT)?4:6);
+			((NO_QUADRATIC_COMPONENT)?4:6) + koff);
 
 
-	fprintf(fp,
-	"\t//\n"
-	"\t// Space for our coefficients, and their copies as we work through\n"
-	"\t// our processing stages\n");
-
-	if (NO_QUADRATIC_COMPONENT) {
-		fprintf(fp,
-		"\treg\tsigned\t[(CBITS-1):0]\tcv, cv_1;\n"
-		"\treg\tsigned\t[(LBITS-1):0]\tlv;\n"
-		"\treg\tsigned\t[(DXBITS-1):0]\tdx;\n\n");
-	} else {
+	if (!dual)
+		declare_quadregs(fp, cubic, with_aux, kbits, qbits, dxbits,
+				cbits);
+	else {
+		if (with_aux)
+			fprintf(fp,
+			"\treg\t\t[(NSTAGES-1):0]\t\taux;\n");
 		fprintf(fp,
-		"\treg\tsigned\t[(CBITS-1):0]\tcv,\n"
-					"\t\t\t\t\tcv_1, cv_2, cv_3;\n"
-		"\treg\tsigned\t[(LBITS-1):0]\tlv, lv_1;\n"
-		"\treg\tsigned\t[(QBITS-1):0]\tqv;\n"
-		"\treg\tsigned\t[(DXBITS-1):0]\tdx, dx_1, dx_2;\n\n");
+			"\twire\t\t[(2*OW-1):0]\t\tw_result;\n\n");
 	}
 
-	fprintf(fp, "\t//\n\t//\n");
-	if (!NO_QUADRATIC_COMPONENT)
-		fprintf(fp,
-		"\treg\tsigned\t[(QBITS+DXBITS-1):0]	qprod; // [%d:%d]\n",
-				qbits+dxbits-1, 0);
-	if (with_aux)
-		fprintf(fp,
-		"\treg\t\t[(NSTAGES-1):0]\t\taux;\n");
-
-	if (!NO_QUADRATIC_COMPONENT)
-		fprintf(fp,
-		"\treg\tsigned\t[(LBITS-1):0]\t\tlsum;\n");
-	fprintf(fp,
-		"\treg\tsigned\t[(LBITS+DXBITS-1):0]\tlprod;\n");
-	if (!NO_QUADRATIC_COMPONENT)
-		fprintf(fp,
-		"\twire\t\t[(LBITS-1):0]\t\tw_qprod;\n");
-	fprintf(fp,
-	"\treg	signed	[(CBITS-1):0]		r_value; // %d bits\n"
-	"\twire	signed	[(CBITS-1):0]		w_lprod;\n\n",
-			cbits);
-
 	fprintf(fp,
 	"\t// Coefficient tables:\n"
-	"\t//\tConstant, Linear, and Quadratic\n"
+	"\t//\tConstant, Linear, %sQuadratic%s\n"
 	"\treg	[(CBITS-1):0]	ctbl [0:(TBLENTRIES-1)]; //=(0...2^(OX)-1)/2^32\n"
 	"\treg	[(LBITS-1):0]	ltbl [0:(TBLENTRIES-1)]; // %d x %d\n",
+		(cubic) ? "" : "and ", (cubic) ? ", and Cubic" : "",
 		lbits, (1<<lgtbl));
 
 	if (!NO_QUADRATIC_COMPONENT)
 		fprintf(fp,
-	"\treg	[(QBITS-1):0]	qtbl [0:(TBLENTRIES-1)]; // %d x %d\n\n",
-		qbits, (1<<lgtbl));
-	fprintf(fp,
+	"\treg	[(QBITS-1):0]	qtbl [0:(TBLENTRIES-1)]; // %d x %d\n%s",
+		qbits, (1<<lgtbl), (cubic) ? "" : "\n");
+	if (cubic)
+		fprintf(fp,
+	"\treg	[(KBITS-1):0]	ktbl [0:(TBLENTRIES-1)]; // %d x %d\n\n",
+		kbits, (1<<lgtbl));
+	if (!dual)
+		fprintf(fp,
 	"\treg	[(WW-1):0]	w_value;\n");
 
 	fprintf(fp,
@@ -441,6 +972,9 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	if (!NO_QUADRATIC_COMPONENT)
 		fprintf(fp,
 		"\t\t$readmemh(\"%s_qtbl.hex\", qtbl);\n", name);
+	if (cubic)
+		fprintf(fp,
+		"\t\t$readmemh(\"%s_ktbl.hex\", ktbl);\n", name);
 	fprintf(fp,
 		"\tend\n\n");
 	fprintf(fp, "\t// }}}\n\n");
@@ -465,7 +999,47 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		fprintf(fp, "\t// }}}\n\n");
 	}
 
-	fprintf(fp,
+	if (dual) {
+		// {{{
+		fprintf(fp,
+	"\t////////////////////////////////////////////////////////////////////////\n"
+	"\t//\n"
+	"\t// Sine and cosine channels\n"
+	"\t// {{{\n"
+	"\t// The cosine is the sine a quarter wave later.  Adding one to the\n"
+	"\t// top two phase bits reads the same tables TBLENTRIES/4 entries\n"
+	"\t// further along, while leaving dx unchanged.  Both channels share\n"
+	"\t// the tables and the aux pipeline.\n"
+	"\t//\n"
+	"\t// The multiplies are not shared.  Each channel evaluates its own\n"
+	"\t// polynomial in dx from its own table entries, so no product is\n"
+	"\t// common to both.  This core uses %d multiplies, %d per channel,\n"
+	"\t// or an estimated %d 25x18 DSPs.\n"
+	"\t//\n"
+	"\tgenvar\tgk;\n"
+	"\tgenerate for(gk=0; gk<2; gk=gk+1)\n"
+	"\tbegin : GEN_CHANNEL\n"
+	"\t// {{{\n"
+	"\twire\t\t[(PW-1):0]\t\tw_phase;\n"
+	"\treg\tsigned\t[(OW-1):0]\t\tr_out;\n",
+		nmults, nmults/2, ndsps);
+		declare_quadregs(fp, cubic, false, kbits, qbits, dxbits,
+				cbits);
+		fprintf(fp,
+	"\treg	[(WW-1):0]	w_value;\n\n"
+	"\tif (gk == 0)\n"
+	"\tbegin : SIN\n"
+	"\t\tassign\tw_phase = i_phase;\n"
+	"\tend else begin : COS\n"
+	"\t\tassign\tw_phase = { i_phase[(PW-1):(PW-2)] + 2'b01,\n"
+	"\t\t\t\t\ti_phase[(PW-3):0] };\n"
+	"\tend\n\n");
+		// }}}
+	}
+
+	if (cubic) {
+		// {{{
+		fprintf(fp,
 	"\t////////////////////////////////////////////////////////////////////////\n"
 	"\t//\n"
 	"\t// Clock 1 - Table coefficient lookups\n"
@@ -476,70 +1050,209 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	"\t//	3. Store dx, the difference between the table value and the\n"
 	"\t//		actually requested phase, for later processing\n"
 	"\t//\n"
-	"\t//\n");
+	"\t//\n"
+	"\tinitial\tkv  = 0;\n"
+	"\tinitial\tkq  = 0;\n"
+	"\tinitial\tkl  = 0;\n"
+	"\tinitial\tkc  = 0;\n"
+	"\tinitial\tkdx = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
 
-	if (!NO_QUADRATIC_COMPONENT)
-		fprintf(fp, "\tinitial\tqv = 0;\n");
-	fprintf(fp,
-		"\tinitial\tlv = 0;\n"
-		"\tinitial\tcv = 0;\n"
-		"\tinitial\tdx = 0;\n");
-	fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp,
+			"\tbegin\n"
+				"\t\tkv  <= 0;\n"
+				"\t\tkq  <= 0;\n"
+				"\t\tkl  <= 0;\n"
+				"\t\tkc  <= 0;\n"
+				"\t\tkdx <= 0;\n"
+			"\tend else ");
 
-	if (with_reset) {
-		fprintf(fp, "\tbegin\n");
-		if (!NO_QUADRATIC_COMPONENT)
-			fprintf(fp, "\t\tqv <= 0;\n");
-		else
-			fprintf(fp, "\t\t// No quadratic coefficient\n");
 		fprintf(fp,
-			"\t\tlv <= 0;\n"
-			"\t\tcv <= 0;\n"
-			"\t\tdx <= 0;\n"
-			"\tend else ");
-	}
+		"if (i_ce)\n"
+		"\tbegin\n"
+		"\t\tkv  <= ktbl[%s[(PW-1):(DXBITS-1)]];\n"
+		"\t\tkq  <= qtbl[%s[(PW-1):(DXBITS-1)]];\n"
+		"\t\tkl  <= ltbl[%s[(PW-1):(DXBITS-1)]];\n"
+		"\t\tkc  <= ctbl[%s[(PW-1):(DXBITS-1)]];\n"
+		"\t\tkdx <= { 1'b0, %s[(DXBITS-2):0] };	// * 2^(-PW)\n"
+		"\tend\n\n", phase, phase, phase, phase, phase);
 
-	fprintf(fp,
-	"if (i_ce)\n"
-	"\tbegin\n");
-	if (!NO_QUADRATIC_COMPONENT)
-		fprintf(fp,"\t\tqv <= qtbl[i_phase[(PW-1):(DXBITS-1)]];\n");
-	else
-		fprintf(fp,"\t\t// This build has no quadratic component\n");
-	fprintf(fp,
-	"\t\tlv <= ltbl[i_phase[(PW-1):(DXBITS-1)]];\n"
-	"\t\tcv <= ctbl[i_phase[(PW-1):(DXBITS-1)]];\n"
-	"\t\tdx <= { 1'b0, i_phase[(DXBITS-2):0] };	// * 2^(-PW)\n"
-	"\tend\n\n");
+		fprintf(fp,
+		"\t//\n"
+		"\t// Here's our formula:\n"
+		"\t//\n"
+		"\t//	 Out = ((K*DX+Q)*DX+L)*DX+C\n"
+		"\t//\n"
+		"\t// A basic cubic interpolant, in Horner form.  All of the smarts\n"
+		"\t// are found within the K, Q, L, and C values.\n\n");
 
-	fprintf(fp,
-	"\t//\n"
-	"\t// Here's our formula:\n"
-	"\t//\n");
-	if (NO_QUADRATIC_COMPONENT)
-		fprintf(fp, "\t//	 Out = (     L)*DX+C\n");
-	else
-		fprintf(fp, "\t//	 Out = (Q*DX+L)*DX+C\n");
-	fprintf(fp,
-	"\t//\n"
-	"\t// A basic %s interpolant.  All of the smarts are found within\n"
-	"\t// the %sL, and C values.\n\n",
-		(NO_QUADRATIC_COMPONENT) ? "linear":"quadratic",
-		(NO_QUADRATIC_COMPONENT) ? "":"Q, ");
+		fprintf(fp,
+		"\t// }}}\n"
+		"\t////////////////////////////////////////////////////////////////////////\n"
+		"\t//\n"
+		"\t// Clock 2 - Multiply by the cubic coefficient\n"
+		"\t// {{{\n"
+		"\t//	1. Multiply to get the cubic component of our design\n"
+		"\t//		This is the first of three multiplies used by this\n"
+		"\t//		algorithm\n"
+		"\t//	2. Everything else is just copied to the next clock\n"
+		"\t//\n"
+		"\t//\n");
+
+		fprintf(fp, "\talways @(posedge i_clk)\n"
+		"\tif (i_ce)\n"
+			"\t\tkprod <= kv * kdx; // %d bits\n\n",
+				kbits+dxbits);
+
+		fprintf(fp,
+		"\tinitial	kq_1  = 0;\n"
+		"\tinitial	kl_1  = 0;\n"
+		"\tinitial	kc_1  = 0;\n"
+		"\tinitial	kdx_1 = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp,
+			"\tbegin\n"
+				"\t\tkq_1  <= 0;\n"
+				"\t\tkl_1  <= 0;\n"
+				"\t\tkc_1  <= 0;\n"
+				"\t\tkdx_1 <= 0;\n"
+			"\tend else ");
+		fprintf(fp,
+			"if (i_ce) begin\n"
+				"\t\tkq_1  <= kq;\n"
+				"\t\tkl_1  <= kl;\n"
+				"\t\tkc_1  <= kc;\n"
+				"\t\tkdx_1 <= kdx;\n"
+			"\tend\n\n");
+
+		fprintf(fp,
+		"\t// }}}\n"
+		"\t////////////////////////////////////////////////////////////////////////\n"
+		"\t//\n"
+		"\t// Clock 3 - Add the result to the quadratic component\n"
+		"\t// {{{\n"
+		"\t//	1. Select the number of bits we want from the output\n"
+		"\t//	2. Add our quadratic term to the result of the multiply\n"
+		"\t//	3. Copy the remaining values for the next clock\n"
+		"\t//\n"
+		"\t// From here on, this is the same as the quadratic interpolant.\n"
+		"\t//\n");
+
+		if (qbits-kbits-1>0) {
+			fprintf(fp,
+		"\tassign	w_kprod[(QBITS-1):(KBITS+1)] = { (%d){kprod[(KBITS+DXBITS-1)]} };\n",
+				qbits-kbits-1);
+		}
+		fprintf(fp,
+		"\tassign\tw_kprod[KBITS:0] // %d\n"
+			"\t\t\t= kprod[(KBITS+DXBITS-1):(DXBITS-1)]; // [%d:%d]\n\n",
+			kbits+1, kbits+dxbits-1, dxbits-1);
+
+		fprintf(fp,
+			"\tinitial\tqv = 0;\n"
+			"\tinitial\tlv = 0;\n"
+			"\tinitial\tcv = 0;\n"
+			"\tinitial\tdx = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp,
+			"\tbegin\n"
+				"\t\tqv <= 0;\n"
+				"\t\tlv <= 0;\n"
+				"\t\tcv <= 0;\n"
+				"\t\tdx <= 0;\n"
+			"\tend else ");
+		fprintf(fp,
+			"if (i_ce) begin\n"
+				"\t\tqv <= w_kprod + kq_1; // %d bits\n"
+				"\t\tlv <= kl_1;\n"
+				"\t\tcv <= kc_1;\n"
+				"\t\tdx <= kdx_1;\n"
+			"\tend\n\n", qbits);
+		// }}}
+	} else {
+		// {{{
+		fprintf(fp,
+		"\t////////////////////////////////////////////////////////////////////////\n"
+		"\t//\n"
+		"\t// Clock 1 - Table coefficient lookups\n"
+		"\t// {{{\n"
+		"\t//	1. Operate on the incoming bits--this is the only stage\n"
+		"\t//	   that does so\n"
+		"\t//	2. Read our coefficients from the table\n"
+		"\t//	3. Store dx, the difference between the table value and the\n"
+		"\t//		actually requested phase, for later processing\n"
+		"\t//\n"
+		"\t//\n");
+
+		if (!NO_QUADRATIC_COMPONENT)
+			fprintf(fp, "\tinitial\tqv = 0;\n");
+		fprintf(fp,
+			"\tinitial\tlv = 0;\n"
+			"\tinitial\tcv = 0;\n"
+			"\tinitial\tdx = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset) {
+			fprintf(fp, "\tbegin\n");
+			if (!NO_QUADRATIC_COMPONENT)
+				fprintf(fp, "\t\tqv <= 0;\n");
+			else
+				fprintf(fp, "\t\t// No quadratic coefficient\n");
+			fprintf(fp,
+				"\t\tlv <= 0;\n"
+				"\t\tcv <= 0;\n"
+				"\t\tdx <= 0;\n"
+				"\tend else ");
+		}
+
+		fprintf(fp,
+		"if (i_ce)\n"
+		"\tbegin\n");
+		if (!NO_QUADRATIC_COMPONENT)
+			fprintf(fp,"\t\tqv <= qtbl[%s[(PW-1):(DXBITS-1)]];\n",
+				phase);
+		else
+			fprintf(fp,"\t\t// This build has no quadratic component\n");
+		fprintf(fp,
+		"\t\tlv <= ltbl[%s[(PW-1):(DXBITS-1)]];\n"
+		"\t\tcv <= ctbl[%s[(PW-1):(DXBITS-1)]];\n"
+		"\t\tdx <= { 1'b0, %s[(DXBITS-2):0] };	// * 2^(-PW)\n"
+		"\tend\n\n", phase, phase, phase);
+
+		fprintf(fp,
+		"\t//\n"
+		"\t// Here's our formula:\n"
+		"\t//\n");
+		if (NO_QUADRATIC_COMPONENT)
+			fprintf(fp, "\t//	 Out = (     L)*DX+C\n");
+		else
+			fprintf(fp, "\t//	 Out = (Q*DX+L)*DX+C\n");
+		fprintf(fp,
+		"\t//\n"
+		"\t// A basic %s interpolant.  All of the smarts are found within\n"
+		"\t// the %sL, and C values.\n\n",
+			(NO_QUADRATIC_COMPONENT) ? "linear":"quadratic",
+			(NO_QUADRATIC_COMPONENT) ? "":"Q, ");
+		// }}}
+	}
 
 	if (!NO_QUADRATIC_COMPONENT) {
 	fprintf(fp,
 	"\t// }}}\n"
 	"\t////////////////////////////////////////////////////////////////////////\n"
 	"\t//\n"
-	"\t// Clock 2 - Multiply by the quadratic coefficient\n"
+	"\t// Clock %d - Multiply by the quadratic coefficient\n"
 	"\t// {{{\n"
 	"\t//	1. Multiply to get the quadratic component of our design\n"
-	"\t//		This is the first of two multiplies used by this\n"
+	"\t//		This is the %s of %s multiplies used by this\n"
 	"\t//		algorithm\n"
 	"\t//	2. Everything else is just copied to the next clock\n"
 	"\t//\n"
-	"\t//\n");
+	"\t//\n", 2+koff, (cubic) ? "second" : "first",
+		(cubic) ? "three" : "two");
 
 		fprintf(fp, "\talways @(posedge i_clk)\n"
 		"\tif (i_ce)\n"
@@ -575,13 +1288,13 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t// }}}\n"
 		"\t////////////////////////////////////////////////////////////////////////\n"
 		"\t//\n"
-		"\t// Clock 3 - Add the result to the linear component\n"
+		"\t// Clock %d - Add the result to the linear component\n"
 		"\t// {{{\n"
 		"\t//	1. Select the number of bits we want from the output\n"
 		"\t//	2. Add our linear term to the result of the multiply\n"
 		"\t//	3. Copy the remaining values for the next clock\n"
 		"\t//\n"
-		"\t//\n");
+		"\t//\n", 3+koff);
 
 		if (lbits-qbits-1>0) {
 			fprintf(fp,
@@ -630,9 +1343,10 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	"\t//	2. Copy the constant coefficient value to the next clock\n"
 	"\t//\n"
 	"\t//\n",
-		(NO_QUADRATIC_COMPONENT) ? 2 : 4,
+		((NO_QUADRATIC_COMPONENT) ? 2 : 4) + koff,
 		(NO_QUADRATIC_COMPONENT) ? "":" - Last multiply, w/ the linear coefficient",
-		(NO_QUADRATIC_COMPONENT) ? "only" : "second and final");
+		(NO_QUADRATIC_COMPONENT) ? "only"
+			: (cubic) ? "third and final" : "second and final");
 
 	fprintf(fp,
 	"\tinitial\tlprod = 0;\n"
@@ -668,7 +1382,7 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	"\t//	   multiplication.  This will be the output of our algorithm\n"
 	"\t//	2. There's nothing left to copy\n"
 	"\t//\n"
-	"\t//\n", NO_QUADRATIC_COMPONENT ? 3: 5);
+	"\t//\n", (NO_QUADRATIC_COMPONENT ? 3: 5) + koff);
 
 //
 // TBLSZ	LBITS
@@ -707,7 +1421,7 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	"\t//	   nearest value.  This also involves dropping the extra bits\n"
 	"\t//	   we've been carrying around since the last multiply.\n"
 	"\t//\n"
-	"\t//\n\n", NO_QUADRATIC_COMPONENT ? 4: 6);
+	"\t//\n\n", (NO_QUADRATIC_COMPONENT ? 4: 6) + koff);
 
 	fprintf(fp,
 	"\t// Since we won't be using all of the bits in w_value, we'll just\n"
@@ -732,16 +1446,16 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	"\t//\n"
 	"\t// Calculate the final result\n"
 	"\t// {{{\n"
-	"\tinitial	o_sin = 0;\n");
+	"\tinitial	%s = 0;\n", osin);
 
 	fprintf(fp, "%s", always_reset.c_str());
 	if (with_reset)
-		fprintf(fp, "\t\to_sin <= 0;\n\telse ");
+		fprintf(fp, "\t\t%s <= 0;\n\telse ", osin);
 
 	fprintf(fp,
 		"if (i_ce)\n"
-			"\t\to_sin <= w_value[(WW-1):XTRA]; // [%d:%d]\n\t// }}}\n\n",
-			ww, nxtra);
+			"\t\t%s <= w_value[(WW-1):XTRA]; // [%d:%d]\n\t// }}}\n\n",
+			osin, ww, nxtra);
 	// }}}
 
 	// Make Verilator happy
@@ -758,6 +1472,10 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	if (NO_QUADRATIC_COMPONENT) {
 		fprintf(fp,
 			"\t\t\t{ (DXBITS){1\'b0} }};\n");
+	} else if (cubic) {
+		fprintf(fp,
+			"\t\t\tqprod[(DXBITS-1):0],\n"
+			"\t\t\tkprod[(DXBITS-1):0] };\n");
 	} else {
 		fprintf(fp,
 			"\t\t\tqprod[(DXBITS-1):0] };\n");
@@ -766,6 +1484,17 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	fprintf(fp, "\t// verilator lint_on  UNUSED\n"
 			"\t// }}}\n\n");
 	// }}}
+
+	if (dual) {
+		// {{{
+		fprintf(fp,
+	"\tassign\tw_result[(gk*OW) +: OW] = r_out;\n"
+	"\t// }}}\n"
+	"\tend endgenerate\n\n"
+	"\tassign\t{ o_cos, o_sin } = w_result;\n"
+	"\t// }}}\n");
+		// }}}
+	}
 	fprintf(fp, "endmodule\n");
 
 	if (NULL != fhp) {
@@ -785,10 +1514,27 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		fprintf(fhp, "const\tint\tOW         = %d; // bits\n", ow);
 		fprintf(fhp, "const\tint\tNEXTRA     = %d; // bits\n", nxtra);
 		fprintf(fhp, "const\tint\tPW         = %d; // bits\n", phase_bits);
+		fprintf(fhp, "const\tint\tORDER      = %d; // Interpolation order\n", order);
+		fprintf(fhp, "const\tint\tLATENCY    = %d; // clocks",
+			((NO_QUADRATIC_COMPONENT) ? 4:6) + koff);
+		if (cubic)
+			fprintf(fhp, ", %d of them for the cubic term", koff);
+		fprintf(fhp, "\n");
 		fprintf(fhp, "const\tlong\tTBL_LGSZ  = %d; // (Units)\n",lgtbl);
 		fprintf(fhp, "const\tlong\tTBL_SZ    = %ld; // (Units)\n",(1l<<lgtbl));
+		// The widths of the (signed) coefficient tables, so a bench
+		// can model the core from its hex files
+		fprintf(fhp, "const\tint\tCBITS      = %d; // bits\n", cbits);
+		fprintf(fhp, "const\tint\tLBITS      = %d; // bits\n", lbits);
+		fprintf(fhp, "const\tint\tQBITS      = %d; // bits\n", qbits);
+		if (cubic)
+			fprintf(fhp, "const\tint\tKBITS      = %d; // bits\n", kbits);
+		fprintf(fhp, "const\tint\tNMULTS     = %d; // multiplies%s\n",
+			nmults, (dual) ? ", both channels" : "");
+		fprintf(fhp, "const\tint\tNDSPS      = %d; // 25x18 DSPs, est.\n",
+			ndsps);
 		fprintf(fhp, "const\tlong\tSCALE     = %ld; // (Units)\n",
-			max_integer(ow));
+			scale);
 		fprintf(fhp, "const\tdouble\tITBL_ERR  = %.2f; // (OW Units)\n",
 			tblerr);
 		fprintf(fhp, "const\tdouble\tTBL_ERR   = %.16f; // (sin Units)\n",
@@ -806,6 +1552,417 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
 			phase_variance(nstages, phase_bits));
 		*/
+		fprintf(fhp, "const\tbool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const\tbool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+		if (dual)
+			fprintf(fhp, "#define\tHAS_COS_OUTPUT\n");
+		fprintf(fhp, "#endif	// %s\n", str);
+
+		delete[] str;
+		// }}}
+	}
+
+	free(noext);
+
+	return ((NO_QUADRATIC_COMPONENT) ? 4:6) + koff;
+	// }}}
+}
+
+// write_lintbls
+// {{{
+// Scale the linear coefficients to integers, and write them out.  The value
+// table absorbs everything the logic would otherwise need to round: the
+// half step offset of the phase (dx is always taken from the start of its
+// step), the truncation of both tables and of the product, and the final
+// rounding of the result to OW bits.  Since every entry of the first
+// quarter wave is positive, both tables are unsigned.
+//
+// Truncating the value and the product each lose half an LSB on average.
+// Dropping the XTRA bits from an integer then acts like truncating a value
+// half an LSB above it, so the offset that rounds the result is half an LSB
+// short of the 1+2^(XTRA-1) one might expect.
+static	void	write_lintbls(const char *fname, QUADTBL_COEFFS *qt,
+		const int dxbits, const int nxtra) {
+	int	ln = (1<<qt->m_lgsz);
+	long	maxv = qt->m_maxv, *cv = new long[ln], *lv = new long[ln],
+		mxc = 0, mxl = 0;
+	double	hlfstep = pow(0.5, dxbits+1),
+		offset = 0.5 + (double)(1l<<(nxtra-1));
+	STRING	name;
+
+	for(int i=0; i<ln; i++) {
+		cv[i] = (long)(maxv * (qt->m_table[i]
+				+ qt->m_slope[i] * hlfstep) + offset);
+		lv[i] = (long)(maxv * qt->m_slope[i] + 0.5);
+		assert(cv[i] >= 0);
+		assert(lv[i] >= 0);
+		mxc = (mxc > cv[i]) ? mxc : cv[i];
+		mxl = (mxl > lv[i]) ? mxl : lv[i];
+	}
+
+	qt->m_cbits = 1;
+	while((mxc >> qt->m_cbits) != 0)
+		qt->m_cbits++;
+	qt->m_lbits = 1;
+	while((mxl >> qt->m_lbits) != 0)
+		qt->m_lbits++;
+
+	printf("MXERR = %f * %ld (0x%08lx)\n", qt->m_mxerr, maxv, maxv);
+	printf("MXERR = %f\n", qt->m_tblerr);
+	printf("MXVLS - TABLE:  %f -> 0x%lx\n", qt->m_mxtbl, mxc);
+	printf("MXVLS - SLOPE:  %f -> 0x%lx\n", qt->m_mxslope, mxl);
+	printf("%d WID := CBITS:LBITS = %d:%d\n", qt->m_wid,
+		qt->m_cbits, qt->m_lbits);
+
+	name = STRING(fname) + STRING("_ctbl");
+	hextable(name.c_str(), qt->m_lgsz, qt->m_cbits, cv);
+
+	name = STRING(fname) + STRING("_ltbl");
+	hextable(name.c_str(), qt->m_lgsz, qt->m_lbits, lv);
+
+	delete[] cv;
+	delete[] lv;
+}
+// }}}
+
+int	linqtr(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+		int phase_bits, int ow, int nxtra, bool with_reset,
+		bool with_aux, bool async_reset) {
+	// {{{
+	const	char	*name;
+	char	*noext;
+	int	lgtbl, cbits, lbits, dxbits, ww;
+	long	maxv;
+	double	tblerr;
+
+	assert(fp);
+	assert(fname);
+
+	if (nxtra < 2)
+		nxtra = 2;
+	ww = ow + nxtra;
+	if (phase_bits < MIN_LGTBL+3) {
+		fprintf(stderr, "ERR: The linearly interpolated table requires at least %d phase bits\n", MIN_LGTBL+3);
+		exit(EXIT_FAILURE);
+	} if (ww > MAX_HEXTABLE_OW) {
+		fprintf(stderr, "ERR: Requested table output width is greater than %d bits\n", MAX_HEXTABLE_OW);
+		exit(EXIT_FAILURE);
+	}
+
+	name = modulename(fname);
+	noext = strdup(fname);
+	{
+		char *ptr;
+		if (NULL != (ptr = strrchr(noext, '.')))
+			*ptr = '\0';
+	}
+
+	{
+		// Size the tables first, leaving at least one bit of dx.  The
+		// peak is one half of an output step below full scale, so
+		// that rounding it never overflows.
+		int	max_lg = phase_bits - 3;
+		QUADTBL_COEFFS	*qt;
+
+		if (max_lg > MAX_LGTBL)
+			max_lg = MAX_LGTBL;
+		maxv = ((1l<<(ow-1))-1l) << nxtra;
+		qt = size_quadtbls(ww, 1, maxv, max_lg);
+		lgtbl  = qt->m_lgsz;
+		dxbits = phase_bits - 2 - lgtbl;
+
+		write_lintbls(noext, qt, dxbits, nxtra);
+		cbits  = qt->m_cbits;
+		lbits  = qt->m_lbits;
+		tblerr = qt->m_tblerr;
+		free_quadtbls(qt);
+	}
+
+	printf("Rpt-Err: %f\n", tblerr);
+	const	char PURPOSE[] =
+	"This is a quarter-wave sine-wave table lookup, coupled with a\n"
+	"//\t\tlinear interpolation of the result.  The table holds a value\n"
+	"//\tand a slope for each step of the first quarter wave, and the\n"
+	"//\tphase bits below the table index select how far along that\n"
+	"//\tslope to go, using only one multiply.  This sits between the\n"
+	"//\tquarter-wave table and the quadratically interpolated table, in\n"
+	"//\tboth logic and accuracy.",
+		HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+
+	legal(fp, fname, PROJECT, PURPOSE, cmdline);
+
+	std::string	resetw = (!with_reset) ? ""
+			: (async_reset) ? "i_areset_n" : "i_reset";
+	std::string	always_reset;
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+			"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+			"\tif (i_reset)\n";
+	else
+		always_reset = "\talways @(posedge i_clk)\n\t";
+
+	// Module declaration
+	// {{{
+	fprintf(fp, "`default_nettype\tnone\n//\n");
+	fprintf(fp,
+		"module	%s #(\n"
+		"\t\t// {{{\n"
+		"\t\tlocalparam\tPW=%2d,\t// Bits in our phase variable\n"
+		"\t\t\t\tOW=%2d,  // The number of output bits to produce\n"
+		"\t\t\t\tXTRA=%2d // Extra bits for internal precision\n"
+		"\t\t// }}}\n"
+		"\t) (\n"
+		"\t\t// {{{\n"
+		"\t\tinput\twire\t\t\t\ti_clk, %s%si_ce,\n"
+		"\t\t//\n"
+		"\t\tinput\twire\t\t[(PW-1):0]\ti_phase,\n"
+		"\t\toutput\treg\tsigned\t[(OW-1):0]\to_val%s\n",
+		name, phase_bits, ow, nxtra,
+		resetw.c_str(), (with_reset)?", ":"",
+		(with_aux) ? ",":"");
+
+	if (with_aux)
+		fprintf(fp, "\t\t//\n"
+			"\t\tinput\twire\t\t\t\ti_aux,\n"
+			"\t\toutput\treg\t\t\t\to_aux\n");
+	fprintf(fp, "\t\t// }}}\n\t);\n\n");
+	// }}}
+
+	// Declarations
+	// {{{
+	fprintf(fp,
+		"\t// Declarations\n\t// {{{\n"
+		"\tlocalparam\tLGTBL   = %d,\n"
+		"\t\t\tDXBITS  = (PW-2-LGTBL),  // %d\n"
+		"\t\t\tTBLENTRIES = (1<<LGTBL), // %d\n"
+		"\t\t\tLBITS   = %d,\n"
+		"\t\t\tCBITS   = %d,\n"
+		"\t\t\tWW      = (OW+XTRA); // Working width\n\n",
+		lgtbl, dxbits, (1<<lgtbl), lbits, cbits);
+
+	fprintf(fp,
+	"\t// Coefficient tables, covering the first quarter wave only:\n"
+	"\t//\tConstant and Linear\n"
+	"\treg\t[(CBITS-1):0]\tctbl [0:(TBLENTRIES-1)];\n"
+	"\treg\t[(LBITS-1):0]\tltbl [0:(TBLENTRIES-1)];\n\n"
+	"\tinitial begin\n"
+	"\t\t$readmemh(\"%s_ctbl.hex\", ctbl);\n"
+	"\t\t$readmemh(\"%s_ltbl.hex\", ltbl);\n"
+	"\tend\n\n", name, name);
+
+	fprintf(fp,
+	"\treg\t\t[3:0]\t\t\tnegate;\n"
+	"\treg\t\t[(LGTBL-1):0]\t\tindex;\n"
+	"\treg\t\t[(DXBITS-1):0]\t\tdx, dx_1;\n"
+	"\treg\t\t[(CBITS-1):0]\t\tcv, cv_1;\n"
+	"\treg\t\t[(LBITS-1):0]\t\tlv;\n"
+	"\treg\t\t[(LBITS+DXBITS-1):0]\tlprod;\n"
+	"\treg\t\t[(WW-1):0]\t\tmag;\n"
+	"\twire\t\t[(OW-2):0]\t\tw_mag;\n");
+	if (with_aux)
+		fprintf(fp, "\treg\t\t[3:0]\t\t\taux;\n");
+	fprintf(fp, "\t// }}}\n\n");
+	// }}}
+
+	// Clock 1 - negate, index, dx
+	// {{{
+	fprintf(fp,
+	"\t////////////////////////////////////////////////////////////////////////\n"
+	"\t//\n"
+	"\t// Clock 1 - Quarter wave symmetry\n"
+	"\t// {{{\n"
+	"\t//	The top phase bit selects whether to negate the result, and\n"
+	"\t//	the next one whether to run backwards through the first\n"
+	"\t//	quarter wave.  The table entries are offset by half of a\n"
+	"\t//	phase step, so running backwards is just a bit inversion.\n"
+	"\t//	The negate flag then follows the data down the pipeline.\n"
+	"\t//\n"
+	"\tinitial\tnegate = 0;\n"
+	"\tinitial\tindex = 0;\n"
+	"\tinitial\tdx    = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\tnegate <= 0;\n"
+			"\t\t{ index, dx } <= 0;\n"
+			"\tend else ");
+	fprintf(fp,
+	"if (i_ce)\n"
+	"\tbegin\n"
+	"\t\tnegate <= { negate[2:0], i_phase[(PW-1)] };\n"
+	"\t\tif (i_phase[(PW-2)])\n"
+	"\t\t\t{ index, dx } <= ~i_phase[(PW-3):0];\n"
+	"\t\telse\n"
+	"\t\t\t{ index, dx } <=  i_phase[(PW-3):0];\n"
+	"\tend\n\t// }}}\n");
+	// }}}
+
+	// Clock 2 - Table lookup
+	// {{{
+	fprintf(fp,
+	"\t////////////////////////////////////////////////////////////////////////\n"
+	"\t//\n"
+	"\t// Clock 2 - Table coefficient lookups\n"
+	"\t// {{{\n"
+	"\t//\n"
+	"\t// Here's our formula:\n"
+	"\t//\n"
+	"\t//	 Out = L*DX+C\n"
+	"\t//\n"
+	"\t// A basic linear interpolant.  All of the smarts are found within\n"
+	"\t// the L and C values.\n"
+	"\t//\n"
+	"\talways @(posedge i_clk)\n"
+	"\tif (i_ce)\n"
+	"\tbegin\n"
+	"\t\tcv <= ctbl[index];\n"
+	"\t\tlv <= ltbl[index];\n"
+	"\tend\n\n"
+	"\tinitial\tdx_1 = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tdx_1 <= 0;\n\telse ");
+	fprintf(fp,
+	"if (i_ce)\n"
+	"\t\tdx_1 <= dx;\n"
+	"\t// }}}\n");
+	// }}}
+
+	// Clock 3 - Multiply
+	// {{{
+	fprintf(fp,
+	"\t////////////////////////////////////////////////////////////////////////\n"
+	"\t//\n"
+	"\t// Clock 3 - Our only multiply\n"
+	"\t// {{{\n"
+	"\t//\n"
+	"\talways @(posedge i_clk)\n"
+	"\tif (i_ce)\n"
+	"\t\tlprod <= lv * dx_1; // %d bits\n\n"
+	"\tinitial\tcv_1 = 0;\n", lbits+dxbits);
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tcv_1 <= 0;\n\telse ");
+	fprintf(fp,
+	"if (i_ce)\n"
+	"\t\tcv_1 <= cv;\n"
+	"\t// }}}\n");
+	// }}}
+
+	// Clock 4 - Add in the constant
+	// {{{
+	fprintf(fp,
+	"\t////////////////////////////////////////////////////////////////////////\n"
+	"\t//\n"
+	"\t// Clock 4 - Add in the constant\n"
+	"\t// {{{\n"
+	"\t//	The constant already includes the rounding, so the magnitude\n"
+	"\t//	only needs to be truncated to produce our output.\n"
+	"\t//\n"
+	"\tinitial\tmag = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\tmag <= 0;\n\telse ");
+	fprintf(fp,
+	"if (i_ce)\n"
+	"\t\tmag <= cv_1 + lprod[(LBITS+DXBITS-1):DXBITS];\n"
+	"\t// }}}\n");
+	// }}}
+
+	// Clock 5 - Output
+	// {{{
+	fprintf(fp,
+	"\t////////////////////////////////////////////////////////////////////////\n"
+	"\t//\n"
+	"\t// Clock 5 - Negate the output, if required\n"
+	"\t// {{{\n"
+	"\t//	Should the magnitude ever overflow, saturate it instead.\n"
+	"\t//\n"
+	"\tassign\tw_mag = (mag[WW-1]) ? {(OW-1){1\'b1}} : mag[(WW-2):XTRA];\n\n"
+	"\tinitial\to_val = 0;\n");
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset)
+		fprintf(fp, "\t\to_val <= 0;\n\telse ");
+	fprintf(fp,
+	"if (i_ce)\n"
+	"\tbegin\n"
+	"\t\tif (negate[3])\n"
+	"\t\t\to_val <= -{ 1\'b0, w_mag };\n"
+	"\t\telse\n"
+	"\t\t\to_val <=  { 1\'b0, w_mag };\n"
+	"\tend\n\t// }}}\n\n");
+	// }}}
+
+	if (with_aux) {
+		// {{{
+		fprintf(fp, "\t// aux, o_aux\n\t// {{{\n"
+			"\tinitial\t{ o_aux, aux } = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if(with_reset)
+			fprintf(fp, "\t\t{ o_aux, aux } <= 0;\n"
+				"\telse ");
+		fprintf(fp, "if (i_ce)\n\t\t{ o_aux, aux } <= { aux, i_aux };\n");
+		fprintf(fp, "\t// }}}\n\n");
+		// }}}
+	}
+
+	// Make Verilator happy
+	// {{{
+	fprintf(fp,
+	"\t// Make verilator happy\n"
+	"\t// {{{\n"
+	"\t// verilator lint_off UNUSED\n"
+	"\twire	 unused;\n"
+	"\tassign	unused = &{ 1\'b0, lprod[(DXBITS-1):0],\n"
+			"\t\t\tmag[(XTRA-1):0] };\n"
+	"\t// verilator lint_on  UNUSED\n"
+	"\t// }}}\n");
+	// }}}
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp) {
+		// {{{
+		char	*str = new char[strlen(name)+4], *ptr;
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef	%s\n", str);
+		fprintf(fhp, "#define	%s\n", str);
+		fprintf(fhp, "const\tint\tOW         = %d; // bits\n", ow);
+		fprintf(fhp, "const\tint\tNEXTRA     = %d; // bits\n", nxtra);
+		fprintf(fhp, "const\tint\tPW         = %d; // bits\n", phase_bits);
+		fprintf(fhp, "const\tint\tLATENCY    = 5; // clocks\n");
+		fprintf(fhp, "const\tlong\tTBL_LGSZ  = %d; // (Units)\n",lgtbl);
+		fprintf(fhp, "const\tlong\tTBL_SZ    = %ld; // (Units, 1/4 wave)\n",
+			(1l<<lgtbl));
+		fprintf(fhp, "const\tlong\tSCALE     = %ld; // (Units)\n",
+			(1l<<(ow-1))-1l);
+		fprintf(fhp, "const\tdouble\tITBL_ERR  = %.2f; // (WW Units)\n",
+			tblerr);
+		fprintf(fhp, "const\tdouble\tTBL_ERR   = %.16f; // (sin Units)\n",
+			tblerr * pow(0.5,ww-1));
+
+		double	spur;
+		spur = pow(sinc(1.0-(1./(4<<lgtbl))),2.);
+		spur = 20.*log(spur)/log(10.0);
+		fprintf(fhp, "const\tdouble\tSPURDB    = %6.2f; // dB\n", spur);
+
 		fprintf(fhp, "const\tbool\tHAS_RESET = %s;\n", with_reset?"true":"false");
 		fprintf(fhp, "const\tbool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
 		if (with_reset)
@@ -819,5 +1976,8 @@ void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	}
 
 	free(noext);
+
+	return 5;
 	// }}}
 }
+// }}}
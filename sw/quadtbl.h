@@ -43,7 +43,16 @@ extern	double	sinc(double v);
 extern	void	build_quadtbls(const char *fname,
 		const int lgsz, const int wid,
 		int &cbits, int &lbits, int &qbits, double &tblerr);
-extern	void	quadtbl(FILE *fp, FILE *fhp, const char *cmdline,
+// Returns the number of clocks from i_ce to o_sin.  The order of the
+// interpolation may be either 2 (quadratic) or 3 (cubic).  With dual set,
+// the core also produces o_cos, from the same tables.
+extern	int	quadtbl(FILE *fp, FILE *fhp, const char *cmdline,
+		const char *fname, int phase_bits, int ow, int nxtra,
+		int order, bool dual, bool with_reset, bool with_aux,
+		bool async_reset);
+// A linear interpolation across a quarter wave table.  Returns the number
+// of clocks from i_ce to o_val
+extern	int	linqtr(FILE *fp, FILE *fhp, const char *cmdline,
 		const char *fname, int phase_bits, int ow, int nxtra,
 		bool with_reset, bool with_aux, bool async_reset);
 
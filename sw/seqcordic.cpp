@@ -53,9 +53,10 @@
 void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		int nstages, int iw, int ow, int nxtra,
 		int phase_bits,
-		bool with_reset, bool with_aux, bool async_reset) {
+		bool with_reset, bool with_aux, bool async_reset,
+		int iters, bool unit_gain) {
 // {{{
-	int	working_width = iw;
+	int	working_width = iw, nactive, niter = nstages, lgbase = 0;
 	const	char *name;
 	const	char PURPOSE[] =
 	"This file executes a vector rotation on the values\n"
@@ -78,6 +79,19 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		working_width = ow;
 	working_width += nxtra;
 
+	// With more than one stage per clock, we only need enough clocks
+	// to cover the useful stages.  base then steps from zero to
+	// niter*iters, iters at a time.
+	if (iters < 1)
+		iters = 1;
+	nactive = active_stages(nstages, working_width, phase_bits);
+	if (iters > 1) {
+		niter = (nactive + iters - 1) / iters;
+		if (niter < 1)
+			niter = 1;
+		lgbase = nextlg((unsigned)(niter * iters + 1));
+	}
+
 	std::string	resetw = (!with_reset)?""
 			: ((async_reset)?"i_areset_n" : "i_reset");
 	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
@@ -99,13 +113,14 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t// so they can\'t really be changed here.\n"
 		"\t\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
 		"\t\t\t\tOW=%2d,\t// The number of output bits to produce\n"
-		"\t\t\t\t// NSTAGES=%2d,\n"
+		"\t\t\t\t%sNSTAGES=%2d,\n"
 		"\t\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
 		"\t\t\t\tWW=%2d,\t// Our working bit-width\n"
 		"\t\t\t\tPW=%2d\t// Bits in our phase variables\n"
 		"\t\t// }}}\n",
 		name,
-		iw, ow, nstages, nxtra, working_width, phase_bits);
+		iw, ow, (iters > 1) ? "" : "// ", nstages, nxtra,
+		working_width, phase_bits);
 	fprintf(fp,
 		"\t) (\n"
 		"\t\t// {{{\n"
@@ -153,8 +168,12 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\treg	signed	[(WW-1):0]	xv, prex, yv, prey;\n"
 		"\treg		[(PW-1):0]	ph, preph;\n");
 	fprintf(fp, "\treg\t\t\t\tidle, pre_valid;\n");
-	fprintf(fp, "\treg\t\t[%d:0]\t\tstate;\n\n",
-		nextlg((unsigned)nstages)-1);
+	if (iters > 1)
+		fprintf(fp, "\treg\t\t[%d:0]\t\tbase;\n"
+			"\twire\t\t\t\tlast_state;\n\n", lgbase-1);
+	else
+		fprintf(fp, "\treg\t\t[%d:0]\t\tstate;\n\n",
+			nextlg((unsigned)nstages)-1);
 
 	if (with_aux)
 		fprintf(fp, "\treg\t\t\t\taux;\n");
@@ -282,88 +301,199 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\tendcase\n"
 		"\t// }}}\n\n");
 
-	cordic_angles(fp, nstages, phase_bits, true);
-
-	fprintf(fp, "\n\t// idle\n\t// {{{\n"
-		"\tinitial\tidle = 1\'b1;\n");
-	fprintf(fp, "%s", always_reset.c_str());
-	if (with_reset)
-		fprintf(fp, "\t\tidle <= 1\'b1;\n");
-	fprintf(fp, "\telse if (i_stb)\n"
-			"\t\tidle <= 1\'b0;\n"
-			"\telse if (state == %d)\n"
-			"\t\tidle <= 1\'b1;\n",
-			nstages-1);
-	fprintf(fp, "\t// }}}\n\n");
-
-	fprintf(fp, "\t// pre_valid\n\t// {{{\n");
-	fprintf(fp, "\tinitial\tpre_valid = 1\'b0;\n");
-	fprintf(fp, "%s", always_reset.c_str());
-	if (with_reset)
-		fprintf(fp, "\t\tpre_valid <= 1\'b0;\n");
-	fprintf(fp, "\telse\n\t\tpre_valid <= (i_stb)&&(idle);\n\t// }}}\n\n");
-
-	fprintf(fp, "\t// cangle - CORDIC angle table lookup\n"
-		"\t// {{{\n"
-		"\talways @(posedge i_clk)\n"
-			"\t\tcangle <= cordic_angle[state];\n"
-		"\t// }}}\n\n");
+	if (iters > 1) {
+		// {{{
+		cordic_angles(fp, nstages, phase_bits);
+
+		fprintf(fp, "\n\tassign\tlast_state = (!idle)&&(base == %d\'d%d);\n",
+			lgbase, niter * iters);
+
+		fprintf(fp, "\n\t// idle\n\t// {{{\n"
+			"\tinitial\tidle = 1\'b1;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tidle <= 1\'b1;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if ((i_stb)&&(idle))\n"
+				"\t\tidle <= 1\'b0;\n"
+				"\telse if (last_state)\n"
+				"\t\tidle <= 1\'b1;\n");
+		fprintf(fp, "\t// }}}\n\n");
+
+		fprintf(fp, "\t// pre_valid\n\t// {{{\n");
+		fprintf(fp, "\tinitial\tpre_valid = 1\'b0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tpre_valid <= 1\'b0;\n");
+		fprintf(fp, "\telse\n\t\tpre_valid <= (i_stb)&&(idle);\n\t// }}}\n\n");
+
+		fprintf(fp, "\t// base -- the first stage applied on this clock\n"
+			"\t// {{{\n\tinitial\tbase = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tbase <= 0;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if ((idle)||(pre_valid))\n"
+				"\t\tbase <= 0;\n"
+				"\telse if (!last_state)\n"
+				"\t\tbase <= base + %d\'d%d;\n\t// }}}\n\n",
+				lgbase, iters);
+
+		unrolled_rotations(fp, nactive, iters, lgbase, false);
 
-	fprintf(fp, "\t// state\n\t// {{{\n\tinitial\tstate = 0;\n");
-	fprintf(fp, "%s", always_reset.c_str());
-	if (with_reset)
 		fprintf(fp,
-				"\t\tstate <= 0;\n\telse ");
-	else
-		fprintf(fp, "\t");
-	fprintf(fp, "if (idle)\n"
-			"\t\tstate <= 0;\n"
-			"\telse if (state == %d)\n"
-			"\t\tstate <= 0;\n"
-			"\telse\n"
-			"\t\tstate <= state + 1;\n\t// }}}\n\n", nstages-1);
+			"\t// CORDIC rotations\n"
+			"\t// {{{\n"
+			"\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t// we\'ve been studying and discussing.  Everything up to\n"
+			"\t// this point has simply been necessary preliminaries.\n");
+		fprintf(fp, "\talways @(posedge i_clk)\n"
+			"\tif (pre_valid)\n"
+			"\tbegin\n"
+				"\t\t// {{{\n"
+				"\t\txv <= prex;\n"
+				"\t\tyv <= prey;\n"
+				"\t\tph <= preph;\n"
+				"\t\t// }}}\n"
+			"\tend else begin\n"
+				"\t\t// {{{\n"
+				"\t\txv <= kx[%d];\n"
+				"\t\tyv <= ky[%d];\n"
+				"\t\tph <= kph[%d];\n"
+				"\t\t// }}}\n"
+			"\tend\n\t// }}}\n", iters, iters, iters);
+		// }}}
+	} else {
+		// {{{
+		cordic_angles(fp, nstages, phase_bits, true);
 
-	fprintf(fp,
-		"\t// CORDIC rotations\n"
-		"\t// {{{\n"
-		"\t// Here\'s where we are going to put the actual CORDIC\n"
-		"\t// we\'ve been studying and discussing.  Everything up to\n"
-		"\t// this point has simply been necessary preliminaries.\n");
-	fprintf(fp, "\talways @(posedge i_clk)\n"
-		"\tif (pre_valid)\n"
-		"\tbegin\n"
-			"\t\t// {{{\n"
-			"\t\txv <= prex;\n"
-			"\t\tyv <= prey;\n"
-			"\t\tph <= preph;\n"
-			"\t\t// }}}\n"
-		"\tend else if (ph[PW-1])\n"
-		"\tbegin\n"
-			"\t\t// {{{\n"
-			"\t\txv <= xv + (yv >>> state);\n"
-			"\t\tyv <= yv - (xv >>> state);\n"
-			"\t\tph <= ph + (cangle);\n"
-			"\t\t// }}}\n"
-		"\tend else begin\n"
-			"\t\t// {{{\n"
-			"\t\txv <= xv - (yv >>> state);\n"
-			"\t\tyv <= yv + (xv >>> state);\n"
-			"\t\tph <= ph - (cangle);\n"
-			"\t\t// }}}\n"
-		"\tend\n\t// }}}\n");
+		fprintf(fp, "\n\t// idle\n\t// {{{\n"
+			"\tinitial\tidle = 1\'b1;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tidle <= 1\'b1;\n");
+		fprintf(fp, "\telse if (i_stb)\n"
+				"\t\tidle <= 1\'b0;\n"
+				"\telse if (state == %d)\n"
+				"\t\tidle <= 1\'b1;\n",
+				nstages-1);
+		fprintf(fp, "\t// }}}\n\n");
+
+		fprintf(fp, "\t// pre_valid\n\t// {{{\n");
+		fprintf(fp, "\tinitial\tpre_valid = 1\'b0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tpre_valid <= 1\'b0;\n");
+		fprintf(fp, "\telse\n\t\tpre_valid <= (i_stb)&&(idle);\n\t// }}}\n\n");
+
+		fprintf(fp, "\t// cangle - CORDIC angle table lookup\n"
+			"\t// {{{\n"
+			"\talways @(posedge i_clk)\n"
+				"\t\tcangle <= cordic_angle[state];\n"
+			"\t// }}}\n\n");
+
+		fprintf(fp, "\t// state\n\t// {{{\n\tinitial\tstate = 0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp,
+					"\t\tstate <= 0;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if (idle)\n"
+				"\t\tstate <= 0;\n"
+				"\telse if (state == %d)\n"
+				"\t\tstate <= 0;\n"
+				"\telse\n"
+				"\t\tstate <= state + 1;\n\t// }}}\n\n", nstages-1);
+
+		fprintf(fp,
+			"\t// CORDIC rotations\n"
+			"\t// {{{\n"
+			"\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t// we\'ve been studying and discussing.  Everything up to\n"
+			"\t// this point has simply been necessary preliminaries.\n");
+		fprintf(fp, "\talways @(posedge i_clk)\n"
+			"\tif (pre_valid)\n"
+			"\tbegin\n"
+				"\t\t// {{{\n"
+				"\t\txv <= prex;\n"
+				"\t\tyv <= prey;\n"
+				"\t\tph <= preph;\n"
+				"\t\t// }}}\n"
+			"\tend else if (ph[PW-1])\n"
+			"\tbegin\n"
+				"\t\t// {{{\n"
+				"\t\txv <= xv + (yv >>> state);\n"
+				"\t\tyv <= yv - (xv >>> state);\n"
+				"\t\tph <= ph + (cangle);\n"
+				"\t\t// }}}\n"
+			"\tend else begin\n"
+				"\t\t// {{{\n"
+				"\t\txv <= xv - (yv >>> state);\n"
+				"\t\tyv <= yv + (xv >>> state);\n"
+				"\t\tph <= ph - (cangle);\n"
+				"\t\t// }}}\n"
+			"\tend\n\t// }}}\n");
+		// }}}
+	}
+
+	// The result is ready on the clock where done is true, and taken from
+	// xv, yv, and aux.  Gain compensation delays it all by one clock.
+	std::string	done, xsrc = "xv", ysrc = "yv", asrc = "aux";
+	if (iters > 1)
+		done = "last_state";
+	else {
+		char	buf[32];
+		sprintf(buf, "state >= %d", nstages-1);
+		done = buf;
+	}
+
+	if (unit_gain) {
+		// {{{
+		const	char	*src[2] = { "xv", "yv" },
+				*dst[2] = { "gxv", "gyv" };
+
+		fprintf(fp, "\n");
+		gain_compensation(fp, working_width,
+			cordic_gain(nstages), 2, src, dst, done.c_str());
+
+		fprintf(fp, "\t// gain_stb%s\n\t// {{{\n"
+			"\treg\tgain_stb;\n\n"
+			"\tinitial\tgain_stb = 1\'b0;\n",
+			(with_aux) ? ", gaux" : "");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tgain_stb <= 1\'b0;\n\telse\n");
+		fprintf(fp, "\t\tgain_stb <= (%s);\n", done.c_str());
+		if (with_aux)
+			fprintf(fp, "\n\treg\tgaux;\n\n"
+				"\talways @(posedge i_clk)\n"
+				"\tif (%s)\n"
+				"\t\tgaux <= aux;\n", done.c_str());
+		fprintf(fp, "\t// }}}\n");
+
+		done = "gain_stb";
+		xsrc = dst[0];
+		ysrc = dst[1];
+		asrc = "gaux";
+		// }}}
+	}
 
 	if (working_width > ow+1) {
 		fprintf(fp,
 			"\n\t// Round our result towards even\n"
 			"\t// {{{\n"
 			"\twire\t[(WW-1):0]\tfinal_xv, final_yv;\n\n"
-			"\tassign\tfinal_xv = xv + $signed({{(OW){1\'b0}},\n"
-				"\t\t\t\txv[(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!xv[WW-OW]}} });\n"
-			"\tassign\tfinal_yv = yv + $signed({{(OW){1\'b0}},\n"
-				"\t\t\t\tyv[(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!yv[WW-OW]}} });\n"
-			"\t// }}}\n");
+			"\tassign\tfinal_xv = %s + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n"
+			"\tassign\tfinal_yv = %s + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n"
+			"\t// }}}\n", xsrc.c_str(), xsrc.c_str(), xsrc.c_str(),
+			ysrc.c_str(), ysrc.c_str(), ysrc.c_str());
 
 		fprintf(fp, "\t// o_done\n\t// {{{\n"
 			"\tinitial\to_done = 1\'b0;\n");
@@ -372,21 +502,22 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		if (with_reset)
 			fprintf(fp, "\t\to_done <= 1\'b0;\n"
 				"\telse\n");
-		fprintf(fp, "\t\to_done <= (state >= %d);\n\t// }}}\n\n",
-			nstages-1);
+		fprintf(fp, "\t\to_done <= %s%s%s;\n\t// }}}\n\n",
+			(iters > 1) ? "" : "(", done.c_str(),
+			(iters > 1) ? "" : ")");
 
 		fprintf(fp, "\t// Output assignments: o_xval, o_yval%s\n"
 			"\t// {{{\n", (with_aux) ? ", o_aux":"");
 		if (with_aux)
 			fprintf(fp, "\tinitial\to_aux = 0;\n");
 		fprintf(fp, "\talways @(posedge i_clk)\n"
-			"\tif (state >= %d)\n"
-			"\tbegin\n"
+			"\tif (%s)\n", done.c_str());
+		fprintf(fp, "\tbegin\n"
 			"\t\to_xval <= final_xv[WW-1:WW-OW];\n"
-			"\t\to_yval <= final_yv[WW-1:WW-OW];\n", nstages-1);
+			"\t\to_yval <= final_yv[WW-1:WW-OW];\n");
 		if (with_aux)
 			fprintf(fp,
-			"\t\to_aux <= aux;\n");
+			"\t\to_aux <= %s;\n", asrc.c_str());
 		fprintf(fp, "\tend\n"
 			"\t// }}}\n\n");
 
@@ -410,14 +541,18 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		fprintf(fp,
 			"if (i_ce)\n"
 			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
-			"\t\to_xval <= xv[(WW-1):(WW-OW)];\n"
-			"\t\to_yval <= yv[(WW-1):(WW-OW)];\n");
+			"\t\to_xval <= %s[(WW-1):(WW-OW)];\n"
+			"\t\to_yval <= %s[(WW-1):(WW-OW)];\n",
+			xsrc.c_str(), ysrc.c_str());
 		if (with_aux)
-			fprintf(fp, "\t\to_aux  <= aux;\n");
+			fprintf(fp, "\t\to_aux  <= %s;\n", asrc.c_str());
 		fprintf(fp, "\tend\n\t// }}}\n\n");
 	}
 
-	fprintf(fp, "\tassign\to_busy = !idle;\n\n");
+	if (unit_gain)
+		fprintf(fp, "\tassign\to_busy = (!idle)||(gain_stb);\n\n");
+	else
+		fprintf(fp, "\tassign\to_busy = !idle;\n\n");
 
 	if (working_width > ow+1) {
 		// {{{
@@ -456,39 +591,47 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		fprintf(fhp, "#ifdef\tCLOCKS_PER_OUTPUT\n");
 		fprintf(fhp, "#undef\tCLOCKS_PER_OUTPUT\n");
 		fprintf(fhp, "#endif\t// CLOCKS_PER_OUTPUT\n");
-		fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n\n", nstages+1);
+		fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n\n",
+			((iters > 1) ? niter+3 : nstages+1)
+				+ ((unit_gain) ? 1:0));
 
+		fprintf(fhp, "const int	NLANES = 1;\n");
 		fprintf(fhp, "const int	IW = %d;\n", iw);
 		fprintf(fhp, "const int	OW = %d;\n", ow);
 		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
 		fprintf(fhp, "const int	WW = %d;\n", working_width);
 		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
 		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
-		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
-			transform_quantization_variance(nstages,
-				working_width-iw,
-				working_width-ow));
-		fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
-			phase_variance(nstages, phase_bits));
-		fprintf(fhp, "const double	GAIN = %.16f;\n",
-			cordic_gain(nstages));
-		{
-			double	amplitude = (1ul<<(iw-1))-1.,
-				signal_energy, noise_energy;
-			amplitude *= (1ul<<((working_width-iw)));
-			amplitude *= cordic_gain(nstages);
-			amplitude *= pow(2.0,-(working_width-ow));
-			signal_energy = amplitude * amplitude;
-
-			noise_energy = transform_quantization_variance(nstages,
-				working_width-iw, working_width-ow);
-
-			noise_energy += signal_energy * phase_variance(nstages, phase_bits)
-				* pow(2,cordic_gain(nstages));
-
+		if (unit_gain) {
+			// {{{
+			double	qv = unit_gain_rotation_variance(nstages,
+					working_width, phase_bits,
+					cordic_gain(nstages), working_width-ow);
+
+			fprintf(fhp, "#define\tUNIT_GAIN\n");
+			fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+				qv);
+			fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
+				phase_variance(nstages, phase_bits));
+			fprintf(fhp, "const double	CORDIC_GAIN = %.16f;\t// Compensated\n",
+				cordic_gain(nstages));
+			fprintf(fhp, "const double	GAIN = 1.0;\n");
+			fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+				unit_gain_cnr(iw, ow, working_width, qv,
+					phase_variance(nstages, phase_bits)));
+			// }}}
+		} else {
+			fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n",
+				transform_quantization_variance(nstages,
+					working_width-iw,
+					working_width-ow));
+			fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n",
+				phase_variance(nstages, phase_bits));
+			fprintf(fhp, "const double	GAIN = %.16f;\n",
+				cordic_gain(nstages));
 			fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
-				10.0 * log(signal_energy / noise_energy)
-					/log(10.0));
+				best_possible_cnr(nstages, iw, ow, working_width,
+					phase_bits));
 		}
 		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
 		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
@@ -47,6 +47,7 @@ void	seqcordic(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		int nstages, int iw, int ow, int nxtra,
 		int phase_bits=32,
 		bool with_reset=true, bool with_aux = true,
-		bool async_reset=false);
+		bool async_reset=false,
+		int iters=1, bool unit_gain=false);
 
 #endif	// SEQCORDIC_H
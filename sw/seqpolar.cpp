@@ -50,9 +50,10 @@
 void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		int nstages,
 		int iw, int ow, int nxtra, int phase_bits,
-		bool with_reset, bool with_aux, bool async_reset) {
+		bool with_reset, bool with_aux, bool async_reset,
+		int iters, bool unit_gain) {
 // {{{
-	int	working_width = iw;
+	int	working_width = iw, nactive, niter = nstages, lgbase = 0;
 	const	char	*name;
 	const	char PURPOSE[] =
 	"This is a rectangular to polar conversion routine based upon an\n"
@@ -81,6 +82,19 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	working_width += nxtra;
 	name = modulename(fname);
 
+	// With more than one stage per clock, we only need enough clocks
+	// to cover the useful stages.  base then steps from zero to
+	// niter*iters, iters at a time.
+	if (iters < 1)
+		iters = 1;
+	nactive = active_stages(nstages, working_width, phase_bits);
+	if (iters > 1) {
+		niter = (nactive + iters - 1) / iters;
+		if (niter < 1)
+			niter = 1;
+		lgbase = nextlg((unsigned)(niter * iters + 1));
+	}
+
 	std::string	resetw = (!with_reset) ? ""
 			: (async_reset) ? "i_areset_n, ":"i_reset, ";
 	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
@@ -97,14 +111,15 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t\t// {{{\n"
 		"\t\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
 		"\t\t\t\tOW=%2d,// The number of output bits to produce\n"
-		"\t\t\t\t// NSTAGES=%2d,\n"
+		"\t\t\t\t%sNSTAGES=%2d,\n"
 		"\t\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
 		"\t\t\t\tWW=%2d,\t// Our working bit-width\n"
 		"\t\t\t\tPW=%2d\t// Bits in our phase variables\n"
 		"\t\t// }}}\n"
 		"\t) (\n"
 		"\t\t// {{{\n",
-		name, iw, ow, nstages, nxtra, working_width, phase_bits);
+		name, iw, ow, (iters > 1) ? "" : "// ", nstages, nxtra,
+		working_width, phase_bits);
 	fprintf(fp,
 		"\t\tinput\twire\t\t\t\ti_clk, %si_stb,\n"
 		"\t\tinput\twire\tsigned\t[(IW-1):0]\ti_xval, i_yval,%s\n"
@@ -155,7 +170,10 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 	if (with_aux)
 		fprintf(fp, "\treg\t\taux;\n");
 	fprintf(fp, "\treg\t\tidle, pre_valid;\n");
-	fprintf(fp, "\treg\t[%d:0]\tstate;\n\n",
+	if (iters > 1)
+		fprintf(fp, "\treg\t[%d:0]\tbase;\n\n", lgbase-1);
+	else
+		fprintf(fp, "\treg\t[%d:0]\tstate;\n\n",
 			nextlg((unsigned)nstages+1)-1);
 	fprintf(fp, "\twire\t\tlast_state;\n"
 		"\t// }}}\n\n");
@@ -234,9 +252,16 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t// }}}\n\n",
 			phase_bits, (1ul << (phase_bits-3)));
 
-	cordic_angles(fp, nstages, phase_bits, true);
+	if (iters > 1) {
+		cordic_angles(fp, nstages, phase_bits);
+
+		fprintf(fp, "\n\tassign\tlast_state = (!idle)&&(base == %d\'d%d);\n",
+			lgbase, niter * iters);
+	} else {
+		cordic_angles(fp, nstages, phase_bits, true);
 
-	fprintf(fp, "\n\tassign	last_state = (state >= %d);\n", nstages+1);
+		fprintf(fp, "\n\tassign	last_state = (state >= %d);\n", nstages+1);
+	}
 	fprintf(fp,
 		"\n\t// idle\n\t// {{{\n"
 		"\tinitial\tidle = 1\'b1;\n%s", always_reset.c_str());
@@ -244,10 +269,11 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		fprintf(fp, "\t\tidle <= 1\'b1;\n\telse ");
 	else
 		fprintf(fp, "\t");
-	fprintf(fp, "if (i_stb)\n"
+	fprintf(fp, "if (%s)\n"
 			"\t\tidle <= 1\'b0;\n"
 			"\telse if (last_state)\n"
-			"\t\tidle <= 1\'b1;\n\t// }}}\n");
+			"\t\tidle <= 1\'b1;\n\t// }}}\n",
+			(iters > 1) ? "(i_stb)&&(idle)" : "i_stb");
 
 	fprintf(fp,
 		"\t// pre_valid\n"
@@ -259,78 +285,167 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		"\t// }}}\n\n");
 
 
-	fprintf(fp,
-		"\t// state\n"
-		"\t// {{{\n"
-		"\tinitial\tstate = 0;\n%s", always_reset.c_str());
-	if (with_reset)
-		fprintf(fp, "\t\tstate <= 0;\n\telse ");
-	else
-		fprintf(fp, "\t");
-	fprintf(fp, "if (idle)\n"
-			"\t\tstate <= 0;\n"
-		"\telse if (last_state)\n"
-			"\t\tstate <= 0;\n"
-		"\telse\n"
-			"\t\tstate <= state + 1;\n\t// }}}\n");
+	if (iters > 1) {
+		// {{{
+		fprintf(fp,
+			"\t// base -- the first stage applied on this clock\n"
+			"\t// {{{\n"
+			"\tinitial\tbase = 0;\n%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tbase <= 0;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if ((idle)||(pre_valid))\n"
+				"\t\tbase <= 0;\n"
+			"\telse if (!last_state)\n"
+				"\t\tbase <= base + %d\'d%d;\n\t// }}}\n\n",
+				lgbase, iters);
 
-	fprintf(fp,
-		"\t// cangle -- table lookup\n"
-		"\t// {{{\n"
-		"\talways @(posedge i_clk)\n"
-		"\t\tcangle <= cordic_angle[state[%d:0]];\n\t// }}}\n",
-			nextlg((unsigned)nstages)-1);
+		unrolled_rotations(fp, nactive, iters, lgbase, true);
 
-	fprintf(fp,
-		"\t// Actual CORDIC rotation\n"
-		"\t// {{{\n"
-		"\t// Here\'s where we are going to put the actual CORDIC\n"
-		"\t// rectangular to polar loop.  Everything up to this\n"
-		"\t// point has simply been necessary preliminaries.\n");
+		fprintf(fp,
+			"\t// Actual CORDIC rotation\n"
+			"\t// {{{\n"
+			"\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t// rectangular to polar loop.  Everything up to this\n"
+			"\t// point has simply been necessary preliminaries.\n");
 
-	fprintf(fp, "\talways @(posedge i_clk)\n"
-		"\tif (pre_valid)\n"
-		"\tbegin\n"
-		"\t\t// {{{\n"
-		"\t\txv <= prex;\n"
-		"\t\tyv <= prey;\n"
-		"\t\tph <= preph;\n"
-		"\t\t// }}}\n"
-		"\tend else if (yv[(WW-1)]) // Below the axis\n"
-		"\tbegin\n"
-		"\t\t// {{{\n"
-		"\t\t// If the vector is below the x-axis, rotate by\n"
-		"\t\t// the CORDIC angle in a positive direction.\n"
-		"\t\txv <= xv - (yv>>>state);\n"
-		"\t\tyv <= yv + (xv>>>state);\n"
-		"\t\tph <= ph - cangle;\n"
-		"\t\t// }}}\n"
-		"\tend else begin\n"
-		"\t\t// {{{\n"
-		"\t\t// On the other hand, if the vector is above the\n"
-		"\t\t// x-axis, then rotate in the other direction\n"
-		"\t\txv <= xv + (yv>>>state);\n"
-		"\t\tyv <= yv - (xv>>>state);\n"
-		"\t\tph <= ph + cangle;\n"
-		"\t\t// }}}\n"
-		"\tend\n\t// }}}\n");
+		fprintf(fp, "\talways @(posedge i_clk)\n"
+			"\tif (pre_valid)\n"
+			"\tbegin\n"
+			"\t\t// {{{\n"
+			"\t\txv <= prex;\n"
+			"\t\tyv <= prey;\n"
+			"\t\tph <= preph;\n"
+			"\t\t// }}}\n"
+			"\tend else begin\n"
+			"\t\t// {{{\n"
+			"\t\txv <= kx[%d];\n"
+			"\t\tyv <= ky[%d];\n"
+			"\t\tph <= kph[%d];\n"
+			"\t\t// }}}\n"
+			"\tend\n\t// }}}\n", iters, iters, iters);
+		// }}}
+	} else {
+		// {{{
+		fprintf(fp,
+			"\t// state\n"
+			"\t// {{{\n"
+			"\tinitial\tstate = 0;\n%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tstate <= 0;\n\telse ");
+		else
+			fprintf(fp, "\t");
+		fprintf(fp, "if (idle)\n"
+				"\t\tstate <= 0;\n"
+			"\telse if (last_state)\n"
+				"\t\tstate <= 0;\n"
+			"\telse\n"
+				"\t\tstate <= state + 1;\n\t// }}}\n");
+
+		fprintf(fp,
+			"\t// cangle -- table lookup\n"
+			"\t// {{{\n"
+			"\talways @(posedge i_clk)\n"
+			"\t\tcangle <= cordic_angle[state[%d:0]];\n\t// }}}\n",
+				nextlg((unsigned)nstages)-1);
+
+		fprintf(fp,
+			"\t// Actual CORDIC rotation\n"
+			"\t// {{{\n"
+			"\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t// rectangular to polar loop.  Everything up to this\n"
+			"\t// point has simply been necessary preliminaries.\n");
+
+		fprintf(fp, "\talways @(posedge i_clk)\n"
+			"\tif (pre_valid)\n"
+			"\tbegin\n"
+			"\t\t// {{{\n"
+			"\t\txv <= prex;\n"
+			"\t\tyv <= prey;\n"
+			"\t\tph <= preph;\n"
+			"\t\t// }}}\n"
+			"\tend else if (yv[(WW-1)]) // Below the axis\n"
+			"\tbegin\n"
+			"\t\t// {{{\n"
+			"\t\t// If the vector is below the x-axis, rotate by\n"
+			"\t\t// the CORDIC angle in a positive direction.\n"
+			"\t\txv <= xv - (yv>>>state);\n"
+			"\t\tyv <= yv + (xv>>>state);\n"
+			"\t\tph <= ph - cangle;\n"
+			"\t\t// }}}\n"
+			"\tend else begin\n"
+			"\t\t// {{{\n"
+			"\t\t// On the other hand, if the vector is above the\n"
+			"\t\t// x-axis, then rotate in the other direction\n"
+			"\t\txv <= xv + (yv>>>state);\n"
+			"\t\tyv <= yv - (xv>>>state);\n"
+			"\t\tph <= ph + cangle;\n"
+			"\t\t// }}}\n"
+			"\tend\n\t// }}}\n");
+		// }}}
+	}
+
+	// The result is ready on the clock where done is true, and taken from
+	// xv, ph, and aux.  Gain compensation delays it all by one clock.
+	std::string	done = "last_state", xsrc = "xv", psrc = "ph",
+			asrc = "aux";
+
+	if (unit_gain) {
+		// {{{
+		const	char	*src[1] = { "xv" },
+				*dst[1] = { "gxv" };
+
+		fprintf(fp, "\n");
+		gain_compensation(fp, working_width,
+			cordic_gain(nstages) * sqrt(2.0) / 2.0,
+			1, src, dst, done.c_str());
+
+		fprintf(fp, "\t// gain_stb, gph%s\n\t// {{{\n"
+			"\treg\t\t\tgain_stb;\n"
+			"\treg\t[(PW-1):0]\tgph;\n",
+			(with_aux) ? ", gaux" : "");
+		if (with_aux)
+			fprintf(fp, "\treg\t\t\tgaux;\n");
+		fprintf(fp, "\n\tinitial\tgain_stb = 1\'b0;\n");
+		fprintf(fp, "%s", always_reset.c_str());
+		if (with_reset)
+			fprintf(fp, "\t\tgain_stb <= 1\'b0;\n\telse\n");
+		fprintf(fp, "\t\tgain_stb <= last_state;\n\n"
+			"\talways @(posedge i_clk)\n"
+			"\tif (last_state)\n");
+		if (with_aux)
+			fprintf(fp, "\tbegin\n"
+				"\t\tgph  <= ph;\n"
+				"\t\tgaux <= aux;\n"
+				"\tend\n");
+		else
+			fprintf(fp, "\t\tgph <= ph;\n");
+		fprintf(fp, "\t// }}}\n");
+
+		done = "gain_stb";
+		xsrc = dst[0];
+		psrc = "gph";
+		asrc = "gaux";
+		// }}}
+	}
 
 	fprintf(fp, "\n\t// o_done\n\t// {{{\n"
 		"%s", always_reset.c_str());
 	if (with_reset)
 		fprintf(fp, "\t\to_done <= 1\'b0;\n\telse\n");
-	fprintf(fp, "\t\to_done <= (last_state);\n\t// }}}\n");
+	fprintf(fp, "\t\to_done <= (%s);\n\t// }}}\n", done.c_str());
 
 	if (working_width > ow+1) {
 		fprintf(fp,
 			"\t// Round our magnitude towards even\n"
 			"\t// {{{\n"
 			"\twire\t[(WW-1):0]\tfinal_mag;\n\n"
-			"\tassign\tfinal_mag = xv + $signed({{(OW){1\'b0}},\n"
-				"\t\t\t\txv[(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!xv[WW-OW]}} });\n"
+			"\tassign\tfinal_mag = %s + $signed({{(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n"
 			"\t// }}}\n"
-			"\n");
+			"\n", xsrc.c_str(), xsrc.c_str(), xsrc.c_str());
 
 		fprintf(fp, "\t// Output assignments: o_mag, o_phase%s\n"
 			"\t// {{{\n", (with_aux) ? ", and o_aux":"");
@@ -338,25 +453,30 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 			fprintf(fp, "\tinitial o_aux = 0;\n");
 		fprintf(fp, "\talways @(posedge i_clk)\n");
 		fprintf(fp,
-			"\tif (last_state)\n"
+			"\tif (%s)\n"
 			"\tbegin\n"
-			"\t\to_mag   <= final_mag[(WW-1):(WW-OW)];\n");
+			"\t\to_mag   <= final_mag[(WW-1):(WW-OW)];\n",
+			done.c_str());
 	} else {
 		if (with_aux)
 			fprintf(fp, "\tinitial o_aux = 0;\n");
 		fprintf(fp, "\talways @(posedge i_clk)\n");
 		fprintf(fp,
-			"\tif (last_state)\n"
+			"\tif (%s)\n"
 			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
-			"\t\to_mag   <= xv[(WW-1):(WW-OW)];\n");
+			"\t\to_mag   <= %s[(WW-1):(WW-OW)];\n",
+			done.c_str(), xsrc.c_str());
 	}
 
-	fprintf(fp, "\t\to_phase <= ph;\n");
+	fprintf(fp, "\t\to_phase <= %s;\n", psrc.c_str());
 	if (with_aux)
-		fprintf(fp, "\t\to_aux   <= aux;\n");
+		fprintf(fp, "\t\to_aux   <= %s;\n", asrc.c_str());
 	fprintf(fp, "\tend\n\t// }}}\n");
 
-	fprintf(fp, "\tassign\to_busy = !idle;\n\n");
+	if (unit_gain)
+		fprintf(fp, "\tassign\to_busy = (!idle)||(gain_stb);\n\n");
+	else
+		fprintf(fp, "\tassign\to_busy = !idle;\n\n");
 
 	if (working_width > ow+1) {
 		// {{{
@@ -393,21 +513,42 @@ void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
 		fprintf(fhp, "#ifdef\tCLOCKS_PER_OUTPUT\n");
 		fprintf(fhp, "#undef\tCLOCKS_PER_OUTPUT\n");
 		fprintf(fhp, "#endif\t// CLOCKS_PER_OUTPUT\n");
-		fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n", nstages+3);
+		fprintf(fhp, "#define\tCLOCKS_PER_OUTPUT\t%d\n",
+			((iters > 1) ? niter+3 : nstages+3)
+				+ ((unit_gain) ? 1:0));
 
+		fprintf(fhp, "const int	NLANES = 1;\n");
 		fprintf(fhp, "const int	IW = %d;\n", iw);
 		fprintf(fhp, "const int	OW = %d;\n", ow);
 		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
 		fprintf(fhp, "const int	WW = %d;\n", working_width);
 		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
 		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
-		fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
-			transform_quantization_variance(nstages,
-				working_width-iw, working_width-ow));
-		fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
-			phase_variance(nstages, phase_bits));
-		fprintf(fhp, "const double\tGAIN = %.16f;\n",
-			cordic_gain(nstages) * sqrt(2.0) / 2.0);
+		if (unit_gain) {
+			// {{{
+			double	gain = cordic_gain(nstages) * sqrt(2.0) / 2.0;
+
+			fprintf(fhp, "#define\tUNIT_GAIN\n");
+			fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
+				unit_gain_variance(
+					transform_quantization_variance(nstages,
+						working_width-iw, 0),
+					gain, working_width-ow));
+			fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
+				phase_variance(nstages, phase_bits));
+			fprintf(fhp, "const double\tCORDIC_GAIN = %.16f;\t// Compensated\n",
+				gain);
+			fprintf(fhp, "const double\tGAIN = 1.0;\n");
+			// }}}
+		} else {
+			fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
+				transform_quantization_variance(nstages,
+					working_width-iw, working_width-ow));
+			fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
+				phase_variance(nstages, phase_bits));
+			fprintf(fhp, "const double\tGAIN = %.16f;\n",
+				cordic_gain(nstages) * sqrt(2.0) / 2.0);
+		}
 		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
 		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
 		if (with_reset)
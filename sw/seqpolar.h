@@ -46,6 +46,7 @@ extern	void	seqpolar(FILE *fp, FILE *fhp, const char *cmdline,
 			int nstages, int iw, int ow, int nxtra,
 			int phase_bits=32,
 			bool with_reset=true, bool with_aux = true,
-			bool async_reset = false);
+			bool async_reset = false,
+			int iters = 1, bool unit_gain = false);
 
 #endif	// SEQPOLAR_H
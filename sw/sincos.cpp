@@ -0,0 +1,597 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/sincos.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Builds a sine and cosine generator out of the polar to
+//		rectangular CORDIC.  When such a CORDIC is used as an NCO,
+//	it's given the same constant vector every clock.  Here, that vector is
+//	folded into the design, so the core has no inputs other than its phase,
+//	and its CORDIC gain is absorbed into the starting vector.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <ctype.h>
+#include <assert.h>
+
+#include "legal.h"
+#include "cordiclib.h"
+#include "sincos.h"
+
+// sincos_gain
+// {{{
+// The gain of the core, from the initial vector to the output: that of the
+// 45 degree first rotation, times that of every CORDIC stage that isn't
+// skipped.
+static	double	sincos_gain(int nstages, int working_width, int phase_bits) {
+	double	gain = sqrt(2.0);
+
+	for(int k=0; k<nstages; k++) {
+		if ((cordic_angle(k, phase_bits) == 0)||(k >= working_width))
+			continue;
+		gain *= sqrt(1.0 + pow(2.0, -2.*(k+1)));
+	}
+
+	return gain;
+}
+// }}}
+
+// sincos_start
+// {{{
+// The magnitude of each coordinate of the initial vector.  Ideally, this
+// would produce an output amplitude of 2^(OW-1)-1.  However, there's no
+// spare bit above the output to absorb any overshoot.  The initial vector is
+// therefore reduced, if necessary, so that neither the truncation within the
+// CORDIC stages (less than one unit per coordinate per stage, before gain),
+// nor the final rounding, can overflow the working width.
+static	long	sincos_start(int nstages, int ow, int working_width,
+			int phase_bits) {
+	long	target, limit;
+
+	target = ((1l << (ow-1)) - 1) << (working_width - ow);
+	limit  = (1l << (working_width-1)) - 2*nstages - 1;
+	if (working_width > ow+1)
+		limit -= (1l << (working_width-ow-1));
+	if (target > limit)
+		target = limit;
+
+	return (long)floor(target / sincos_gain(nstages, working_width,
+				phase_bits));
+}
+// }}}
+
+// sincos_quantization_variance
+// {{{
+// The quantization variance of the output vector, summed across o_cos and
+// o_sin, in output units squared.  This is what cordic_tb measures against
+// QUANTIZATION_VARIANCE.
+//
+// transform_quantization_variance() doesn't fit this core.  It charges an
+// input quantization to a vector that, here, is a constant, and it charges
+// each stage 1/3 unit^2, the second moment of a full truncation, to each
+// coordinate.  Here, nothing comes in but START, whose own rounding is
+// already absorbed into AMPLITUDE.  Each stage then truncates its shifted
+// operands by only (k+1) bits, dropping j/2^(k+1) for j uniform on
+// [0,2^(k+1)).  That error's sign follows the rotation's direction, so its
+// mean doesn't accumulate as a bias, but it does add to the variance.  With
+// only NEXTRA bits to spare, these errors are then divided by 4^NEXTRA
+// rather than buried, and the final rounding adds its own.
+static	double	sincos_quantization_variance(int nstages, int ow,
+			int working_width, int phase_bits) {
+	double	variance = 0.0, dv, mean;
+	int	dropped = working_width - ow;
+
+	for(int k=0; k<nstages; k++) {
+		if ((cordic_angle(k, phase_bits) == 0)||(k >= working_width))
+			continue;
+		mean = (1.0 - pow(2.0, -(k+1))) / 2.0;
+		dv   = mean * mean + (1.0 - pow(4.0, -(k+1))) / 12.0;
+
+		// Any prior error grows with this stage's gain
+		variance = (1.0 + pow(4.0, -(k+1))) * variance + 2.0 * dv;
+	}
+
+	variance *= pow(4.0, -dropped);
+
+	// The output stage drops the extra bits
+	if (working_width > ow+1)
+		// Round towards even
+		dv = (pow(4.0, dropped) + 2.0) / 12.0 / pow(4.0, dropped);
+	else {
+		// Truncate a single bit
+		mean = 0.25;
+		dv   = mean * mean + (1.0 - 0.25) / 12.0;
+	}
+
+	return variance + 2.0 * dv;
+}
+// }}}
+
+static	void	sincos_model(FILE *fhp, int nstages, int ow, int ww,
+		int phase_bits, long start) {
+	// {{{
+	assert(ww < 64);
+	assert(phase_bits < 64);
+
+	fprintf(fhp,
+"\n"
+"// Bit-exact model\n"
+"// {{{\n"
+"// The following duplicates, in integer arithmetic, the logic of the core\n"
+"// above: the same initial vector, the same truncated CORDIC angles, the\n"
+"// same shifts, and the same round-towards-even output stage.  Given the\n"
+"// same phase, sincos_model() will return exactly what the core will\n"
+"// produce on o_cos and o_sin LATENCY clocks later.\n"
+"//\n"
+"#define\tHAS_SINCOS_MODEL\n\n");
+
+	fprintf(fhp, "static const long\tSINCOS_START = %ld;\n\n", start);
+
+	fprintf(fhp, "static const unsigned long\tSINCOS_ANGLE[%d] = {", nstages);
+	for(int k=0; k<nstages; k++) {
+		fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+			(0 == (k%4)) ? "\n\t" : " ",
+			(phase_bits+3)/4, cordic_angle(k, phase_bits));
+	} fprintf(fhp, "\n};\n\n");
+
+	fprintf(fhp,
+"// Sign extend the bottom w bits of v\n"
+"static inline long\tsincos_sext(unsigned long v, int w) {\n"
+"\treturn ((long)(v << (64-w))) >> (64-w);\n"
+"}\n\n");
+
+	fprintf(fhp,
+"static inline void\tsincos_model(unsigned long i_phase,\n"
+"\t\tlong &o_cos, long &o_sin) {\n"
+"\tconst\tunsigned long	PMSK = (1ul << PW) - 1;\n"
+"\tlong\t\txv, yv;\n"
+"\tunsigned long\tph;\n"
+"\n"
+"\t// The initial vector, one per quadrant\n"
+"\tswitch((i_phase >> (PW-2)) & 3) {\n"
+"\tcase 0:  xv =  SINCOS_START; yv =  SINCOS_START; break;\n"
+"\tcase 1:  xv = -SINCOS_START; yv =  SINCOS_START; break;\n"
+"\tcase 2:  xv = -SINCOS_START; yv = -SINCOS_START; break;\n"
+"\tdefault: xv =  SINCOS_START; yv = -SINCOS_START; break;\n"
+"\t}\n"
+"\n"
+"\t// The phase within the quadrant, less 45 degrees\n"
+"\tph = ((i_phase & ((1ul << (PW-2))-1)) - (1ul << (PW-3))) & PMSK;\n"
+"\n"
+"\t// CORDIC rotations\n"
+"\tfor(int k=0; k<NSTAGES; k++) {\n"
+"\t\tlong\tdx, dy;\n"
+"\n"
+"\t\tif ((SINCOS_ANGLE[k] == 0)||(k >= WW))\n"
+"\t\t\tcontinue;\n"
+"\n"
+"\t\tdx = xv >> (k+1);\n"
+"\t\tdy = yv >> (k+1);\n"
+"\t\tif ((ph >> (PW-1))&1) {\n"
+"\t\t\t// Negative phase, rotate clockwise\n"
+"\t\t\txv = sincos_sext(xv + dy, WW);\n"
+"\t\t\tyv = sincos_sext(yv - dx, WW);\n"
+"\t\t\tph = (ph + SINCOS_ANGLE[k]) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\t// Positive phase, rotate counter-clockwise\n"
+"\t\t\txv = sincos_sext(xv - dy, WW);\n"
+"\t\t\tyv = sincos_sext(yv + dx, WW);\n"
+"\t\t\tph = (ph - SINCOS_ANGLE[k]) & PMSK;\n"
+"\t\t}\n"
+"\t}\n"
+"\n");
+
+	if (ww > ow+1) {
+		fprintf(fhp,
+"\t// Round towards even, then drop the extra bits\n"
+"\tif ((xv >> (WW-OW)) & 1)\n"
+"\t\txv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\txv += (1l << (WW-OW-1)) - 1;\n"
+"\tif ((yv >> (WW-OW)) & 1)\n"
+"\t\tyv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\tyv += (1l << (WW-OW-1)) - 1;\n"
+"\txv = sincos_sext(xv, WW);\n"
+"\tyv = sincos_sext(yv, WW);\n\n");
+	} else
+		fprintf(fhp,
+"\t// No rounding required\n");
+
+	fprintf(fhp,
+"\to_cos = xv >> (WW-OW);\n"
+"\to_sin = yv >> (WW-OW);\n"
+"}\n"
+"// }}}\n");
+	// }}}
+}
+
+int	sincos(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+		int nstages, int ow, int nxtra, int phase_bits,
+		bool with_reset, bool with_aux, bool async_reset) {
+	// {{{
+	int	working_width;
+	long	start;
+	double	gain;
+	const	char *name;
+	const	char PURPOSE[] =
+	"This file produces the cosine and sine of i_phase, on\n"
+	"//\t\to_cos and o_sin respectively.  i_phase is given by the angle,\n"
+	"//\tin radians, multiplied by 2^PW/(2pi).  Internally, this is a\n"
+	"//\tpolar to rectangular CORDIC whose input vector is a constant, and\n"
+	"//\tso has been folded into the logic.",
+		HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
+
+	legal(fp, fname, PROJECT, PURPOSE, cmdline);
+	if (nxtra < 1)
+		nxtra = 1;
+	assert(phase_bits >= 4);
+
+	// Since the CORDIC gain is absorbed into the initial vector, the
+	// working width needs no extra bit on top to hold it.
+	working_width = ow + nxtra;
+	assert(working_width < 64);
+
+	gain  = sincos_gain(nstages, working_width, phase_bits);
+	start = sincos_start(nstages, ow, working_width, phase_bits);
+	assert(start > 0);
+
+	std::string	resetw = (!with_reset)?""
+			: ((async_reset)?"i_areset_n" : "i_reset");
+	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
+	if ((with_reset)&&(async_reset))
+		always_reset = "\talways @(posedge i_clk, negedge i_areset_n)\n"
+				"\tif (!i_areset_n)\n";
+	else if (with_reset)
+		always_reset = "\talways @(posedge i_clk)\n"
+				"\tif (i_reset)\n";
+
+	name = modulename(fname);
+
+	fprintf(fp, "`default_nettype\tnone\n");
+	fprintf(fp,
+		"module	%s#(\n"
+		"\t\t// {{{\n"
+		"\tlocalparam\tOW=%2d,\t// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d\t// Bits in our phase variables\n"
+		"\t\t// }}}\n"
+		"\t) (\n"
+		"\t\t// {{{\n"
+		"\tinput\twire\t\t\t\ti_clk, %s%si_ce,\n"
+		"\tinput\twire\t\t[(PW-1):0]\t\t\ti_phase,\n"
+		"\toutput\treg\tsigned\t[(OW-1):0]\to_cos, o_sin%s\n",
+		name, ow, nstages, nxtra, working_width, phase_bits,
+		resetw.c_str(), (with_reset)?", ":"", (with_aux)?",":"");
+
+	if (with_aux) {
+		fprintf(fp,
+			"\tinput\twire\t\t\t\ti_aux,\n"
+			"\toutput\treg\t\t\t\to_aux\n");
+	} fprintf(fp, "\t\t// }}}\n\t);\n\n");
+
+	fprintf(fp,
+		"\t// Declare variables for all of the separate stages\n"
+		"\t// {{{\n"
+		"\treg	signed	[(WW-1):0]\txv\t[0:(NSTAGES)];\n"
+		"\treg	signed	[(WW-1):0]\tyv\t[0:(NSTAGES)];\n"
+		"\treg		[(PW-1):0]\tph\t[0:(NSTAGES)];\n");
+	if (with_aux)
+		fprintf(fp, "\treg\t\t[(NSTAGES):0]\tax;\n");
+	fprintf(fp,
+		"\t// }}}\n\n");
+
+	if (with_aux) {
+		fprintf(fp,
+"\t//\n"
+"\t// Handle the auxilliary logic.\n"
+"\t// {{{\n"
+"\t// The auxilliary bit is designed so that you can place a valid bit into\n"
+"\t// the CORDIC function, and see when it comes out.  While the bit is\n"
+"\t// allowed to be anything, the requirement of this bit is that it *must*\n"
+"\t// be aligned with the output when done.  That is, if i_phase is input\n"
+"\t// together with i_aux, then when o_cos and o_sin are set to its\n"
+"\t// result, o_aux *must* contain the value that was in i_aux.\n"
+"\t//\n"
+"\n"
+"\tinitial\tax = 0;\n");
+
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset)
+			fprintf(fp,
+				"\t\tax <= 0;\n\telse ");
+		fprintf(fp, "if (i_ce)\n"
+			"\t\tax <= { ax[(NSTAGES-1):0], i_aux };\n"
+			"\t// }}}\n\n");
+	}
+
+	fprintf(fp,
+		"\t// Initial vector\n"
+		"\t// {{{\n"
+		"\t// With no input vector, the usual pre-rotation to within +/- 45\n"
+		"\t// degrees, followed by a rotation of +/- 45 degrees, can only\n"
+		"\t// ever produce one of four vectors--one per quadrant.  The gain\n"
+		"\t// of that first rotation, and of every CORDIC stage following,\n"
+		"\t// has already been divided out of START.  The phase left over\n"
+		"\t// is the phase within the quadrant, less 45 degrees.\n"
+		"\t//\n"
+		"\tlocalparam\tsigned\t[(WW-1):0]\tSTART = %d\'h%lx;\n\n",
+		working_width, start);
+
+	fprintf(fp,
+		"\tinitial begin\n"
+		"\t\txv[0] = 0;\n"
+		"\t\tyv[0] = 0;\n"
+		"\t\tph[0] = 0;\n"
+		"\tend\n");
+
+	fprintf(fp, "%s", always_reset.c_str());
+
+	if (with_reset)
+		fprintf(fp,
+			"\tbegin\n"
+			"\t\txv[0] <= 0;\n"
+			"\t\tyv[0] <= 0;\n"
+			"\t\tph[0] <= 0;\n"
+			"\tend else ");
+
+	fprintf(fp, "if (i_ce)\n"
+		"\tbegin\n"
+		"\t\t// {{{\n"
+		"\t\tcase(i_phase[(PW-1):(PW-2)])\n"
+		"\t\t2\'b00: begin xv[0] <=  START; yv[0] <=  START; end\n"
+		"\t\t2\'b01: begin xv[0] <= -START; yv[0] <=  START; end\n"
+		"\t\t2\'b10: begin xv[0] <= -START; yv[0] <= -START; end\n"
+		"\t\t2\'b11: begin xv[0] <=  START; yv[0] <= -START; end\n"
+		"\t\tendcase\n"
+		"\n"
+		"\t\tph[0] <= { {(3){!i_phase[PW-3]}}, i_phase[(PW-4):0] };\n"
+		"\t\t// }}}\n"
+		"\tend\n"
+		"\t// }}}\n");
+
+	cordic_angles(fp, nstages, phase_bits);
+
+	fprintf(fp,"\n"
+		"\t// CORDIC rotations\n"
+		"\t// {{{\n"
+		"\tgenvar	i;\n"
+		"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : CORDICops\n");
+	if (with_reset) {
+		fprintf(fp,
+			"\t\tinitial begin\n"
+			"\t\t\txv[i+1] = 0;\n"
+			"\t\t\tyv[i+1] = 0;\n"
+			"\t\t\tph[i+1] = 0;\n"
+			"\t\tend\n\n\t");
+	}
+	fprintf(fp, "%s", always_reset.c_str());
+	if (with_reset) {
+		fprintf(fp,
+			"\t\tbegin\n"
+			"\t\t\t// {{{\n"
+			"\t\t\txv[i+1] <= 0;\n"
+			"\t\t\tyv[i+1] <= 0;\n"
+			"\t\t\tph[i+1] <= 0;\n"
+			"\t\t\t// }}}\n"
+			"\t\tend else ");
+	} else
+		fprintf(fp, "\t\t");
+
+	fprintf(fp,
+		"if (i_ce)\n"
+		"\t\tbegin\n"
+		"\t\t\t// {{{\n"
+		"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
+		"\t\t\tbegin // Do nothing but move our outputs\n"
+		"\t\t\t// forward one stage, since we have more\n"
+		"\t\t\t// stages than valid data\n"
+		"\t\t\t\t// {{{\n"
+		"\t\t\t\txv[i+1] <= xv[i];\n"
+		"\t\t\t\tyv[i+1] <= yv[i];\n"
+		"\t\t\t\tph[i+1] <= ph[i];\n"
+		"\t\t\t\t// }}}\n"
+		"\t\t\tend else if (ph[i][(PW-1)]) // Negative phase\n"
+		"\t\t\tbegin\n"
+		"\t\t\t\t// {{{\n"
+		"\t\t\t\t// If the phase is negative, rotate by the\n"
+		"\t\t\t\t// CORDIC angle in a clockwise direction.\n"
+		"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
+		"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
+		"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
+		"\t\t\t\t// }}}\n"
+		"\t\t\tend else begin\n"
+		"\t\t\t\t// {{{\n"
+		"\t\t\t\t// On the other hand, if the phase is\n"
+		"\t\t\t\t// positive ... rotate in the\n"
+		"\t\t\t\t// counter-clockwise direction\n"
+		"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
+		"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
+		"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
+		"\t\t\t\t// }}}\n"
+		"\t\t\tend\n"
+		"\t\t\t// }}}\n"
+		"\t\tend\n"
+		"\tend endgenerate\n\t// }}}\n\n");
+
+	if (working_width > ow+1) {
+		fprintf(fp,
+			"\t// Round our result towards even\n"
+			"\t// {{{\n"
+			"\twire\t[(WW-1):0]\tpre_cos, pre_sin;\n\n"
+			"\tassign\tpre_cos = xv[NSTAGES] + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\txv[NSTAGES][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!xv[NSTAGES][WW-OW]}} });\n"
+			"\tassign\tpre_sin = yv[NSTAGES] + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\tyv[NSTAGES][(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!yv[NSTAGES][WW-OW]}} });\n"
+			"\n\n");
+
+		fprintf(fp, "\tinitial begin\n"
+			"\t\to_cos = 0;\n"
+			"\t\to_sin = 0;\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux = 0;\n");
+		fprintf(fp, "\tend\n");
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset) {
+			fprintf(fp, "\tbegin\n"
+				"\t\to_cos <= 0;\n"
+				"\t\to_sin <= 0;\n");
+			if (with_aux)
+				fprintf(fp, "\t\to_aux <= 0;\n");
+			fprintf(fp, "\tend else ");
+		}
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\tbegin\n"
+			"\t\to_cos <= pre_cos[(WW-1):(WW-OW)];\n"
+			"\t\to_sin <= pre_sin[(WW-1):(WW-OW)];\n");
+		if (with_aux)
+			fprintf(fp,
+			"\t\to_aux <= ax[NSTAGES];\n");
+		fprintf(fp, "\tend\n\t// }}}\n");
+
+		fprintf(fp, "\t// Make Verilator happy with pre_cos and pre_sin\n"
+			"\t// {{{\n"
+			"\t// verilator lint_off UNUSED\n"
+			"\twire	unused_val;\n"
+			"\tassign\tunused_val = &{ 1\'b0, \n"
+			"\t\tpre_cos[(WW-OW-1):0],\n"
+			"\t\tpre_sin[(WW-OW-1):0]\n"
+			"\t\t};\n"
+			"\t// }}}\n"
+			"\t// verilator lint_on UNUSED\n");
+	} else {
+		fprintf(fp,
+			"\t// No rounding required\n"
+			"\t// {{{\n"
+			"\tinitial begin\n"
+			"\t\to_cos = 0;\n"
+			"\t\to_sin = 0;\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux = 0;\n");
+		fprintf(fp, "\tend\n");
+		fprintf(fp, "%s", always_reset.c_str());
+
+		if (with_reset) {
+			fprintf(fp,
+			"\tbegin\n"
+			"\t\to_cos <= 0;\n"
+			"\t\to_sin <= 0;\n");
+			if (with_aux)
+				fprintf(fp, "\t\to_aux <= 0;\n");
+			fprintf(fp, "\tend else ");
+		}
+
+		fprintf(fp,
+			"if (i_ce)\n"
+			"\tbegin\n"
+			"\t\to_cos <= xv[NSTAGES][(WW-1):(WW-OW)];\n"
+			"\t\to_sin <= yv[NSTAGES][(WW-1):(WW-OW)];\n");
+		if (with_aux)
+			fprintf(fp, "\t\to_aux <= ax[NSTAGES];\n");
+		fprintf(fp, "\tend\n\t// }}}\n");
+	}
+
+	fprintf(fp, "endmodule\n");
+
+	if (NULL != fhp) {
+		// {{{
+		char	*str = new char[strlen(name)+4], *ptr;
+		double	amplitude, qv, pv;
+
+		amplitude = start * gain / (double)(1l << (working_width-ow));
+		qv = sincos_quantization_variance(nstages, ow,
+				working_width, phase_bits);
+		pv = phase_variance(nstages, phase_bits);
+
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef	%s\n", str);
+		fprintf(fhp, "#define	%s\n", str);
+
+		if (async_reset)
+			fprintf(fhp, "#define\tASYNC_RESET\n");
+		fprintf(fhp, "const int	OW = %d;\n", ow);
+		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
+		fprintf(fhp, "const int	WW = %d;\n", working_width);
+		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
+		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
+		fprintf(fhp, "const int	LATENCY = %d;\t// Clocks from i_ce to output\n",
+			nstages+2);
+		fprintf(fhp, "const double	QUANTIZATION_VARIANCE = %.4e; // (Units^2)\n", qv);
+		fprintf(fhp, "const double	PHASE_VARIANCE_RAD = %.4e; // (Radians^2)\n", pv);
+		fprintf(fhp, "const double	CORDIC_GAIN = %.16f;\t// Folded into START\n",
+			gain);
+		fprintf(fhp, "const double	AMPLITUDE = %.16f;\t// Of o_cos and o_sin\n",
+			amplitude);
+		fprintf(fhp, "const double\tBEST_POSSIBLE_CNR = %.2f;\n",
+			10.0 * log10(amplitude * amplitude
+				/ (qv + amplitude * amplitude * pv)));
+		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+
+		sincos_model(fhp, nstages, ow, working_width, phase_bits,
+			start);
+
+		fprintf(fhp, "#endif\t// %s\n", str);
+		delete[] str;
+		// }}}
+	}
+
+	return nstages + 2;
+	// }}}
+}
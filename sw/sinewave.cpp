@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/sinewave.cpp
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Calculates the samples of a sine wave from its first quarter
+//		wave, as described in sinewave.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <thread>
+#include <vector>
+
+#include "sinewave.h"
+
+// Quarter waves of more than 2^MAX_QUARTER_LG samples are not kept in memory,
+// but rather calculated as needed--so that memory use remains bounded.
+#define	MAX_QUARTER_LG	24
+
+// Quarter waves of fewer than PARALLEL_QUARTER samples are calculated by a
+// single thread, since starting the others would cost more than it saves.
+#define	PARALLEL_QUARTER	(1l<<16)
+
+// quarter_sample
+// {{{
+// Sample k of the first quarter wave, calculated with only one rounding
+// step prior to the sin() itself.
+static inline double quarter_sample(long entries, int offset2, long k) {
+	return sin(M_PI * (double)(2*k + offset2) / (double)entries);
+}
+// }}}
+
+// sinewave
+// {{{
+SINEWAVE	*sinewave(long entries, bool half_offset) {
+	SINEWAVE	*sw = new SINEWAVE;
+	long		nq = entries / 4 + 1;
+
+	assert(entries >= 4);
+	assert(0 == (entries & (entries-1)));
+
+	sw->m_entries = entries;
+	sw->m_offset2 = (half_offset) ? 1 : 0;
+	sw->m_quarter = NULL;
+
+	if (nq > (1l<<MAX_QUARTER_LG) + 1)
+		return sw;
+
+	double	*qw = new double[nq];
+	int	nthreads = 1;
+
+	if (nq >= PARALLEL_QUARTER)
+		nthreads = std::thread::hardware_concurrency();
+
+	if (nthreads <= 1) {
+		for(long k=0; k<nq; k++)
+			qw[k] = quarter_sample(entries, sw->m_offset2, k);
+	} else {
+		std::vector<std::thread>	pool;
+
+		for(int t=0; t<nthreads; t++) {
+			pool.push_back(std::thread([=]() {
+				long	first = nq * t / nthreads,
+					last  = nq * (t+1) / nthreads;
+
+				for(long k=first; k<last; k++)
+					qw[k] = quarter_sample(entries,
+							sw->m_offset2, k);
+			}));
+		}
+
+		for(int t=0; t<nthreads; t++)
+			pool[t].join();
+	}
+
+	sw->m_quarter = qw;
+	return sw;
+}
+// }}}
+
+// free_sinewave
+// {{{
+void	free_sinewave(SINEWAVE *sw) {
+	if (!sw)
+		return;
+	delete[] sw->m_quarter;
+	delete sw;
+}
+// }}}
+
+// sinewave_value
+// {{{
+// Sample k + N/2 is the negative of sample k, and within the first half
+// wave, sample k (past the first quarter) mirrors sample N/2 - k - offset2.
+double	sinewave_value(const SINEWAVE *sw, long k) {
+	long	n = sw->m_entries, h = n/2;
+	bool	negate;
+	double	v;
+
+	k &= (n-1);
+	negate = (k >= h);
+	if (negate)
+		k -= h;
+	if (k > n/4 - sw->m_offset2)
+		k = h - k - sw->m_offset2;
+
+	if (sw->m_quarter)
+		v = sw->m_quarter[k];
+	else
+		v = quarter_sample(n, sw->m_offset2, k);
+
+	return (negate) ? -v : v;
+}
+// }}}
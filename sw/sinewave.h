@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sw/sinewave.h
+// {{{
+// Project:	A series of CORDIC related projects
+//
+// Purpose:	Calculates the samples of a sine wave, as used by all of the
+//		table based generators.  Only the first quarter wave is ever
+//	calculated, split across a pool of threads.  The rest of the wave is
+//	then found by mirroring and negating that first quarter, so every
+//	table built from it is exactly symmetric.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2017-2024, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef	SINEWAVE_H
+#define	SINEWAVE_H
+
+// SINEWAVE
+// {{{
+// A full wave of m_entries samples, where sample k is
+//	sin(2pi * (k + m_offset2/2) / m_entries)
+// and m_offset2 is either zero or one.  Only the samples of the first
+// quarter wave are kept, and then only if there aren't too many of them.
+// Otherwise, they are calculated as needed.
+typedef	struct	SINEWAVE_S {
+	long	m_entries;
+	int	m_offset2;
+	double	*m_quarter;
+} SINEWAVE;
+// }}}
+
+// Build a sine wave of entries samples, where entries is a power of two
+// no smaller than four.  If half_offset is true, every sample is offset by
+// half a step, as the quarter wave tables require.
+extern	SINEWAVE	*sinewave(long entries, bool half_offset = false);
+extern	void		free_sinewave(SINEWAVE *sw);
+
+// Return sample k, for any k--negative or beyond one wave
+extern	double		sinewave_value(const SINEWAVE *sw, long k);
+
+#endif	// SINEWAVE_H
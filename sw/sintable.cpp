@@ -42,14 +42,62 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <string>
 #include <math.h>
 #include <assert.h>
 #include "hexfile.h"
+#include "sinewave.h"
 
 #include "legal.h"
 
-void	sintable(FILE *fp, const char *cmdline, const char *fname,
+// Beyond 53 bits, a double can no longer hold the table values exactly
+#define	MAX_SINTABLE_OW	53
+#define	MAX_SINTABLE_LG	30
+
+// SINGEN
+// {{{
+// Describes a sine table to hextable(), so the table can be written as it
+// is calculated rather than first being built in memory.  Entry k holds
+// maxv * sin(2pi * (k + offset) / tbl_entries), for an offset of either
+// zero or one half.
+typedef	struct	SINGEN_S {
+	long		m_maxv;
+	SINEWAVE	*m_wave;
+} SINGEN;
+
+static	long	singen(long k, void *arg) {
+	const	SINGEN	*sg = (const SINGEN *)arg;
+
+	return (long)(sg->m_maxv * sinewave_value(sg->m_wave, k));
+}
+// }}}
+
+// check_table_size
+// {{{
+// Tables are limited by the phase bits Verilog can express in a 32-bit
+// (1<<PW), and by the precision of the double used to calculate each
+// entry.  Beyond 16M entries, they are also larger than most FPGA's can hold,
+// although still useful as golden models.
+static	bool	check_table_size(int lgphase, int lgtable, int ow) {
+	if (lgphase > MAX_SINTABLE_LG) {
+		fprintf(stderr, "ERR: Requested table phase is greater than %d bits\n",
+			MAX_SINTABLE_LG);
+		return false;
+	} if (ow > MAX_SINTABLE_OW) {
+		fprintf(stderr, "ERR: Requested table output width is greater than %d bits\n",
+			MAX_SINTABLE_OW);
+		return false;
+	} if (lgtable >= 24) {
+		fprintf(stderr, "WARNING: Requested table size is greater than 16M\n\n");
+		fprintf(stderr, "Few FPGA's have this kind of block RAM.\n");
+	}
+
+	return true;
+}
+// }}}
+
+int	sintable(FILE *fp, const char *cmdline, const char *fname,
 		int lgtable, int ow,
 		bool with_reset, bool with_aux, bool async_reset) {
 	// {{{
@@ -59,14 +107,8 @@ void	sintable(FILE *fp, const char *cmdline, const char *fname,
 	"//\t\tapproach to generating a sine wave.  It has the lowest latency\n"
 	"//\tamong all sinewave generation alternatives.";
 
-	if (lgtable >= 24) {
-		fprintf(stderr, "ERR: Requested table size is greater than 16M\n\n");
-		fprintf(stderr, "While this is an arbitrary limit, few FPGA's have this kind of\n");
-		fprintf(stderr, "block RAM.  If you know what you are doing, you can change this\n");
-		fprintf(stderr, "limit up to perhaps 30 without much hassle.  Beyond that, be\n");
-		fprintf(stderr, "aware of integer overflow.\n");
+	if (!check_table_size(lgtable, lgtable, ow))
 		exit(EXIT_FAILURE);
-	}
 
 	legal(fp, fname, PROJECT, PURPOSE);
 	fprintf(fp, "`default_nettype\tnone\n//\n");
@@ -153,26 +195,19 @@ void	sintable(FILE *fp, const char *cmdline, const char *fname,
 	}
 	fprintf(fp, "endmodule\n");
 
-	long	*tbldata;
-	tbldata = new long[(1<<lgtable)];
-	int	tbl_entries = (1<<lgtable);
-	long	maxv = (1l<<(ow-1))-1l;
-
-	for(int k=0; k<tbl_entries; k++) {
-		double	ph;
-		ph = 2.0 * M_PI * (double)k / (double)tbl_entries;
+	SINGEN	sg;
+	sg.m_maxv = (1l<<(ow-1))-1l;
+	sg.m_wave = sinewave(1l<<lgtable);
 
-		tbldata[k]  = (long)maxv * sin(ph);
-	}
-
-	hextable(fname, lgtable, ow, tbldata);
+	hextable(fname, lgtable, ow, singen, &sg);
+	free_sinewave(sg.m_wave);
 
-	delete[] tbldata;
+	return 1;
 	// }}}
 }
 
-void	quarterwav(FILE *fp, const char *cmdline, const char *fname,
-		int lgtable, int ow,
+int	quarterwav(FILE *fp, FILE *fhp, const char *cmdline, const char *fname,
+		int lgtable, int ow, bool dual,
 		bool with_reset, bool with_aux, bool async_reset) {
 	// {{{
 	// File header
@@ -184,19 +219,24 @@ void	quarterwav(FILE *fp, const char *cmdline, const char *fname,
 	"//\texploits the fact that a sinewave table has symmetry within it,\n"
 	"//\tenough symmetry so as to cut the necessary size of the table\n"
 	"//\tin fourths.  Generating the sinewave value, though, requires\n"
-	"//\ta little more logic to make this possible.";
+	"//\ta little more logic to make this possible.",
+		DPURPOSE[] =
+	"This is a touch more complicated than the simple sinewave table\n"
+	"//\t\tlookup approach to generating a sine wave.  This approach\n"
+	"//\texploits the fact that a sinewave table has symmetry within it,\n"
+	"//\tenough symmetry so as to cut the necessary size of the table\n"
+	"//\tin fourths.  The same symmetry, read from a second port of the\n"
+	"//\tsame table, also produces the cosine.",
+		HPURPOSE[] =
+	"This .h file notes the default parameter values from\n"
+	"//\t\twithin the generated file.  It is used to communicate\n"
+	"//\tinformation about the design to the bench testing code.";
 
 	assert(lgtable>2);
-	if (lgtable >= 26) {
-		fprintf(stderr, "ERR: Requested table size is greater than 16M\n\n");
-		fprintf(stderr, "While this is an arbitrary limit, few FPGA's have this kind of\n");
-		fprintf(stderr, "block RAM.  If you know what you are doing, you can change this\n");
-		fprintf(stderr, "limit up to perhaps 30 without much hassle.  Beyond that, be\n");
-		fprintf(stderr, "aware of integer overflow.\n");
+	if (!check_table_size(lgtable, lgtable-2, ow))
 		exit(EXIT_FAILURE);
-	}
 
-	legal(fp, fname, PROJECT, PURPOSE, cmdline);
+	legal(fp, fname, PROJECT, (dual) ? DPURPOSE : PURPOSE, cmdline);
 	name = modulename(fname);
 
 	std::string	resetw = (!with_reset) ? ""
@@ -225,13 +265,14 @@ void	quarterwav(FILE *fp, const char *cmdline, const char *fname,
 		"\t\t// {{{\n"
 		"\t\tinput\twire\t\t\ti_clk, %s%si_ce,\n"
 		"\t\tinput\twire\t[(PW-1):0]\ti_phase,\n"
-		"\t\toutput\treg\t[(OW-1):0]\to_val%s\n",
+		"\t\toutput\treg\t[(OW-1):0]\t%s%s\n",
 		name,
 		// resetw.c_str(), (with_reset) ? ", ":"",
 		// (with_aux)   ? "i_aux, ":"",
 		// (with_aux)   ? ", o_aux":"",
 		lgtable, ow,
-		resetw.c_str(), (with_reset) ? ", ":"", (with_aux) ? ",":"");
+		resetw.c_str(), (with_reset) ? ", ":"",
+		(dual) ? "o_sin, o_cos" : "o_val", (with_aux) ? ",":"");
 
 	if (with_aux)
 		fprintf(fp, "\t//\n"
@@ -252,6 +293,11 @@ void	quarterwav(FILE *fp, const char *cmdline, const char *fname,
 		"\treg\t[1:0]\tnegate;\n"
 		"\treg\t[(PW-3):0]\tindex;\n"
 		"\treg\t[(OW-1):0]\ttblvalue;\n", name);
+	if (dual)
+		fprintf(fp,
+		"\treg\t[1:0]\tcnegate;\n"
+		"\treg\t[(PW-3):0]\tcindex;\n"
+		"\treg\t[(OW-1):0]\tcosvalue;\n");
 	if (with_aux)
 		fprintf(fp, "\treg [1:0]\taux;\n");
 	fprintf(fp, "\t// }}}\n\n");
@@ -259,23 +305,47 @@ void	quarterwav(FILE *fp, const char *cmdline, const char *fname,
 
 	// Processing
 	// {{{
+	// In dual mode, the cosine is the sine a quarter wave later.  Adding
+	// one to the top two phase bits toggles the mirror bit, and toggles
+	// the sign bit whenever the mirror bit was set.  Both reads then come
+	// from the same table, as a dual-port ROM.
+	const char *oval = (dual) ? "o_sin" : "o_val";
+
+	if (dual)
+		fprintf(fp,
+		"\t// negate, index, tblvalue, o_sin, and the same for o_cos\n");
+	else
+		fprintf(fp,
+		"\t// negate, index, tblvalue, o_val\n");
 	fprintf(fp,
-		"\t// negate, index, tblvalue, o_val\n"
 		"\t// {{{\n"
 		"\tinitial\tnegate  = 2\'b00;\n"
 		"\tinitial\tindex   = 0;\n"
 		"\tinitial\ttblvalue= 0;\n"
-		"\tinitial\to_val   = 0;\n");
+		"\tinitial\t%s   = 0;\n", oval);
+	if (dual)
+		fprintf(fp,
+		"\tinitial\tcnegate = 2\'b00;\n"
+		"\tinitial\tcindex  = 0;\n"
+		"\tinitial\tcosvalue= 0;\n"
+		"\tinitial\to_cos   = 0;\n");
 	fprintf(fp, "%s", always_reset.c_str());
 
-	if (with_reset)
+	if (with_reset) {
 		fprintf(fp,
 			"\tbegin\n"
 			"\t\tnegate  <= 2\'b00;\n"
 			"\t\tindex   <= 0;\n"
 			"\t\ttblvalue<= 0;\n"
-			"\t\to_val   <= 0;\n"
-			"\tend else ");
+			"\t\t%s   <= 0;\n", oval);
+		if (dual)
+			fprintf(fp,
+			"\t\tcnegate <= 2\'b00;\n"
+			"\t\tcindex  <= 0;\n"
+			"\t\tcosvalue<= 0;\n"
+			"\t\to_cos   <= 0;\n");
+		fprintf(fp, "\tend else ");
+	}
 
 	fprintf(fp,
 		"if (i_ce)\n"
@@ -286,21 +356,43 @@ void	quarterwav(FILE *fp, const char *cmdline, const char *fname,
 			"\t\tif (i_phase[(PW-2)])\n"
 			"\t\t\tindex <= ~i_phase[(PW-3):0];\n"
 			"\t\telse\n"
-			"\t\t\tindex <=  i_phase[(PW-3):0];\n"
+			"\t\t\tindex <=  i_phase[(PW-3):0];\n");
+	if (dual)
+		fprintf(fp,
+			"\n"
+			"\t\tcnegate[0] <= i_phase[(PW-1)] ^ i_phase[(PW-2)];\n"
+			"\t\tif (i_phase[(PW-2)])\n"
+			"\t\t\tcindex <=  i_phase[(PW-3):0];\n"
+			"\t\telse\n"
+			"\t\t\tcindex <= ~i_phase[(PW-3):0];\n");
+	fprintf(fp,
 			"\t\t// }}}\n"
 			""
 			"\t\t// Clock #2\n"
 			"\t\t// {{{\n"
 			"\t\ttblvalue <= quartertable[index];\n"
-			"\t\tnegate[1] <= negate[0];\n"
+			"\t\tnegate[1] <= negate[0];\n");
+	if (dual)
+		fprintf(fp,
+			"\t\tcosvalue <= quartertable[cindex];\n"
+			"\t\tcnegate[1] <= cnegate[0];\n");
+	fprintf(fp,
 			"\t\t// }}}\n"
 			""
 			"\t\t// Output Clock\n"
 			"\t\t// {{{\n"
 			"\t\tif (negate[1])\n"
-			"\t\t\to_val <= -tblvalue;\n"
+			"\t\t\t%s <= -tblvalue;\n"
+			"\t\telse\n"
+			"\t\t\t%s <=  tblvalue;\n", oval, oval);
+	if (dual)
+		fprintf(fp,
+			"\n"
+			"\t\tif (cnegate[1])\n"
+			"\t\t\to_cos <= -cosvalue;\n"
 			"\t\telse\n"
-			"\t\t\to_val <=  tblvalue;\n"
+			"\t\t\to_cos <=  cosvalue;\n");
+	fprintf(fp,
 			"\t\t// }}}\n"
 		"\tend\n\t// }}}\n");
 	// }}}
@@ -322,21 +414,53 @@ void	quarterwav(FILE *fp, const char *cmdline, const char *fname,
 
 	// Build the lookup table
 	// {{{
-	long	*tbldata;
-	tbldata = new long[(1<<lgtable)];
-	int	tbl_entries = (1<<lgtable);
-	long	maxv = (1l<<(ow-1))-1l;
-
-	for(int k=0; k<tbl_entries/4; k++) {
-		double	ph;
-		ph = 2.0 * M_PI * (double)k / (double)tbl_entries;
-		ph+=       M_PI             / (double)tbl_entries;
-		tbldata[k] = maxv * sin(ph);
-	}
+	// Only the first quarter wave is placed in the table, offset by half
+	// a step so that every other quarter may be found by symmetry.
+	SINGEN	sg;
+	sg.m_maxv = (1l<<(ow-1))-1l;
+	sg.m_wave = sinewave(1l<<lgtable, true);
 
-	hextable(fname, lgtable-2, ow, tbldata);
+	hextable(fname, lgtable-2, ow, singen, &sg);
+	free_sinewave(sg.m_wave);
 	// }}}
 
-	delete[] tbldata;
+	if (NULL != fhp) {
+		// {{{
+		char	*str = new char[strlen(name)+4], *ptr;
+		sprintf(str, "%s.h", name);
+		legal(fhp, str, PROJECT, HPURPOSE);
+		ptr = str;
+		while(*ptr) {
+			if ('.' == *ptr)
+				*ptr = '_';
+			else	*ptr = toupper(*ptr);
+			ptr++;
+		}
+		fprintf(fhp, "#ifndef	%s\n", str);
+		fprintf(fhp, "#define	%s\n", str);
+		fprintf(fhp, "const\tint\tOW         = %d; // bits\n", ow);
+		fprintf(fhp, "const\tint\tPW         = %d; // bits\n", lgtable);
+		fprintf(fhp, "const\tint\tLATENCY    = 3; // clocks\n");
+		fprintf(fhp, "const\tlong\tTBL_LGSZ  = %d; // (Units)\n",
+			lgtable-2);
+		fprintf(fhp, "const\tlong\tTBL_SZ    = %ld; // (Units, 1/4 wave)\n",
+			(1l<<(lgtable-2)));
+		fprintf(fhp, "const\tlong\tSCALE     = %ld; // (Units)\n",
+			sg.m_maxv);
+		fprintf(fhp, "const\tbool\tHAS_RESET = %s;\n", with_reset?"true":"false");
+		fprintf(fhp, "const\tbool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
+		if (with_reset)
+			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
+		if (with_aux)
+			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+		if (dual)
+			fprintf(fhp, "#define\tHAS_COS_OUTPUT\n");
+		fprintf(fhp, "#endif	// %s\n", str);
+
+		delete[] str;
+		// }}}
+	}
+
+	return 3;
 	// }}}
 }
@@ -45,12 +45,15 @@
 
 #include <stdio.h>
 
-extern	void	sintable(FILE *fp, const char *fname, const char *cmdline,
+// Each returns its latency, the number of clocks from i_ce to the output
+extern	int	sintable(FILE *fp, const char *fname, const char *cmdline,
 			int lgtable, int ow,
 			bool with_reset, bool with_aux, bool async_reset);
 
-extern	void	quarterwav(FILE *fp, const char *fname, const char *cmdline,
-			int lgtable, int ow,
+// With dual set, quarterwav produces both o_sin and o_cos from one table, in
+// place of o_val, and describes itself in the header file fhp (if not NULL)
+extern	int	quarterwav(FILE *fp, FILE *fhp, const char *fname,
+			const char *cmdline, int lgtable, int ow, bool dual,
 			bool with_reset, bool with_aux, bool async_reset);
 
 #endif
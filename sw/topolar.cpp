@@ -37,6 +37,7 @@
 //
 // }}}
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 #include <string.h>
 #include <string>
@@ -47,10 +48,192 @@
 #include "cordiclib.h"
 #include "topolar.h"
 
-void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int nstages, int iw, int ow,
+static	void	topolar_model(FILE *fhp, int nstages, int iw, int ow, int ww,
+		int phase_bits, bool radix4, bool unit_gain) {
+	// {{{
+	int	nr4 = (radix4) ? radix4_stages(nstages, ww, phase_bits) : 0;
+
+	assert(ww < 64);
+	assert(phase_bits < 64);
+
+	fprintf(fhp,
+"\n"
+"// Bit-exact model\n"
+"// {{{\n"
+"// The following duplicates, in integer arithmetic, the logic of the core\n"
+"// above: the same quadrant pre-rotation, the same truncated CORDIC angles,\n"
+"// the same vectoring decisions, and the same round-towards-even magnitude.\n"
+"// Given the same inputs, topolar_model() will return exactly what the core\n"
+"// will produce on o_mag and o_phase LATENCY clocks later.\n"
+"//\n"
+"#define\tHAS_TOPOLAR_MODEL\n\n");
+
+	if (unit_gain)
+		fprintf(fhp, "static const unsigned long\tGAIN_COMP = 0x%lxul;\n\n",
+			gain_coefficient(((nr4 > 0)
+				? radix4_gain(nstages, ww, phase_bits)
+				: cordic_gain(nstages)) * sqrt(2.0) / 2., ww));
+
+	fprintf(fhp, "static const unsigned long\tTOPOLAR_ANGLE[%d] = {", nstages);
+	for(int k=0; k<nstages; k++) {
+		fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+			(0 == (k%4)) ? "\n\t" : " ",
+			(phase_bits+3)/4, cordic_angle(k, phase_bits));
+	} fprintf(fhp, "\n};\n\n");
+
+	if (nr4 > 0) {
+		// {{{
+		int	s0 = radix4_start(ww);
+
+		fprintf(fhp, "static const unsigned long\tTOPOLAR_ANGLE4[%d] = {",
+			2*nr4);
+		for(int k=0; k<2*nr4; k++) {
+			fprintf(fhp, "%s%s0x%0*lx", (k > 0) ? ",":"",
+				(0 == (k%4)) ? "\n\t" : " ",
+				(phase_bits+3)/4,
+				radix4_angle(s0+2*(k/2), 1+(k&1), phase_bits));
+		} fprintf(fhp, "\n};\n\n");
+		// }}}
+	}
+
+	fprintf(fhp,
+"// Sign extend the bottom w bits of v\n"
+"static inline long\ttopolar_sext(unsigned long v, int w) {\n"
+"\treturn ((long)(v << (64-w))) >> (64-w);\n"
+"}\n\n");
+
+	fprintf(fhp,
+"static inline void\ttopolar_model(long i_xval, long i_yval,\n"
+"\t\tlong &o_mag, unsigned long &o_phase) {\n"
+"\tconst\tunsigned long	PMSK = (1ul << PW) - 1;\n"
+"\tlong\t\tex, ey, xv, yv;\n"
+"\tunsigned long\tph;\n"
+"\n"
+"\t// Sign extend our inputs to the working width\n"
+"\tex = topolar_sext(i_xval, IW) * (1l << (WW-IW-2));\n"
+"\tey = topolar_sext(i_yval, IW) * (1l << (WW-IW-2));\n"
+"\n"
+"\t// Pre-CORDIC rotation, to within +/- 45 degrees\n"
+"\tswitch(((i_xval >> (IW-1))&1)*2 + ((i_yval >> (IW-1))&1)) {\n"
+"\tcase 1:\t// Rotate by -315 degrees\n"
+"\t\txv =  ex - ey; yv =  ex + ey;\n"
+"\t\tph = 7ul << (PW-3);\n"
+"\t\tbreak;\n"
+"\tcase 2:\t// Rotate by -135 degrees\n"
+"\t\txv = -ex + ey; yv = -ex - ey;\n"
+"\t\tph = 3ul << (PW-3);\n"
+"\t\tbreak;\n"
+"\tcase 3:\t// Rotate by -225 degrees\n"
+"\t\txv = -ex - ey; yv =  ex - ey;\n"
+"\t\tph = 5ul << (PW-3);\n"
+"\t\tbreak;\n"
+"\tdefault:\t// Rotate by -45 degrees\n"
+"\t\txv =  ex + ey; yv = -ex + ey;\n"
+"\t\tph = 1ul << (PW-3);\n"
+"\t\tbreak;\n"
+"\t}\n"
+"\n"
+"\txv = topolar_sext(xv, WW);\n"
+"\tyv = topolar_sext(yv, WW);\n"
+"\n"
+"\t// CORDIC rotations\n"
+"\tfor(int k=0; k<%s; k++) {\n"
+"\t\tlong\tdx, dy;\n"
+"\n"
+"\t\tif ((TOPOLAR_ANGLE[k] == 0)||(k >= WW))\n"
+"\t\t\tcontinue;\n"
+"\n"
+"\t\tdx = xv >> (k+1);\n"
+"\t\tdy = yv >> (k+1);\n"
+"\t\tif (yv < 0) {\n"
+"\t\t\t// Below the axis, rotate counter-clockwise\n"
+"\t\t\txv = topolar_sext(xv - dy, WW);\n"
+"\t\t\tyv = topolar_sext(yv + dx, WW);\n"
+"\t\t\tph = (ph - TOPOLAR_ANGLE[k]) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\t// Above the axis, rotate clockwise\n"
+"\t\t\txv = topolar_sext(xv + dy, WW);\n"
+"\t\t\tyv = topolar_sext(yv - dx, WW);\n"
+"\t\t\tph = (ph + TOPOLAR_ANGLE[k]) & PMSK;\n"
+"\t\t}\n"
+"\t}\n"
+"\n", (nr4 > 0) ? "NR2" : "NSTAGES");
+
+	if (nr4 > 0) {
+		fprintf(fhp,
+"\t// Radix-4 rotations, each by atan(d*2^-sh) for d in {-2..2}, where\n"
+"\t// d is the nearest multiple of 2^-sh to y/x\n"
+"\tfor(int k=0; k<NR4; k++) {\n"
+"\t\tconst\tint\tsh = R4_SHIFT0 + 2*k;\n"
+"\t\tlong\tlo, hi, dx, dy;\n"
+"\t\tint\td;\n"
+"\n"
+"\t\tlo = xv >> (sh+1);\n"
+"\t\thi = topolar_sext(lo + (xv >> sh), WW);\n"
+"\t\tif (yv >= hi)\n"
+"\t\t\td = 2;\n"
+"\t\telse if (yv >= lo)\n"
+"\t\t\td = 1;\n"
+"\t\telse if (yv > -lo)\n"
+"\t\t\td = 0;\n"
+"\t\telse if (yv > -hi)\n"
+"\t\t\td = -1;\n"
+"\t\telse\n"
+"\t\t\td = -2;\n"
+"\n"
+"\t\tif (d == 0)\n"
+"\t\t\tcontinue;\n"
+"\n"
+"\t\tdx = xv >> ((d == 2 || d == -2) ? sh-1 : sh);\n"
+"\t\tdy = yv >> ((d == 2 || d == -2) ? sh-1 : sh);\n"
+"\t\tif (d > 0) {\n"
+"\t\t\t// Above the axis, rotate clockwise\n"
+"\t\t\txv = topolar_sext(xv + dy, WW);\n"
+"\t\t\tyv = topolar_sext(yv - dx, WW);\n"
+"\t\t\tph = (ph + TOPOLAR_ANGLE4[2*k+d-1]) & PMSK;\n"
+"\t\t} else {\n"
+"\t\t\t// Below the axis, rotate counter-clockwise\n"
+"\t\t\txv = topolar_sext(xv - dy, WW);\n"
+"\t\t\tyv = topolar_sext(yv + dx, WW);\n"
+"\t\t\tph = (ph - TOPOLAR_ANGLE4[2*k-d-1]) & PMSK;\n"
+"\t\t}\n"
+"\t}\n"
+"\n");
+	}
+
+	if (unit_gain)
+		fprintf(fhp,
+"\t// Gain compensation, rounded back to the working width\n"
+"\txv = topolar_sext((long)(((__int128)xv * GAIN_COMP\n"
+"\t\t\t+ ((__int128)1 << (WW-1))) >> WW), WW);\n"
+"\n");
+
+	if (ww > ow+1) {
+		fprintf(fhp,
+"\t// Round towards even, then drop the extra bits\n"
+"\tif ((xv >> (WW-OW)) & 1)\n"
+"\t\txv += (1l << (WW-OW-1));\n"
+"\telse\n"
+"\t\txv += (1l << (WW-OW-1)) - 1;\n"
+"\txv = topolar_sext(xv, WW);\n\n");
+	} else
+		fprintf(fhp,
+"\t// No rounding required\n");
+
+	fprintf(fhp,
+"\to_mag   = xv >> (WW-OW);\n"
+"\to_phase = ph;\n"
+"}\n"
+"// }}}\n");
+	// }}}
+}
+
+int	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int nstages, int iw, int ow,
 		int nxtra, int phase_bits, bool with_reset, bool with_aux,
-		bool async_reset) {
-	int	working_width = iw;
+		bool async_reset, int lanes, int regs, bool radix4,
+		bool unit_gain) {
+	int	working_width = iw, nregs, nr2 = nstages, nr4 = 0;
+	double	gain;
 	const	char	*name;
 	const	char PURPOSE[] =
 	"This is a rectangular to polar conversion routine based upon an\n"
@@ -75,6 +258,74 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 	working_width += nxtra;
 	name = modulename(fname);
 
+	// A stage whose angle rounds to zero, or whose shift would clear the
+	// working width, only ever passes its inputs along.  Such stages can
+	// only come at the end, so drop them.
+	nstages = active_stages(nstages, working_width, phase_bits);
+	nr2 = nstages;
+
+	// With more than one CORDIC stage between registers, the pipeline
+	// holds only nregs registered stages.  Throughout, depth names the
+	// last of these.
+	if (regs < 1)
+		regs = 1;
+	nregs = (nstages + regs - 1) / regs;
+
+	// A radix-4 core follows its first nr2 radix-2 stages with nr4
+	// radix-4 ones.  If there's no room for any radix-4 stages, it's
+	// just a radix-2 core.
+	if (radix4) {
+		nr4 = radix4_stages(nstages, working_width, phase_bits);
+		if (nr4 > 0) {
+			nr2 = radix2_stages(nstages, working_width);
+			nregs = nr2 + nr4;
+		} else
+			radix4 = false;
+	}
+
+	const	char	*depth = (regs > 1) ? "NREGS"
+				: (radix4) ? "NPIPE" : "NSTAGES";
+
+	gain = ((radix4) ? radix4_gain(nstages, working_width, phase_bits)
+			: cordic_gain(nstages)) * sqrt(2.0) / 2.;
+
+	// Gain compensation takes one more clock.  The rounding stage then
+	// reads from its registers, rather than the last CORDIC stage, and the
+	// aux pipeline grows by one.
+	std::string	xsrc = std::string("xv[") + depth + "]",
+			psrc = std::string("ph[") + depth + "]",
+			axdepth = depth;
+	if (unit_gain)
+		axdepth += "+1";
+	std::string	regparams = "";
+	if (regs > 1) {
+		char	buf[128];
+		sprintf(buf, "\t\t\tNREGS=%2d,\t// Registered CORDIC stages\n"
+			"\t\t\tREGS_EVERY=%2d,\t// CORDIC stages per register\n",
+			nregs, regs);
+		regparams = buf;
+	} else if (radix4) {
+		char	buf[160];
+		sprintf(buf, "\t\t\tNR2=%2d,\t// Radix-2 stages\n"
+			"\t\t\tNR4=%2d,\t// Radix-4 stages, following them\n"
+			"\t\t\tNPIPE=%2d,\t// Registered CORDIC stages\n",
+			nr2, nr4, nregs);
+		regparams = buf;
+	}
+
+	// With more than one lane, the datapath is first written into a
+	// buffer, and then copied into a generate block covering every lane.
+	// The angle table and the aux pipeline are shared by all lanes.
+	FILE	*dp = fp;
+	char	*dpbuf = NULL;
+	size_t	dplen = 0;
+	bool	lane_aux = (with_aux)&&(lanes <= 1);
+
+	if (lanes > 1) {
+		dp = open_memstream(&dpbuf, &dplen);
+		assert(dp);
+	}
+
 	std::string	resetw = (!with_reset) ? ""
 			: (async_reset) ? "i_areset_n, ":"i_reset, ";
 	std::string	always_reset = "\talways @(posedge i_clk)\n\t";
@@ -86,12 +337,39 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 			"\tif (i_reset)\n";
 
 	fprintf(fp, "`default_nettype\tnone\n//\n");
+	if (lanes > 1) {
+		// {{{
+		fprintf(fp,
+		"module	%s #(\n"
+		"\t\t// {{{\n"
+		"\t\tlocalparam\tNLANES=%2d,\t// Samples processed per clock\n"
+		"\t\t\tIW=%2d,\t// The number of bits in our inputs\n"
+		"\t\t\tOW=%2d,// The number of output bits to produce\n"
+		"\t\t\tNSTAGES=%2d,\n%s"
+		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
+		"\t\t\tWW=%2d,\t// Our working bit-width\n"
+		"\t\t\tPW=%2d\t// Bits in our phase variables\n"
+		"\t\t// }}}\n"
+		"\t) (\n"
+		"\t\t// {{{\n"
+		"\tinput\twire\t\t\t\ti_clk, %si_ce,\n"
+		"\t// Lane k occupies bits [k*IW +: IW] of i_xval and i_yval,\n"
+		"\t// bits [k*OW +: OW] of o_mag, and so on.\n"
+		"\tinput\twire\tsigned\t[(NLANES*IW-1):0]\ti_xval, i_yval,\n"
+		"\toutput\twire\tsigned\t[(NLANES*OW-1):0]\to_mag,\n"
+		"\toutput\twire\t\t[(NLANES*PW-1):0]\to_phase%s\n",
+		name, lanes,
+		iw, ow, nstages, regparams.c_str(), nxtra,
+		working_width, phase_bits,
+		resetw.c_str(), (with_aux) ? ",":"");
+		// }}}
+	} else
 	fprintf(fp,
 		"module	%s #(\n"
 		"\t\t// {{{\n"
 		"\t\tlocalparam\tIW=%2d,\t// The number of bits in our inputs\n"
 		"\t\t\tOW=%2d,// The number of output bits to produce\n"
-		"\t\t\tNSTAGES=%2d,\n"
+		"\t\t\tNSTAGES=%2d,\n%s"
 		"\t\t\t// XTRA=%2d,// Extra bits for internal precision\n"
 		"\t\t\tWW=%2d,\t// Our working bit-width\n"
 		"\t\t\tPW=%2d\t// Bits in our phase variables\n"
@@ -103,7 +381,8 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 		"\toutput\treg\tsigned\t[(OW-1):0]\to_mag,\n"
 		"\toutput\treg\t\t[(PW-1):0]\to_phase%s\n",
 		name,
-		iw, ow, nstages, nxtra, working_width, phase_bits,
+		iw, ow, nstages, regparams.c_str(), nxtra,
+		working_width, phase_bits,
 		resetw.c_str(), (with_aux) ? ",":"");
 
 	if (with_aux) {
@@ -113,19 +392,19 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 	}
 	fprintf(fp, "\t\t// }}}\n\t);\n");
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t// Declare variables for all of the separate stages\n"
 		"\t// {{{\n"
 		"\twire\tsigned [(WW-1):0]\te_xval, e_yval;\n"
-		"\treg	signed	[(WW-1):0]\txv\t[0:NSTAGES];\n"
-		"\treg	signed	[(WW-1):0]\tyv\t[0:NSTAGES];\n"
-		"\treg		[(PW-1):0]\tph\t[0:NSTAGES];\n"
-		"\t// }}}\n");
+		"\treg	signed	[(WW-1):0]\txv\t[0:%s];\n"
+		"\treg	signed	[(WW-1):0]\tyv\t[0:%s];\n"
+		"\treg		[(PW-1):0]\tph\t[0:%s];\n"
+		"\t// }}}\n", depth, depth, depth);
 
 
 	// Sign extend (if necessary)
 	// {{{
-	fprintf(fp,
+	fprintf(dp,
 		"\t// Sign extension\n"
 		"\t// {{{\n"
 		"\t// First step: expand our input to our working width.\n"
@@ -137,18 +416,18 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 		"\t// \n");
 
 	if (working_width-iw > 2) {
-		fprintf(fp,
+		fprintf(dp,
 			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval, {(WW-IW-2){1'b0}} };\n"
 			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval, {(WW-IW-2){1'b0}} };\n\n");
 	} else if (working_width-iw > 1) {
-		fprintf(fp,
+		fprintf(dp,
 			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}}, i_xval };\n"
 			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}}, i_yval };\n\n");
 	} else {
-		fprintf(fp,
+		fprintf(dp,
 			"\tassign\te_xval = { {(2){i_xval[(IW-1)]}, i_xval[(IW-1):1] };\n"
 			"\tassign\te_yval = { {(2){i_yval[(IW-1)]}, i_yval[(IW-1):1] };\n\n");
-	} fprintf(fp, "\t// }}}\n");
+	} fprintf(dp, "\t// }}}\n");
 	// }}}
 
 	if (with_aux) {
@@ -164,8 +443,8 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 "\t// are input together with i_aux, then when o_xval and o_yval are set\n"
 "\t// to this value, o_aux *must* contain the value that was in i_aux.\n"
 "\t//\n"
-"\treg\t\t[(NSTAGES):0]\tax;\n"
-"\n");
+"\treg\t\t[(%s):0]\tax;\n"
+"\n", axdepth.c_str());
 
 		fprintf(fp,
 "\tinitial\tax = 0;\n");
@@ -177,15 +456,15 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 "\telse ");
 
 		fprintf(fp, "if (i_ce)\n"
-"\t\tax <= { ax[(NSTAGES-1):0], i_aux };\n"
-"\n");
+"\t\tax <= { ax[(%s-1):0], i_aux };\n"
+"\n", axdepth.c_str());
 		fprintf(fp, "\t// }}}\n");
 		// }}}
 	}
 
 	// Pre-CORDIC rotations
 	// {{{
-	fprintf(fp,
+	fprintf(dp,
 		"\t// Pre-CORDIC rotation\n"
 		"\t// {{{\n"
 		"\tinitial begin\n"
@@ -193,22 +472,22 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 		"\t\tyv[0] = 0;\n"
 		"\t\tph[0] = 0;\n"
 		"\tend\n");
-	fprintf(fp,
+	fprintf(dp,
 		"\t// First stage, map to within +/- 45 degrees\n"
 		"%s", always_reset.c_str());
 	if (with_reset)
-		fprintf(fp,
+		fprintf(dp,
 			"\tbegin\n"
 			"\t\txv[0] <= 0;\n"
 			"\t\tyv[0] <= 0;\n"
 			"\t\tph[0] <= 0;\n"
 			"\tend else ");
-	fprintf(fp, "if (i_ce)\n\t");
+	fprintf(dp, "if (i_ce)\n\t");
 
-	fprintf(fp,
+	fprintf(dp,
 		"case({i_xval[IW-1], i_yval[IW-1]})\n");
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t2\'b01: begin // Rotate by -315 degrees\n"
 		"\t\t// {{{\n"
 		"\t\txv[0] <=  e_xval - e_yval;\n"
@@ -217,7 +496,7 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 		"\t\tend\n"
 		"\t\t// }}}\n",
 			phase_bits, (7ul << (phase_bits-3)));
-	fprintf(fp,
+	fprintf(dp,
 		"\t2\'b10: begin // Rotate by -135 degrees\n"
 		"\t\t// {{{\n"
 		"\t\txv[0] <= -e_xval + e_yval;\n"
@@ -227,7 +506,7 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 		"\t\t// }}}\n",
 			phase_bits, (3ul << (phase_bits-3)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t2\'b11: begin // Rotate by -225 degrees\n"
 		"\t\t// {{{\n"
 		"\t\txv[0] <= -e_xval - e_yval;\n"
@@ -237,7 +516,7 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 		"\t\t// }}}\n",
 			phase_bits, (5ul << (phase_bits-3)));
 
-	fprintf(fp,
+	fprintf(dp,
 		"\t// 2\'b00:\n"
 		"\t\t// {{{\n"
 		"\tdefault: begin // Rotate by -45 degrees\n"
@@ -252,123 +531,250 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 	// }}}
 
 	cordic_angles(fp, nstages, phase_bits);
+	if (radix4)
+		radix4_angles(fp, nstages, working_width, phase_bits, false);
 
 	// CORDIC rotation stages
 	// {{{
-	fprintf(fp,"\n"
-		"\t// Actual CORDIC rotations\n"
-		"\t// {{{\n"
-		"\tgenvar\ti;\n"
-		"\tgenerate for(i=0; i<NSTAGES; i=i+1) begin : TOPOLARloop\n");
-
-	fprintf(fp,
-		"\t\tinitial begin\n"
-		"\t\t\txv[i+1] = 0;\n"
-		"\t\t\tyv[i+1] = 0;\n"
-		"\t\t\tph[i+1] = 0;\n"
-		"\t\tend\n\n");
-	if ((with_reset)&&(async_reset))
-		fprintf(fp,
-			"\t\talways @(posedge i_clk, negedge i_areset_n)\n");
-	else
-		fprintf(fp,
-		"\t\talways @(posedge i_clk)\n");
-
-	fprintf(fp,
-		"\t\t// Here\'s where we are going to put the actual CORDIC\n"
-		"\t\t// rectangular to polar loop.  Everything up to this\n"
-		"\t\t// point has simply been necessary preliminaries.\n");
-	if (with_reset) {
-		if (async_reset)
-			fprintf(fp, "\t\tif (!i_areset_n)\n");
+	if (regs > 1) {
+		// {{{
+		fprintf(dp,"\n"
+			"\t// Actual CORDIC rotations\n"
+			"\t// {{{\n"
+			"\t// Each registered stage applies REGS_EVERY CORDIC rotations,\n"
+			"\t// one after the other, before registering the result.\n"
+			"\tgenvar\ti, j;\n"
+			"\t%sfor(i=0; i<NREGS; i=i+1) begin : TOPOLARloop\n",
+			(lanes > 1) ? "" : "generate ");
+
+		fprintf(dp,
+			"\t\twire\tsigned\t[(WW-1):0]\tcx\t[0:REGS_EVERY];\n"
+			"\t\twire\tsigned\t[(WW-1):0]\tcy\t[0:REGS_EVERY];\n"
+			"\t\twire\t\t[(PW-1):0]\tcph\t[0:REGS_EVERY];\n"
+			"\n"
+			"\t\tassign\tcx[0]  = xv[i];\n"
+			"\t\tassign\tcy[0]  = yv[i];\n"
+			"\t\tassign\tcph[0] = ph[i];\n"
+			"\n"
+			"\t\tfor(j=0; j<REGS_EVERY; j=j+1) begin : ITER\n"
+			"\t\t\tlocalparam\tS = i*REGS_EVERY+j;\n"
+			"\n"
+			"\t\t\tif (S >= NSTAGES)\n"
+			"\t\t\tbegin : PASS\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// The last register may be only partially\n"
+			"\t\t\t\t// used, if REGS_EVERY doesn't divide NSTAGES\n"
+			"\t\t\t\tassign\tcx[j+1]  = cx[j];\n"
+			"\t\t\t\tassign\tcy[j+1]  = cy[j];\n"
+			"\t\t\t\tassign\tcph[j+1] = cph[j];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else begin : ROTATE\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// As before, a vector below the axis\n"
+			"\t\t\t\t// rotates up, one above it rotates down\n"
+			"\t\t\t\twire\tskip;\n"
+			"\n"
+			"\t\t\t\tassign\tskip = (cordic_angle[S] == 0)||(S >= WW);\n"
+			"\t\t\t\tassign\tcx[j+1] = (skip) ? cx[j]\n"
+			"\t\t\t\t\t: (cy[j][WW-1]) ? (cx[j] - (cy[j]>>>(S+1)))\n"
+			"\t\t\t\t\t: (cx[j] + (cy[j]>>>(S+1)));\n"
+			"\t\t\t\tassign\tcy[j+1] = (skip) ? cy[j]\n"
+			"\t\t\t\t\t: (cy[j][WW-1]) ? (cy[j] + (cx[j]>>>(S+1)))\n"
+			"\t\t\t\t\t: (cy[j] - (cx[j]>>>(S+1)));\n"
+			"\t\t\t\tassign\tcph[j+1] = (skip) ? cph[j]\n"
+			"\t\t\t\t\t: (cy[j][WW-1]) ? (cph[j] - cordic_angle[S])\n"
+			"\t\t\t\t\t: (cph[j] + cordic_angle[S]);\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend\n"
+			"\t\tend\n\n");
+
+		fprintf(dp,
+			"\t\tinitial begin\n"
+			"\t\t\txv[i+1] = 0;\n"
+			"\t\t\tyv[i+1] = 0;\n"
+			"\t\t\tph[i+1] = 0;\n"
+			"\t\tend\n\n");
+		if ((with_reset)&&(async_reset))
+			fprintf(dp,
+				"\t\talways @(posedge i_clk, negedge i_areset_n)\n");
 		else
-			fprintf(fp, "\t\tif (i_reset)\n");
-		fprintf(fp,
+			fprintf(dp,
+			"\t\talways @(posedge i_clk)\n");
+
+		if (with_reset) {
+			if (async_reset)
+				fprintf(dp, "\t\tif (!i_areset_n)\n");
+			else
+				fprintf(dp, "\t\tif (i_reset)\n");
+			fprintf(dp,
+				"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tph[i+1] <= 0;\n"
+				"\t\t\t// }}}\n"
+				"\t\tend else if (i_ce)\n");
+		} else
+			fprintf(dp,
+				"\t\tif (i_ce)\n");
+
+		fprintf(dp,
 			"\t\tbegin\n"
 			"\t\t\t// {{{\n"
-			"\t\t\txv[i+1] <= 0;\n"
-			"\t\t\tyv[i+1] <= 0;\n"
-			"\t\t\tph[i+1] <= 0;\n"
+			"\t\t\txv[i+1] <= cx[REGS_EVERY];\n"
+			"\t\t\tyv[i+1] <= cy[REGS_EVERY];\n"
+			"\t\t\tph[i+1] <= cph[REGS_EVERY];\n"
 			"\t\t\t// }}}\n"
-			"\t\tend else if (i_ce)\n");
-	} else
-		fprintf(fp,
-			"\t\tif (i_ce)\n");
+			"\t\tend\n"
+			"\tend%s\n\t// }}}\n\n",
+			(lanes > 1) ? "" : " endgenerate");
+		// }}}
+	} else {
+		// {{{
+		fprintf(dp,"\n"
+			"\t// Actual CORDIC rotations\n"
+			"\t// {{{\n"
+			"\tgenvar\ti;\n"
+			"\t%sfor(i=0; i<%s; i=i+1) begin : TOPOLARloop\n",
+			(lanes > 1) ? "" : "generate ",
+			(radix4) ? "NR2" : "NSTAGES");
+
+		fprintf(dp,
+			"\t\tinitial begin\n"
+			"\t\t\txv[i+1] = 0;\n"
+			"\t\t\tyv[i+1] = 0;\n"
+			"\t\t\tph[i+1] = 0;\n"
+			"\t\tend\n\n");
+		if ((with_reset)&&(async_reset))
+			fprintf(dp,
+				"\t\talways @(posedge i_clk, negedge i_areset_n)\n");
+		else
+			fprintf(dp,
+			"\t\talways @(posedge i_clk)\n");
 
-	fprintf(fp,
-		"\t\tbegin\n"
-		"\t\t\t// {{{\n"
-		"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
-		"\t\t\tbegin // Do nothing but move our vector\n"
-		"\t\t\t// forward one stage, since we have more\n"
-		"\t\t\t// stages than valid data\n"
-		"\t\t\t\t// {{{\n"
-		"\t\t\t\txv[i+1] <= xv[i];\n"
-		"\t\t\t\tyv[i+1] <= yv[i];\n"
-		"\t\t\t\tph[i+1] <= ph[i];\n"
-		"\t\t\t\t// }}}\n"
-		"\t\t\tend else if (yv[i][(WW-1)]) // Below the axis\n"
-		"\t\t\tbegin\n"
-		"\t\t\t\t// {{{\n"
-		"\t\t\t\t// If the vector is below the x-axis, rotate by\n"
-		"\t\t\t\t// the CORDIC angle in a positive direction.\n"
-		"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
-		"\t\t\t\t// }}}\n"
-		"\t\t\tend else begin\n"
-		"\t\t\t\t// {{{\n"
-		"\t\t\t\t// On the other hand, if the vector is above the\n"
-		"\t\t\t\t// x-axis, then rotate in the other direction\n"
-		"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
-		"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
-		"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
-		"\t\t\t\t// }}}\n"
-		"\t\t\tend\n"
-		"\t\t\t// }}}\n"
-		"\t\tend\n"
-		"\tend endgenerate\n\t// }}}\n\n");
+		fprintf(dp,
+			"\t\t// Here\'s where we are going to put the actual CORDIC\n"
+			"\t\t// rectangular to polar loop.  Everything up to this\n"
+			"\t\t// point has simply been necessary preliminaries.\n");
+		if (with_reset) {
+			if (async_reset)
+				fprintf(dp, "\t\tif (!i_areset_n)\n");
+			else
+				fprintf(dp, "\t\tif (i_reset)\n");
+			fprintf(dp,
+				"\t\tbegin\n"
+				"\t\t\t// {{{\n"
+				"\t\t\txv[i+1] <= 0;\n"
+				"\t\t\tyv[i+1] <= 0;\n"
+				"\t\t\tph[i+1] <= 0;\n"
+				"\t\t\t// }}}\n"
+				"\t\tend else if (i_ce)\n");
+		} else
+			fprintf(dp,
+				"\t\tif (i_ce)\n");
+
+		fprintf(dp,
+			"\t\tbegin\n"
+			"\t\t\t// {{{\n"
+			"\t\t\tif ((cordic_angle[i] == 0)||(i >= WW))\n"
+			"\t\t\tbegin // Do nothing but move our vector\n"
+			"\t\t\t// forward one stage, since we have more\n"
+			"\t\t\t// stages than valid data\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\txv[i+1] <= xv[i];\n"
+			"\t\t\t\tyv[i+1] <= yv[i];\n"
+			"\t\t\t\tph[i+1] <= ph[i];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else if (yv[i][(WW-1)]) // Below the axis\n"
+			"\t\t\tbegin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// If the vector is below the x-axis, rotate by\n"
+			"\t\t\t\t// the CORDIC angle in a positive direction.\n"
+			"\t\t\t\txv[i+1] <= xv[i] - (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] + (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= ph[i] - cordic_angle[i];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend else begin\n"
+			"\t\t\t\t// {{{\n"
+			"\t\t\t\t// On the other hand, if the vector is above the\n"
+			"\t\t\t\t// x-axis, then rotate in the other direction\n"
+			"\t\t\t\txv[i+1] <= xv[i] + (yv[i]>>>(i+1));\n"
+			"\t\t\t\tyv[i+1] <= yv[i] - (xv[i]>>>(i+1));\n"
+			"\t\t\t\tph[i+1] <= ph[i] + cordic_angle[i];\n"
+			"\t\t\t\t// }}}\n"
+			"\t\t\tend\n"
+			"\t\t\t// }}}\n"
+			"\t\tend\n"
+			"\tend%s\n\t// }}}\n\n",
+			(lanes > 1) ? "" : " endgenerate");
+
+		if (radix4)
+			radix4_rotations(dp, nstages, working_width,
+				phase_bits, nr2, true, always_reset.c_str(),
+				with_reset);
+		// }}}
+	}
 	// }}}
 
+	if (unit_gain) {
+		// {{{
+		const	char	*src[1] = { xsrc.c_str() },
+				*dst[1] = { "gxv" };
+
+		gain_compensation(dp, working_width, gain, 1, src, dst, "i_ce");
+		fprintf(dp,
+			"\t// The phase needs no compensation, only the delay\n"
+			"\t// {{{\n"
+			"\treg\t\t[(PW-1):0]\tgph;\n\n"
+			"\tinitial\tgph = 0;\n"
+			"\talways @(posedge i_clk)\n"
+			"\tif (i_ce)\n"
+			"\t\tgph <= %s;\n"
+			"\t// }}}\n\n", psrc.c_str());
+		xsrc = dst[0];
+		psrc = "gph";
+		// }}}
+	}
+
 	// Round the results (if necessary)
 	// {{{
 	if (working_width > ow+1) {
-		fprintf(fp,
+		fprintf(dp,
 			"\t// Round our magnitude towards even\n"
 			"\t// {{{\n"
 			"\twire\t[(WW-1):0]\tpre_mag;\n\n"
-			"\tassign\tpre_mag = xv[NSTAGES] + $signed({ {(OW){1\'b0}},\n"
-				"\t\t\t\txv[NSTAGES][(WW-OW)],\n"
-				"\t\t\t\t{(WW-OW-1){!xv[NSTAGES][WW-OW]}} });\n"
-			"\n");
+			"\tassign\tpre_mag = %s + $signed({ {(OW){1\'b0}},\n"
+				"\t\t\t\t%s[(WW-OW)],\n"
+				"\t\t\t\t{(WW-OW-1){!%s[WW-OW]}} });\n"
+			"\n", xsrc.c_str(), xsrc.c_str(), xsrc.c_str());
 
-		fprintf(fp,
+		fprintf(dp,
 			"\tinitial\to_mag   = 0;\n"
 			"\tinitial\to_phase = 0;\n");
-		if (with_aux)
-			fprintf(fp, "\tinitial\to_aux   = 0;\n");
-		fprintf(fp, "%s", always_reset.c_str());
+		if (lane_aux)
+			fprintf(dp, "\tinitial\to_aux   = 0;\n");
+		fprintf(dp, "%s", always_reset.c_str());
 		if (with_reset) {
-			fprintf(fp,
+			fprintf(dp,
 				"\tbegin\n"
 				"\t\to_mag   <= 0;\n"
 				"\t\to_phase <= 0;\n");
-			if (with_aux)
-				fprintf(fp,
+			if (lane_aux)
+				fprintf(dp,
 				"\t\to_aux   <= 0;\n");
-			fprintf(fp, "\tend else ");
+			fprintf(dp, "\tend else ");
 		}
 
-		fprintf(fp, "if (i_ce)\n"
+		fprintf(dp, "if (i_ce)\n"
 			"\tbegin\n"
 			"\t\to_mag   <= pre_mag[(WW-1):(WW-OW)];\n"
-			"\t\to_phase <= ph[NSTAGES];\n");
-		if (with_aux)
-			fprintf(fp,
-			"\t\to_aux <= ax[NSTAGES];\n");
-		fprintf(fp, "\tend\n\n");
+			"\t\to_phase <= %s;\n", psrc.c_str());
+		if (lane_aux)
+			fprintf(dp,
+			"\t\to_aux <= ax[%s];\n", axdepth.c_str());
+		fprintf(dp, "\tend\n\n");
 
-		fprintf(fp, "\t// Make Verilator happy with pre_.val\n"
+		fprintf(dp, "\t// Make Verilator happy with pre_.val\n"
 			"\t// verilator lint_off UNUSED\n"
 			"\twire\tunused_val;\n"
 			"\tassign\tunused_val = &{ 1\'b0, "
@@ -378,35 +784,82 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 	} else {
 		// No rounding required
 		// {{{
-		fprintf(fp,
+		fprintf(dp,
 			"\t// No rounding required\n"
 			"\t// {{{\n"
 			"\tinitial\to_mag   = 0;\n"
 			"\tinitial\to_phase = 0;\n");
-		if (with_aux)
-			fprintf(fp, "\tinitial\to_aux = 0;\n");
-		fprintf(fp, "%s", always_reset.c_str());
+		if (lane_aux)
+			fprintf(dp, "\tinitial\to_aux = 0;\n");
+		fprintf(dp, "%s", always_reset.c_str());
 
 		if (with_reset) {
-			fprintf(fp, "\tbegin\n"
+			fprintf(dp, "\tbegin\n"
 			"\t\to_mag   <= 0;\n"
 			"\t\to_phase <= 0;\n");
-			if (with_aux)
-				fprintf(fp, "\t\to_aux  <= 0;\n");
-			fprintf(fp, "\tend else ");
+			if (lane_aux)
+				fprintf(dp, "\t\to_aux  <= 0;\n");
+			fprintf(dp, "\tend else ");
 		}
 
-		fprintf(fp, "if (i_ce)\n"
+		fprintf(dp, "if (i_ce)\n"
 			"\tbegin\t// We accumulate a bit during our processing, so shift by one\n"
-			"\t\to_mag   <= xv[NSTAGES][(WW-1):(WW-OW)];\n"
-			"\t\to_phase <= ph[NSTAGES];\n");
-		if (with_aux)
-			fprintf(fp, "\t\to_aux  <= ax[NSTAGES];\n");
-		fprintf(fp, "\tend\n\t// }}}\n");
+			"\t\to_mag   <= %s[(WW-1):(WW-OW)];\n"
+			"\t\to_phase <= %s;\n", xsrc.c_str(), psrc.c_str());
+		if (lane_aux)
+			fprintf(dp, "\t\to_aux  <= ax[%s];\n", axdepth.c_str());
+		fprintf(dp, "\tend\n\t// }}}\n");
 		// }}}
 	}
 	// }}}
 
+	if (lanes > 1) {
+		// {{{
+		const	char *const	rename[] = {
+			"i_xval", "li_xval", "i_yval", "li_yval",
+			"o_mag", "lo_mag", "o_phase", "lo_phase", NULL };
+
+		fclose(dp);
+
+		if (with_aux) {
+			fprintf(fp,
+				"\t// Aux output, shared by all lanes\n"
+				"\t// {{{\n"
+				"\tinitial\to_aux = 0;\n");
+			fprintf(fp, "%s", always_reset.c_str());
+			if (with_reset)
+				fprintf(fp, "\t\to_aux <= 0;\n\telse ");
+			fprintf(fp, "if (i_ce)\n"
+				"\t\to_aux <= ax[%s];\n"
+				"\t// }}}\n\n", axdepth.c_str());
+		}
+
+		fprintf(fp,
+			"\t// Parallel CORDIC lanes\n"
+			"\t// {{{\n"
+			"\tgenvar\tlane;\n"
+			"\tgenerate for(lane=0; lane<NLANES; lane=lane+1)\n"
+			"\tbegin : LANE\n"
+			"\t\twire\tsigned\t[(IW-1):0]\tli_xval, li_yval;\n"
+			"\t\treg\tsigned\t[(OW-1):0]\tlo_mag;\n"
+			"\t\treg\t\t[(PW-1):0]\tlo_phase;\n"
+			"\n"
+			"\t\tassign\tli_xval = i_xval[lane*IW +: IW];\n"
+			"\t\tassign\tli_yval = i_yval[lane*IW +: IW];\n"
+			"\n");
+
+		lane_copy(fp, dpbuf, rename);
+
+		fprintf(fp,
+			"\n"
+			"\t\tassign\to_mag[lane*OW +: OW]   = lo_mag;\n"
+			"\t\tassign\to_phase[lane*PW +: PW] = lo_phase;\n"
+			"\tend endgenerate\n"
+			"\t// }}}\n");
+		free(dpbuf);
+		// }}}
+	}
+
 	fprintf(fp, "endmodule\n");
 
 	if (NULL != fhp) {
@@ -425,28 +878,86 @@ void	topolar(FILE *fp, FILE *fhp, const char *cmdline, const char *fname, int ns
 		fprintf(fhp, "#define	%s\n", str);
 		if (async_reset)
 			fprintf(fhp, "#define\tASYNC_RESET\n");
+		fprintf(fhp, "const int	NLANES = %d;\n", (lanes > 1) ? lanes : 1);
 		fprintf(fhp, "const int	IW = %d;\n", iw);
 		fprintf(fhp, "const int	OW = %d;\n", ow);
 		fprintf(fhp, "const int	NEXTRA = %d;\n", nxtra);
 		fprintf(fhp, "const int	WW = %d;\n", working_width);
 		fprintf(fhp, "const int	PW = %d;\n", phase_bits);
 		fprintf(fhp, "const int	NSTAGES = %d;\n", nstages);
-		fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
-			transform_quantization_variance(nstages,
-				working_width-iw, working_width-ow));
-		fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
-			phase_variance(nstages, phase_bits));
-		fprintf(fhp, "const double\tGAIN = %.16f;\n",
-			cordic_gain(nstages) * sqrt(2.0) / 2.);
+		fprintf(fhp, "const int	LATENCY = %d;\t// Clocks from i_ce to output\n",
+			nregs+((unit_gain) ? 3:2));
+		if (radix4) {
+			fprintf(fhp, "#define\tRADIX4\n");
+			fprintf(fhp, "const int	NR2 = %d;\t// Radix-2 stages\n", nr2);
+			fprintf(fhp, "const int	NR4 = %d;\t// Radix-4 stages\n", nr4);
+			fprintf(fhp, "const int	R4_SHIFT0 = %d;\t// Shift of the first\n",
+				radix4_start(working_width));
+		}
+
+		if (unit_gain) {
+			// {{{
+			// The quantization noise is that of the working width,
+			// compensated along with the signal
+			double	qv, pv;
+
+			if (radix4) {
+				qv = radix4_quantization_variance(nstages,
+					working_width, phase_bits,
+					working_width-iw, 0);
+				pv = radix4_phase_variance(nstages,
+					working_width, phase_bits);
+			} else {
+				qv = transform_quantization_variance(nstages,
+					working_width-iw, 0);
+				pv = phase_variance(nstages, phase_bits);
+			}
+
+			fprintf(fhp, "#define\tUNIT_GAIN\n");
+			fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
+				unit_gain_variance(qv, gain, working_width-ow));
+			fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n", pv);
+			fprintf(fhp, "const double\tCORDIC_GAIN = %.16f;\t// Compensated\n",
+				gain);
+			fprintf(fhp, "const double\tGAIN = 1.0;\n");
+			// }}}
+		} else if (radix4) {
+			// {{{
+			fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
+				radix4_quantization_variance(nstages,
+					working_width, phase_bits,
+					working_width-iw, working_width-ow));
+			fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
+				radix4_phase_variance(nstages, working_width,
+					phase_bits));
+			fprintf(fhp, "const double\tGAIN = %.16f;\n",
+				radix4_gain(nstages, working_width,
+					phase_bits) * sqrt(2.0) / 2.);
+			// }}}
+		} else {
+			fprintf(fhp, "const double\tQUANTIZATION_VARIANCE = %.16f; // (Units^2)\n",
+				transform_quantization_variance(nstages,
+					working_width-iw, working_width-ow));
+			fprintf(fhp, "const double\tPHASE_VARIANCE_RAD = %.16f; // (Radians^2)\n",
+				phase_variance(nstages, phase_bits));
+			fprintf(fhp, "const double\tGAIN = %.16f;\n",
+				cordic_gain(nstages) * sqrt(2.0) / 2.);
+		}
 		fprintf(fhp, "const bool\tHAS_RESET = %s;\n", with_reset?"true":"false");
 		fprintf(fhp, "const bool\tHAS_AUX   = %s;\n", with_aux?"true":"false");
 		if (with_reset)
 			fprintf(fhp, "#define\tHAS_RESET_WIRE\n");
 		if (with_aux)
 			fprintf(fhp, "#define\tHAS_AUX_WIRES\n");
+
+		topolar_model(fhp, nstages, iw, ow, working_width, phase_bits,
+			radix4, unit_gain);
+
 		fprintf(fhp, "#endif	// %s\n", str);
 
 		delete[] str;
 		// }}}
 	}
+
+	return nregs + ((unit_gain) ? 3:2);
 }